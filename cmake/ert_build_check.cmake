@@ -37,6 +37,8 @@ check_function_exists( pthread_yield_np HAVE_YIELD_NP)
 check_function_exists( pthread_yield HAVE_YIELD)
 check_function_exists( fseeko HAVE_FSEEKO )
 check_function_exists( timegm HAVE_TIMEGM )
+check_function_exists( mmap HAVE_MMAP )
+check_function_exists( getc_unlocked HAVE_GETC_UNLOCKED )
 
 check_function_exists( _mkdir HAVE_WINDOWS_MKDIR)
 if (NOT HAVE_WINDOWS_MKDIR)
@@ -27,6 +27,7 @@ extern "C" {
 #include <ert/util/bool_vector.h>
 
 #include <ert/analysis/module_info.h>
+#include <ert/analysis/obs_covar.h>
 
 /*
    These are option flag values which are used by the core ert code to
@@ -46,18 +47,27 @@ typedef enum {
     ANALYSIS_USE_A      = 4,       // The module will read the content of A - but not modify it.
     ANALYSIS_UPDATE_A   = 8,       // The update will be based on modifying A directly, and not on an X matrix.
     ANALYSIS_SCALE_DATA = 16,
-    ANALYSIS_ITERABLE   = 32       // The module can bu used as an iterative smoother.
+    ANALYSIS_ITERABLE   = 32,      // The module can bu used as an iterative smoother.
+    ANALYSIS_OBS_COVAR  = 64       // The module implements initX_covar() and does not need the dense R matrix.
 } analysis_module_flag_enum;
 
 
-#define ANALYSIS_MODULE_FLAG_ENUM_SIZE 5
+#define ANALYSIS_MODULE_FLAG_ENUM_SIZE 6
 #define ANALYSIS_MODULE_FLAG_ENUM_DEFS {.value = ANALYSIS_NEED_ED     , .name = "ANALYSIS_NEED_ED"},\
                                        {.value = ANALYSIS_USE_A       , .name = "ANALYSIS_USE_A"},\
                                        {.value = ANALYSIS_UPDATE_A    , .name = "ANALYSIS_UPDATE_A"},\
                                        {.value = ANALYSIS_SCALE_DATA  , .name = "ANALYSIS_SCALE_DATA"},\
-                                       {.value = ANALYSIS_ITERABLE    , .name = "ANALYSIS_ITERABLE"}
+                                       {.value = ANALYSIS_ITERABLE    , .name = "ANALYSIS_ITERABLE"},\
+                                       {.value = ANALYSIS_OBS_COVAR   , .name = "ANALYSIS_OBS_COVAR"}
 
 
+/*
+  Modules which do their own multithreading can support this integer
+  variable; it is set from the ANALYSIS_THREADS configuration before
+  each update.
+*/
+#define ANALYSIS_NUM_THREADS_KEY "NUM_THREADS"
+
 #define EXTERNAL_MODULE_NAME "analysis_table"
 #define EXTERNAL_MODULE_SYMBOL analysis_table
 
@@ -89,6 +99,16 @@ typedef enum {
                              matrix_type * D);
 
 
+  void analysis_module_initX_covar(analysis_module_type * module ,
+                                   matrix_type * X ,
+                                   matrix_type * A ,
+                                   matrix_type * S ,
+                                   const obs_covar_type * R ,
+                                   matrix_type * dObs ,
+                                   matrix_type * E ,
+                                   matrix_type * D);
+
+
   void analysis_module_updateA(analysis_module_type * module ,
                                matrix_type * A ,
                                matrix_type * S ,
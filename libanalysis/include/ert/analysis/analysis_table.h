@@ -11,6 +11,7 @@ extern "C" {
 #include <ert/util/bool_vector.h>
 
 #include <ert/analysis/module_info.h>
+#include <ert/analysis/obs_covar.h>
 
 
   typedef void (analysis_updateA_ftype) (void * module_data ,
@@ -33,6 +34,16 @@ extern "C" {
                                              matrix_type * D );
 
 
+  typedef void (analysis_initX_covar_ftype) (void * module_data ,
+                                             matrix_type * X ,
+                                             matrix_type * A ,
+                                             matrix_type * S ,
+                                             const obs_covar_type * R ,
+                                             matrix_type * dObs ,
+                                             matrix_type * E ,
+                                             matrix_type * D );
+
+
   typedef bool (analysis_set_int_ftype)       (void * module_data , const char * flag , int value);
   typedef bool (analysis_set_bool_ftype)      (void * module_data , const char * flag , bool value);
   typedef bool (analysis_set_double_ftype)    (void * module_data , const char * var , double value);
@@ -83,6 +94,13 @@ typedef struct {
   analysis_get_double_ftype      * get_double;
   analysis_get_bool_ftype        * get_bool;
   analysis_get_ptr_ftype         * get_ptr;
+
+  /*
+    Only read for modules which set the ANALYSIS_OBS_COVAR option,
+    so that modules compiled before this field was added can still
+    be loaded.
+  */
+  analysis_initX_covar_ftype     * initX_covar;
 } analysis_table_type;
 
 
@@ -5,6 +5,8 @@
 #include <ert/util/matrix.h>
 #include <ert/util/double_vector.h>
 
+#include <ert/analysis/obs_covar.h>
+
 
 int enkf_linalg_get_PC( const matrix_type * S0, 
                          const matrix_type * dObs , 
@@ -35,6 +37,7 @@ void enkf_linalg_init_sqrtX(matrix_type * X5      ,
 
 
 void enkf_linalg_Cee(matrix_type * B, int nrens , const matrix_type * R , const matrix_type * U0 , const double * inv_sig0);
+void enkf_linalg_Cee_covar(matrix_type * B, int nrens , const obs_covar_type * R , const matrix_type * U0 , const double * inv_sig0);
 
 
 int enkf_linalg_svd_truncation(const matrix_type * S , 
@@ -76,6 +79,13 @@ void enkf_linalg_lowrankCinv(const matrix_type * S ,
                              double truncation     ,
                              int    ncomp);
 
+void enkf_linalg_lowrankCinv_covar(const matrix_type * S ,
+                                   const obs_covar_type * R ,
+                                   matrix_type * W       ,
+                                   double * eig          ,
+                                   double truncation     ,
+                                   int    ncomp);
+
 
 
 void enkf_linalg_genX2(matrix_type * X2 , const matrix_type * S , const matrix_type * W , const double * eig);
@@ -0,0 +1,47 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'obs_covar.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_OBS_COVAR_H
+#define ERT_OBS_COVAR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <ert/util/type_macros.h>
+#include <ert/util/matrix.h>
+
+  typedef struct obs_covar_struct obs_covar_type;
+
+  obs_covar_type * obs_covar_alloc( void );
+  void             obs_covar_free( obs_covar_type * covar );
+  void             obs_covar_add_var( obs_covar_type * covar , double var );
+  void             obs_covar_add_block( obs_covar_type * covar , matrix_type * block );
+  int              obs_covar_get_size( const obs_covar_type * covar );
+  int              obs_covar_get_num_blocks( const obs_covar_type * covar );
+  double           obs_covar_iget( const obs_covar_type * covar , int i , int j);
+  void             obs_covar_scale( obs_covar_type * covar , const double * scale_factor );
+  matrix_type    * obs_covar_alloc_matrix( const obs_covar_type * covar );
+  void             obs_covar_UtRU( const obs_covar_type * covar , const matrix_type * U , matrix_type * B);
+
+  UTIL_IS_INSTANCE_HEADER( obs_covar );
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -10,6 +10,8 @@ extern "C" {
 #include <ert/util/matrix.h>
 #include <ert/util/rng.h>
 
+#include <ert/analysis/obs_covar.h>
+
 #define  DEFAULT_ENKF_TRUNCATION_  0.98
 #define  ENKF_TRUNCATION_KEY_      "ENKF_TRUNCATION"
 #define  ENKF_NCOMP_KEY_           "ENKF_NCOMP"
@@ -47,6 +49,14 @@ extern "C" {
                         matrix_type * dObs ,
                         matrix_type * E ,
                         matrix_type * D);
+  void   std_enkf_initX_covar(void * module_data ,
+                              matrix_type * X ,
+                              matrix_type * A ,
+                              matrix_type * S ,
+                              const obs_covar_type * R ,
+                              matrix_type * dObs ,
+                              matrix_type * E ,
+                              matrix_type * D);
 
 #ifdef __cplusplus
 }
@@ -42,6 +42,7 @@ struct analysis_module_struct {
   analysis_free_ftype            * freef;
   analysis_alloc_ftype           * alloc;
   analysis_initX_ftype           * initX;
+  analysis_initX_covar_ftype     * initX_covar;
   analysis_updateA_ftype         * updateA;
   analysis_init_update_ftype     * init_update;
   analysis_complete_update_ftype * complete_update;
@@ -71,6 +72,7 @@ static analysis_module_type * analysis_module_alloc_empty( const char * symbol_t
 
   module->lib_handle      = NULL;
   module->initX           = NULL;
+  module->initX_covar     = NULL;
   module->updateA         = NULL;
   module->set_int         = NULL;
   module->set_bool        = NULL;
@@ -132,6 +134,9 @@ static analysis_module_type * analysis_module_alloc__( rng_type * rng ,
   if (module->alloc)
     module->module_data = module->alloc( rng );
 
+  if (module->get_options && analysis_module_check_option( module , ANALYSIS_OBS_COVAR ))
+    module->initX_covar = table->initX_covar;
+
   if (!analysis_module_internal_check( module )) {
     fprintf(stderr,"** Warning loading module: %s failed - internal inconsistency\n", module->user_name);
     analysis_module_free( module );
@@ -265,6 +270,31 @@ void analysis_module_initX(analysis_module_type * module ,
 }
 
 
+/*
+  The observation error covariance is passed as an obs_covar
+  instance. Modules which do not implement initX_covar() get a dense
+  copy of R.
+*/
+
+void analysis_module_initX_covar(analysis_module_type * module ,
+                                 matrix_type * X ,
+                                 matrix_type * A ,
+                                 matrix_type * S ,
+                                 const obs_covar_type * R ,
+                                 matrix_type * dObs ,
+                                 matrix_type * E ,
+                                 matrix_type * D ) {
+
+  if (module->initX_covar != NULL)
+    module->initX_covar(module->module_data , X , A , S , R , dObs , E , D );
+  else {
+    matrix_type * denseR = obs_covar_alloc_matrix( R );
+    module->initX(module->module_data , X , A , S , denseR , dObs , E , D );
+    matrix_free( denseR );
+  }
+}
+
+
 void analysis_module_updateA(analysis_module_type * module ,
                              matrix_type * A ,
                              matrix_type * S ,
@@ -26,6 +26,7 @@
 #include <ert/util/rng.h>
 #include <ert/util/matrix.h>
 #include <ert/util/matrix_blas.h>
+#include <ert/util/thread_pool.h>
 
 #include <ert/analysis/std_enkf.h>
 #include <ert/analysis/cv_enkf.h>
@@ -53,6 +54,7 @@ typedef struct {
   rng_type             * rng;
   long                   option_flags;
   bool                   doCV;
+  int                    num_threads;
 } bootstrap_enkf_data_type;
 
 
@@ -89,6 +91,7 @@ void * bootstrap_enkf_data_alloc( rng_type * rng ) {
   bootstrap_enkf_set_truncation( boot_data , DEFAULT_TRUNCATION );
   bootstrap_enkf_set_subspace_dimension( boot_data , DEFAULT_NCOMP );
   bootstrap_enkf_set_doCV( boot_data , DEFAULT_DO_CV);
+  boot_data->num_threads = util_get_num_cpu();
   boot_data->option_flags = ANALYSIS_NEED_ED + ANALYSIS_UPDATE_A + ANALYSIS_SCALE_DATA;
   return boot_data;
 }
@@ -133,6 +136,130 @@ static void free_iens_resample( int ** iens_resample, int ens_size ) {
 
 
 
+/*
+  The bootstrap update of realisation iens is column iens of
+
+     A_resampled * X_iens + A
+
+  where A_resampled is A with the columns resampled with
+  iens_resample[iens], and X_iens is the X matrix computed from S
+  resampled in the same way. Only column iens of X_iens is needed, so
+  these columns are first collected in the matrix W; then the update
+  of all the realisations is a gather of the columns of A, weighted
+  with W, and is done in one pass over the rows of A.
+*/
+
+#define BOOTSTRAP_BLOCK_SIZE       32768
+#define BOOTSTRAP_MIN_BLOCK_ROWS   16
+
+
+typedef struct {
+  bootstrap_enkf_data_type * bootstrap_data;
+  matrix_type              * A;
+  matrix_type              * S;
+  matrix_type              * R;
+  matrix_type              * dObs;
+  matrix_type              * E;
+  matrix_type              * D;
+  matrix_type              * W;
+  int                     ** iens_resample;
+  int                        block_rows;
+} bootstrap_update_type;
+
+
+static void bootstrap_enkf_resample( matrix_type * target , const matrix_type * src , const int * resample ) {
+  for (int i = 0; i < matrix_get_columns( target ); i++)
+    matrix_copy_column( target , src , i , resample[i] );
+}
+
+
+/*
+  X is computed from the resampled S; A is only resampled when the CV
+  scheme is used, the std_enkf scheme does not need it.
+*/
+
+static void bootstrap_enkf_initW_column( bootstrap_update_type * update , int iens ) {
+  bootstrap_enkf_data_type * bootstrap_data = update->bootstrap_data;
+  int ens_size              = matrix_get_columns( update->S );
+  matrix_type * X           = matrix_alloc( ens_size , ens_size );
+  matrix_type * S_resampled = matrix_alloc( matrix_get_rows( update->S ) , ens_size );
+
+  bootstrap_enkf_resample( S_resampled , update->S , update->iens_resample[iens] );
+  if (bootstrap_data->doCV) {
+    const bool_vector_type * ens_mask = NULL;
+    matrix_type * A_resampled = matrix_alloc( matrix_get_rows( update->A ) , ens_size );
+
+    bootstrap_enkf_resample( A_resampled , update->A , update->iens_resample[iens] );
+    cv_enkf_init_update( bootstrap_data->cv_enkf_data , ens_mask , S_resampled , update->R , update->dObs , update->E , update->D);
+    cv_enkf_initX( bootstrap_data->cv_enkf_data , X , A_resampled , S_resampled , update->R , update->dObs , update->E , update->D);
+    matrix_free( A_resampled );
+  } else
+    std_enkf_initX( bootstrap_data->std_enkf_data , X , NULL , S_resampled , update->R , update->dObs , update->E , update->D );
+
+  matrix_copy_column( update->W , X , iens , iens );
+  matrix_free( S_resampled );
+  matrix_free( X );
+}
+
+
+static void bootstrap_enkf_initW_column__( int iens , void * arg ) {
+  bootstrap_enkf_initW_column( arg , iens );
+}
+
+
+/*
+  Updates the rows [row1, row1 + block_rows) of A. The block is copied
+  to a work buffer first, so A can be updated in place.
+*/
+
+static void bootstrap_enkf_update_block( int iblock , void * arg ) {
+  bootstrap_update_type * update = arg;
+  const int ens_size = matrix_get_columns( update->A );
+  const int row1     = iblock * update->block_rows;
+  const int rows     = util_int_min( update->block_rows , matrix_get_rows( update->A ) - row1 );
+  double * work      = util_malloc( 2 * rows * ens_size * sizeof * work );
+  double * A0        = work;
+  double * A1        = &work[ rows * ens_size ];
+  matrix_type * A_block = matrix_alloc_shared( update->A , row1 , 0 , rows , ens_size );
+
+  {
+    matrix_type * A0_view = matrix_alloc_view( A0 , rows , ens_size );
+    matrix_assign( A0_view , A_block );
+    matrix_free( A0_view );
+  }
+
+  for (int iens = 0; iens < ens_size; iens++) {
+    const int * resample = update->iens_resample[iens];
+    double * y = &A1[ iens * rows ];
+
+    for (int i = 0; i < rows; i++)
+      y[i] = 0;
+
+    for (int k = 0; k < ens_size; k++) {
+      const double w = matrix_iget( update->W , k , iens );
+      const double * x = &A0[ resample[k] * rows ];
+      for (int i = 0; i < rows; i++)
+        y[i] += w * x[i];
+    }
+
+    {
+      const double * x = &A0[ iens * rows ];
+      for (int i = 0; i < rows; i++)
+        y[i] += x[i];
+    }
+  }
+
+  {
+    matrix_type * A1_view = matrix_alloc_view( A1 , rows , ens_size );
+    matrix_assign( A_block , A1_view );
+    matrix_free( A1_view );
+  }
+
+  matrix_free( A_block );
+  free( work );
+}
+
+
 void bootstrap_enkf_updateA(void * module_data ,
                             matrix_type * A ,
                             matrix_type * S ,
@@ -144,55 +271,36 @@ void bootstrap_enkf_updateA(void * module_data ,
 
   bootstrap_enkf_data_type * bootstrap_data = bootstrap_enkf_data_safe_cast( module_data );
   {
-    const int num_cpu_threads = 4;
-    int ens_size              = matrix_get_columns( A );
-    matrix_type * X           = matrix_alloc( ens_size , ens_size );
-    matrix_type * A0          = matrix_alloc_copy( A );
-    matrix_type * S_resampled = matrix_alloc_copy( S );
-    matrix_type * A_resampled = matrix_alloc( matrix_get_rows(A0) , matrix_get_columns( A0 ));
-    int ** iens_resample      = alloc_iens_resample( bootstrap_data->rng , ens_size );
-    {
-      int ensemble_members_loop;
-      for ( ensemble_members_loop = 0; ensemble_members_loop < ens_size; ensemble_members_loop++) {
-        int unique_bootstrap_components;
-        int ensemble_counter;
-        /* Resample A and meas_data. Here we are careful to resample the working copy.*/
-        {
-          {
-            int_vector_type * bootstrap_components = int_vector_alloc( ens_size , 0);
-            for (ensemble_counter  = 0; ensemble_counter < ens_size; ensemble_counter++) {
-              int random_column = iens_resample[ ensemble_members_loop][ensemble_counter];
-              int_vector_iset( bootstrap_components , ensemble_counter , random_column );
-              matrix_copy_column( A_resampled , A0 , ensemble_counter , random_column );
-              matrix_copy_column( S_resampled , S  , ensemble_counter , random_column );
-            }
-            int_vector_select_unique( bootstrap_components );
-            unique_bootstrap_components = int_vector_size( bootstrap_components );
-            int_vector_free( bootstrap_components );
-          }
-
-          if (bootstrap_data->doCV) {
-            const bool_vector_type * ens_mask = NULL;
-            cv_enkf_init_update( bootstrap_data->cv_enkf_data , ens_mask , S_resampled , R , dObs , E , D);
-            cv_enkf_initX( bootstrap_data->cv_enkf_data , X , A_resampled , S_resampled , R , dObs , E , D);
-          } else
-            std_enkf_initX(bootstrap_data->std_enkf_data , X , NULL , S_resampled,R, dObs, E,D );
-
-
-          matrix_inplace_matmul_mt1( A_resampled , X , num_cpu_threads );
-          matrix_inplace_add( A_resampled , A0 );
-          matrix_copy_column( A , A_resampled, ensemble_members_loop, ensemble_members_loop);
-
-        }
-      }
-    }
-
-
-    free_iens_resample( iens_resample , ens_size);
-    matrix_free( X );
-    matrix_free( S_resampled );
-    matrix_free( A_resampled );
-    matrix_free( A0 );
+    const int ens_size    = matrix_get_columns( A );
+    const int rows        = matrix_get_rows( A );
+    thread_pool_type * tp = thread_pool_alloc( bootstrap_data->num_threads , true );
+    bootstrap_update_type update = { .bootstrap_data = bootstrap_data ,
+                                     .A              = A ,
+                                     .S              = S ,
+                                     .R              = R ,
+                                     .dObs           = dObs ,
+                                     .E              = E ,
+                                     .D              = D ,
+                                     .W              = matrix_alloc( ens_size , ens_size ),
+                                     .iens_resample  = alloc_iens_resample( bootstrap_data->rng , ens_size ),
+                                     .block_rows     = util_int_max( BOOTSTRAP_MIN_BLOCK_ROWS , BOOTSTRAP_BLOCK_SIZE / util_int_max( 1 , ens_size )) };
+
+    /*
+      The cv_enkf scheme draws from the rng and keeps state in the
+      module data, so then the X matrices must be computed in order.
+    */
+    if (bootstrap_data->doCV) {
+      for (int iens = 0; iens < ens_size; iens++)
+        bootstrap_enkf_initW_column( &update , iens );
+    } else
+      thread_pool_parallel_for( tp , 0 , ens_size , bootstrap_enkf_initW_column__ , &update );
+
+    thread_pool_parallel_for( tp , 0 , (rows + update.block_rows - 1) / update.block_rows , bootstrap_enkf_update_block , &update );
+    thread_pool_join( tp );
+
+    free_iens_resample( update.iens_resample , ens_size );
+    matrix_free( update.W );
+    thread_pool_free( tp );
   }
 }
 
@@ -224,7 +332,10 @@ bool bootstrap_enkf_set_double( void * arg , const char * var_name , double valu
 bool bootstrap_enkf_set_int( void * arg , const char * var_name , int value) {
   bootstrap_enkf_data_type * bootstrap_data = bootstrap_enkf_data_safe_cast( arg );
   {
-    if (std_enkf_set_int( bootstrap_data->std_enkf_data , var_name , value ))
+    if (strcmp( var_name , ANALYSIS_NUM_THREADS_KEY ) == 0) {
+      bootstrap_data->num_threads = util_int_max( 1 , value );
+      return true;
+    } else if (std_enkf_set_int( bootstrap_data->std_enkf_data , var_name , value ))
       return true;
     else {
       return false;
@@ -251,7 +362,10 @@ bool bootstrap_enkf_set_bool( void * arg , const char * var_name , bool value) {
 bool bootstrap_enkf_has_var( const void * arg, const char * var_name) {
     const bootstrap_enkf_data_type * module_data = bootstrap_enkf_data_safe_cast_const( arg );
     {
-      return std_enkf_has_var(module_data->std_enkf_data, var_name);
+      if (strcmp( var_name , ANALYSIS_NUM_THREADS_KEY ) == 0)
+        return true;
+      else
+        return std_enkf_has_var(module_data->std_enkf_data, var_name);
     }
 }
 
@@ -265,7 +379,10 @@ double bootstrap_enkf_get_double( const void * arg, const char * var_name) {
 int bootstrap_enkf_get_int( const void * arg, const char * var_name) {
     const bootstrap_enkf_data_type * module_data = bootstrap_enkf_data_safe_cast_const( arg );
     {
-      return std_enkf_get_int( module_data->std_enkf_data , var_name);
+      if (strcmp( var_name , ANALYSIS_NUM_THREADS_KEY ) == 0)
+        return module_data->num_threads;
+      else
+        return std_enkf_get_int( module_data->std_enkf_data , var_name);
     }
 }
 
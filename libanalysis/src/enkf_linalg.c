@@ -224,6 +224,27 @@ int enkf_linalg_num_PC(const matrix_type * S , double truncation ) {
 
 
 
+/*
+  Multiply B with S^(-1) from left and right, and scale with (nrens - 1):
+
+     BHat = (nrens - 1) * S^(-1) * B * S^(-1)
+*/
+
+static void enkf_linalg_Cee_scale(matrix_type * B , int nrens , const double * inv_sig0) {
+  int i ,j;
+
+  for (j=0; j < matrix_get_columns( B ) ; j++)
+    for (i=0; i < matrix_get_rows( B ); i++)
+      matrix_imul(B , i , j , inv_sig0[i]);
+
+  for (j=0; j < matrix_get_columns( B ) ; j++)
+    for (i=0; i < matrix_get_rows( B ); i++)
+      matrix_imul(B , i , j , inv_sig0[j]);
+
+  matrix_scale(B , nrens - 1.0);
+}
+
+
 void enkf_linalg_Cee(matrix_type * B, int nrens , const matrix_type * R , const matrix_type * U0 , const double * inv_sig0) {
   const int nrmin = matrix_get_rows( B );
   {
@@ -232,37 +253,37 @@ void enkf_linalg_Cee(matrix_type * B, int nrens , const matrix_type * R , const
     matrix_dgemm(B  , X0 , U0 , false , false , 1.0 , 0.0);  /* B = X0 * U0 */
     matrix_free( X0 );
   }
+  enkf_linalg_Cee_scale( B , nrens , inv_sig0 );
+}
 
-  {
-    int i ,j;
-
-    /* Funny code ??
-       Multiply B with S^(-1)from left and right
-       BHat =  S^(-1) * B * S^(-1)
-    */
-    for (j=0; j < matrix_get_columns( B ) ; j++)
-      for (i=0; i < matrix_get_rows( B ); i++)
-        matrix_imul(B , i , j , inv_sig0[i]);
-
-    for (j=0; j < matrix_get_columns( B ) ; j++)
-      for (i=0; i < matrix_get_rows( B ); i++)
-        matrix_imul(B , i , j , inv_sig0[j]);
-  }
 
-  matrix_scale(B , nrens - 1.0);
+/*
+  Same as enkf_linalg_Cee(), but the U0^T * R * U0 product is
+  evaluated one block of the obs_covar at a time, without the dense R
+  matrix.
+*/
+
+void enkf_linalg_Cee_covar(matrix_type * B, int nrens , const obs_covar_type * R , const matrix_type * U0 , const double * inv_sig0) {
+  obs_covar_UtRU( R , U0 , B );
+  enkf_linalg_Cee_scale( B , nrens , inv_sig0 );
 }
 
 
 
 
-void enkf_linalg_lowrankCinv__(const matrix_type * S ,
-                               const matrix_type * R ,
-                               matrix_type * V0T ,
-                               matrix_type * Z,
-                               double * eig ,
-                               matrix_type * U0,
-                               double truncation,
-                               int ncomp) {
+/*
+  Exactly one of @R and @covar should be non NULL.
+*/
+
+static void enkf_linalg_lowrankCinv___(const matrix_type * S ,
+                                       const matrix_type * R ,
+                                       const obs_covar_type * covar ,
+                                       matrix_type * V0T ,
+                                       matrix_type * Z,
+                                       double * eig ,
+                                       matrix_type * U0,
+                                       double truncation,
+                                       int ncomp) {
 
   const int nrobs = matrix_get_rows( S );
   const int nrens = matrix_get_columns( S );
@@ -277,7 +298,10 @@ void enkf_linalg_lowrankCinv__(const matrix_type * S ,
 
   {
     matrix_type * B    = matrix_alloc( nrmin , nrmin );
-    enkf_linalg_Cee( B , nrens , R , U0 , inv_sig0);          /* B = Xo = (N-1) * Sigma0^(+) * U0'* Cee * U0 * Sigma0^(+')  (14.26)*/
+    if (covar != NULL)
+      enkf_linalg_Cee_covar( B , nrens , covar , U0 , inv_sig0);
+    else
+      enkf_linalg_Cee( B , nrens , R , U0 , inv_sig0);          /* B = Xo = (N-1) * Sigma0^(+) * U0'* Cee * U0 * Sigma0^(+')  (14.26)*/
     matrix_dgesvd(DGESVD_MIN_RETURN , DGESVD_NONE, B , eig, Z , NULL);
     matrix_free( B );
   }
@@ -297,12 +321,25 @@ void enkf_linalg_lowrankCinv__(const matrix_type * S ,
 }
 
 
-void enkf_linalg_lowrankCinv(const matrix_type * S ,
-                             const matrix_type * R ,
-                             matrix_type * W       , /* Corresponding to X1 from Eq. 14.29 */
-                             double * eig          , /* Corresponding to 1 / (1 + Lambda_1) (14.29) */
-                             double truncation     ,
-                             int    ncomp) {
+void enkf_linalg_lowrankCinv__(const matrix_type * S ,
+                               const matrix_type * R ,
+                               matrix_type * V0T ,
+                               matrix_type * Z,
+                               double * eig ,
+                               matrix_type * U0,
+                               double truncation,
+                               int ncomp) {
+  enkf_linalg_lowrankCinv___( S , R , NULL , V0T , Z , eig , U0 , truncation , ncomp );
+}
+
+
+static void enkf_linalg_lowrankCinvW__(const matrix_type * S ,
+                                       const matrix_type * R ,
+                                       const obs_covar_type * covar ,
+                                       matrix_type * W ,
+                                       double * eig ,
+                                       double truncation ,
+                                       int    ncomp) {
 
   const int nrobs = matrix_get_rows( S );
   const int nrens = matrix_get_columns( S );
@@ -311,7 +348,7 @@ void enkf_linalg_lowrankCinv(const matrix_type * S ,
   matrix_type * U0   = matrix_alloc( nrobs , nrmin );
   matrix_type * Z    = matrix_alloc( nrmin , nrmin );
 
-  enkf_linalg_lowrankCinv__( S , R , NULL , Z , eig , U0 , truncation , ncomp);
+  enkf_linalg_lowrankCinv___( S , R , covar , NULL , Z , eig , U0 , truncation , ncomp);
   matrix_matmul(W , U0 , Z); /* X1 = W = U0 * Z2 = U0 * Sigma0^(+') * Z    */
 
   matrix_free( U0 );
@@ -319,6 +356,26 @@ void enkf_linalg_lowrankCinv(const matrix_type * S ,
 }
 
 
+void enkf_linalg_lowrankCinv(const matrix_type * S ,
+                             const matrix_type * R ,
+                             matrix_type * W       , /* Corresponding to X1 from Eq. 14.29 */
+                             double * eig          , /* Corresponding to 1 / (1 + Lambda_1) (14.29) */
+                             double truncation     ,
+                             int    ncomp) {
+  enkf_linalg_lowrankCinvW__( S , R , NULL , W , eig , truncation , ncomp );
+}
+
+
+void enkf_linalg_lowrankCinv_covar(const matrix_type * S ,
+                                   const obs_covar_type * R ,
+                                   matrix_type * W       ,
+                                   double * eig          ,
+                                   double truncation     ,
+                                   int    ncomp) {
+  enkf_linalg_lowrankCinvW__( S , NULL , R , W , eig , truncation , ncomp );
+}
+
+
 void enkf_linalg_meanX5(const matrix_type * S ,
                         const matrix_type * W ,
                         const double * eig    ,
@@ -29,6 +29,8 @@
 #include <ert/util/stepwise.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/double_vector.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/thread_pool.h>
 
 #include <ert/analysis/fwd_step_enkf.h>
 #include <ert/analysis/fwd_step_log.h>
@@ -59,6 +61,7 @@ struct fwd_step_enkf_data_struct {
   long                       option_flags;
   double                     r2_limit;
   bool                       verbose;
+  int                        num_threads;
   fwd_step_log_type        * fwd_step_log;
 };
 
@@ -79,6 +82,10 @@ void fwd_step_enkf_set_verbose( fwd_step_enkf_data_type * data , bool verbose )
   data->verbose = verbose;
 }
 
+void fwd_step_enkf_set_num_threads( fwd_step_enkf_data_type * data , int num_threads ) {
+  data->num_threads = util_int_max( 1 , num_threads );
+}
+
 void * fwd_step_enkf_data_alloc( rng_type * rng ) {
   fwd_step_enkf_data_type * data = util_malloc( sizeof * data );
   UTIL_TYPE_ID_INIT( data , FWD_STEP_ENKF_TYPE_ID );
@@ -89,6 +96,7 @@ void * fwd_step_enkf_data_alloc( rng_type * rng ) {
   data->r2_limit     = DEFAULT_R2_LIMIT;
   data->option_flags = ANALYSIS_NEED_ED + ANALYSIS_UPDATE_A + ANALYSIS_SCALE_DATA;
   data->verbose      = DEFAULT_VERBOSE;
+  data->num_threads  = util_get_num_cpu();
   data->fwd_step_log = fwd_step_log_alloc();
   return data;
 }
@@ -147,20 +155,22 @@ static void fwd_step_enkf_write_log_header( fwd_step_enkf_data_type * fwd_step_d
   printf("===============================================================================================================================\n");
 }
 
-static void fwd_step_enkf_write_iter_info( fwd_step_enkf_data_type * data , stepwise_type * stepwise, const char* key, const int data_active_index, const int global_index, const module_info_type * module_info ) {
+/*
+  Returns the log line for one parameter; the lines are created in
+  parallel and written in order when all the parameters have been
+  updated.
+*/
+
+static char * fwd_step_enkf_alloc_iter_info( stepwise_type * stepwise, const char* key, const int data_active_index, const int global_index, const module_info_type * module_info ) {
 
   const char * format = "%-25s%-25d%-25d";
   int n_active = stepwise_get_n_active( stepwise);
   bool_vector_type * active_set = stepwise_get_active_set(stepwise);
-  bool has_log = fwd_step_log_is_open( data->fwd_step_log );
   module_obs_block_vector_type * module_obs_block_vector  = module_info_get_obs_block_vector(module_info);
   char * loc_key = util_alloc_string_copy(key);
   char * data_active_index_str = util_alloc_sprintf( "(%d)" , data_active_index );
   char * cat = util_strcat_realloc(loc_key , data_active_index_str );
-  if (has_log)
-    fwd_step_log_line( data->fwd_step_log , format, cat, global_index, n_active);
-
-  printf(format, cat, global_index,n_active);
+  char * line = util_alloc_sprintf( format , cat , global_index , n_active );
 
   const double sum_beta = stepwise_get_sum_beta(stepwise);
   int obs_active_index = 0;
@@ -204,26 +214,98 @@ static void fwd_step_enkf_write_iter_info( fwd_step_enkf_data_type * data , step
     perm_vector_type * sort_perm =  double_vector_alloc_rsort_perm(r_list);
     for (int i = 0; i < stringlist_get_size( obs_list); i++) {
       const char * obs_list_entry = stringlist_iget(obs_list, perm_vector_iget(sort_perm, i));
-      if (has_log)
-        fwd_step_log_line( data->fwd_step_log , "%s", obs_list_entry);
-
-      printf("%s", obs_list_entry);
+      line = util_strcat_realloc( line , obs_list_entry );
     }
     perm_vector_free(sort_perm);
   }
+  line = util_strcat_realloc( line , "\n" );
+
+  stringlist_free(obs_list);
+  double_vector_free(r_list);
+  util_safe_free(data_active_index_str);
+  util_safe_free(cat);
+  return line;
+}
+
 
+/*
+  The rows of A are updated independently of each other, in parallel
+  jobs with blocks of consecutive rows. Each job has its own stepwise
+  instance and rng; before each row the rng is set to a state which
+  has been drawn for that row from the module rng up front, so the
+  result does not depend on the number of threads.
+*/
 
+typedef struct {
+  fwd_step_enkf_data_type  * data;
+  const module_info_type   * module_info;
+  matrix_type              * A;
+  matrix_type              * workS;        /* S' */
+  matrix_type              * workE;        /* E' */
+  matrix_type             ** di;           /* Column j of D as a 1 x nd matrix, for each realisation j. */
+  int_vector_type          * rows;         /* The rows of A to update ... */
+  int_vector_type          * row_kw;       /* ... the data block of each row ... */
+  int_vector_type          * row_index;    /* ... and the index of the row within the data block. */
+  char                     * rng_states;
+  int                        rng_state_size;
+  int                        block_size;
+  char                    ** lines;        /* Verbose output; one line per row. */
+} fwd_step_update_type;
+
+
+static void fwd_step_enkf_update_block( int iblock , void * arg ) {
+  fwd_step_update_type * update = arg;
+  fwd_step_enkf_data_type * data = update->data;
+  const int ens_size = matrix_get_columns( update->A );
+  const int nd       = matrix_get_columns( update->workS );
+  const int index1   = iblock * update->block_size;
+  const int index2   = util_int_min( index1 + update->block_size , int_vector_size( update->rows ));
+  rng_type * rng     = rng_alloc( rng_get_type( data->rng ) , INIT_DEFAULT );
+  stepwise_type * stepwise_data = stepwise_alloc1( ens_size , nd , rng );
+  module_data_block_vector_type * data_block_vector = module_info_get_data_block_vector( update->module_info );
+
+  stepwise_set_X0( stepwise_data , matrix_alloc_copy( update->workS ));
+  stepwise_set_E0( stepwise_data , matrix_alloc_copy( update->workE ));
+
+  for (int index = index1; index < index2; index++) {
+    const int i = int_vector_iget( update->rows , index );
+    matrix_type * y = matrix_alloc( ens_size , 1 );
+
+    rng_set_state( rng , &update->rng_states[ index * update->rng_state_size ] );
+    for (int j = 0; j < ens_size; j++)
+      matrix_iset(y , j , 0 , matrix_iget( update->A, i , j ) );
+
+    stepwise_set_Y0( stepwise_data , y );
+    stepwise_estimate(stepwise_data , data->r2_limit , data->nfolds );
+
+    /*manipulate A directly*/
+    for (int j = 0; j < ens_size; j++) {
+      double aij = matrix_iget( update->A , i , j );
+      double xHat = stepwise_eval(stepwise_data , update->di[j] );
+      matrix_iset(update->A , i , j , aij + xHat);
+    }
 
-  if (has_log)
-    fwd_step_log_line( data->fwd_step_log , "\n");
+    if (update->lines) {
+      module_data_block_type * data_block = module_data_block_vector_iget_module_data_block(data_block_vector, int_vector_iget( update->row_kw , index ));
+      const char * key = module_data_block_get_key(data_block);
+      const int* active_indices = module_data_block_get_active_indices(data_block);
+      int local_index = int_vector_iget( update->row_index , index );
+      int active_index;
 
-  printf("\n");
+      if (active_indices == NULL) /* Inactive are not present in A */
+        active_index = local_index;
+      else
+        active_index = active_indices[local_index];
 
-  stringlist_free(obs_list);
-  util_safe_free(data_active_index_str);
-  util_safe_free(cat);
+      update->lines[index] = fwd_step_enkf_alloc_iter_info(stepwise_data, key, active_index, i, update->module_info);
+    }
+  }
+
+  stepwise_free( stepwise_data );
+  rng_free( rng );
 }
 
+
 /*Main function: */
 void fwd_step_enkf_updateA(void * module_data ,
                            matrix_type * A ,
@@ -246,7 +328,6 @@ void fwd_step_enkf_updateA(void * module_data ,
     int nx          = matrix_get_rows( A );
     int nd          = matrix_get_rows( S );
     int nfolds      = fwd_step_data->nfolds;
-    double r2_limit = fwd_step_data->r2_limit;
     bool verbose    = fwd_step_data->verbose;
     int num_kw     =  module_data_block_vector_get_size(data_block_vector);
 
@@ -256,88 +337,93 @@ void fwd_step_enkf_updateA(void * module_data ,
 
 
     {
+      fwd_step_update_type update;
+      int num_rows;
 
-      stepwise_type * stepwise_data = stepwise_alloc1(ens_size, nd , fwd_step_data->rng);
-
-      matrix_type * workS = matrix_alloc( ens_size , nd  );
-      matrix_type * workE = matrix_alloc( ens_size , nd  );
+      update.data        = fwd_step_data;
+      update.module_info = module_info;
+      update.A           = A;
+      update.rows        = int_vector_alloc( 0 , 0 );
+      update.row_kw      = int_vector_alloc( 0 , 0 );
+      update.row_index   = int_vector_alloc( 0 , 0 );
 
       /*workS = S' */
       matrix_subtract_row_mean( S );           /* Shift away the mean */
-      workS   = matrix_alloc_transpose( S );
-      workE   = matrix_alloc_transpose( E );
-
-      stepwise_set_X0( stepwise_data , workS );
-      stepwise_set_E0( stepwise_data , workE );
-
-      matrix_type * di = matrix_alloc( 1 , nd );
-
-      if (verbose){
-        char * ministep_name = module_info_get_ministep_name(module_info);
-        fwd_step_enkf_write_log_header(fwd_step_data, ministep_name, nx, nd, ens_size);
+      update.workS = matrix_alloc_transpose( S );
+      update.workE = matrix_alloc_transpose( E );
+
+      update.di = util_calloc( ens_size , sizeof * update.di );
+      for (int j = 0; j < ens_size; j++) {
+        update.di[j] = matrix_alloc( 1 , nd );
+        for (int k = 0; k < nd; k++)
+          matrix_iset( update.di[j] , 0 , k , matrix_iget( D , k , j ));
       }
 
       for (int kw = 0; kw < num_kw; kw++) {
-
         module_data_block_type * data_block = module_data_block_vector_iget_module_data_block(data_block_vector, kw);
-        const char * key = module_data_block_get_key(data_block);
         int row_start = module_data_block_get_row_start(data_block);
         int row_end   = module_data_block_get_row_end(data_block);
-        const int* active_indices = module_data_block_get_active_indices(data_block);
-        int local_index = 0;
-        int active_index = 0;
-        bool all_active = active_indices == NULL; /* Inactive are not present in A */
 
         for (int i = row_start; i < row_end; i++) {
+          int_vector_append( update.rows , i );
+          int_vector_append( update.row_kw , kw );
+          int_vector_append( update.row_index , i - row_start );
+        }
+      }
+      num_rows = int_vector_size( update.rows );
+
+      update.rng_state_size = rng_state_size( fwd_step_data->rng );
+      update.rng_states = util_malloc( util_int_max( 1 , num_rows * update.rng_state_size ));
+      {
+        rng_type * row_rng = rng_alloc( rng_get_type( fwd_step_data->rng ) , INIT_DEFAULT );
+        for (int index = 0; index < num_rows; index++) {
+          rng_rng_init( row_rng , fwd_step_data->rng );
+          rng_get_state( row_rng , &update.rng_states[ index * update.rng_state_size ] );
+        }
+        rng_free( row_rng );
+      }
 
-          /*Update values of y */
-          /*Start of the actual update */
-          matrix_type * y = matrix_alloc( ens_size , 1 );
-
-          for (int j = 0; j < ens_size; j++) {
-            matrix_iset(y , j , 0 , matrix_iget( A, i , j ) );
-          }
-
-          stepwise_set_Y0( stepwise_data , y );
-
-          stepwise_estimate(stepwise_data , r2_limit , nfolds );
-
-          /*manipulate A directly*/
-          for (int j = 0; j < ens_size; j++) {
-            for (int k = 0; k < nd; k++) {
-              matrix_iset(di , 0 , k , matrix_iget( D , k , j ) );
-            }
-            double aij = matrix_iget( A , i , j );
-            double xHat = stepwise_eval(stepwise_data , di );
-            matrix_iset(A , i , j , aij + xHat);
-          }
-
-          if (verbose){
-            if (all_active)
-             active_index = local_index;
-            else
-             active_index = active_indices[local_index];
+      update.lines = NULL;
+      if (verbose){
+        char * ministep_name = module_info_get_ministep_name(module_info);
+        fwd_step_enkf_write_log_header(fwd_step_data, ministep_name, nx, nd, ens_size);
+        update.lines = util_calloc( util_int_max( 1 , num_rows ) , sizeof * update.lines );
+      }
 
-            fwd_step_enkf_write_iter_info(fwd_step_data, stepwise_data, key, active_index, i, module_info);
+      {
+        const int num_threads = fwd_step_data->num_threads;
+        thread_pool_type * tp = thread_pool_alloc( num_threads , true );
 
-          }
+        update.block_size = util_int_max( 1 , num_rows / (8 * num_threads));
+        thread_pool_parallel_for( tp , 0 , (num_rows + update.block_size - 1) / update.block_size , fwd_step_enkf_update_block , &update );
+        thread_pool_join( tp );
+        thread_pool_free( tp );
+      }
 
-          local_index ++;
+      if (verbose) {
+        bool has_log = fwd_step_log_is_open( fwd_step_data->fwd_step_log );
+        for (int index = 0; index < num_rows; index++) {
+          if (has_log)
+            fwd_step_log_line( fwd_step_data->fwd_step_log , "%s" , update.lines[index] );
+          printf("%s" , update.lines[index]);
+          free( update.lines[index] );
         }
+        free( update.lines );
+        printf("===============================================================================================================================\n");
       }
 
-      if (verbose)
-       printf("===============================================================================================================================\n");
-
       printf("Done with stepwise regression enkf\n");
 
-      stepwise_free( stepwise_data );
-      matrix_free( di );
-
+      for (int j = 0; j < ens_size; j++)
+        matrix_free( update.di[j] );
+      free( update.di );
+      free( update.rng_states );
+      matrix_free( update.workS );
+      matrix_free( update.workE );
+      int_vector_free( update.rows );
+      int_vector_free( update.row_kw );
+      int_vector_free( update.row_index );
     }
-
-
-
   }
 
   fwd_step_log_close( fwd_step_data->fwd_step_log );
@@ -371,6 +457,8 @@ bool fwd_step_enkf_set_int( void * arg , const char * var_name , int value) {
     /*Set number of CV folds */
     if (strcmp( var_name , NFOLDS_KEY) == 0)
       fwd_step_enkf_set_nfolds( module_data , value);
+    else if (strcmp( var_name , ANALYSIS_NUM_THREADS_KEY) == 0)
+      fwd_step_enkf_set_num_threads( module_data , value);
     else
       name_recognized = false;
 
@@ -428,6 +516,8 @@ bool fwd_step_enkf_has_var( const void * arg, const char * var_name) {
       return true;
     else if (strcmp(var_name , CLEAR_LOG_KEY) == 0)
       return true;
+    else if (strcmp(var_name , ANALYSIS_NUM_THREADS_KEY) == 0)
+      return true;
     else
       return false;
   }
@@ -448,6 +538,8 @@ int fwd_step_enkf_get_int( const void * arg, const char * var_name) {
   {
     if (strcmp(var_name , NFOLDS_KEY) == 0)
       return module_data->nfolds;
+    else if (strcmp(var_name , ANALYSIS_NUM_THREADS_KEY) == 0)
+      return module_data->num_threads;
     else
       return -1;
   }
@@ -0,0 +1,276 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'obs_covar.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+
+#include <ert/util/util.h>
+#include <ert/util/type_macros.h>
+#include <ert/util/vector.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/matrix.h>
+#include <ert/util/matrix_blas.h>
+
+#include <ert/analysis/obs_covar.h>
+
+/*
+  The obs_covar is the observation error covariance matrix R stored
+  as a block diagonal matrix. Each block is either diagonal, where
+  only the variances are stored, or a dense covariance matrix.
+  Consecutive diagonal blocks are merged, so the common case of
+  many uncorrelated observations is stored as one vector of
+  variances, and the memory used is O(nobs) instead of O(nobs^2) for
+  the dense R matrix.
+*/
+
+#define OBS_COVAR_TYPE_ID 77163311
+
+typedef struct {
+  int                  offset;
+  int                  size;
+  double_vector_type * var;     /* Diagonal blocks: the variances. */
+  matrix_type        * covar;   /* Dense blocks: the covariance matrix; NULL for diagonal blocks. */
+} covar_block_type;
+
+
+struct obs_covar_struct {
+  UTIL_TYPE_ID_DECLARATION;
+  int             size;
+  vector_type   * blocks;
+};
+
+
+UTIL_IS_INSTANCE_FUNCTION( obs_covar , OBS_COVAR_TYPE_ID )
+
+
+static covar_block_type * covar_block_alloc( int offset , matrix_type * covar ) {
+  covar_block_type * block = util_malloc( sizeof * block );
+  block->offset = offset;
+  block->covar = covar;
+  if (covar == NULL) {
+    block->size = 0;
+    block->var = double_vector_alloc( 0 , 0 );
+  } else {
+    block->size = matrix_get_rows( covar );
+    block->var = NULL;
+  }
+  return block;
+}
+
+
+static void covar_block_free( covar_block_type * block ) {
+  if (block->covar != NULL)
+    matrix_free( block->covar );
+
+  if (block->var != NULL)
+    double_vector_free( block->var );
+
+  free( block );
+}
+
+
+static void covar_block_free__( void * arg ) {
+  covar_block_free( arg );
+}
+
+
+obs_covar_type * obs_covar_alloc( void ) {
+  obs_covar_type * covar = util_malloc( sizeof * covar );
+  UTIL_TYPE_ID_INIT( covar , OBS_COVAR_TYPE_ID );
+  covar->size = 0;
+  covar->blocks = vector_alloc_new();
+  return covar;
+}
+
+
+void obs_covar_free( obs_covar_type * covar ) {
+  vector_free( covar->blocks );
+  free( covar );
+}
+
+
+/*
+  Adds one uncorrelated observation with variance @var.
+*/
+
+void obs_covar_add_var( obs_covar_type * covar , double var ) {
+  covar_block_type * block = NULL;
+
+  if (vector_get_size( covar->blocks ) > 0) {
+    block = vector_get_last( covar->blocks );
+    if (block->covar != NULL)
+      block = NULL;
+  }
+
+  if (block == NULL) {
+    block = covar_block_alloc( covar->size , NULL );
+    vector_append_owned_ref( covar->blocks , block , covar_block_free__ );
+  }
+
+  double_vector_append( block->var , var );
+  block->size++;
+  covar->size++;
+}
+
+
+/*
+  Adds a block of correlated observations; the obs_covar takes
+  ownership of the square @block matrix.
+*/
+
+void obs_covar_add_block( obs_covar_type * covar , matrix_type * block ) {
+  if (matrix_get_rows( block ) != matrix_get_columns( block ))
+    util_abort("%s: covariance block must be square - got [%d,%d] \n",__func__ , matrix_get_rows( block ) , matrix_get_columns( block ));
+
+  vector_append_owned_ref( covar->blocks , covar_block_alloc( covar->size , block ) , covar_block_free__ );
+  covar->size += matrix_get_rows( block );
+}
+
+
+int obs_covar_get_size( const obs_covar_type * covar ) {
+  return covar->size;
+}
+
+
+int obs_covar_get_num_blocks( const obs_covar_type * covar ) {
+  return vector_get_size( covar->blocks );
+}
+
+
+static const covar_block_type * obs_covar_find_block( const obs_covar_type * covar , int index ) {
+  int block_min = 0;
+  int block_max = vector_get_size( covar->blocks ) - 1;
+
+  if ((index < 0) || (index >= covar->size))
+    util_abort("%s: index:%d invalid - size:%d \n",__func__ , index , covar->size);
+
+  while (true) {
+    int block_mid = (block_min + block_max) / 2;
+    const covar_block_type * block = vector_iget_const( covar->blocks , block_mid );
+
+    if (index < block->offset)
+      block_max = block_mid - 1;
+    else if (index >= block->offset + block->size)
+      block_min = block_mid + 1;
+    else
+      return block;
+  }
+}
+
+
+double obs_covar_iget( const obs_covar_type * covar , int i , int j) {
+  const covar_block_type * block = obs_covar_find_block( covar , i );
+
+  if ((j < block->offset) || (j >= block->offset + block->size))
+    return 0;
+
+  if (block->covar == NULL) {
+    if (i == j)
+      return double_vector_iget( block->var , i - block->offset );
+    else
+      return 0;
+  } else
+    return matrix_iget( block->covar , i - block->offset , j - block->offset );
+}
+
+
+/*
+  Scales the covariance matrix as R[i,j] *= scale_factor[i] * scale_factor[j].
+*/
+
+void obs_covar_scale( obs_covar_type * covar , const double * scale_factor ) {
+  int iblock;
+  for (iblock = 0; iblock < vector_get_size( covar->blocks ); iblock++) {
+    covar_block_type * block = vector_iget( covar->blocks , iblock );
+    const double * block_scale = &scale_factor[ block->offset ];
+    int i , j;
+
+    if (block->covar == NULL) {
+      double * var = double_vector_get_ptr( block->var );
+      for (i = 0; i < block->size; i++)
+        var[i] *= block_scale[i] * block_scale[i];
+    } else {
+      for (j = 0; j < block->size; j++)
+        for (i = 0; i < block->size; i++)
+          matrix_imul( block->covar , i , j , block_scale[i] * block_scale[j]);
+    }
+  }
+}
+
+
+matrix_type * obs_covar_alloc_matrix( const obs_covar_type * covar ) {
+  matrix_type * R = matrix_alloc( covar->size , covar->size );
+  int iblock;
+
+  for (iblock = 0; iblock < vector_get_size( covar->blocks ); iblock++) {
+    const covar_block_type * block = vector_iget_const( covar->blocks , iblock );
+    int i;
+
+    if (block->covar == NULL) {
+      for (i = 0; i < block->size; i++)
+        matrix_iset( R , block->offset + i , block->offset + i , double_vector_iget( block->var , i ));
+    } else {
+      int j;
+      for (j = 0; j < block->size; j++)
+        for (i = 0; i < block->size; i++)
+          matrix_iset( R , block->offset + i , block->offset + j , matrix_iget( block->covar , i , j ));
+    }
+  }
+
+  matrix_set_name( R , "R");
+  return R;
+}
+
+
+/*
+  Calculates B = U^T * R * U one block at a time, without
+  assembling the dense R matrix; U must have obs_covar_get_size()
+  rows and B must be a square matrix with the same number of
+  columns as U.
+*/
+
+void obs_covar_UtRU( const obs_covar_type * covar , const matrix_type * U , matrix_type * B) {
+  const int columns = matrix_get_columns( U );
+  int iblock;
+
+  if (matrix_get_rows( U ) != covar->size)
+    util_abort("%s: size mismatch: U has %d rows - covariance size:%d \n",__func__ , matrix_get_rows( U ) , covar->size);
+
+  if ((matrix_get_rows( B ) != columns) || (matrix_get_columns( B ) != columns))
+    util_abort("%s: size mismatch: B must be [%d,%d] \n",__func__ , columns , columns);
+
+  matrix_set( B , 0 );
+  for (iblock = 0; iblock < vector_get_size( covar->blocks ); iblock++) {
+    const covar_block_type * block = vector_iget_const( covar->blocks , iblock );
+    matrix_type * Ub  = matrix_alloc_shared( U , block->offset , 0 , block->size , columns );
+    matrix_type * RUb;
+
+    if (block->covar == NULL) {
+      int i;
+      RUb = matrix_alloc_sub_copy( U , block->offset , 0 , block->size , columns );
+      for (i = 0; i < block->size; i++)
+        matrix_scale_row( RUb , i , double_vector_iget( block->var , i ));
+    } else {
+      RUb = matrix_alloc( block->size , columns );
+      matrix_dgemm( RUb , block->covar , Ub , false , false , 1.0 , 0.0 );
+    }
+    matrix_dgemm( B , Ub , RUb , true , false , 1.0 , 1.0 );   /* B += Ub^T * Rb * Ub */
+
+    matrix_free( RUb );
+    matrix_free( Ub );
+  }
+}
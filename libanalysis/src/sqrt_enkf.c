@@ -58,7 +58,7 @@ void * sqrt_enkf_data_alloc( rng_type * rng ) {
   data->std_data = std_enkf_data_alloc( rng );
   data->randrot  = NULL;
   data->rng      = rng;
-  data->options  = ANALYSIS_SCALE_DATA;
+  data->options  = ANALYSIS_SCALE_DATA + ANALYSIS_OBS_COVAR;
   
   return data;
 }
@@ -104,6 +104,34 @@ bool sqrt_enkf_set_int( void * arg , const char * var_name , int value) {
 
 
 
+static void sqrt_enkf_initX__(sqrt_enkf_data_type * data ,
+                              matrix_type * X ,
+                              matrix_type * S ,
+                              const matrix_type * R ,
+                              const obs_covar_type * covar ,
+                              matrix_type * dObs ) {
+
+  int ncomp         = std_enkf_get_subspace_dimension( data->std_data );
+  double truncation = std_enkf_get_truncation( data->std_data );
+  int nrobs         = matrix_get_rows( S );
+  int ens_size      = matrix_get_columns( S );
+  int nrmin         = util_int_min( ens_size , nrobs);
+  matrix_type * W   = matrix_alloc(nrobs , nrmin);
+  double      * eig = util_calloc( nrmin , sizeof * eig );
+
+  matrix_subtract_row_mean( S );   /* Shift away the mean */
+  if (covar != NULL)
+    enkf_linalg_lowrankCinv_covar( S , covar , W , eig , truncation , ncomp);
+  else
+    enkf_linalg_lowrankCinv( S , R , W , eig , truncation , ncomp);
+  enkf_linalg_init_sqrtX( X , S , data->randrot , dObs , W , eig , false);
+  matrix_free( W );
+  free( eig );
+
+  enkf_linalg_checkX( X , false );
+}
+
+
 void sqrt_enkf_initX(void * module_data , 
                      matrix_type * X , 
                      matrix_type * A , 
@@ -114,23 +142,21 @@ void sqrt_enkf_initX(void * module_data ,
                      matrix_type *D ) {
 
   sqrt_enkf_data_type * data = sqrt_enkf_data_safe_cast( module_data );
-  {
-    int ncomp         = std_enkf_get_subspace_dimension( data->std_data );
-    double truncation = std_enkf_get_truncation( data->std_data );
-    int nrobs         = matrix_get_rows( S );
-    int ens_size      = matrix_get_columns( S );
-    int nrmin         = util_int_min( ens_size , nrobs); 
-    matrix_type * W   = matrix_alloc(nrobs , nrmin);                      
-    double      * eig = util_calloc( nrmin , sizeof * eig );    
-    
-    matrix_subtract_row_mean( S );   /* Shift away the mean */
-    enkf_linalg_lowrankCinv( S , R , W , eig , truncation , ncomp);    
-    enkf_linalg_init_sqrtX( X , S , data->randrot , dObs , W , eig , false);
-    matrix_free( W );
-    free( eig );
+  sqrt_enkf_initX__( data , X , S , R , NULL , dObs );
+}
 
-    enkf_linalg_checkX( X , false );
-  }
+
+void sqrt_enkf_initX_covar(void * module_data ,
+                           matrix_type * X ,
+                           matrix_type * A ,
+                           matrix_type * S ,
+                           const obs_covar_type * R ,
+                           matrix_type * dObs ,
+                           matrix_type * E ,
+                           matrix_type *D ) {
+
+  sqrt_enkf_data_type * data = sqrt_enkf_data_safe_cast( module_data );
+  sqrt_enkf_initX__( data , X , S , NULL , R , dObs );
 }
 
 
@@ -218,6 +244,7 @@ analysis_table_type LINK_NAME = {
   .get_int         = sqrt_enkf_get_int,
   .get_double      = sqrt_enkf_get_double,
   .get_bool        = NULL,
-  .get_ptr         = NULL
+  .get_ptr         = NULL,
+  .initX_covar     = sqrt_enkf_initX_covar
 };
 
@@ -131,7 +131,7 @@ void * std_enkf_data_alloc( rng_type * rng) {
 
   std_enkf_set_truncation( data , DEFAULT_ENKF_TRUNCATION_ );
   std_enkf_set_subspace_dimension( data , DEFAULT_SUBSPACE_DIMENSION );
-  data->option_flags = ANALYSIS_NEED_ED;
+  data->option_flags = ANALYSIS_NEED_ED + ANALYSIS_OBS_COVAR;
   data->use_EE = DEFAULT_USE_EE;
   data->analysis_scale_data = DEFAULT_ANALYSIS_SCALE_DATA;
   return data;
@@ -145,9 +145,16 @@ void std_enkf_data_free( void * data ) {
 
 
 
+/*
+  The observation error covariance is given either as the dense
+  matrix @R or as the block structured @covar; the other should be
+  NULL.
+*/
+
 static void std_enkf_initX__( matrix_type * X ,
                               matrix_type * S ,
                               matrix_type * R ,
+                              const obs_covar_type * covar ,
                               matrix_type * E ,
                               matrix_type * D ,
                               double truncation,
@@ -173,7 +180,9 @@ static void std_enkf_initX__( matrix_type * X ,
 
     matrix_free( Et );
     matrix_free( Cee );
-  } else
+  } else if (covar != NULL)
+    enkf_linalg_lowrankCinv_covar( S , covar , W , eig , truncation , ncomp);
+  else
     enkf_linalg_lowrankCinv( S , R , W , eig , truncation , ncomp);
 
 
@@ -203,7 +212,27 @@ void std_enkf_initX(void * module_data ,
     int ncomp         = data->subspace_dimension;
     double truncation = data->truncation;
 
-    std_enkf_initX__(X,S,R,E,D,truncation,ncomp,false,data->use_EE);
+    std_enkf_initX__(X,S,R,NULL,E,D,truncation,ncomp,false,data->use_EE);
+  }
+}
+
+
+void std_enkf_initX_covar(void * module_data ,
+                          matrix_type * X ,
+                          matrix_type * A ,
+                          matrix_type * S ,
+                          const obs_covar_type * R ,
+                          matrix_type * dObs ,
+                          matrix_type * E ,
+                          matrix_type * D) {
+
+
+  std_enkf_data_type * data = std_enkf_data_safe_cast( module_data );
+  {
+    int ncomp         = data->subspace_dimension;
+    double truncation = data->truncation;
+
+    std_enkf_initX__(X,S,NULL,R,E,D,truncation,ncomp,false,data->use_EE);
   }
 }
 
@@ -339,6 +368,7 @@ analysis_table_type LINK_NAME = {
     .set_string      = NULL ,
     .get_options     = std_enkf_get_options ,
     .initX           = std_enkf_initX ,
+    .initX_covar     = std_enkf_initX_covar ,
     .updateA         = NULL,
     .init_update     = NULL,
     .complete_update = NULL,
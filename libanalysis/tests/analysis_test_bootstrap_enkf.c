@@ -0,0 +1,178 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'analysis_test_bootstrap_enkf.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/rng.h>
+#include <ert/util/timer.h>
+#include <ert/util/matrix.h>
+#include <ert/util/matrix_blas.h>
+
+#include <ert/analysis/analysis_module.h>
+#include <ert/analysis/std_enkf.h>
+
+/*
+  Compares the BOOTSTRAP_ENKF module with a direct implementation of
+  the bootstrap update, where a full X matrix is computed and
+  multiplied with the resampled A for each realisation. With the
+  optional arguments the update is timed for a larger problem:
+
+     analysis_test_bootstrap_enkf  [rows  [ens_size  [nobs]]]
+*/
+
+
+static void assert_matrix_close( const matrix_type * m1 , const matrix_type * m2 ) {
+  int i , j;
+  test_assert_int_equal( matrix_get_rows( m1 ) , matrix_get_rows( m2 ));
+  test_assert_int_equal( matrix_get_columns( m1 ) , matrix_get_columns( m2 ));
+  for (j = 0; j < matrix_get_columns( m1 ); j++)
+    for (i = 0; i < matrix_get_rows( m1 ); i++)
+      test_assert_true( fabs( matrix_iget( m1 , i , j ) - matrix_iget( m2 , i , j )) < 1e-9 * (1 + fabs( matrix_iget( m1 , i , j ))));
+}
+
+
+static void assert_matrix_equal( const matrix_type * m1 , const matrix_type * m2 ) {
+  int i , j;
+  for (j = 0; j < matrix_get_columns( m1 ); j++)
+    for (i = 0; i < matrix_get_rows( m1 ); i++)
+      test_assert_double_equal( matrix_iget( m1 , i , j ) , matrix_iget( m2 , i , j ));
+}
+
+
+/*
+  The reference must draw the resampling indices from the rng in the
+  same order as the module.
+*/
+
+static matrix_type * alloc_reference( rng_type * rng , const matrix_type * A , const matrix_type * S , matrix_type * R , matrix_type * dObs , matrix_type * E , matrix_type * D) {
+  const int ens_size = matrix_get_columns( A );
+  matrix_type * A_updated   = matrix_alloc_copy( A );
+  matrix_type * A_resampled = matrix_alloc_copy( A );
+  matrix_type * S_resampled = matrix_alloc_copy( S );
+  matrix_type * X           = matrix_alloc( ens_size , ens_size );
+  std_enkf_data_type * std_data = std_enkf_data_alloc( NULL );
+  int * iens_resample = util_calloc( ens_size * ens_size , sizeof * iens_resample );
+
+  std_enkf_set_truncation( std_data , 0.95 );
+  std_enkf_set_subspace_dimension( std_data , -1 );
+  for (int i = 0; i < ens_size * ens_size; i++)
+    iens_resample[i] = rng_get_int( rng , ens_size );
+
+  for (int iens = 0; iens < ens_size; iens++) {
+    for (int k = 0; k < ens_size; k++) {
+      matrix_copy_column( A_resampled , A , k , iens_resample[ iens * ens_size + k ] );
+      matrix_copy_column( S_resampled , S , k , iens_resample[ iens * ens_size + k ] );
+    }
+    std_enkf_initX( std_data , X , NULL , S_resampled , R , dObs , E , D );
+
+    {
+      matrix_type * AX = matrix_alloc_matmul( A_resampled , X );
+      matrix_inplace_add( AX , A );
+      matrix_copy_column( A_updated , AX , iens , iens );
+      matrix_free( AX );
+    }
+  }
+
+  free( iens_resample );
+  std_enkf_data_free( std_data );
+  matrix_free( X );
+  matrix_free( S_resampled );
+  matrix_free( A_resampled );
+  return A_updated;
+}
+
+
+static matrix_type * alloc_update( analysis_module_type * module , rng_type * rng , const char * num_threads , const matrix_type * A , matrix_type * S , matrix_type * R , matrix_type * dObs , matrix_type * E , matrix_type * D) {
+  matrix_type * A_updated = matrix_alloc_copy( A );
+  timer_type * timer = timer_alloc( false );
+
+  test_assert_true( analysis_module_set_var( module , ANALYSIS_NUM_THREADS_KEY , num_threads ));
+  rng_init( rng , INIT_DEFAULT );
+
+  timer_start( timer );
+  analysis_module_updateA( module , A_updated , S , R , dObs , E , D , NULL );
+  timer_stop( timer );
+  printf("threads:%3s   update: %8.3f s\n" , num_threads , timer_get_total_time( timer ));
+
+  timer_free( timer );
+  return A_updated;
+}
+
+
+int main(int argc , char ** argv) {
+  int rows = 1003;
+  int ens_size = 20;
+  int nobs = 30;
+  rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+  analysis_module_type * module = analysis_module_alloc_internal( rng , "BOOTSTRAP_ENKF" );
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &rows );
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &ens_size );
+  if (argc > 3)
+    util_sscanf_int( argv[3] , &nobs );
+
+  test_assert_not_NULL( module );
+  {
+    matrix_type * A    = matrix_alloc( rows , ens_size );
+    matrix_type * S    = matrix_alloc( nobs , ens_size );
+    matrix_type * E    = matrix_alloc( nobs , ens_size );
+    matrix_type * D    = matrix_alloc( nobs , ens_size );
+    matrix_type * R    = matrix_alloc( nobs , nobs );
+    matrix_type * dObs = matrix_alloc( nobs , 2 );
+    matrix_type * A1;
+    matrix_type * A4;
+
+    matrix_random_init( A , rng );
+    matrix_random_init( S , rng );
+    matrix_random_init( E , rng );
+    matrix_random_init( D , rng );
+    matrix_random_init( dObs , rng );
+    for (int i = 0; i < nobs; i++)
+      matrix_iset( R , i , i , 0.5 + 0.1 * i );
+
+    A1 = alloc_update( module , rng , "1" , A , S , R , dObs , E , D );
+    A4 = alloc_update( module , rng , "4" , A , S , R , dObs , E , D );
+    assert_matrix_equal( A1 , A4 );
+
+    if (argc == 1) {
+      matrix_type * A_reference;
+      rng_init( rng , INIT_DEFAULT );
+      A_reference = alloc_reference( rng , A , S , R , dObs , E , D );
+      assert_matrix_close( A1 , A_reference );
+      matrix_free( A_reference );
+    }
+
+    matrix_free( A4 );
+    matrix_free( A1 );
+    matrix_free( dObs );
+    matrix_free( R );
+    matrix_free( D );
+    matrix_free( E );
+    matrix_free( S );
+    matrix_free( A );
+  }
+  analysis_module_free( module );
+  rng_free( rng );
+  exit(0);
+}
@@ -0,0 +1,165 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'analysis_test_fwd_step_enkf.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/rng.h>
+#include <ert/util/timer.h>
+#include <ert/util/matrix.h>
+
+#include <ert/analysis/analysis_module.h>
+#include <ert/analysis/module_info.h>
+#include <ert/analysis/module_data_block.h>
+#include <ert/analysis/module_obs_block.h>
+
+/*
+  Checks that the FWD_STEP_ENKF update does not depend on the number
+  of threads. With the optional arguments the update is timed for a
+  larger problem, and the test can be used as a benchmark:
+
+     analysis_test_fwd_step_enkf  [rows  [ens_size  [nobs  [max_threads]]]]
+*/
+
+
+static void assert_matrix_equal( const matrix_type * m1 , const matrix_type * m2 ) {
+  int i , j;
+  for (j = 0; j < matrix_get_columns( m1 ); j++)
+    for (i = 0; i < matrix_get_rows( m1 ); i++)
+      test_assert_double_equal( matrix_iget( m1 , i , j ) , matrix_iget( m2 , i , j ));
+}
+
+
+/*
+  Two parameter blocks, where only every second element of the last
+  block is active, and two observation blocks.
+*/
+
+static module_info_type * alloc_module_info( int rows , int nobs , int * index_list ) {
+  module_info_type * module_info = module_info_alloc( "FWD_STEP" );
+  module_data_block_vector_type * data_block_vector = module_info_get_data_block_vector( module_info );
+  module_obs_block_vector_type * obs_block_vector = module_info_get_obs_block_vector( module_info );
+  int rows1 = rows / 2;
+  int nobs1 = nobs / 2;
+
+  for (int i = 0; i < rows - rows1; i++)
+    index_list[i] = 2*i;
+
+  module_data_block_vector_add_data_block( data_block_vector , module_data_block_alloc( "PARAM1" , NULL , 0 , rows1 ));
+  module_data_block_vector_add_data_block( data_block_vector , module_data_block_alloc( "PARAM2" , index_list , rows1 , rows - rows1 ));
+  module_obs_block_vector_add_obs_block( obs_block_vector , module_obs_block_alloc( "OBS1" , NULL , 0 , nobs1 ));
+  module_obs_block_vector_add_obs_block( obs_block_vector , module_obs_block_alloc( "OBS2" , NULL , nobs1 , nobs - nobs1 ));
+  return module_info;
+}
+
+
+static matrix_type * alloc_update( analysis_module_type * module , rng_type * rng , int num_threads , const module_info_type * module_info ,
+                                   const matrix_type * A , const matrix_type * S , matrix_type * R , matrix_type * dObs , matrix_type * E , matrix_type * D) {
+  matrix_type * A_updated = matrix_alloc_copy( A );
+  matrix_type * S_copy = matrix_alloc_copy( S );   /* The update shifts S in place. */
+  timer_type * timer = timer_alloc( false );
+  char * num_threads_string = util_alloc_sprintf( "%d" , num_threads );
+
+  test_assert_true( analysis_module_set_var( module , ANALYSIS_NUM_THREADS_KEY , num_threads_string ));
+  test_assert_int_equal( num_threads , analysis_module_get_int( module , ANALYSIS_NUM_THREADS_KEY ));
+  rng_init( rng , INIT_DEFAULT );
+
+  timer_start( timer );
+  analysis_module_updateA( module , A_updated , S_copy , R , dObs , E , D , module_info );
+  timer_stop( timer );
+  printf("threads:%3d   update: %8.3f s\n" , num_threads , timer_get_total_time( timer ));
+
+  free( num_threads_string );
+  timer_free( timer );
+  matrix_free( S_copy );
+  return A_updated;
+}
+
+
+int main(int argc , char ** argv) {
+  int rows = 101;
+  int ens_size = 30;
+  int nobs = 20;
+  int max_threads = 4;
+  rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+  analysis_module_type * module = analysis_module_alloc_internal( rng , "FWD_STEP_ENKF" );
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &rows );
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &ens_size );
+  if (argc > 3)
+    util_sscanf_int( argv[3] , &nobs );
+  if (argc > 4)
+    util_sscanf_int( argv[4] , &max_threads );
+
+  test_assert_not_NULL( module );
+  test_assert_true( analysis_module_set_var( module , "VERBOSE" , (argc == 1) ? "True" : "False" ));
+  {
+    int * index_list = util_calloc( rows , sizeof * index_list );
+    module_info_type * module_info = alloc_module_info( rows , nobs , index_list );
+    matrix_type * A    = matrix_alloc( rows , ens_size );
+    matrix_type * S    = matrix_alloc( nobs , ens_size );
+    matrix_type * E    = matrix_alloc( nobs , ens_size );
+    matrix_type * D    = matrix_alloc( nobs , ens_size );
+    matrix_type * R    = matrix_alloc( nobs , nobs );
+    matrix_type * dObs = matrix_alloc( nobs , 2 );
+    matrix_type * A1;
+
+    matrix_random_init( A , rng );
+    matrix_random_init( S , rng );
+    matrix_random_init( E , rng );
+    matrix_random_init( D , rng );
+    matrix_random_init( dObs , rng );
+    for (int i = 0; i < nobs; i++)
+      matrix_iset( R , i , i , 0.5 + 0.1 * i );
+
+    /* The parameters are correlated with the first observations. */
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < ens_size; j++)
+        matrix_iadd( A , i , j , (1 + i % 3) * matrix_iget( S , i % nobs , j ));
+
+    A1 = alloc_update( module , rng , 1 , module_info , A , S , R , dObs , E , D );
+    {
+      int num_threads = 2;
+      while (num_threads <= max_threads) {
+        matrix_type * An = alloc_update( module , rng , num_threads , module_info , A , S , R , dObs , E , D );
+        assert_matrix_equal( A1 , An );
+        matrix_free( An );
+        num_threads *= 2;
+      }
+    }
+
+    test_assert_false( matrix_equal( A , A1 ));
+
+    matrix_free( A1 );
+    matrix_free( dObs );
+    matrix_free( R );
+    matrix_free( D );
+    matrix_free( E );
+    matrix_free( S );
+    matrix_free( A );
+    module_info_free( module_info );
+    free( index_list );
+  }
+  analysis_module_free( module );
+  rng_free( rng );
+  exit(0);
+}
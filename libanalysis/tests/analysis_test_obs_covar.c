@@ -0,0 +1,234 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'analysis_test_obs_covar.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/rng.h>
+#include <ert/util/timer.h>
+#include <ert/util/matrix.h>
+#include <ert/util/matrix_blas.h>
+
+#include <ert/analysis/obs_covar.h>
+#include <ert/analysis/enkf_linalg.h>
+
+/*
+  Compares the block structured obs_covar with the dense R matrix.
+  With the optional arguments the low rank inversion is timed with
+  the obs_covar for a large number of uncorrelated observations:
+
+     analysis_test_obs_covar  [nobs  [ens_size]]
+*/
+
+
+static void assert_matrix_equal( const matrix_type * m1 , const matrix_type * m2 ) {
+  int i , j;
+  test_assert_int_equal( matrix_get_rows( m1 ) , matrix_get_rows( m2 ));
+  test_assert_int_equal( matrix_get_columns( m1 ) , matrix_get_columns( m2 ));
+  for (j = 0; j < matrix_get_columns( m1 ); j++)
+    for (i = 0; i < matrix_get_rows( m1 ); i++)
+      test_assert_true( fabs( matrix_iget( m1 , i , j ) - matrix_iget( m2 , i , j )) < 1e-9 * (1 + fabs( matrix_iget( m1 , i , j ))));
+}
+
+
+/*
+  Diagonal observations, a dense block, more diagonal observations
+  and finally a second dense block.
+*/
+
+static obs_covar_type * alloc_covar( ) {
+  obs_covar_type * covar = obs_covar_alloc( );
+  int i , j;
+
+  for (i = 0; i < 5; i++)
+    obs_covar_add_var( covar , 1 + i );
+
+  {
+    matrix_type * block = matrix_alloc( 4 , 4 );
+    for (i = 0; i < 4; i++)
+      for (j = 0; j < 4; j++)
+        matrix_iset( block , i , j , exp( -fabs( i - j )) * 2);
+    obs_covar_add_block( covar , block );
+  }
+
+  for (i = 0; i < 3; i++)
+    obs_covar_add_var( covar , 0.5 + i );
+  obs_covar_add_var( covar , 0.25 );
+
+  {
+    matrix_type * block = matrix_alloc( 2 , 2 );
+    matrix_iset( block , 0 , 0 , 3 );
+    matrix_iset( block , 1 , 1 , 3 );
+    matrix_iset( block , 0 , 1 , 1 );
+    matrix_iset( block , 1 , 0 , 1 );
+    obs_covar_add_block( covar , block );
+  }
+  return covar;
+}
+
+
+static void test_structure( ) {
+  obs_covar_type * covar = alloc_covar( );
+  matrix_type * R = obs_covar_alloc_matrix( covar );
+  int i , j;
+
+  test_assert_true( obs_covar_is_instance( covar ));
+  test_assert_int_equal( obs_covar_get_size( covar ) , 15 );
+  test_assert_int_equal( obs_covar_get_num_blocks( covar ) , 4 );
+  test_assert_int_equal( matrix_get_rows( R ) , 15 );
+
+  test_assert_double_equal( matrix_iget( R , 2 , 2 ) , 3 );
+  test_assert_double_equal( matrix_iget( R , 2 , 3 ) , 0 );
+  test_assert_double_equal( matrix_iget( R , 5 , 6 ) , 2 * exp( -1 ));
+  test_assert_double_equal( matrix_iget( R , 12 , 12 ) , 0.25 );
+  test_assert_double_equal( matrix_iget( R , 14 , 13 ) , 1 );
+  test_assert_double_equal( matrix_iget( R , 4 , 5 ) , 0 );
+
+  for (i = 0; i < 15; i++)
+    for (j = 0; j < 15; j++)
+      test_assert_double_equal( obs_covar_iget( covar , i , j ) , matrix_iget( R , i , j ));
+
+  matrix_free( R );
+  obs_covar_free( covar );
+}
+
+
+static void test_scale( ) {
+  obs_covar_type * covar = alloc_covar( );
+  matrix_type * R = obs_covar_alloc_matrix( covar );
+  double scale_factor[15];
+  int i , j;
+
+  for (i = 0; i < 15; i++)
+    scale_factor[i] = 1.0 / (i + 1);
+
+  obs_covar_scale( covar , scale_factor );
+  for (i = 0; i < 15; i++)
+    for (j = 0; j < 15; j++)
+      test_assert_double_equal( obs_covar_iget( covar , i , j ) , matrix_iget( R , i , j ) * scale_factor[i] * scale_factor[j]);
+
+  matrix_free( R );
+  obs_covar_free( covar );
+}
+
+
+static void test_UtRU( rng_type * rng ) {
+  obs_covar_type * covar = alloc_covar( );
+  matrix_type * R = obs_covar_alloc_matrix( covar );
+  matrix_type * U = matrix_alloc( 15 , 6 );
+  matrix_type * B = matrix_alloc( 6 , 6 );
+  matrix_type * B0 = matrix_alloc( 6 , 6 );
+  matrix_type * X0 = matrix_alloc( 6 , 15 );
+
+  matrix_random_init( U , rng );
+  matrix_dgemm( X0 , U , R , true , false , 1.0 , 0.0 );
+  matrix_dgemm( B0 , X0 , U , false , false , 1.0 , 0.0 );
+  obs_covar_UtRU( covar , U , B );
+  assert_matrix_equal( B , B0 );
+
+  matrix_free( X0 );
+  matrix_free( B0 );
+  matrix_free( B );
+  matrix_free( U );
+  matrix_free( R );
+  obs_covar_free( covar );
+}
+
+
+static void test_lowrankCinv( rng_type * rng ) {
+  const int ens_size = 10;
+  obs_covar_type * covar = alloc_covar( );
+  matrix_type * R = obs_covar_alloc_matrix( covar );
+  matrix_type * S = matrix_alloc( 15 , ens_size );
+  matrix_type * W0 = matrix_alloc( 15 , ens_size );
+  matrix_type * W = matrix_alloc( 15 , ens_size );
+  double eig0[10];
+  double eig[10];
+  int i;
+
+  matrix_random_init( S , rng );
+  matrix_subtract_row_mean( S );
+  enkf_linalg_lowrankCinv( S , R , W0 , eig0 , 0.99 , -1 );
+  enkf_linalg_lowrankCinv_covar( S , covar , W , eig , 0.99 , -1 );
+
+  assert_matrix_equal( W , W0 );
+  for (i = 0; i < ens_size; i++)
+    test_assert_true( fabs( eig[i] - eig0[i] ) < 1e-9 );
+
+  matrix_free( W );
+  matrix_free( W0 );
+  matrix_free( S );
+  matrix_free( R );
+  obs_covar_free( covar );
+}
+
+
+static void run_large( rng_type * rng , int nobs , int ens_size ) {
+  obs_covar_type * covar = obs_covar_alloc( );
+  matrix_type * S = matrix_alloc( nobs , ens_size );
+  matrix_type * W = matrix_alloc( nobs , ens_size );
+  double * eig = util_calloc( ens_size , sizeof * eig );
+  timer_type * timer = timer_alloc( false );
+  int i;
+
+  for (i = 0; i < nobs; i++)
+    obs_covar_add_var( covar , 0.5 + (i % 7) );
+
+  matrix_random_init( S , rng );
+  matrix_subtract_row_mean( S );
+
+  timer_start( timer );
+  enkf_linalg_lowrankCinv_covar( S , covar , W , eig , 0.99 , -1 );
+  timer_stop( timer );
+
+  printf("nobs:%d  ens_size:%d  lowrankCinv_covar:%8.3f s   dense R would need:%8.1f MB\n",
+         nobs , ens_size , timer_get_total_time( timer ) , 1.0 * nobs * nobs * sizeof(double) / (1024 * 1024));
+
+  timer_free( timer );
+  free( eig );
+  matrix_free( W );
+  matrix_free( S );
+  obs_covar_free( covar );
+}
+
+
+int main(int argc , char ** argv) {
+  rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+
+  test_structure( );
+  test_scale( );
+  test_UtRU( rng );
+  test_lowrankCinv( rng );
+
+  if (argc > 1) {
+    int nobs;
+    int ens_size = 100;
+
+    util_sscanf_int( argv[1] , &nobs );
+    if (argc > 2)
+      util_sscanf_int( argv[2] , &ens_size );
+
+    run_large( rng , nobs , ens_size );
+  }
+
+  rng_free( rng );
+  exit(0);
+}
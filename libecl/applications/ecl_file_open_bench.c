@@ -0,0 +1,132 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_file_open_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+/*
+  Small benchmark of ecl_file_open() with and without the keyword
+  index file. The file is opened with a full scan, then with the
+  ECL_FILE_INDEX flag and no index file present (cold: scan and write
+  the index) and finally with the index file present (warm).
+
+     ecl_file_open_bench.x  FILE  [repeat]
+     ecl_file_open_bench.x  [num_steps  [num_kw]]
+
+  If no file is given a synthetic unified restart file with num_steps
+  report steps, each with num_kw small keywords, is created in the
+  current directory. Observe that the page cache is not flushed, the
+  gain is considerably larger when the file is on network storage.
+*/
+
+
+static void write_synthetic_file( const char * filename , int num_steps , int num_kw) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  ecl_kw_type * seqnum_kw = ecl_kw_alloc( "SEQNUM" , 1 , ECL_INT_TYPE );
+  ecl_kw_type * data_kw = ecl_kw_alloc( "PRESSURE" , 100 , ECL_FLOAT_TYPE );
+  int step , kw;
+
+  ecl_kw_scalar_set_float( data_kw , 100 );
+  for (step = 0; step < num_steps; step++) {
+    ecl_kw_iset_int( seqnum_kw , 0 , step );
+    ecl_kw_fwrite( seqnum_kw , fortio );
+    for (kw = 0; kw < num_kw; kw++)
+      ecl_kw_fwrite( data_kw , fortio );
+  }
+
+  ecl_kw_free( seqnum_kw );
+  ecl_kw_free( data_kw );
+  fortio_fclose( fortio );
+}
+
+
+static double time_open( const char * filename , int flags , int repeat , int * size) {
+  timer_type * timer = timer_alloc( false );
+  double time;
+  int i;
+
+  timer_start( timer );
+  for (i=0; i < repeat; i++) {
+    ecl_file_type * ecl_file = ecl_file_open( filename , flags );
+    if (ecl_file == NULL)
+      util_exit("Could not open file:%s \n",filename);
+
+    *size = ecl_file_get_size( ecl_file );
+    ecl_file_close( ecl_file );
+  }
+  timer_stop( timer );
+
+  time = timer_get_total_time( timer ) / repeat;
+  timer_free( timer );
+  return time;
+}
+
+
+int main(int argc, char ** argv) {
+  const char * filename = "BENCH.UNRST";
+  bool synthetic = true;
+  int repeat = 10;
+  int num_steps = 1000;
+  int num_kw = 50;
+
+  if (argc > 1 && !util_sscanf_int( argv[1] , &num_steps )) {
+    filename = argv[1];
+    synthetic = false;
+    if (argc > 2)
+      util_sscanf_int( argv[2] , &repeat );
+  } else {
+    if (argc > 2)
+      util_sscanf_int( argv[2] , &num_kw );
+    write_synthetic_file( filename , num_steps , num_kw );
+  }
+
+  {
+    char * index_file = ecl_file_alloc_index_filename( filename );
+    double scan_time , cold_time , warm_time;
+    int scan_size , cold_size , warm_size;
+
+    util_unlink_existing( index_file );
+    scan_time = time_open( filename , 0 , repeat , &scan_size );
+    cold_time = time_open( filename , ECL_FILE_INDEX , 1 , &cold_size );
+    warm_time = time_open( filename , ECL_FILE_INDEX , repeat , &warm_size );
+
+    printf("%s  keywords:%8d   scan:%8.4f   index cold:%8.4f   index warm:%8.4f   %s\n",
+           filename ,
+           scan_size ,
+           scan_time ,
+           cold_time ,
+           warm_time ,
+           ((scan_size == cold_size) && (scan_size == warm_size)) ? "equal" : "DIFFERENT");
+
+    if (synthetic) {
+      util_unlink_existing( index_file );
+      util_unlink_existing( filename );
+    }
+    free( index_file );
+  }
+  exit(0);
+}
@@ -0,0 +1,185 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_kw_fmt_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+/*
+  Small benchmark of reading and writing formatted keywords. The
+  ecl_kw_fread() / ecl_kw_fwrite() functions are compared with a
+  reference implementation doing one fscanf() / fprintf() call per
+  element, which is how the formatted files used to be handled. The
+  values read with the two implementations are compared.
+
+     ecl_kw_fmt_bench.x  [size]  [repeat]
+*/
+
+
+static void fprintf_scientific(FILE * stream, const char * fmt , double x) {
+  double pow_x = ceil(log10(fabs(x)));
+  double arg_x   = x / pow(10.0 , pow_x);
+  if (x != 0.0) {
+    if (fabs(arg_x) == 1.0) {
+      arg_x *= 0.10;
+      pow_x += 1;
+    }
+  } else {
+    arg_x = 0.0;
+    pow_x = 0.0;
+  }
+  fprintf(stream , fmt , arg_x , (int) pow_x);
+}
+
+
+static void reference_fwrite( const ecl_kw_type * kw , const char * filename ) {
+  FILE * stream = util_fopen( filename , "w");
+  const int size = ecl_kw_get_size( kw );
+  const int columns = (ecl_kw_get_type( kw ) == ECL_INT_TYPE) ? 6 : 3;
+  int i;
+
+  fprintf(stream , " '%-8s' %11d '%-4s'\n" , ecl_kw_get_header( kw ) , size , ecl_kw_get_type( kw ) == ECL_INT_TYPE ? "INTE" : "DOUB");
+  for (i=0; i < size; i++) {
+    if (ecl_kw_get_type( kw ) == ECL_INT_TYPE)
+      fprintf(stream , " %11d" , ecl_kw_iget_int( kw , i ));
+    else
+      fprintf_scientific( stream , "  %17.14fD%+03d" , ecl_kw_iget_double( kw , i ));
+
+    if (((i % 1000) % columns == columns - 1) || (i % 1000 == 999) || (i == size - 1))
+      fprintf(stream , "\n");
+  }
+  fclose( stream );
+}
+
+
+static void reference_fread( ecl_kw_type * kw , const char * filename ) {
+  FILE * stream = util_fopen( filename , "r");
+  const int size = ecl_kw_get_size( kw );
+  int i;
+
+  while (fgetc( stream ) != '\n') ;
+  for (i=0; i < size; i++) {
+    if (ecl_kw_get_type( kw ) == ECL_INT_TYPE) {
+      int value;
+      if (fscanf( stream , "%d" , &value ) != 1)
+        util_abort("%s: read failed \n",__func__);
+      ecl_kw_iset_int( kw , i , value );
+    } else {
+      double arg;
+      int power;
+      if (fscanf( stream , "%lgD%d" , &arg , &power ) != 2)
+        util_abort("%s: read failed \n",__func__);
+      ecl_kw_iset_double( kw , i , arg * pow(10 , power ));
+    }
+  }
+  fclose( stream );
+}
+
+
+static void run_case( ecl_kw_type * kw , int repeat ) {
+  const char * filename = "ecl_kw_fmt_bench.FINIT";
+  timer_type * ref_write = timer_alloc( false );
+  timer_type * ref_read  = timer_alloc( false );
+  timer_type * kw_write  = timer_alloc( false );
+  timer_type * kw_read   = timer_alloc( false );
+  ecl_kw_type * ref_kw   = ecl_kw_alloc_copy( kw );
+  bool equal = true;
+  int r;
+
+  for (r=0; r < repeat; r++) {
+    timer_start( ref_write );
+    reference_fwrite( kw , filename );
+    timer_stop( ref_write );
+
+    timer_start( ref_read );
+    reference_fread( ref_kw , filename );
+    timer_stop( ref_read );
+
+    timer_start( kw_write );
+    {
+      fortio_type * fortio = fortio_open_writer( filename , true , ECL_ENDIAN_FLIP );
+      ecl_kw_fwrite( kw , fortio );
+      fortio_fclose( fortio );
+    }
+    timer_stop( kw_write );
+
+    timer_start( kw_read );
+    {
+      fortio_type * fortio = fortio_open_reader( filename , true , ECL_ENDIAN_FLIP );
+      ecl_kw_type * read_kw = ecl_kw_fread_alloc( fortio );
+      fortio_fclose( fortio );
+      timer_stop( kw_read );
+
+      equal = equal && ecl_kw_numeric_equal( read_kw , ref_kw , 0 , 1e-13 );
+      ecl_kw_free( read_kw );
+    }
+  }
+  util_unlink_existing( filename );
+
+  printf("%-8s size:%9d   fprintf:%8.4f  ecl_kw_fwrite:%8.4f   fscanf:%8.4f  ecl_kw_fread:%8.4f   %s\n",
+         ecl_kw_get_header( kw ) ,
+         ecl_kw_get_size( kw ) ,
+         timer_get_total_time( ref_write ) / repeat ,
+         timer_get_total_time( kw_write ) / repeat ,
+         timer_get_total_time( ref_read ) / repeat ,
+         timer_get_total_time( kw_read ) / repeat ,
+         equal ? "equal" : "DIFFERENT");
+
+  ecl_kw_free( ref_kw );
+  timer_free( ref_write );
+  timer_free( ref_read );
+  timer_free( kw_write );
+  timer_free( kw_read );
+}
+
+
+int main(int argc, char ** argv) {
+  int size   = 1000000;
+  int repeat = 3;
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &size );
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &repeat );
+
+  {
+    ecl_kw_type * int_kw = ecl_kw_alloc( "INT" , size , ECL_INT_TYPE );
+    ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , size , ECL_DOUBLE_TYPE );
+    int i;
+
+    for (i=0; i < size; i++) {
+      ecl_kw_iset_int( int_kw , i , (i * 7919) % 1000003 - 500000 );
+      ecl_kw_iset_double( double_kw , i , sin( i ) * 1000 );
+    }
+
+    run_case( int_kw , repeat );
+    run_case( double_kw , repeat );
+
+    ecl_kw_free( int_kw );
+    ecl_kw_free( double_kw );
+  }
+  exit(0);
+}
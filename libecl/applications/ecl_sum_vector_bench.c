@@ -0,0 +1,152 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_sum_vector_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+#include <ert/util/double_vector.h>
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_tstep.h>
+#include <ert/ecl/ecl_sum_vector.h>
+#include <ert/ecl/smspec_node.h>
+
+/*
+  Small benchmark of extracting many summary vectors. All the vectors
+  matching the pattern are extracted with ecl_sum_alloc_data_vector(),
+  first with the row oriented storage and then after the vectors have
+  been loaded as columns with ecl_sum_load_columns().
+
+     ecl_sum_vector_bench.x  [CASE  [PATTERN]]
+     ecl_sum_vector_bench.x  [num_wells  num_tstep]
+
+  If no case is given a synthetic case is created in memory.
+*/
+
+
+static ecl_sum_type * alloc_synthetic_case( int num_wells , int num_tstep ) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( "BENCH" , false , true , ":" , 0 , true , 10 , 10 , 10 );
+  int * params_index = util_calloc( num_wells , sizeof * params_index );
+  int w,t;
+
+  for (w=0; w < num_wells; w++) {
+    char * well = util_alloc_sprintf("W%05d" , w);
+    smspec_node_type * node = ecl_sum_add_var( ecl_sum , "WOPR" , well , 0 , "SM3/DAY" , 0 );
+    params_index[w] = smspec_node_get_params_index( node );
+    free( well );
+  }
+
+  for (t=0; t < num_tstep; t++) {
+    ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , 1 + t / 10 , (t + 1) * 86400.0 );
+    for (w=0; w < num_wells; w++)
+      ecl_sum_tstep_iset( tstep , params_index[w] , w + 0.25 * t );
+  }
+
+  free( params_index );
+  return ecl_sum;
+}
+
+
+static double extract_all( const ecl_sum_type * ecl_sum , const ecl_sum_vector_type * keylist , double_vector_type ** vectors) {
+  timer_type * timer = timer_alloc( false );
+  double time;
+  int i;
+
+  timer_start( timer );
+  for (i=0; i < ecl_sum_vector_get_size( keylist ); i++)
+    vectors[i] = ecl_sum_alloc_data_vector( ecl_sum , ecl_sum_vector_iget_param_index( keylist , i ) , false );
+  timer_stop( timer );
+
+  time = timer_get_total_time( timer );
+  timer_free( timer );
+  return time;
+}
+
+
+static void run_case( ecl_sum_type * ecl_sum , const char * pattern ) {
+  ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( ecl_sum );
+  int num_keys;
+  double_vector_type ** row_vectors;
+  double_vector_type ** column_vectors;
+  double row_time , load_time , column_time;
+  bool equal = true;
+  int i;
+
+  ecl_sum_vector_add_keys( keylist , pattern );
+  num_keys = ecl_sum_vector_get_size( keylist );
+  row_vectors = util_calloc( num_keys , sizeof * row_vectors );
+  column_vectors = util_calloc( num_keys , sizeof * column_vectors );
+
+  row_time = extract_all( ecl_sum , keylist , row_vectors );
+  {
+    timer_type * timer = timer_alloc( false );
+    timer_start( timer );
+    ecl_sum_load_columns( ecl_sum , keylist );
+    timer_stop( timer );
+    load_time = timer_get_total_time( timer );
+    timer_free( timer );
+  }
+  column_time = extract_all( ecl_sum , keylist , column_vectors );
+
+  for (i=0; i < num_keys; i++) {
+    equal = equal && double_vector_equal( row_vectors[i] , column_vectors[i] );
+    double_vector_free( row_vectors[i] );
+    double_vector_free( column_vectors[i] );
+  }
+
+  printf("%s  vectors:%6d  tstep:%7d   rows:%8.4f   load_columns:%8.4f  columns:%8.4f   %s\n",
+         pattern ,
+         num_keys ,
+         ecl_sum_get_data_length( ecl_sum ) ,
+         row_time ,
+         load_time ,
+         column_time ,
+         equal ? "equal" : "DIFFERENT");
+
+  free( row_vectors );
+  free( column_vectors );
+  ecl_sum_vector_free( keylist );
+}
+
+
+int main(int argc, char ** argv) {
+  ecl_sum_type * ecl_sum;
+  const char * pattern = "WOPR:*";
+  int num_wells = 500;
+  int num_tstep = 5000;
+
+  if (argc > 1 && !util_sscanf_int( argv[1] , &num_wells )) {
+    ecl_sum = ecl_sum_fread_alloc_case( argv[1] , ":" );
+    if (ecl_sum == NULL)
+      util_exit("Could not load summary case:%s \n",argv[1]);
+
+    if (argc > 2)
+      pattern = argv[2];
+  } else {
+    if (argc > 2)
+      util_sscanf_int( argv[2] , &num_tstep );
+    ecl_sum = alloc_synthetic_case( num_wells , num_tstep );
+  }
+
+  run_case( ecl_sum , pattern );
+  ecl_sum_free( ecl_sum );
+  exit(0);
+}
@@ -0,0 +1,101 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'matrix_dgemm_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+#include <ert/util/rng.h>
+#include <ert/util/matrix.h>
+#include <ert/util/matrix_blas.h>
+
+/*
+  Small benchmark of the in place multiplication A = A*X used in the
+  EnKF update. The same product is calculated with
+  matrix_inplace_matmul_mt1() and matrix_inplace_dgemm_mt1(), and the
+  time and largest difference is reported.
+
+     matrix_dgemm_bench.x  [rows  [ens_size  [num_threads]]]
+*/
+
+
+static double run_matmul( matrix_type * A , const matrix_type * X , int num_threads , bool dgemm) {
+  timer_type * timer = timer_alloc( false );
+  double time;
+
+  timer_start( timer );
+  if (dgemm)
+    matrix_inplace_dgemm_mt1( A , X , num_threads );
+  else
+    matrix_inplace_matmul_mt1( A , X , num_threads );
+  timer_stop( timer );
+
+  time = timer_get_total_time( timer );
+  timer_free( timer );
+  return time;
+}
+
+
+int main(int argc , char ** argv) {
+  int rows = 1000000;
+  int ens_size = 100;
+  int num_threads = 4;
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &rows );
+
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &ens_size );
+
+  if (argc > 3)
+    util_sscanf_int( argv[3] , &num_threads );
+
+  {
+    rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+    matrix_type * A0 = matrix_alloc( rows , ens_size );
+    matrix_type * X  = matrix_alloc( ens_size , ens_size );
+    matrix_type * A1;
+    matrix_type * A2;
+    double matmul_time , dgemm_time;
+    double max_diff = 0;
+
+    matrix_random_init( A0 , rng );
+    matrix_random_init( X , rng );
+    A1 = matrix_alloc_copy( A0 );
+    A2 = matrix_alloc_copy( A0 );
+
+    matmul_time = run_matmul( A1 , X , num_threads , false );
+    dgemm_time  = run_matmul( A2 , X , num_threads , true );
+
+    for (int j = 0; j < ens_size; j++)
+      for (int i = 0; i < rows; i++)
+        max_diff = util_double_max( max_diff , fabs( matrix_iget( A1 , i , j ) - matrix_iget( A2 , i , j )));
+
+    printf("A:[%d,%d]  threads:%d   matrix_inplace_matmul: %8.3f s   matrix_inplace_dgemm: %8.3f s   speedup: %6.1f   max diff: %g\n",
+           rows , ens_size , num_threads , matmul_time , dgemm_time , matmul_time / dgemm_time , max_diff );
+
+    matrix_free( A0 );
+    matrix_free( A1 );
+    matrix_free( A2 );
+    matrix_free( X );
+    rng_free( rng );
+  }
+  exit(0);
+}
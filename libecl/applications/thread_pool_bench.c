@@ -0,0 +1,102 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'thread_pool_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+#include <ert/util/thread_pool.h>
+
+/*
+  Small benchmark of the per job overhead of the thread_pool. A large
+  number of small jobs are added to the pool and joined; the time per
+  job is reported.
+
+     thread_pool_bench.x  [num_threads  [num_jobs  [job_size]]]
+
+  The job_size is the number of iterations of a small floating point
+  loop done by each job.
+*/
+
+static int job_size = 100;
+
+static void * small_job( void * arg ) {
+  double * result = arg;
+  double sum = 0;
+  int i;
+
+  for (i=0; i < job_size; i++)
+    sum += i * 0.5;
+
+  *result = sum;
+  return NULL;
+}
+
+
+static void small_loop( int index , void * arg ) {
+  small_job( &((double *) arg)[index] );
+}
+
+
+
+int main(int argc , char ** argv) {
+  int num_threads = 4;
+  int num_jobs = 100000;
+  double * results;
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &num_threads );
+
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &num_jobs );
+
+  if (argc > 3)
+    util_sscanf_int( argv[3] , &job_size );
+
+  results = util_calloc( num_jobs , sizeof * results );
+  printf("Threads: %d   jobs: %d   job size: %d\n", num_threads , num_jobs , job_size );
+
+  {
+    timer_type * timer = timer_alloc( false );
+    thread_pool_type * tp;
+    int i;
+
+    timer_start( timer );
+    tp = thread_pool_alloc( num_threads , true );
+    for (i=0; i < num_jobs; i++)
+      thread_pool_add_job( tp , small_job , &results[i] );
+    thread_pool_join( tp );
+    timer_stop( timer );
+    printf("thread_pool_add_job()      : %8.3f s   %8.2f us/job\n" , timer_get_total_time( timer ) , 1e6 * timer_get_total_time( timer ) / num_jobs );
+
+    timer_reset( timer );
+    timer_start( timer );
+    thread_pool_restart( tp );
+    thread_pool_parallel_for( tp , 0 , num_jobs , small_loop , results );
+    thread_pool_join( tp );
+    timer_stop( timer );
+    printf("thread_pool_parallel_for() : %8.3f s   %8.2f us/index\n" , timer_get_total_time( timer ) , 1e6 * timer_get_total_time( timer ) / num_jobs );
+
+    thread_pool_free( tp );
+    timer_free( timer );
+  }
+
+  free( results );
+  exit(0);
+}
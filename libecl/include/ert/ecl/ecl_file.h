@@ -37,8 +37,10 @@ extern "C" {
 
 #define ECL_FILE_FLAGS_ENUM_DEFS \
   {.value =   1 , .name="ECL_FILE_CLOSE_STREAM"}, \
-  {.value =   2 , .name="ECL_FILE_WRITABLE"}
-#define ECL_FILE_FLAGS_ENUM_SIZE 2
+  {.value =   2 , .name="ECL_FILE_WRITABLE"}, \
+  {.value =   4 , .name="ECL_FILE_MMAP"}, \
+  {.value =   8 , .name="ECL_FILE_INDEX"}
+#define ECL_FILE_FLAGS_ENUM_SIZE 4
 
 
 
@@ -47,6 +49,7 @@ extern "C" {
   bool             ecl_file_load_all( ecl_file_type * ecl_file );
   ecl_file_type  * ecl_file_open( const char * filename , int flags);
   void             ecl_file_close( ecl_file_type * ecl_file );
+  char           * ecl_file_alloc_index_filename( const char * filename );
   void             ecl_file_fortio_detach( ecl_file_type * ecl_file );
   void             ecl_file_free__(void * arg);
   ecl_kw_type    * ecl_file_icopy_named_kw( const ecl_file_type * ecl_file , const char * kw, int ith);
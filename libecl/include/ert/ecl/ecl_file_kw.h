@@ -24,6 +24,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stdio.h>
 
 #include <ert/util/util.h>
 
@@ -51,6 +52,8 @@ typedef struct inv_map_struct inv_map_type;
   void               ecl_file_kw_replace_kw( ecl_file_kw_type * file_kw , fortio_type * target , ecl_kw_type * new_kw );
   bool               ecl_file_kw_fskip_data( const ecl_file_kw_type * file_kw , fortio_type * fortio);
   void               ecl_file_kw_inplace_fwrite( ecl_file_kw_type * file_kw , fortio_type * fortio);
+  bool               ecl_file_kw_fwrite( const ecl_file_kw_type * file_kw , FILE * stream );
+  ecl_file_kw_type * ecl_file_kw_fread_alloc( FILE * stream );
  
 #ifdef __cplusplus
 }
@@ -37,12 +37,25 @@ typedef enum {
                                     mainly to save filedescriptors in cases where many ecl_file instances are open at
                                     the same time. */
   //
-  ECL_FILE_WRITABLE      =  2    /*
+  ECL_FILE_WRITABLE      =  2 ,  /*
                                     This flag opens the file in a mode where it can be updated and modified, but it
                                     must still exist and be readable. I.e. this should not compared with the normal:
                                     fopen(filename , "w") where an existing file is truncated to zero upon successfull
                                     open.
                                  */
+  //
+  ECL_FILE_MMAP          =  4 ,  /*
+                                    This flag will memory map the file, the keyword headers and data are then copied
+                                    directly out of the mapped region instead of being read with fread(). The flag is
+                                    silently ignored for formatted files, for files opened with ECL_FILE_WRITABLE and
+                                    on platforms without mmap().
+                                 */
+  //
+  ECL_FILE_INDEX         =  8    /*
+                                    This flag will store the keyword index in a file '<filename>.index' next to the
+                                    file, and use that index instead of scanning the file when it is opened again. The
+                                    index file is validated against the size and mtime of the file.
+                                 */
 } ecl_file_flag_type;
 
 
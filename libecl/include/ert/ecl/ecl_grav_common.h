@@ -27,9 +27,12 @@ extern "C" {
 
 #include <ert/ecl/ecl_grid_cache.h>
 #include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_region.h>
 
   bool   * ecl_grav_common_alloc_aquifer_cell( const ecl_grid_cache_type * grid_cache , const ecl_file_type * init_file);
   double   ecl_grav_common_eval_biot_savart( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight ,  double utm_x , double utm_y , double depth);
+  void     ecl_grav_common_eval_biot_savart_stations( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight ,
+                                                      int num_stations , const double * utm_x , const double * utm_y , const double * depth , double * result , int num_threads);
 
 #ifdef __cplusplus
 }
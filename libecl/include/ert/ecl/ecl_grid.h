@@ -55,6 +55,7 @@ extern "C" {
   void            ecl_grid_get_cell_corner_xyz3(const ecl_grid_type * grid , int i , int j , int k, int corner_nr , double * xpos , double * ypos , double * zpos );
   void            ecl_grid_get_cell_corner_xyz1(const ecl_grid_type * grid , int global_index , int corner_nr , double * xpos , double * ypos , double * zpos );
   void            ecl_grid_get_corner_xyz(const ecl_grid_type * grid , int i , int j , int k, double * xpos , double * ypos , double * zpos );
+  void            ecl_grid_get_cell_bbox1(const ecl_grid_type * grid , int global_index , double * xmin , double * xmax , double * ymin , double * ymax , double * zmin , double * zmax);
 
   double          ecl_grid_get_cell_dx1A( const ecl_grid_type * grid , int active_index);
   double          ecl_grid_get_cell_dy1A( const ecl_grid_type * grid , int active_index);
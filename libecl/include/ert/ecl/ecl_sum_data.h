@@ -50,6 +50,10 @@ typedef struct ecl_sum_data_struct ecl_sum_data_type ;
   int                      ecl_sum_data_get_num_ministep( const ecl_sum_data_type * data );
   double_vector_type     * ecl_sum_data_alloc_data_vector( const ecl_sum_data_type * data , int data_index , bool report_only);
   void                     ecl_sum_data_init_data_vector( const ecl_sum_data_type * data , double_vector_type * data_vector , int data_index , bool report_only);
+  void                     ecl_sum_data_load_columns( ecl_sum_data_type * data , const ecl_sum_vector_type * keylist );
+  void                     ecl_sum_data_set_lazy_load( ecl_sum_data_type * data , bool lazy_load );
+  bool                     ecl_sum_data_get_lazy_load( const ecl_sum_data_type * data );
+  void                     ecl_sum_data_get_interp_vector( const ecl_sum_data_type * data , time_t sim_time , const ecl_sum_vector_type * keylist , double_vector_type * results);
   void                     ecl_sum_data_init_time_vector( const ecl_sum_data_type * data , time_t_vector_type * time_vector , bool report_only);
   time_t_vector_type     * ecl_sum_data_alloc_time_vector( const ecl_sum_data_type * data , bool report_only);
   time_t                   ecl_sum_data_get_data_start( const ecl_sum_data_type * data );
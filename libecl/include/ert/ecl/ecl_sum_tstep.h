@@ -39,6 +39,13 @@ typedef struct ecl_sum_tstep_struct ecl_sum_tstep_type;
                                                      const char * src_file ,
                                                      const ecl_smspec_type * smspec);
 
+  ecl_sum_tstep_type * ecl_sum_tstep_alloc_lazy( int report_step ,
+                                                 int ministep_nr ,
+                                                 const float * time_data ,
+                                                 int src_file_index ,
+                                                 offset_type params_offset ,
+                                                 const ecl_smspec_type * smspec);
+
   ecl_sum_tstep_type * ecl_sum_tstep_alloc_new( int report_step , int ministep , float sim_seconds , const ecl_smspec_type * smspec );
 
   double ecl_sum_tstep_iget(const ecl_sum_tstep_type * ministep , int index);
@@ -48,6 +55,9 @@ typedef struct ecl_sum_tstep_struct ecl_sum_tstep_type;
 
   int  ecl_sum_tstep_get_report(const ecl_sum_tstep_type * ministep);
   int  ecl_sum_tstep_get_ministep(const ecl_sum_tstep_type * ministep);
+  bool ecl_sum_tstep_has_data(const ecl_sum_tstep_type * ministep);
+  int  ecl_sum_tstep_get_src_file_index(const ecl_sum_tstep_type * ministep);
+  offset_type ecl_sum_tstep_get_params_offset(const ecl_sum_tstep_type * ministep);
 
   void ecl_sum_tstep_fwrite( const ecl_sum_tstep_type * ministep , const int_vector_type * index_map , fortio_type * fortio);
   void ecl_sum_tstep_iset( ecl_sum_tstep_type * tstep , int index , float value);
@@ -39,6 +39,9 @@ typedef struct ecl_sum_vector_struct ecl_sum_vector_type;
   int ecl_sum_vector_iget_param_index(const ecl_sum_vector_type * ecl_sum_vector, int index);
   int ecl_sum_vector_get_size(const ecl_sum_vector_type * ecl_sum_vector);
 
+  void ecl_sum_load_columns( ecl_sum_type * ecl_sum , const ecl_sum_vector_type * keylist );
+  void ecl_sum_get_interp_vector( const ecl_sum_type * ecl_sum , time_t sim_time , const ecl_sum_vector_type * keylist , double_vector_type * data);
+
   UTIL_IS_INSTANCE_HEADER( ecl_sum_vector);
 
 
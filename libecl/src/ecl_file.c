@@ -545,6 +545,151 @@ static bool ecl_file_scan( ecl_file_type * ecl_file ) {
 }
 
 
+/**
+   With the ECL_FILE_INDEX flag the keyword list created by
+   ecl_file_scan() is stored in the file '<filename>.index' next to
+   the original file, and subsequent calls to ecl_file_open() will
+   create the global view from the index file instead of scanning
+   through the file. The index file is considered valid if it has
+   been created from a file with identical size and mtime as the
+   current file; otherwise the file is scanned and the index is
+   rewritten.
+
+   Writing the index is on a best effort basis: if the directory is
+   not writable the file is just scanned every time. The index is
+   first written to a temporary file and then renamed into place, so
+   concurrent readers will never see a half written index.
+*/
+
+#define ECL_FILE_INDEX_ID       771064
+#define ECL_FILE_INDEX_VERSION  1
+
+
+char * ecl_file_alloc_index_filename( const char * filename ) {
+  return util_alloc_sprintf("%s.index" , filename );
+}
+
+
+static bool ecl_file_load_index( ecl_file_type * ecl_file , const char * filename ) {
+  char * index_file = ecl_file_alloc_index_filename( filename );
+  FILE * stream = fopen( index_file , "rb" );
+  bool index_ok = false;
+
+  if (stream) {
+    int         id , version , num_kw;
+    offset_type file_size;
+    time_t      mtime;
+
+    if ((fread( &id , sizeof id , 1 , stream ) == 1) && (id == ECL_FILE_INDEX_ID) &&
+        (fread( &version , sizeof version , 1 , stream ) == 1) && (version == ECL_FILE_INDEX_VERSION) &&
+        (fread( &file_size , sizeof file_size , 1 , stream ) == 1) &&
+        (fread( &mtime , sizeof mtime , 1 , stream ) == 1) &&
+        (fread( &num_kw , sizeof num_kw , 1 , stream ) == 1) && (num_kw >= 0)) {
+
+      if ((file_size == (offset_type) util_file_size( filename )) && (mtime == util_file_mtime( filename ))) {
+        ecl_file_kw_type ** kw_list = util_calloc( num_kw , sizeof * kw_list );
+        int num_read = 0;
+
+        while (num_read < num_kw) {
+          kw_list[num_read] = ecl_file_kw_fread_alloc( stream );
+          if (kw_list[num_read] == NULL)
+            break;
+          num_read++;
+        }
+
+        if (num_read == num_kw) {
+          int i;
+          for (i=0; i < num_kw; i++)
+            ecl_file_view_add_kw( ecl_file->global_view , kw_list[i] );
+          index_ok = true;
+        } else {
+          int i;
+          for (i=0; i < num_read; i++)
+            ecl_file_kw_free( kw_list[i] );
+        }
+        free( kw_list );
+      }
+    }
+    fclose( stream );
+  }
+  free( index_file );
+
+  if (index_ok)
+    ecl_file_view_make_index( ecl_file->global_view );
+
+  return index_ok;
+}
+
+
+static void ecl_file_save_index( const ecl_file_type * ecl_file , const char * filename , offset_type file_size , time_t mtime) {
+  char * index_file = ecl_file_alloc_index_filename( filename );
+  char * path = util_split_alloc_dirname( filename );
+  char * tmp_file;
+
+  {
+    char * index_name = util_split_alloc_filename( index_file );
+    tmp_file = util_alloc_tmp_file( path ? path : "." , index_name , true );
+    free( index_name );
+  }
+
+  {
+    FILE * stream = fopen( tmp_file , "wb" );
+    if (stream) {
+      const int id = ECL_FILE_INDEX_ID;
+      const int version = ECL_FILE_INDEX_VERSION;
+      const int num_kw = ecl_file_view_get_size( ecl_file->global_view );
+      bool write_ok = true;
+      int i;
+
+      write_ok = write_ok && (fwrite( &id , sizeof id , 1 , stream ) == 1);
+      write_ok = write_ok && (fwrite( &version , sizeof version , 1 , stream ) == 1);
+      write_ok = write_ok && (fwrite( &file_size , sizeof file_size , 1 , stream ) == 1);
+      write_ok = write_ok && (fwrite( &mtime , sizeof mtime , 1 , stream ) == 1);
+      write_ok = write_ok && (fwrite( &num_kw , sizeof num_kw , 1 , stream ) == 1);
+
+      for (i=0; (i < num_kw) && write_ok; i++)
+        write_ok = ecl_file_kw_fwrite( ecl_file_view_iget_file_kw( ecl_file->global_view , i ) , stream );
+
+      if (fclose( stream ) != 0)
+        write_ok = false;
+
+      if (!write_ok || (rename( tmp_file , index_file ) != 0))
+        remove( tmp_file );
+    }
+  }
+
+  util_safe_free( path );
+  free( tmp_file );
+  free( index_file );
+}
+
+
+/**
+   Will create the global view from the index file if that is valid,
+   otherwise scan the file and try to store a new index. The index is
+   only stored if the file has not changed during the scan, i.e. an
+   index is never written for a file which is still being written by
+   the simulator.
+*/
+
+static bool ecl_file_scan_indexed( ecl_file_type * ecl_file , const char * filename ) {
+  if (ecl_file_load_index( ecl_file , filename ))
+    return true;
+  else {
+    offset_type file_size = (offset_type) util_file_size( filename );
+    time_t mtime = util_file_mtime( filename );
+    bool scan_ok = ecl_file_scan( ecl_file );
+
+    if (scan_ok) {
+      if ((file_size == (offset_type) util_file_size( filename )) && (mtime == util_file_mtime( filename )))
+        ecl_file_save_index( ecl_file , filename , file_size , mtime );
+    }
+
+    return scan_ok;
+  }
+}
+
+
 void ecl_file_select_global( ecl_file_type * ecl_file ) {
   ecl_file->active_view = ecl_file->global_view;
 }
@@ -560,6 +705,14 @@ void ecl_file_select_global( ecl_file_type * ecl_file ) {
 
    The ecl_file instance will retain an open fortio reference to the
    file until ecl_file_close() is called.
+
+   If the flag ECL_FILE_MMAP is set the file will be memory mapped,
+   and both the scan and the subsequent loading of keywords will be
+   served from the mapped region; if the file can not be mapped we
+   silently fall back to ordinary stream reading.
+
+   If the flag ECL_FILE_INDEX is set the index will be loaded from
+   the keyword index file, see ecl_file_scan_indexed().
 */
 
 
@@ -576,10 +729,14 @@ ecl_file_type * ecl_file_open( const char * filename , int flags) {
 
   if (fortio) {
     ecl_file_type * ecl_file = ecl_file_alloc_empty( flags );
+
+    if (ecl_file_view_check_flags(flags , ECL_FILE_MMAP) && !ecl_file_view_check_flags(flags , ECL_FILE_WRITABLE))
+      fortio_mmap( fortio );
+
     ecl_file->fortio = fortio;
     ecl_file->global_view = ecl_file_view_alloc( ecl_file->fortio , &ecl_file->flags , ecl_file->inv_view , true );
 
-    if (ecl_file_scan( ecl_file )) {
+    if (ecl_file_view_check_flags( flags , ECL_FILE_INDEX ) ? ecl_file_scan_indexed( ecl_file , filename ) : ecl_file_scan( ecl_file )) {
       ecl_file_select_global( ecl_file );
 
       if (ecl_file_view_check_flags( ecl_file->flags , ECL_FILE_CLOSE_STREAM))
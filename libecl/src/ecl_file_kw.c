@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include <ert/util/size_t_vector.h>
 #include <ert/util/util.h>
@@ -318,3 +319,63 @@ void ecl_file_kw_inplace_fwrite( ecl_file_kw_type * file_kw , fortio_type * fort
 
 
 
+
+
+/**
+   The ecl_file_kw_fwrite() and ecl_file_kw_fread_alloc() functions
+   are used to store the header information in the keyword index file
+   written by ecl_file. The record has fixed size, the offset is
+   stored in the native format of the offset_type.
+
+   Both functions are used on a best effort basis; instead of aborting
+   on failure they return false / NULL and leave it to the calling
+   scope to fall back to scanning the file.
+*/
+
+bool ecl_file_kw_fwrite( const ecl_file_kw_type * file_kw , FILE * stream ) {
+  char header[ECL_STRING_LENGTH];
+  int  type = file_kw->ecl_type;
+
+  memset( header , 0 , sizeof header );
+  strncpy( header , file_kw->header , ECL_STRING_LENGTH );
+
+  if (fwrite( header , sizeof header , 1 , stream ) != 1)
+    return false;
+
+  if (fwrite( &type , sizeof type , 1 , stream ) != 1)
+    return false;
+
+  if (fwrite( &file_kw->kw_size , sizeof file_kw->kw_size , 1 , stream ) != 1)
+    return false;
+
+  if (fwrite( &file_kw->file_offset , sizeof file_kw->file_offset , 1 , stream ) != 1)
+    return false;
+
+  return true;
+}
+
+
+ecl_file_kw_type * ecl_file_kw_fread_alloc( FILE * stream ) {
+  char        header[ECL_STRING_LENGTH + 1];
+  int         type;
+  int         size;
+  offset_type offset;
+
+  if (fread( header , ECL_STRING_LENGTH , 1 , stream ) != 1)
+    return NULL;
+
+  if (fread( &type , sizeof type , 1 , stream ) != 1)
+    return NULL;
+
+  if (fread( &size , sizeof size , 1 , stream ) != 1)
+    return NULL;
+
+  if (fread( &offset , sizeof offset , 1 , stream ) != 1)
+    return NULL;
+
+  if ((size < 0) || (offset < 0) || (type < ECL_CHAR_TYPE) || (type > ECL_MESS_TYPE))
+    return NULL;
+
+  header[ECL_STRING_LENGTH] = '\0';
+  return ecl_file_kw_alloc__( header , type , size , offset );
+}
@@ -561,6 +561,60 @@ static double ecl_grav_survey_eval( const ecl_grav_survey_type * base_survey,
   return deltag;
 }
 
+/*
+   The total difference in mass, summed over the phases in @phase_mask,
+   for every cell.
+*/
+
+static double * ecl_grav_survey_alloc_mass_diff( const ecl_grav_survey_type * base_survey,
+                                                 const ecl_grav_survey_type * monitor_survey ,
+                                                 int phase_mask) {
+  const int size = ecl_grid_cache_get_size( base_survey->grid_cache );
+  double * mass_diff = util_calloc( size , sizeof * mass_diff );
+  int phase_nr , index;
+
+  for (index = 0; index < size; index++)
+    mass_diff[index] = 0;
+
+  for (phase_nr = 0; phase_nr < vector_get_size( base_survey->phase_list ); phase_nr++) {
+    const ecl_grav_phase_type * base_phase = vector_iget_const( base_survey->phase_list , phase_nr );
+    if (base_phase->phase & phase_mask) {
+      if (monitor_survey != NULL) {
+        const ecl_grav_phase_type * monitor_phase = vector_iget_const( monitor_survey->phase_list , phase_nr );
+        if (base_phase->phase != monitor_phase->phase)
+          util_abort("%s comparing different phases ... \n",__func__);
+
+        for (index = 0; index < size; index++)
+          mass_diff[index] += monitor_phase->fluid_mass[index] - base_phase->fluid_mass[index];
+      } else {
+        for (index = 0; index < size; index++)
+          mass_diff[index] -= base_phase->fluid_mass[index];
+      }
+    }
+  }
+  return mass_diff;
+}
+
+
+static void ecl_grav_survey_eval_stations( const ecl_grav_survey_type * base_survey,
+                                           const ecl_grav_survey_type * monitor_survey ,
+                                           ecl_region_type * region ,
+                                           int phase_mask ,
+                                           int num_stations ,
+                                           const double * utm_x , const double * utm_y , const double * depth ,
+                                           double * deltag) {
+  double * mass_diff = ecl_grav_survey_alloc_mass_diff( base_survey , monitor_survey , phase_mask );
+  int i;
+
+  ecl_grav_common_eval_biot_savart_stations( base_survey->grid_cache , region , base_survey->aquifer_cell , mass_diff ,
+                                             num_stations , utm_x , utm_y , depth , deltag , util_get_num_cpu() );
+  /* Scaled to microGal - see ecl_grav_phase_eval(). */
+  for (i = 0; i < num_stations; i++)
+    deltag[i] *= 6.67428E-3;
+
+  free( mass_diff );
+}
+
 /*****************************************************************/
 /**
    The grid instance is only used during the construction phase. The
@@ -645,6 +699,25 @@ double ecl_grav_eval( const ecl_grav_type * grav , const char * base, const char
 }
 
 
+/**
+   Evaluates the gravity change at @num_stations stations, station i is
+   at (utm_x[i], utm_y[i], depth[i]) and the result is stored in
+   deltag[i]. The mass difference between the surveys is calculated
+   once, and the stations are evaluated in parallel; this is much
+   faster than calling ecl_grav_eval() for each station. Since the
+   phases are summed before the stations are evaluated the results
+   can differ from ecl_grav_eval() in the last digits.
+*/
+
+void ecl_grav_eval_stations( const ecl_grav_type * grav , const char * base, const char * monitor , ecl_region_type * region , int phase_mask ,
+                             int num_stations , const double * utm_x , const double * utm_y , const double * depth , double * deltag) {
+  ecl_grav_survey_type * base_survey    = ecl_grav_get_survey( grav , base );
+  ecl_grav_survey_type * monitor_survey = ecl_grav_get_survey( grav , monitor );
+
+  ecl_grav_survey_eval_stations( base_survey , monitor_survey , region , phase_mask , num_stations , utm_x , utm_y , depth , deltag );
+}
+
+
 /******************************************************************/
 /* The functions ecl_grav_new_std_density() and ecl_grav_add_std_density() are
    used to "install" standard conditions densities for the various phases
@@ -23,6 +23,11 @@
 
 #include <ert/util/util.h>
 
+#ifdef ERT_HAVE_THREAD_POOL
+#include <ert/util/arg_pack.h>
+#include <ert/util/thread_pool.h>
+#endif
+
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_file.h>
 #include <ert/ecl/ecl_region.h>
@@ -49,6 +54,10 @@ bool * ecl_grav_common_alloc_aquifer_cell( const ecl_grid_cache_type * grid_cach
       else
         aquifer_cell[ active_index ] = false;
     }
+  } else {
+    int active_index;
+    for (active_index = 0; active_index < ecl_grid_cache_get_size( grid_cache ); active_index++)
+      aquifer_cell[ active_index ] = false;
   }
 
   return aquifer_cell;
@@ -99,3 +108,173 @@ double ecl_grav_common_eval_biot_savart( const ecl_grid_cache_type * grid_cache
 }
 
 
+
+/*****************************************************************/
+
+/*
+  Evaluation of the Biot-Savart sum for many stations with the same
+  weight. The cells which contribute, i.e. the cells in the region
+  which are not aquifer cells, are first packed in contiguous
+  coordinate and weight arrays. The stations are then evaluated in
+  blocks of STATION_BLOCK_SIZE: the outer loop goes over the cells and
+  the inner loop over the stations in the block, so every cell is
+  loaded once per block instead of once per station, and the inner
+  loop has neither branches nor a loop carried dependency.
+
+  Each station sees the cells in the same order as in
+  ecl_grav_common_eval_biot_savart(), so the results are identical to
+  calling that function for one station at a time.
+*/
+
+#define STATION_BLOCK_SIZE     64
+#define MIN_STATIONS_PER_JOB  STATION_BLOCK_SIZE
+
+typedef struct {
+  int      size;
+  double * xpos;
+  double * ypos;
+  double * zpos;
+  double * weight;
+} grav_cells_type;
+
+
+static void grav_cells_add( grav_cells_type * cells , const ecl_grid_cache_type * grid_cache , const double * weight , int index) {
+  cells->xpos[ cells->size ]   = ecl_grid_cache_get_xpos( grid_cache )[index];
+  cells->ypos[ cells->size ]   = ecl_grid_cache_get_ypos( grid_cache )[index];
+  cells->zpos[ cells->size ]   = ecl_grid_cache_get_zpos( grid_cache )[index];
+  cells->weight[ cells->size ] = weight[index];
+  cells->size++;
+}
+
+
+static void grav_cells_init( grav_cells_type * cells , const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight ) {
+  const int grid_size = ecl_grid_cache_get_size( grid_cache );
+
+  cells->size   = 0;
+  cells->xpos   = util_calloc( grid_size , sizeof * cells->xpos );
+  cells->ypos   = util_calloc( grid_size , sizeof * cells->ypos );
+  cells->zpos   = util_calloc( grid_size , sizeof * cells->zpos );
+  cells->weight = util_calloc( grid_size , sizeof * cells->weight );
+
+  if (region == NULL) {
+    int index;
+    for (index = 0; index < grid_size; index++)
+      if (!aquifer[index])
+        grav_cells_add( cells , grid_cache , weight , index );
+  } else {
+    const int_vector_type * index_vector = ecl_region_get_active_list( region );
+    const int * index_list = int_vector_get_const_ptr( index_vector );
+    int i;
+    for (i = 0; i < int_vector_size( index_vector ); i++)
+      if (!aquifer[index_list[i]])
+        grav_cells_add( cells , grid_cache , weight , index_list[i] );
+  }
+}
+
+
+static void grav_cells_free( grav_cells_type * cells ) {
+  free( cells->xpos );
+  free( cells->ypos );
+  free( cells->zpos );
+  free( cells->weight );
+}
+
+
+static void grav_cells_eval_block( const grav_cells_type * cells , int num_stations , const double * utm_x , const double * utm_y , const double * depth , double * result) {
+  const double * xpos   = cells->xpos;
+  const double * ypos   = cells->ypos;
+  const double * zpos   = cells->zpos;
+  const double * weight = cells->weight;
+  double sum[STATION_BLOCK_SIZE] = { 0 };
+  int index , s;
+
+  for (index = 0; index < cells->size; index++) {
+    for (s = 0; s < num_stations; s++) {
+      double dist_x  = (xpos[index] - utm_x[s] );
+      double dist_y  = (ypos[index] - utm_y[s] );
+      double dist_z  = (zpos[index] - depth[s] );
+      double dist    = sqrt( dist_x*dist_x + dist_y*dist_y + dist_z*dist_z );
+
+      sum[s] += weight[index] * dist_z/(dist * dist * dist );
+    }
+  }
+
+  for (s = 0; s < num_stations; s++)
+    result[s] = sum[s];
+}
+
+
+static void grav_cells_eval( const grav_cells_type * cells , int num_stations , const double * utm_x , const double * utm_y , const double * depth , double * result) {
+  int offset;
+  for (offset = 0; offset < num_stations; offset += STATION_BLOCK_SIZE)
+    grav_cells_eval_block( cells ,
+                           util_int_min( STATION_BLOCK_SIZE , num_stations - offset ) ,
+                           &utm_x[offset] , &utm_y[offset] , &depth[offset] , &result[offset] );
+}
+
+
+#ifdef ERT_HAVE_THREAD_POOL
+
+static void * grav_cells_eval_mt( void * arg ) {
+  arg_pack_type * arg_pack = arg_pack_safe_cast( arg );
+  const grav_cells_type * cells = arg_pack_iget_const_ptr( arg_pack , 0 );
+  int num_stations     = arg_pack_iget_int( arg_pack , 1 );
+  const double * utm_x = arg_pack_iget_const_ptr( arg_pack , 2 );
+  const double * utm_y = arg_pack_iget_const_ptr( arg_pack , 3 );
+  const double * depth = arg_pack_iget_const_ptr( arg_pack , 4 );
+  double * result      = arg_pack_iget_ptr( arg_pack , 5 );
+
+  grav_cells_eval( cells , num_stations , utm_x , utm_y , depth , result );
+  return NULL;
+}
+
+#endif
+
+
+/*
+  Evaluates the Biot-Savart sum for @num_stations stations at
+  (utm_x[i], utm_y[i], depth[i]) and stores the sums in result[i].
+  The stations are split in contiguous blocks between @num_threads
+  threads; when the thread pool is not available, or there are few
+  stations, the evaluation is done in the calling thread.
+*/
+
+void ecl_grav_common_eval_biot_savart_stations( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight ,
+                                                int num_stations , const double * utm_x , const double * utm_y , const double * depth , double * result , int num_threads) {
+  grav_cells_type cells;
+  grav_cells_init( &cells , grid_cache , region , aquifer , weight );
+
+  num_threads = util_int_min( num_threads , num_stations / MIN_STATIONS_PER_JOB );
+#ifdef ERT_HAVE_THREAD_POOL
+  if (num_threads > 1) {
+    thread_pool_type * tp = thread_pool_alloc( num_threads , true );
+    arg_pack_type ** arglist = util_calloc( num_threads , sizeof * arglist );
+    int offset = 0;
+    int it;
+
+    for (it = 0; it < num_threads; it++) {
+      int size = num_stations / num_threads + ((it < num_stations % num_threads) ? 1 : 0);
+
+      arglist[it] = arg_pack_alloc();
+      arg_pack_append_const_ptr( arglist[it] , &cells );
+      arg_pack_append_int( arglist[it] , size );
+      arg_pack_append_const_ptr( arglist[it] , &utm_x[offset] );
+      arg_pack_append_const_ptr( arglist[it] , &utm_y[offset] );
+      arg_pack_append_const_ptr( arglist[it] , &depth[offset] );
+      arg_pack_append_ptr( arglist[it] , &result[offset] );
+
+      thread_pool_add_job( tp , grav_cells_eval_mt , arglist[it] );
+      offset += size;
+    }
+    thread_pool_join( tp );
+    thread_pool_free( tp );
+
+    for (it = 0; it < num_threads; it++)
+      arg_pack_free( arglist[it] );
+    free( arglist );
+  } else
+#endif
+    grav_cells_eval( &cells , num_stations , utm_x , utm_y , depth , result );
+
+  grav_cells_free( &cells );
+}
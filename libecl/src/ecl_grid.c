@@ -690,11 +690,9 @@ static void point_copy_values(point_type * p , const point_type * src) {
 #define HOST_CELL_NONE     -1
 
 #define CELL_FLAG_VALID    1     /* In the case of GRID files not necessarily all cells geometry values set - in that case this will be left as false. */
-#define CELL_FLAG_CENTER   2     /* Has the center value been calculated - this is by default not done to speed up loading a tiny bit. */
-#define CELL_FLAG_TAINTED  4     /* lazy fucking stupid reservoir engineers make invalid grid
+#define CELL_FLAG_TAINTED  2     /* lazy fucking stupid reservoir engineers make invalid grid
                                     cells - for kicks??  must try to keep those cells out of
                                     real-world calculations with some hysteric heuristics.*/
-#define CELL_FLAG_VOLUME 8
 
 typedef struct ecl_cell_struct           ecl_cell_type;
 
@@ -702,18 +700,32 @@ typedef struct ecl_cell_struct           ecl_cell_type;
 #define SET_CELL_FLAG(cell,flag) ((cell->cell_flags |= (flag)))
 #define METER_TO_FEET_SCALE_FACTOR 3.28084
 
-struct ecl_cell_struct {
-  point_type center;
-  point_type corner_list[8];
+/*
+  The ecl_cell structure only holds the small per cell state which is
+  needed by (almost) all cells. The cell geometry, and the information
+  which only applies to a minority of the cells, is stored in the
+  ecl_grid structure:
+
+    1. For corner point grids, i.e. grids created from EGRID files or
+       from COORD and ZCORN data, the corners are not stored at
+       all. The grid keeps a copy of the ZCORN data and the
+       COORD pillars, and the corners are recalculated when they are
+       needed. For all other grids the corners are stored in three
+       separate arrays corner_x, corner_y and corner_z with eight
+       consecutive values per cell. See ecl_grid_get_cell_corners().
+
+    2. The cell center and the cell volume are calculated from the
+       corners every time they are requested; they are not cached.
+
+    3. The host cell, the coarse group, the lgr pointer and the nnc
+       information are stored in side tables which are only allocated
+       when the grid actually has lgrs, coarsening or nnc connections.
+*/
 
-  double                 volume;             /* Cache volume - whether it is initialized or not is handled by a cell_flags. */
+struct ecl_cell_struct {
   int                    active;
   int                    active_index[2];    /* [0]: The active matrix index; [1]: the active fracture index */
-  const ecl_grid_type   *lgr;                /* if this cell is part of an lgr; this will point to a grid instance for that lgr; NULL if not part of lgr. */
-  int                    host_cell;          /* the global index of the host cell for an lgr cell, set to -1 for normal cells. */
-  int                    coarse_group;       /* The index of the coarse group holding this cell -1 for non-coarsened cells. */
   int                    cell_flags;
-  nnc_info_type        * nnc_info;           /* Non-neighbour connection info*/
 };
 
 
@@ -742,6 +754,19 @@ struct ecl_grid_struct {
 
   ecl_cell_type      *  cells;
 
+  /* Cell geometry - either zcorn + pillars, or corner_x/y/z. */
+  float               * zcorn;                  /* Copy of the ZCORN data for corner point grids - NULL otherwise. */
+  double              * pillars;                /* (nx + 1)*(ny + 1) pillars: top point (x,y,z) and direction (ex,ey,ez). */
+  double              * corner_x;               /* Explicit corners: 8*size values - NULL for corner point grids. */
+  double              * corner_y;
+  double              * corner_z;
+
+  /* Side tables - NULL when all cells have the default value. */
+  int                 * host_cell;              /* The global index of the host cell for an lgr cell, default HOST_CELL_NONE. */
+  int                 * coarse_group;           /* The index of the coarse group holding the cell, default COARSE_GROUP_NONE. */
+  const ecl_grid_type ** cell_lgr;              /* The lgr refining the cell, default NULL. */
+  nnc_info_type      ** nnc_info;               /* Non-neighbour connection info, default NULL. */
+
   char                * parent_name;   /* the name of the parent for a nested lgr - for the main grid, and also a
                                           lgr descending directly from the main grid this will be NULL. */
   hash_type           * children;      /* a table of lgr children for this grid. */
@@ -782,7 +807,7 @@ struct ecl_grid_struct {
   int                   eclipse_version;
 };
 
-static void ecl_cell_compare(const ecl_cell_type * c1 , const ecl_cell_type * c2,  bool include_nnc , bool * equal) {
+static void ecl_cell_compare(const ecl_cell_type * c1 , const point_type * corners1 , const ecl_cell_type * c2 , const point_type * corners2 , bool * equal) {
   int i;
 
   if (c1->active != c2->active)
@@ -795,48 +820,39 @@ static void ecl_cell_compare(const ecl_cell_type * c1 , const ecl_cell_type * c2
   if (c1->active_index[1] != c2->active_index[1])
     *equal = false;
 
-  if (c1->coarse_group != c2->coarse_group)
-    *equal = false;
-
-  if (c1->host_cell != c2->host_cell)
-    *equal = false;
-
   if (*equal) {
     for (i=0; i < 8; i++)
-      point_compare( &c1->corner_list[i] , &c2->corner_list[i] , equal );
-
-  }
+      point_compare( &corners1[i] , &corners2[i] , equal );
 
-  if (include_nnc) {
-    if (*equal)
-      *equal = nnc_info_equal( c1->nnc_info , c2->nnc_info );
   }
-
 }
 
 
-static void ecl_cell_dump( const ecl_cell_type * cell , FILE * stream) {
+static void ecl_cell_dump( const point_type * corner_list , FILE * stream) {
   int i;
   for (i=0; i < 8; i++)
-    point_dump( &cell->corner_list[i] , stream );
+    point_dump( &corner_list[i] , stream );
 }
 
 
-static void ecl_cell_assert_center( ecl_cell_type * cell);
+static void ecl_cell_get_center( const point_type * corner_list , point_type * center);
 
-static void ecl_cell_dump_ascii( ecl_cell_type * cell , int i , int j , int k , FILE * stream , const double * offset) {
-  fprintf(stream , "Cell: i:%3d  j:%3d    k:%3d   host_cell:%d  CoarseGroup:%4d active_nr:%6d  active:%d \nCorners:\n",i,j,k,cell->host_cell, cell->coarse_group , cell->active_index[MATRIX_INDEX], cell->active);
+static void ecl_cell_dump_ascii( const ecl_cell_type * cell , const point_type * corner_list , int host_cell , int coarse_group , int i , int j , int k , FILE * stream , const double * offset) {
+  fprintf(stream , "Cell: i:%3d  j:%3d    k:%3d   host_cell:%d  CoarseGroup:%4d active_nr:%6d  active:%d \nCorners:\n",i,j,k,host_cell, coarse_group , cell->active_index[MATRIX_INDEX], cell->active);
 
-  ecl_cell_assert_center( cell );
-  fprintf(stream , "Center   : ");
-  point_dump_ascii( &cell->center , stream , offset);
-  fprintf(stream , "\n");
+  {
+    point_type center;
+    ecl_cell_get_center( corner_list , &center );
+    fprintf(stream , "Center   : ");
+    point_dump_ascii( &center , stream , offset);
+    fprintf(stream , "\n");
+  }
 
   {
     int l;
     for (l=0; l < 8; l++) {
       fprintf(stream , "Corner %d : ",l);
-      point_dump_ascii( &cell->corner_list[l] , stream , offset);
+      point_dump_ascii( &corner_list[l] , stream , offset);
       fprintf(stream , "\n");
     }
   }
@@ -844,7 +860,7 @@ static void ecl_cell_dump_ascii( ecl_cell_type * cell , int i , int j , int k ,
 }
 
 
-static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_type * cell , bool fracture_cell , int coords_size , int i, int j , int k , int global_index , ecl_kw_type * coords_kw , ecl_kw_type * corners_kw, fortio_type * fortio) {
+static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_type * cell , const point_type * corner_list , int host_cell , int coarse_group , bool fracture_cell , int coords_size , int i, int j , int k , int global_index , ecl_kw_type * coords_kw , ecl_kw_type * corners_kw, fortio_type * fortio) {
   ecl_kw_iset_int( coords_kw , 0 , i + 1);
   ecl_kw_iset_int( coords_kw , 1 , j + 1);
   ecl_kw_iset_int( coords_kw , 2 , k + 1);
@@ -860,8 +876,8 @@ static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_ty
   }
 
   if (coords_size == 7) {
-    ecl_kw_iset_int( coords_kw , 5 , cell->host_cell + 1);
-    ecl_kw_iset_int( coords_kw , 6 , cell->coarse_group + 1);
+    ecl_kw_iset_int( coords_kw , 5 , host_cell + 1);
+    ecl_kw_iset_int( coords_kw , 6 , coarse_group + 1);
   }
 
   ecl_kw_fwrite( coords_kw , fortio );
@@ -871,7 +887,7 @@ static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_ty
     int c;
 
     for (c = 0; c < 8; c++) {
-      point_copy_values( &point , &cell->corner_list[c] );
+      point_copy_values( &point , &corner_list[c] );
       if (grid->use_mapaxes)
         point_mapaxes_invtransform( &point , grid->origo , grid->unit_x , grid->unit_y );
 
@@ -884,7 +900,7 @@ static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_ty
 }
 
 //static const size_t cellMappingECLRi[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
-static void ecl_cell_ri_export( const ecl_cell_type * cell , double * ri_points) {
+static void ecl_cell_ri_export( const point_type * corner_list , double * ri_points) {
   int ecl_offset = 4;
   int ri_offset =  ecl_offset * 3;
   {
@@ -892,14 +908,14 @@ static void ecl_cell_ri_export( const ecl_cell_type * cell , double * ri_points)
     // Handling the points 0,1 & 4,5 which map directly between ECLIPSE and RI
     for (point_nr =0; point_nr < 2; point_nr++) {
       // Points 0 & 1
-      ri_points[ point_nr * 3     ] =  cell->corner_list[point_nr].x;
-      ri_points[ point_nr * 3 + 1 ] =  cell->corner_list[point_nr].y;
-      ri_points[ point_nr * 3 + 2 ] = -cell->corner_list[point_nr].z;
+      ri_points[ point_nr * 3     ] =  corner_list[point_nr].x;
+      ri_points[ point_nr * 3 + 1 ] =  corner_list[point_nr].y;
+      ri_points[ point_nr * 3 + 2 ] = -corner_list[point_nr].z;
 
       // Points 4 & 5
-      ri_points[ ri_offset + point_nr * 3     ] =  cell->corner_list[ecl_offset + point_nr].x;
-      ri_points[ ri_offset + point_nr * 3 + 1 ] =  cell->corner_list[ecl_offset + point_nr].y;
-      ri_points[ ri_offset + point_nr * 3 + 2 ] = -cell->corner_list[ecl_offset + point_nr].z;
+      ri_points[ ri_offset + point_nr * 3     ] =  corner_list[ecl_offset + point_nr].x;
+      ri_points[ ri_offset + point_nr * 3 + 1 ] =  corner_list[ecl_offset + point_nr].y;
+      ri_points[ ri_offset + point_nr * 3 + 2 ] = -corner_list[ecl_offset + point_nr].z;
     }
   }
 
@@ -912,15 +928,15 @@ static void ecl_cell_ri_export( const ecl_cell_type * cell , double * ri_points)
     for (ecl_point =2; ecl_point < 4; ecl_point++) {
       int ri_point = 5 - ecl_point;
       // Points 2 & 3
-      ri_points[ ri_point * 3     ] =  cell->corner_list[ecl_point].x;
-      ri_points[ ri_point * 3 + 1 ] =  cell->corner_list[ecl_point].y;
-      ri_points[ ri_point * 3 + 2 ] = -cell->corner_list[ecl_point].z;
+      ri_points[ ri_point * 3     ] =  corner_list[ecl_point].x;
+      ri_points[ ri_point * 3 + 1 ] =  corner_list[ecl_point].y;
+      ri_points[ ri_point * 3 + 2 ] = -corner_list[ecl_point].z;
 
 
       // Points 6 & 7
-      ri_points[ ri_offset + ri_point * 3     ] =  cell->corner_list[ecl_offset + ecl_point].x;
-      ri_points[ ri_offset + ri_point * 3 + 1 ] =  cell->corner_list[ecl_offset + ecl_point].y;
-      ri_points[ ri_offset + ri_point * 3 + 2 ] = -cell->corner_list[ecl_offset + ecl_point].z;
+      ri_points[ ri_offset + ri_point * 3     ] =  corner_list[ecl_offset + ecl_point].x;
+      ri_points[ ri_offset + ri_point * 3 + 1 ] =  corner_list[ecl_offset + ecl_point].y;
+      ri_points[ ri_offset + ri_point * 3 + 2 ] = -corner_list[ecl_offset + ecl_point].z;
     }
   }
 }
@@ -955,12 +971,12 @@ static  double min8( double x1 , double x2 , double x3, double x4 , double x5 ,
 
 /*****************************************************************/
 
-static double ecl_cell_min_z( const ecl_cell_type * cell) {
-  return min4( cell->corner_list[0].z , cell->corner_list[1].z , cell->corner_list[2].z , cell->corner_list[3].z);
+static double ecl_cell_min_z( const point_type * corner_list ) {
+  return min4( corner_list[0].z , corner_list[1].z , corner_list[2].z , corner_list[3].z);
 }
 
-static double ecl_cell_max_z( const ecl_cell_type * cell ) {
-  return max4( cell->corner_list[4].z , cell->corner_list[5].z , cell->corner_list[6].z , cell->corner_list[7].z );
+static double ecl_cell_max_z( const point_type * corner_list ) {
+  return max4( corner_list[4].z , corner_list[5].z , corner_list[6].z , corner_list[7].z );
 }
 
 
@@ -969,26 +985,26 @@ static double ecl_cell_max_z( const ecl_cell_type * cell ) {
    plane for the x/y min/max.
 */
 
-static double ecl_cell_min_x( const ecl_cell_type * cell) {
-  return min8( cell->corner_list[0].x , cell->corner_list[1].x , cell->corner_list[2].x , cell->corner_list[3].x,
-               cell->corner_list[4].x , cell->corner_list[5].x , cell->corner_list[6].x , cell->corner_list[7].x );
+static double ecl_cell_min_x( const point_type * corner_list ) {
+  return min8( corner_list[0].x , corner_list[1].x , corner_list[2].x , corner_list[3].x,
+               corner_list[4].x , corner_list[5].x , corner_list[6].x , corner_list[7].x );
 }
 
 
-static double ecl_cell_max_x( const ecl_cell_type * cell ) {
-  return max8( cell->corner_list[0].x , cell->corner_list[1].x , cell->corner_list[2].x , cell->corner_list[3].x,
-               cell->corner_list[4].x , cell->corner_list[5].x , cell->corner_list[6].x , cell->corner_list[7].x );
+static double ecl_cell_max_x( const point_type * corner_list ) {
+  return max8( corner_list[0].x , corner_list[1].x , corner_list[2].x , corner_list[3].x,
+               corner_list[4].x , corner_list[5].x , corner_list[6].x , corner_list[7].x );
 }
 
-static double ecl_cell_min_y( const ecl_cell_type * cell) {
-  return min8( cell->corner_list[0].y , cell->corner_list[1].y , cell->corner_list[2].y , cell->corner_list[3].y,
-               cell->corner_list[4].y , cell->corner_list[5].y , cell->corner_list[6].y , cell->corner_list[7].y );
+static double ecl_cell_min_y( const point_type * corner_list ) {
+  return min8( corner_list[0].y , corner_list[1].y , corner_list[2].y , corner_list[3].y,
+               corner_list[4].y , corner_list[5].y , corner_list[6].y , corner_list[7].y );
 }
 
 
-static double ecl_cell_max_y( const ecl_cell_type * cell ) {
-  return max8( cell->corner_list[0].y , cell->corner_list[1].y , cell->corner_list[2].y , cell->corner_list[3].y,
-               cell->corner_list[4].y , cell->corner_list[5].y , cell->corner_list[6].y , cell->corner_list[7].y );
+static double ecl_cell_max_y( const point_type * corner_list ) {
+  return max8( corner_list[0].y , corner_list[1].y , corner_list[2].y , corner_list[3].y,
+               corner_list[4].y , corner_list[5].y , corner_list[6].y , corner_list[7].y );
 }
 
 
@@ -1028,10 +1044,10 @@ static double ecl_cell_max_y( const ecl_cell_type * cell ) {
  */
 
 
-static void ecl_cell_taint_cell( ecl_cell_type * cell ) {
+static void ecl_cell_taint_cell( ecl_cell_type * cell , const point_type * corner_list ) {
   int c;
   for (c = 0; c < 8; c++) {
-    const point_type p = cell->corner_list[c];
+    const point_type p = corner_list[c];
     if ((p.x == 0) && (p.y == 0)) {
       SET_CELL_FLAG(cell , CELL_FLAG_TAINTED);
       break;
@@ -1043,10 +1059,10 @@ static void ecl_cell_taint_cell( ecl_cell_type * cell ) {
   */
   if (cell->active == CELL_NOT_ACTIVE) {
     if (!GET_CELL_FLAG(cell , CELL_FLAG_TAINTED)) {
-      const point_type p0 = cell->corner_list[0];
+      const point_type p0 = corner_list[0];
       int cell_index = 1;
       while (true) {
-        const point_type pi = cell->corner_list[cell_index];
+        const point_type pi = corner_list[cell_index];
         if (pi.z != p0.z)
           // There is a difference - the cell is certainly valid.
           break;
@@ -1078,16 +1094,11 @@ static void ecl_cell_taint_cell( ecl_cell_type * cell ) {
 
 static void ecl_cell_init( ecl_cell_type * cell , bool init_valid) {
   cell->active                = CELL_NOT_ACTIVE;
-  cell->lgr                   = NULL;
-  cell->host_cell             = HOST_CELL_NONE;
-  cell->coarse_group          = COARSE_GROUP_NONE;
   cell->cell_flags            = 0;
   cell->active_index[MATRIX_INDEX]   = -1;
   cell->active_index[FRACTURE_INDEX] = -1;
   if (init_valid)
     cell->cell_flags = CELL_FLAG_VALID;
-
-  cell->nnc_info = NULL;
 }
 
 
@@ -1099,22 +1110,14 @@ static int ecl_cell_get_tetrahedron_method( int i , int j , int k) {
 #undef mod
 */
 
-static void ecl_cell_set_center( ecl_cell_type * cell) {
-  point_set(&cell->center , 0 , 0 , 0);
+static void ecl_cell_get_center( const point_type * corner_list , point_type * center) {
+  point_set(center , 0 , 0 , 0);
   {
     int c;
     for (c = 0; c < 8; c++)
-      point_inplace_add(&cell->center , &cell->corner_list[c]);
+      point_inplace_add(center , &corner_list[c]);
   }
-  point_inplace_scale(&cell->center , 1.0 / 8.0);
-
-  SET_CELL_FLAG( cell , CELL_FLAG_CENTER );
-}
-
-
-static void ecl_cell_assert_center( ecl_cell_type * cell) {
-  if (!GET_CELL_FLAG(cell , CELL_FLAG_CENTER))
-    ecl_cell_set_center( cell );
+  point_inplace_scale(center , 1.0 / 8.0);
 }
 
 
@@ -1123,10 +1126,6 @@ static void ecl_cell_memcpy( ecl_cell_type * target_cell , const ecl_cell_type *
   memcpy( target_cell , src_cell , sizeof * target_cell );
 }
 
-static void ecl_cell_install_lgr( ecl_cell_type * cell , const ecl_grid_type * lgr_grid) {
-  cell->lgr       = lgr_grid;
-}
-
 static double C(double *r,int f1,int f2,int f3){
   if (f1 == 0) {
     if (f2 == 0) {
@@ -1156,7 +1155,7 @@ static double C(double *r,int f1,int f2,int f3){
 }
 
 
-static double ecl_cell_get_volume_tskille( ecl_cell_type * cell ) {
+static double ecl_cell_get_volume_tskille( const point_type * corner_list ) {
   double volume = 0;
   int pb,pg,qa,qg,ra,rb;
   double X[8];
@@ -1165,9 +1164,9 @@ static double ecl_cell_get_volume_tskille( ecl_cell_type * cell ) {
   {
     int c;
     for (c = 0; c < 8; c++) {
-      X[c] = cell->corner_list[c].x;
-      Y[c] = cell->corner_list[c].y;
-      Z[c] = cell->corner_list[c].z;
+      X[c] = corner_list[c].x;
+      Y[c] = corner_list[c].y;
+      Z[c] = corner_list[c].z;
     }
   }
 
@@ -1234,19 +1233,16 @@ static inline double tetrahedron_volume6( tetrahedron_type tet ) {
  * when used in opm-parser and has been optimised significantly. This means
  * inlining several operations, e.g. vector operations, and other tricks.
  */
-static double ecl_cell_get_signed_volume( ecl_cell_type * cell) {
-  if (GET_CELL_FLAG(cell , CELL_FLAG_VOLUME))
-    return cell->volume;
-
-  ecl_cell_assert_center( cell );
+static double ecl_cell_get_signed_volume( const point_type * corner_list ) {
   {
     /*
      * We make an activation record local copy of the cell's corners for less
      * jumping in memory and better cache performance.
      */
-    point_type center = cell->center;
+    point_type center;
     point_type corners[ 8 ];
-    memcpy( corners, cell->corner_list, sizeof( point_type ) * 8 );
+    memcpy( corners, corner_list, sizeof( point_type ) * 8 );
+    ecl_cell_get_center( corners , &center );
 
     tetrahedron_type tet = { .p0 = center };
     double           volume = 0;
@@ -1290,15 +1286,13 @@ static double ecl_cell_get_signed_volume( ecl_cell_type * cell) {
      * reverted.
      */
 
-    cell->volume = volume * 0.5;
-    SET_CELL_FLAG( cell , CELL_FLAG_VOLUME );
+    return volume * 0.5;
   }
-  return cell->volume;
 }
 
 
-static double ecl_cell_get_volume( ecl_cell_type * cell ) {
-  return fabs( ecl_cell_get_signed_volume(cell));
+static double ecl_cell_get_volume( const point_type * corner_list ) {
+  return fabs( ecl_cell_get_signed_volume(corner_list));
 }
 
 
@@ -1353,7 +1347,7 @@ static bool triangle_contains(const point_type *p0 , const point_type * p1 , con
 */
 
 
-static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , bool lower_layer , double x , double y) {
+static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , const point_type * corner_list , bool lower_layer , double x , double y) {
   if (GET_CELL_FLAG(cell,CELL_FLAG_TAINTED))
     return false;
   {
@@ -1365,10 +1359,10 @@ static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , bool lower_
       else
         corner_offset = 4;
 
-      p0 = &cell->corner_list[corner_offset + 0];
-      p1 = &cell->corner_list[corner_offset + 1];
-      p2 = &cell->corner_list[corner_offset + 2];
-      p3 = &cell->corner_list[corner_offset + 3];
+      p0 = &corner_list[corner_offset + 0];
+      p1 = &corner_list[corner_offset + 1];
+      p2 = &corner_list[corner_offset + 2];
+      p3 = &corner_list[corner_offset + 3];
     }
 
     if (triangle_contains(p0,p1,p2,x,y))
@@ -1387,23 +1381,23 @@ static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , bool lower_
          |   |           |   |
          0---1           4---5
 */
-static void ecl_cell_init_regular( ecl_cell_type * cell , const double * offset , int i , int j , int k , int global_index , const double * ivec , const double * jvec , const double * kvec , const int * actnum ) {
-  point_set(&cell->corner_list[0] , offset[0] , offset[1] , offset[2] ); // Point 0
+static void ecl_cell_init_regular( ecl_cell_type * cell , point_type * corner_list , const double * offset , int i , int j , int k , int global_index , const double * ivec , const double * jvec , const double * kvec , const int * actnum ) {
+  point_set(&corner_list[0] , offset[0] , offset[1] , offset[2] ); // Point 0
 
-  cell->corner_list[1] = cell->corner_list[0];                       // Point 1
-  point_shift(&cell->corner_list[1] , ivec[0] , ivec[1] , ivec[2]);
+  corner_list[1] = corner_list[0];                       // Point 1
+  point_shift(&corner_list[1] , ivec[0] , ivec[1] , ivec[2]);
 
-  cell->corner_list[2] = cell->corner_list[0];                       // Point 2
-  point_shift(&cell->corner_list[2] , jvec[0] , jvec[1] , jvec[2]);
+  corner_list[2] = corner_list[0];                       // Point 2
+  point_shift(&corner_list[2] , jvec[0] , jvec[1] , jvec[2]);
 
-  cell->corner_list[3] = cell->corner_list[1];                       // Point 3
-  point_shift(&cell->corner_list[3] , jvec[0] , jvec[1] , jvec[2]);
+  corner_list[3] = corner_list[1];                       // Point 3
+  point_shift(&corner_list[3] , jvec[0] , jvec[1] , jvec[2]);
 
   {
     int i;
     for (i=0; i < 4; i++) {
-      cell->corner_list[i+4] = cell->corner_list[i];                      // Point 4-7
-      point_shift(&cell->corner_list[i+4] , kvec[0] , kvec[1] , kvec[2]);
+      corner_list[i+4] = corner_list[i];                      // Point 4-7
+      point_shift(&corner_list[i+4] , kvec[0] , kvec[1] , kvec[2]);
     }
   }
 
@@ -1431,6 +1425,266 @@ static ecl_cell_type * ecl_grid_get_cell(const ecl_grid_type * grid , int global
 }
 
 
+/*****************************************************************/
+/* Cell geometry */
+
+/*
+  Will fill the corner_list argument with the eight corners of the
+  cell. For corner point grids the corners are calculated from the
+  pillars and the zcorn data with exactly the same arithmetic as was
+  used when the corners were stored in the cells, i.e. the values are
+  bitwise identical.
+*/
+
+static void ecl_grid_get_cell_corners( const ecl_grid_type * grid , int global_index , point_type * corner_list) {
+  if (grid->zcorn) {
+    const int nx = grid->nx;
+    const int ny = grid->ny;
+    const int k  = global_index / (nx * ny);
+    const int j  = (global_index - k * nx * ny) / nx;
+    const int i  = global_index - k * nx * ny - j * nx;
+    const int zcorn_offset = k*8*nx*ny + j*4*nx + 2*i;
+    int ip , iz;
+
+    for (ip = 0; ip < 4; ip++) {
+      const int di = ip % 2;
+      const int dj = ip / 2;
+      const double * pillar = &grid->pillars[ 6 * ((j + dj) * (nx + 1) + i + di) ];
+
+      for (iz = 0; iz < 2; iz++) {
+        point_type * p = &corner_list[ip + 4*iz];
+        double z = grid->zcorn[ zcorn_offset + dj*2*nx + di + iz*4*nx*ny ];
+
+        if (pillar[5] != 0) {
+          double t = (z - pillar[2]) / pillar[5];
+          point_set( p , pillar[0] + t * pillar[3] , pillar[1] + t * pillar[4] , z );
+        } else
+          point_set( p , pillar[0] , pillar[1] , z );
+
+        if (grid->use_mapaxes)
+          point_mapaxes_transform( p , grid->origo , grid->unit_x , grid->unit_y );
+      }
+    }
+  } else {
+    const int offset = 8 * global_index;
+    int c;
+    for (c = 0; c < 8; c++)
+      point_set( &corner_list[c] , grid->corner_x[offset + c] , grid->corner_y[offset + c] , grid->corner_z[offset + c]);
+  }
+}
+
+
+/*
+  Only the z values of the corners; for corner point grids this is a
+  plain lookup in the zcorn data.
+*/
+
+static void ecl_grid_get_cell_corners_z( const ecl_grid_type * grid , int global_index , double * z) {
+  if (grid->zcorn) {
+    const int nx = grid->nx;
+    const int ny = grid->ny;
+    const int k  = global_index / (nx * ny);
+    const int j  = (global_index - k * nx * ny) / nx;
+    const int i  = global_index - k * nx * ny - j * nx;
+    const int zcorn_offset = k*8*nx*ny + j*4*nx + 2*i;
+    int c;
+
+    for (c = 0; c < 8; c++)
+      z[c] = grid->zcorn[ zcorn_offset + ((c % 4) / 2)*2*nx + (c % 2) + (c / 4)*4*nx*ny ];
+  } else
+    memcpy( z , &grid->corner_z[ 8 * global_index ] , 8 * sizeof * z );
+}
+
+
+static void ecl_grid_get_cell_center( const ecl_grid_type * grid , int global_index , point_type * center) {
+  point_type corner_list[8];
+  ecl_grid_get_cell_corners( grid , global_index , corner_list );
+  ecl_cell_get_center( corner_list , center );
+}
+
+
+static void ecl_grid_set_cell_corners( ecl_grid_type * grid , int global_index , const point_type * corner_list) {
+  const int offset = 8 * global_index;
+  int c;
+
+  if (grid->zcorn)
+    util_abort("%s: internal error - the corners of a corner point grid can not be set explicitly\n",__func__);
+
+  for (c = 0; c < 8; c++) {
+    grid->corner_x[offset + c] = corner_list[c].x;
+    grid->corner_y[offset + c] = corner_list[c].y;
+    grid->corner_z[offset + c] = corner_list[c].z;
+  }
+}
+
+
+static bool ecl_grid_alloc_corners( ecl_grid_type * grid ) {
+  grid->corner_x = calloc( 8 * (size_t) grid->size , sizeof * grid->corner_x );
+  grid->corner_y = calloc( 8 * (size_t) grid->size , sizeof * grid->corner_y );
+  grid->corner_z = calloc( 8 * (size_t) grid->size , sizeof * grid->corner_z );
+
+  if (grid->corner_x && grid->corner_y && grid->corner_z)
+    return true;
+  else
+    return false;
+}
+
+
+/*
+  Installs the zcorn data and the pillars from the coord data for a
+  corner point grid; the zcorn data is copied verbatim, whereas the
+  pillars are stored as the top point and the direction vector in
+  double precision.
+*/
+
+static bool ecl_grid_init_pillars( ecl_grid_type * grid , const float * zcorn , const float * coord ) {
+  const int num_pillars = (grid->nx + 1) * (grid->ny + 1);
+
+  grid->zcorn = malloc( 8 * (size_t) grid->size * sizeof * grid->zcorn );
+  grid->pillars = malloc( 6 * (size_t) num_pillars * sizeof * grid->pillars );
+  if (!(grid->zcorn && grid->pillars))
+    return false;
+
+  memcpy( grid->zcorn , zcorn , 8 * (size_t) grid->size * sizeof * grid->zcorn );
+  {
+    int ip;
+    for (ip = 0; ip < num_pillars; ip++) {
+      const float * coord_pillar = &coord[6*ip];
+      double * pillar = &grid->pillars[6*ip];
+
+      pillar[0] = coord_pillar[0];
+      pillar[1] = coord_pillar[1];
+      pillar[2] = coord_pillar[2];
+
+      pillar[3] = (double) coord_pillar[3] - pillar[0];
+      pillar[4] = (double) coord_pillar[4] - pillar[1];
+      pillar[5] = (double) coord_pillar[5] - pillar[2];
+    }
+  }
+  return true;
+}
+
+
+static void ecl_grid_copy_geometry( ecl_grid_type * target_grid , const ecl_grid_type * src_grid ) {
+  const size_t corner_size = 8 * (size_t) src_grid->size;
+
+  if (src_grid->zcorn) {
+    const size_t pillar_size = 6 * (size_t) (src_grid->nx + 1) * (src_grid->ny + 1);
+    target_grid->zcorn   = util_alloc_copy( src_grid->zcorn , corner_size * sizeof * src_grid->zcorn );
+    target_grid->pillars = util_alloc_copy( src_grid->pillars , pillar_size * sizeof * src_grid->pillars );
+  } else {
+    memcpy( target_grid->corner_x , src_grid->corner_x , corner_size * sizeof * src_grid->corner_x );
+    memcpy( target_grid->corner_y , src_grid->corner_y , corner_size * sizeof * src_grid->corner_y );
+    memcpy( target_grid->corner_z , src_grid->corner_z , corner_size * sizeof * src_grid->corner_z );
+  }
+}
+
+
+/*****************************************************************/
+/* Side tables */
+
+static int * ecl_grid_alloc_int_table( const ecl_grid_type * grid , int default_value ) {
+  int * table = util_malloc( grid->size * sizeof * table );
+  int i;
+  for (i=0; i < grid->size; i++)
+    table[i] = default_value;
+  return table;
+}
+
+
+static int ecl_grid_get_cell_host( const ecl_grid_type * grid , int global_index ) {
+  if (grid->host_cell)
+    return grid->host_cell[global_index];
+  else
+    return HOST_CELL_NONE;
+}
+
+
+static void ecl_grid_set_cell_host( ecl_grid_type * grid , int global_index , int host_cell ) {
+  if (!grid->host_cell) {
+    if (host_cell == HOST_CELL_NONE)
+      return;
+    grid->host_cell = ecl_grid_alloc_int_table( grid , HOST_CELL_NONE );
+  }
+  grid->host_cell[global_index] = host_cell;
+}
+
+
+static int ecl_grid_get_cell_coarse_group( const ecl_grid_type * grid , int global_index ) {
+  if (grid->coarse_group)
+    return grid->coarse_group[global_index];
+  else
+    return COARSE_GROUP_NONE;
+}
+
+
+static void ecl_grid_set_cell_coarse_group( ecl_grid_type * grid , int global_index , int coarse_group ) {
+  if (!grid->coarse_group) {
+    if (coarse_group == COARSE_GROUP_NONE)
+      return;
+    grid->coarse_group = ecl_grid_alloc_int_table( grid , COARSE_GROUP_NONE );
+  }
+  grid->coarse_group[global_index] = coarse_group;
+}
+
+
+static void ecl_grid_install_cell_lgr( ecl_grid_type * grid , int global_index , const ecl_grid_type * lgr_grid) {
+  if (!grid->cell_lgr) {
+    int i;
+    grid->cell_lgr = util_calloc( grid->size , sizeof * grid->cell_lgr );
+    for (i=0; i < grid->size; i++)
+      grid->cell_lgr[i] = NULL;
+  }
+  grid->cell_lgr[global_index] = lgr_grid;
+}
+
+
+static nnc_info_type * ecl_grid_get_cell_nnc_info__( const ecl_grid_type * grid , int global_index ) {
+  if (grid->nnc_info)
+    return grid->nnc_info[global_index];
+  else
+    return NULL;
+}
+
+
+static nnc_info_type * ecl_grid_get_or_create_cell_nnc_info( ecl_grid_type * grid , int global_index ) {
+  if (!grid->nnc_info) {
+    int i;
+    grid->nnc_info = util_calloc( grid->size , sizeof * grid->nnc_info );
+    for (i=0; i < grid->size; i++)
+      grid->nnc_info[i] = NULL;
+  }
+
+  if (!grid->nnc_info[global_index])
+    grid->nnc_info[global_index] = nnc_info_alloc( grid->lgr_nr );
+
+  return grid->nnc_info[global_index];
+}
+
+
+static void ecl_grid_copy_side_tables( ecl_grid_type * target_grid , const ecl_grid_type * src_grid ) {
+  if (src_grid->host_cell)
+    target_grid->host_cell = util_alloc_copy( src_grid->host_cell , src_grid->size * sizeof * src_grid->host_cell );
+
+  if (src_grid->coarse_group)
+    target_grid->coarse_group = util_alloc_copy( src_grid->coarse_group , src_grid->size * sizeof * src_grid->coarse_group );
+
+  if (src_grid->nnc_info) {
+    int i;
+    target_grid->nnc_info = util_calloc( src_grid->size , sizeof * target_grid->nnc_info );
+    for (i=0; i < src_grid->size; i++) {
+      if (src_grid->nnc_info[i])
+        target_grid->nnc_info[i] = nnc_info_alloc_copy( src_grid->nnc_info[i] );
+      else
+        target_grid->nnc_info[i] = NULL;
+    }
+  }
+  /* The cell_lgr table is established when the lgrs are installed. */
+}
+
+/*****************************************************************/
+
+
 /**
    this function uses heuristics (ahhh - i hate it) in an attempt to
    mark cells with fucked geometry - see further comments in the
@@ -1439,24 +1693,35 @@ static ecl_cell_type * ecl_grid_get_cell(const ecl_grid_type * grid , int global
 
 static void ecl_grid_taint_cells( ecl_grid_type * ecl_grid ) {
   int index;
+#pragma omp parallel for
   for (index = 0; index < ecl_grid->size; index++) {
     ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , index );
-    ecl_cell_taint_cell( cell );
+    point_type corner_list[8];
+
+    ecl_grid_get_cell_corners( ecl_grid , index , corner_list );
+    ecl_cell_taint_cell( cell , corner_list );
   }
 }
 
 
 static void ecl_grid_free_cells( ecl_grid_type * grid ) {
-  if (!grid->cells)
-    return;
-
-  for (int i=0; i < grid->size; i++) {
-    ecl_cell_type * cell = ecl_grid_get_cell( grid , i );
-    if (cell->nnc_info)
-      nnc_info_free(cell->nnc_info);
+  if (grid->nnc_info) {
+    for (int i=0; i < grid->size; i++) {
+      if (grid->nnc_info[i])
+        nnc_info_free(grid->nnc_info[i]);
+    }
+    free( grid->nnc_info );
   }
-  free( grid->cells );
 
+  free( grid->cells );
+  free( grid->zcorn );
+  free( grid->pillars );
+  free( grid->corner_x );
+  free( grid->corner_y );
+  free( grid->corner_z );
+  free( grid->host_cell );
+  free( grid->coarse_group );
+  free( grid->cell_lgr );
 }
 
 static bool ecl_grid_alloc_cells( ecl_grid_type * grid , bool init_valid) {
@@ -1486,7 +1751,7 @@ static bool ecl_grid_alloc_cells( ecl_grid_type * grid , bool init_valid) {
    is performed.
 */
 
-static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int dualp_flag , int nx , int ny , int nz, int lgr_nr, bool init_valid) {
+static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int dualp_flag , int nx , int ny , int nz, int lgr_nr, bool init_valid, bool explicit_corners) {
   ecl_grid_type * grid = util_malloc(sizeof * grid );
   UTIL_TYPE_ID_INIT(grid , ECL_GRID_ID);
   grid->total_active   = 0;
@@ -1509,6 +1774,17 @@ static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int du
   grid->inv_fracture_index_map = NULL;
   grid->unit_system            = ERT_ECL_METRIC_UNITS;
 
+  grid->cells                  = NULL;
+  grid->zcorn                  = NULL;
+  grid->pillars                = NULL;
+  grid->corner_x               = NULL;
+  grid->corner_y               = NULL;
+  grid->corner_z               = NULL;
+  grid->host_cell              = NULL;
+  grid->coarse_group           = NULL;
+  grid->cell_lgr               = NULL;
+  grid->nnc_info               = NULL;
+
 
   if (global_grid != NULL) {
     /*
@@ -1552,10 +1828,20 @@ static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int du
   grid->coarse_cells    = vector_alloc_new();
   grid->eclipse_version = 0;
 
-  /* This is the large allocation - which can potentially fail. */
-  if (!ecl_grid_alloc_cells( grid , init_valid )) {
-    ecl_grid_free( grid );
-    grid = NULL;
+  /*
+     These are the large allocations - which can potentially fail. For
+     corner point grids the geometry is allocated when the zcorn and
+     coord data is installed.
+  */
+  {
+    bool alloc_ok = ecl_grid_alloc_cells( grid , init_valid );
+    if (alloc_ok && explicit_corners)
+      alloc_ok = ecl_grid_alloc_corners( grid );
+
+    if (!alloc_ok) {
+      ecl_grid_free( grid );
+      grid = NULL;
+    }
   }
   return grid;
 }
@@ -1568,43 +1854,6 @@ static  int ecl_grid_get_global_index__(const ecl_grid_type * ecl_grid , int i ,
 }
 
 
-static void ecl_grid_set_cell_EGRID(ecl_grid_type * ecl_grid , int i, int j , int k ,
-                                    double x[4][2] , double y[4][2] , double z[4][2] ,
-                                    const int * actnum, const int * corsnum) {
-
-  const int global_index   = ecl_grid_get_global_index__(ecl_grid , i , j  , k );
-  ecl_cell_type * cell     = ecl_grid_get_cell( ecl_grid , global_index );
-  int ip , iz;
-
-  for (iz = 0; iz < 2; iz++) {
-    for (ip = 0; ip < 4; ip++) {
-      int c = ip + iz * 4;
-      point_set(&cell->corner_list[c] , x[ip][iz] , y[ip][iz] , z[ip][iz]);
-
-      if (ecl_grid->use_mapaxes)
-        point_mapaxes_transform( &cell->corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
-    }
-  }
-
-
-
-
-  /*
-    If actnum == NULL that is taken to mean active.
-
-    for normal runs actnum will be 1 for active cells,
-    for dual porosity models it can also be 2 and 3.
-  */
-  if (actnum == NULL)
-    cell->active = CELL_ACTIVE;
-  else
-    cell->active = actnum[global_index];
-
-  if (corsnum != NULL)
-    cell->coarse_group = corsnum[ global_index ] - 1;
-}
-
-
 static void ecl_grid_set_cell_GRID(ecl_grid_type * ecl_grid , int coords_size , const int * coords , const float * corners) {
 
   const int i  = coords[0] - 1; /* eclipse 1 offset */
@@ -1675,9 +1924,9 @@ static void ecl_grid_set_cell_GRID(ecl_grid_type * ecl_grid , int coords_size ,
       break;
     case 7:
       cell->active      += coords[4] * active_value;
-      cell->host_cell    = coords[5] - 1;
-      cell->coarse_group = coords[6] - 1;
-      if (cell->coarse_group >= 0)
+      ecl_grid_set_cell_host( ecl_grid , global_index , coords[5] - 1);
+      ecl_grid_set_cell_coarse_group( ecl_grid , global_index , coords[6] - 1);
+      if (coords[6] > 0)
         ecl_grid->coarsening_active = true;
       break;
     default:
@@ -1685,13 +1934,15 @@ static void ecl_grid_set_cell_GRID(ecl_grid_type * ecl_grid , int coords_size ,
     }
 
     if (matrix_cell) {
+      point_type corner_list[8];
       for (c = 0; c < 8; c++) {
-        point_set(&cell->corner_list[c] , corners[3*c] , corners[3*c + 1] , corners[3*c + 2]);
+        point_set(&corner_list[c] , corners[3*c] , corners[3*c + 1] , corners[3*c + 2]);
 
         if (ecl_grid->use_mapaxes)
-          point_mapaxes_transform( &cell->corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
+          point_mapaxes_transform( &corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
 
       }
+      ecl_grid_set_cell_corners( ecl_grid , global_index , corner_list );
     }
   }
   SET_CELL_FLAG(cell , CELL_FLAG_VALID );
@@ -1712,7 +1963,7 @@ static void ecl_grid_init_index_map__( ecl_grid_type * ecl_grid , int * index_ma
     if (cell->active & active_mask) {
       index_map[global_index] = cell->active_index[type_index];
 
-      if (cell->coarse_group == COARSE_GROUP_NONE)
+      if (ecl_grid_get_cell_coarse_group( ecl_grid , global_index ) == COARSE_GROUP_NONE)
         inv_index_map[cell->active_index[type_index]] = global_index;
       //else: In the case of coarse groups the inv_index_map is set below.
     } else
@@ -1823,7 +2074,8 @@ static void ecl_grid_set_active_index(ecl_grid_type * ecl_grid) {
     for (global_index = 0; global_index < ecl_grid->size; global_index++) {
       ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index);
       if (cell->active != CELL_NOT_ACTIVE) {
-        if (cell->coarse_group == COARSE_GROUP_NONE) {
+        int coarse_group = ecl_grid_get_cell_coarse_group( ecl_grid , global_index );
+        if (coarse_group == COARSE_GROUP_NONE) {
 
           if (cell->active & CELL_ACTIVE_MATRIX) {
             cell->active_index[MATRIX_INDEX] = active_index;
@@ -1836,7 +2088,7 @@ static void ecl_grid_set_active_index(ecl_grid_type * ecl_grid) {
           }
 
         } else {
-          ecl_coarse_cell_type * coarse_cell = ecl_grid_iget_coarse_group( ecl_grid , cell->coarse_group );
+          ecl_coarse_cell_type * coarse_cell = ecl_grid_iget_coarse_group( ecl_grid , coarse_group );
           ecl_coarse_cell_update_index( coarse_cell , global_index , &active_index , &active_fracture_index , cell->active);
         }
       }
@@ -1905,9 +2157,9 @@ static void ecl_grid_init_coarse_cells( ecl_grid_type * ecl_grid ) {
   if (ecl_grid->coarsening_active) {
     int global_index;
     for (global_index = 0; global_index < ecl_grid->size; global_index++) {
-      ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-      if (cell->coarse_group != COARSE_GROUP_NONE) {
-        ecl_coarse_cell_type * coarse_cell = ecl_grid_get_or_create_coarse_cell( ecl_grid , cell->coarse_group);
+      int coarse_group = ecl_grid_get_cell_coarse_group( ecl_grid , global_index );
+      if (coarse_group != COARSE_GROUP_NONE) {
+        ecl_coarse_cell_type * coarse_cell = ecl_grid_get_or_create_coarse_cell( ecl_grid , coarse_group);
         int i,j,k;
         ecl_grid_get_ijk1( ecl_grid , global_index , &i , &j , &k);
         ecl_coarse_cell_update( coarse_cell , i , j , k , global_index );
@@ -1923,11 +2175,11 @@ ecl_coarse_cell_type * ecl_grid_iget_coarse_group( const ecl_grid_type * ecl_gri
 
 
 ecl_coarse_cell_type * ecl_grid_get_cell_coarse_group1( const ecl_grid_type * ecl_grid , int global_index) {
-  ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-  if (cell->coarse_group == COARSE_GROUP_NONE)
+  int coarse_group = ecl_grid_get_cell_coarse_group( ecl_grid , global_index );
+  if (coarse_group == COARSE_GROUP_NONE)
     return NULL;
   else
-    return ecl_grid_iget_coarse_group( ecl_grid , cell->coarse_group );
+    return ecl_grid_iget_coarse_group( ecl_grid , coarse_group );
 }
 
 
@@ -1938,8 +2190,7 @@ ecl_coarse_cell_type * ecl_grid_get_cell_coarse_group3( const ecl_grid_type * ec
 
 
 bool ecl_grid_cell_in_coarse_group1( const ecl_grid_type * main_grid , int global_index ) {
-  ecl_cell_type * cell = ecl_grid_get_cell( main_grid , global_index );
-  if (cell->coarse_group == COARSE_GROUP_NONE )
+  if (ecl_grid_get_cell_coarse_group( main_grid , global_index ) == COARSE_GROUP_NONE )
     return false;
   else
     return true;
@@ -1953,25 +2204,6 @@ bool ecl_grid_cell_in_coarse_group3( const ecl_grid_type * main_grid , int i , i
 
 /*****************************************************************/
 
-static void ecl_grid_pillar_cross_planes(const point_type * p0,
-                                         double e_x , double e_y , double e_z ,
-                                         const double *z , double *x , double *y) {
-  int k;
-  if (e_z != 0) {
-    for (k=0; k < 2; k++) {
-      double t = (z[k] -  p0->z) / e_z;
-      x[k] = p0->x + t * e_x;
-      y[k] = p0->y + t * e_y;
-    }
-  } else {
-    for (k=0; k < 2; k++) {
-      x[k] = p0->x;
-      y[k] = p0->y;
-    }
-  }
-}
-
-
 /**
    This function must be run before the cell coordinates are
    calculated.  This function is only called for the main grid
@@ -2037,7 +2269,7 @@ static void ecl_grid_init_mapaxes( ecl_grid_type * ecl_grid , bool apply_mapaxes
     observe that this is in principle somewhat different from the
     install functions below; here the lgr is added to the top level
     grid (i.e. the main grid) which has the storage responsability of
-    all the lgr instances. the cell->lgr relationship is established
+    all the lgr instances. the cell -> lgr relationship is established
     in the _install_egrid / install_grid functions further down.
 */
 
@@ -2069,11 +2301,9 @@ static void ecl_grid_install_lgr_EGRID(ecl_grid_type * host_grid , ecl_grid_type
 
   for (global_lgr_index = 0; global_lgr_index < lgr_grid->size; global_lgr_index++) {
     int host_index = hostnum[ global_lgr_index ] - 1;
-    ecl_cell_type * lgr_cell  = ecl_grid_get_cell( lgr_grid , global_lgr_index);
-    ecl_cell_type * host_cell = ecl_grid_get_cell( host_grid ,  host_index );
 
-    ecl_cell_install_lgr( host_cell , lgr_grid );
-    lgr_cell->host_cell = host_index;
+    ecl_grid_install_cell_lgr( host_grid , host_index , lgr_grid );
+    ecl_grid_set_cell_host( lgr_grid , global_lgr_index , host_index );
   }
   ecl_grid_install_lgr_common( host_grid , lgr_grid );
 }
@@ -2086,9 +2316,8 @@ static void ecl_grid_install_lgr_GRID(ecl_grid_type * host_grid , ecl_grid_type
   int global_lgr_index;
 
   for (global_lgr_index = 0; global_lgr_index < lgr_grid->size; global_lgr_index++) {
-    ecl_cell_type * lgr_cell = ecl_grid_get_cell( lgr_grid , global_lgr_index);
-    ecl_cell_type * host_cell = ecl_grid_get_cell( host_grid , lgr_cell->host_cell );
-    ecl_cell_install_lgr( host_cell , lgr_grid );
+    int host_index = ecl_grid_get_cell_host( lgr_grid , global_lgr_index );
+    ecl_grid_install_cell_lgr( host_grid , host_index , lgr_grid );
   }
   ecl_grid_install_lgr_common( host_grid , lgr_grid );
 }
@@ -2174,82 +2403,35 @@ int ecl_grid_zcorn_index(const ecl_grid_type * grid , int i, int j , int k , int
 
 
 
-static void ecl_grid_init_GRDECL_data_jslice(ecl_grid_type * ecl_grid ,  const float * zcorn , const float * coord , const int * actnum, const int * corsnum , int j) {
-  const int nx = ecl_grid->nx;
-  const int ny = ecl_grid->ny;
-  const int nz = ecl_grid->nz;
-  int i;
-
-
-  for (i=0; i < nx; i++) {
-    point_type pillars[4][2];
-    int pillar_index[4];
-    pillar_index[0] = 6 * ( j      * (nx + 1) + i    );
-    pillar_index[1] = 6 * ( j      * (nx + 1) + i + 1);
-    pillar_index[2] = 6 * ((j + 1) * (nx + 1) + i    );
-    pillar_index[3] = 6 * ((j + 1) * (nx + 1) + i + 1);
-
-    {
-      int ip;
-      for (ip = 0; ip < 4; ip++) {
-        int index = pillar_index[ip];
-        point_set(&pillars[ip][0] , coord[index] , coord[index + 1] , coord[index + 2]);
-
-        index += 3;
-        point_set(&pillars[ip][1] , coord[index] , coord[index + 1] , coord[index + 2]);
-      }
-    }
-
-    {
-      double ex[4];
-      double ey[4];
-      double ez[4];
-      int k;
-
-      {
-        int ip;
-        for (ip = 0; ip <  4; ip++) {
-          ex[ip] = pillars[ip][1].x - pillars[ip][0].x;
-          ey[ip] = pillars[ip][1].y - pillars[ip][0].y;
-          ez[ip] = pillars[ip][1].z - pillars[ip][0].z;
-        }
-      }
+/*
+  Installs the geometry of a corner point grid, and sets the active
+  and coarse group properties of the cells. The cell corners are not
+  calculated here; they are calculated from the zcorn and coord data
+  when needed, see ecl_grid_get_cell_corners().
+
+  If actnum == NULL that is taken to mean active. For normal runs
+  actnum will be 1 for active cells, for dual porosity models it can
+  also be 2 and 3.
+*/
 
+static bool ecl_grid_init_GRDECL_data(ecl_grid_type * ecl_grid ,  const float * zcorn , const float * coord , const int * actnum, const int * corsnum) {
+  int global_index;
 
-      for (k=0; k < nz; k++) {
-        double x[4][2];
-        double y[4][2];
-        double z[4][2];
+  if (!ecl_grid_init_pillars( ecl_grid , zcorn , coord ))
+    return false;
 
-        {
-          int c;
-          for (c = 0; c < 2; c++) {
-            z[0][c] = zcorn[k*8*nx*ny + j*4*nx + 2*i            + c*4*nx*ny];
-            z[1][c] = zcorn[k*8*nx*ny + j*4*nx + 2*i  +  1      + c*4*nx*ny];
-            z[2][c] = zcorn[k*8*nx*ny + j*4*nx + 2*nx + 2*i     + c*4*nx*ny];
-            z[3][c] = zcorn[k*8*nx*ny + j*4*nx + 2*nx + 2*i + 1 + c*4*nx*ny];
-          }
-        }
+  for (global_index = 0; global_index < ecl_grid->size; global_index++) {
+    ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
 
-        {
-          int ip;
-          for (ip = 0; ip <  4; ip++)
-            ecl_grid_pillar_cross_planes(&pillars[ip][0] , ex[ip], ey[ip] , ez[ip] , z[ip] , x[ip] , y[ip]);
-        }
+    if (actnum == NULL)
+      cell->active = CELL_ACTIVE;
+    else
+      cell->active = actnum[global_index];
 
-        ecl_grid_set_cell_EGRID(ecl_grid , i , j , k , x , y , z , actnum , corsnum);
-      }
-    }
+    if (corsnum != NULL)
+      ecl_grid_set_cell_coarse_group( ecl_grid , global_index , corsnum[ global_index ] - 1);
   }
-}
-
-
-void ecl_grid_init_GRDECL_data(ecl_grid_type * ecl_grid ,  const float * zcorn , const float * coord , const int * actnum, const int * corsnum) {
-  const int ny = ecl_grid->ny;
-  int j;
-#pragma omp parallel for
-  for ( j=0; j < ny; j++)
-    ecl_grid_init_GRDECL_data_jslice( ecl_grid , zcorn, coord , actnum , corsnum , j );
+  return true;
 }
 
 
@@ -2265,7 +2447,7 @@ static ecl_grid_type * ecl_grid_alloc_GRDECL_data__(ecl_grid_type * global_grid
                                                     const float * zcorn , const float * coord , const int * actnum, const float * mapaxes, const int * corsnum,
                                                     int lgr_nr) {
 
-  ecl_grid_type * ecl_grid = ecl_grid_alloc_empty(global_grid , dualp_flag , nx,ny,nz,lgr_nr,true);
+  ecl_grid_type * ecl_grid = ecl_grid_alloc_empty(global_grid , dualp_flag , nx,ny,nz,lgr_nr,true,false);
   if (ecl_grid) {
     if (mapaxes != NULL)
       ecl_grid_init_mapaxes( ecl_grid , apply_mapaxes, mapaxes );
@@ -2274,7 +2456,10 @@ static ecl_grid_type * ecl_grid_alloc_GRDECL_data__(ecl_grid_type * global_grid
       ecl_grid->coarsening_active = true;
 
     ecl_grid->coord_kw = ecl_kw_alloc_new("COORD" , 6*(nx + 1) * (ny + 1) , ECL_FLOAT_TYPE , coord );
-    ecl_grid_init_GRDECL_data( ecl_grid , zcorn , coord , actnum , corsnum);
+    if (!ecl_grid_init_GRDECL_data( ecl_grid , zcorn , coord , actnum , corsnum)) {
+      ecl_grid_free( ecl_grid );
+      return NULL;
+    }
 
     ecl_grid_init_coarse_cells( ecl_grid );
     ecl_grid_update_index( ecl_grid );
@@ -2306,9 +2491,9 @@ static void ecl_grid_copy_content( ecl_grid_type * target_grid , const ecl_grid_
     const ecl_cell_type * src_cell = ecl_grid_get_cell( src_grid , global_index );
 
     ecl_cell_memcpy( target_cell , src_cell );
-    if (src_cell->nnc_info)
-      target_cell->nnc_info = nnc_info_alloc_copy( src_cell->nnc_info );
   }
+  ecl_grid_copy_geometry( target_grid , src_grid );
+  ecl_grid_copy_side_tables( target_grid , src_grid );
   ecl_grid_copy_mapaxes( target_grid , src_grid );
 
   target_grid->parent_name = util_alloc_string_copy( src_grid->parent_name );
@@ -2325,7 +2510,8 @@ static ecl_grid_type * ecl_grid_alloc_copy__( const ecl_grid_type * src_grid,  e
                                                     ecl_grid_get_ny( src_grid ) ,
                                                     ecl_grid_get_nz( src_grid ) ,
                                                     0 ,
-                                                    false );
+                                                    false ,
+                                                    src_grid->zcorn == NULL );
   if (copy_grid) {
     ecl_grid_copy_content( copy_grid , src_grid );  // This will handle everything except LGR relationships which is established in the calling routine
     ecl_grid_update_index( copy_grid );
@@ -2356,10 +2542,8 @@ ecl_grid_type * ecl_grid_alloc_copy( const ecl_grid_type * src_grid ) {
         int global_lgr_index;
 
         for (global_lgr_index = 0; global_lgr_index < copy_lgr->size; global_lgr_index++) {
-          ecl_cell_type * lgr_cell  = ecl_grid_get_cell( copy_lgr , global_lgr_index);
-          ecl_cell_type * host_cell = ecl_grid_get_cell( host_grid , lgr_cell->host_cell );
-
-          ecl_cell_install_lgr( host_cell , copy_lgr );
+          int host_index = ecl_grid_get_cell_host( copy_lgr , global_lgr_index );
+          ecl_grid_install_cell_lgr( host_grid , host_index , copy_lgr );
         }
         ecl_grid_install_lgr_common( host_grid , copy_lgr );
 
@@ -2521,13 +2705,6 @@ ecl_grid_type * ecl_grid_alloc_GRDECL_kw( int nx, int ny , int nz ,
 
 
 
-static void ecl_grid_init_cell_nnc_info(ecl_grid_type * ecl_grid, int global_index) {
-  ecl_cell_type * grid_cell = ecl_grid_get_cell(ecl_grid, global_index);
-
-  if (!grid_cell->nnc_info)
-    grid_cell->nnc_info = nnc_info_alloc(ecl_grid->lgr_nr);
-}
-
 /*
   The function ecl_grid_add_self_nnc() will add a NNC connection
   between two cells in the same grid. Observe that there are two
@@ -2572,9 +2749,8 @@ static void ecl_grid_init_cell_nnc_info(ecl_grid_type * ecl_grid, int global_ind
 */
 
 void ecl_grid_add_self_nnc( ecl_grid_type * grid, int cell_index1, int cell_index2, int nnc_index) {
-  ecl_cell_type * grid_cell = ecl_grid_get_cell(grid, cell_index1);
-  ecl_grid_init_cell_nnc_info(grid, cell_index1);
-  nnc_info_add_nnc(grid_cell->nnc_info, grid->lgr_nr, cell_index2, nnc_index);
+  nnc_info_type * nnc_info = ecl_grid_get_or_create_cell_nnc_info(grid, cell_index1);
+  nnc_info_add_nnc(nnc_info, grid->lgr_nr, cell_index2, nnc_index);
 }
 
 /*
@@ -2636,9 +2812,8 @@ static void ecl_grid_init_nnc_cells( ecl_grid_type * grid1, ecl_grid_type * grid
 
 
     {
-      ecl_cell_type * grid1_cell = ecl_grid_get_cell(grid1, grid1_cell_index);
-      ecl_grid_init_cell_nnc_info(grid1, grid1_cell_index);
-      nnc_info_add_nnc(grid1_cell->nnc_info, grid2->lgr_nr, grid2_cell_index , nnc_index);
+      nnc_info_type * nnc_info = ecl_grid_get_or_create_cell_nnc_info(grid1, grid1_cell_index);
+      nnc_info_add_nnc(nnc_info, grid2->lgr_nr, grid2_cell_index , nnc_index);
     }
   }
 }
@@ -2824,7 +2999,7 @@ static ecl_grid_type * ecl_grid_alloc_GRID_data__(ecl_grid_type * global_grid ,
   if (dualp_flag != FILEHEAD_SINGLE_POROSITY)
     nz = nz / 2;
   {
-    ecl_grid_type * grid = ecl_grid_alloc_empty( global_grid , dualp_flag , nx , ny , nz , grid_nr, false);
+    ecl_grid_type * grid = ecl_grid_alloc_empty( global_grid , dualp_flag , nx , ny , nz , grid_nr, false, true);
     if (grid) {
       if (mapaxes != NULL)
         ecl_grid_init_mapaxes( grid , apply_mapaxes , mapaxes);
@@ -3063,7 +3238,7 @@ ecl_grid_type * ecl_grid_alloc_GRID(const char * grid_file, bool apply_mapaxes)
    which case all cells will be active.
 */
 ecl_grid_type * ecl_grid_alloc_regular( int nx, int ny , int nz , const double * ivec, const double * jvec , const double * kvec , const int * actnum) {
-  ecl_grid_type * grid = ecl_grid_alloc_empty(NULL , FILEHEAD_SINGLE_POROSITY , nx , ny , nz , 0, true);
+  ecl_grid_type * grid = ecl_grid_alloc_empty(NULL , FILEHEAD_SINGLE_POROSITY , nx , ny , nz , 0, true, true);
   if (grid) {
     const double grid_offset[3] = {0,0,0};
 
@@ -3079,7 +3254,9 @@ ecl_grid_type * ecl_grid_alloc_regular( int nx, int ny , int nz , const double *
           };
 
           ecl_cell_type * cell = ecl_grid_get_cell(grid , global_index );
-          ecl_cell_init_regular( cell , offset , i,j,k,global_index , ivec , jvec , kvec , actnum );
+          point_type corner_list[8];
+          ecl_cell_init_regular( cell , corner_list , offset , i,j,k,global_index , ivec , jvec , kvec , actnum );
+          ecl_grid_set_cell_corners( grid , global_index , corner_list );
         }
       }
     }
@@ -3123,7 +3300,8 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv( int nx, int ny , int nz , const doub
     ecl_grid_type* grid = ecl_grid_alloc_empty(NULL,
                                                FILEHEAD_SINGLE_POROSITY,
                                                nx, ny, nz,
-                                               /*lgr_nr=*/0, /*init_valid=*/true);
+                                               /*lgr_nr=*/0, /*init_valid=*/true,
+                                               /*explicit_corners=*/true);
     if (grid) {
       double ivec[3] = { 0, 0, 0 };
       double jvec[3] = { 0, 0, 0 };
@@ -3142,12 +3320,14 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv( int nx, int ny , int nz , const doub
           for (i=0; i < nx; i++) {
             int global_index = i + j*nx + k*nx*ny;
             ecl_cell_type* cell = ecl_grid_get_cell(grid, global_index);
+            point_type corner_list[8];
             ivec[0] = dxv[i];
 
-            ecl_cell_init_regular(cell, offset,
+            ecl_cell_init_regular(cell, corner_list, offset,
                                   i,j,k,global_index,
                                   ivec,jvec,kvec,
                                   actnum);
+            ecl_grid_set_cell_corners(grid, global_index, corner_list);
             offset[0] += dxv[i];
           }
           offset[1] += dyv[j];
@@ -3166,7 +3346,8 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv_depthz( int nx, int ny , int nz , con
     ecl_grid_type* grid = ecl_grid_alloc_empty(NULL,
                                                FILEHEAD_SINGLE_POROSITY,
                                                nx, ny, nz,
-                                               /*lgr_nr=*/0, /*init_valid=*/true);
+                                               /*lgr_nr=*/0, /*init_valid=*/true,
+                                               /*explicit_corners=*/true);
 
 
     /* First layer - where the DEPTHZ keyword applies. */
@@ -3178,24 +3359,25 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv_depthz( int nx, int ny , int nz , con
         double x0 = 0;
         for (i = 0; i < nx; i++) {
           int global_index = i + j*nx + k*nx*ny;
-          ecl_cell_type* cell = ecl_grid_get_cell(grid, global_index);
+          point_type corner_list[8];
           double z0 = depthz[ i     + j*(nx + 1)];
           double z1 = depthz[ i + 1 + j*(nx + 1)];
           double z2 = depthz[ i +     (j + 1)*(nx + 1)];
           double z3 = depthz[ i + 1 + (j + 1)*(nx + 1)];
 
 
-          point_set(&cell->corner_list[0] , x0 , y0 , z0);
-          point_set(&cell->corner_list[1] , x0 + dxv[i] , y0 , z1);
-          point_set(&cell->corner_list[2] , x0          , y0 + dyv[j] , z2);
-          point_set(&cell->corner_list[3] , x0 + dxv[i] , y0 + dyv[j] , z3);
+          point_set(&corner_list[0] , x0 , y0 , z0);
+          point_set(&corner_list[1] , x0 + dxv[i] , y0 , z1);
+          point_set(&corner_list[2] , x0          , y0 + dyv[j] , z2);
+          point_set(&corner_list[3] , x0 + dxv[i] , y0 + dyv[j] , z3);
           {
             int c;
             for (c = 0; c < 4; c++) {
-              cell->corner_list[c + 4] = cell->corner_list[c];
-              point_shift(&cell->corner_list[c + 4] , 0 , 0 , dzv[0]);
+              corner_list[c + 4] = corner_list[c];
+              point_shift(&corner_list[c + 4] , 0 , 0 , dzv[0]);
             }
           }
+          ecl_grid_set_cell_corners(grid, global_index, corner_list);
           x0 += dxv[i];
         }
         y0 += dyv[j];
@@ -3210,15 +3392,17 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv_depthz( int nx, int ny , int nz , con
           for (i=0; i < nx; i++) {
             int g2 = i + j*nx + k*nx*ny;
             int g1 = i + j*nx + (k - 1)*nx*ny;
-            ecl_cell_type* cell2 = ecl_grid_get_cell(grid, g2);
-            ecl_cell_type* cell1 = ecl_grid_get_cell(grid, g1);
+            point_type corners2[8];
+            point_type corners1[8];
             int c;
 
+            ecl_grid_get_cell_corners(grid, g1, corners1);
             for (c = 0; c < 4; c++) {
-              cell2->corner_list[c] = cell1->corner_list[c + 4];
-              cell2->corner_list[c + 4] = cell1->corner_list[c + 4];
-              point_shift( &cell2->corner_list[c + 4] , 0 , 0 , dzv[k]);
+              corners2[c] = corners1[c + 4];
+              corners2[c + 4] = corners1[c + 4];
+              point_shift( &corners2[c + 4] , 0 , 0 , dzv[k]);
             }
+            ecl_grid_set_cell_corners(grid, g2, corners2);
           }
         }
       }
@@ -3270,7 +3454,7 @@ ecl_grid_type * ecl_grid_alloc_dx_dy_dz_tops( int nx, int ny , int nz , const do
   ecl_grid_type* grid = ecl_grid_alloc_empty(NULL,
                                              FILEHEAD_SINGLE_POROSITY,
                                              nx, ny, nz,
-                                             0, true);
+                                             0, true, true);
   if (grid) {
     int i, j, k;
     double * y0 = util_calloc( nx, sizeof * y0 );
@@ -3284,17 +3468,19 @@ ecl_grid_type * ecl_grid_alloc_dx_dy_dz_tops( int nx, int ny , int nz , const do
         for (i=0; i < nx; i++) {
           int g = i + j*nx + k*nx*ny;
           ecl_cell_type* cell = ecl_grid_get_cell(grid, g);
+          point_type corner_list[8];
           double z0 = tops[ g ];
 
-          point_set(&cell->corner_list[0] , x0         , y0[i]         , z0);
-          point_set(&cell->corner_list[1] , x0 + dx[g] , y0[i]         , z0);
-          point_set(&cell->corner_list[2] , x0         , y0[i] + dy[g] , z0);
-          point_set(&cell->corner_list[3] , x0 + dx[g] , y0[i] + dy[g] , z0);
+          point_set(&corner_list[0] , x0         , y0[i]         , z0);
+          point_set(&corner_list[1] , x0 + dx[g] , y0[i]         , z0);
+          point_set(&corner_list[2] , x0         , y0[i] + dy[g] , z0);
+          point_set(&corner_list[3] , x0 + dx[g] , y0[i] + dy[g] , z0);
 
-          point_set(&cell->corner_list[4] , x0         , y0[i]         , z0 + dz[g]);
-          point_set(&cell->corner_list[5] , x0 + dx[g] , y0[i]         , z0 + dz[g]);
-          point_set(&cell->corner_list[6] , x0         , y0[i] + dy[g] , z0 + dz[g]);
-          point_set(&cell->corner_list[7] , x0 + dx[g] , y0[i] + dy[g] , z0 + dz[g]);
+          point_set(&corner_list[4] , x0         , y0[i]         , z0 + dz[g]);
+          point_set(&corner_list[5] , x0 + dx[g] , y0[i]         , z0 + dz[g]);
+          point_set(&corner_list[6] , x0         , y0[i] + dy[g] , z0 + dz[g]);
+          point_set(&corner_list[7] , x0 + dx[g] , y0[i] + dy[g] , z0 + dz[g]);
+          ecl_grid_set_cell_corners(grid, g, corner_list);
 
           x0    += dx[g];
           y0[i] += dy[g];
@@ -3589,18 +3775,37 @@ static bool ecl_grid_compare_cells(const ecl_grid_type * g1 , const ecl_grid_typ
     bool this_equal = true;
     ecl_cell_type *c1 = ecl_grid_get_cell( g1 , g );
     ecl_cell_type *c2 = ecl_grid_get_cell( g2 , g );
-    ecl_cell_compare(c1 , c2 ,  include_nnc , &this_equal);
+    point_type corners1[8];
+    point_type corners2[8];
+
+    ecl_grid_get_cell_corners( g1 , g , corners1 );
+    ecl_grid_get_cell_corners( g2 , g , corners2 );
+
+    if (ecl_grid_get_cell_coarse_group( g1 , g ) != ecl_grid_get_cell_coarse_group( g2 , g ))
+      this_equal = false;
+
+    if (ecl_grid_get_cell_host( g1 , g ) != ecl_grid_get_cell_host( g2 , g ))
+      this_equal = false;
+
+    ecl_cell_compare(c1 , corners1 , c2 , corners2 , &this_equal);
+
+    if (include_nnc) {
+      if (this_equal)
+        this_equal = nnc_info_equal( ecl_grid_get_cell_nnc_info__( g1 , g ) , ecl_grid_get_cell_nnc_info__( g2 , g ));
+    }
 
     if (!this_equal) {
       if (verbose) {
         int i,j,k;
         ecl_grid_get_ijk1( g1 , g , &i , &j , &k);
 
-        printf("Difference in cell: %d : %d,%d,%d  nnc_equal:%d Volume:%g \n",g,i,j,k , nnc_info_equal( c1->nnc_info , c2->nnc_info) , ecl_cell_get_volume( c1 ));
+        printf("Difference in cell: %d : %d,%d,%d  nnc_equal:%d Volume:%g \n",g,i,j,k ,
+               nnc_info_equal( ecl_grid_get_cell_nnc_info__( g1 , g ) , ecl_grid_get_cell_nnc_info__( g2 , g )) ,
+               ecl_cell_get_volume( corners1 ));
         printf("-----------------------------------------------------------------\n");
-        ecl_cell_dump_ascii( c1 , i , j , k , stdout , NULL);
+        ecl_cell_dump_ascii( c1 , corners1 , ecl_grid_get_cell_host( g1 , g ) , ecl_grid_get_cell_coarse_group( g1 , g ) , i , j , k , stdout , NULL);
         printf("-----------------------------------------------------------------\n");
-        ecl_cell_dump_ascii( c2 , i , j , k , stdout , NULL );
+        ecl_cell_dump_ascii( c2 , corners2 , ecl_grid_get_cell_host( g2 , g ) , ecl_grid_get_cell_coarse_group( g2 , g ) , i , j , k , stdout , NULL );
         printf("-----------------------------------------------------------------\n");
 
       }
@@ -3753,6 +3958,7 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
   const double min_volume = 1e-9;
   point_type p;
   ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
+  point_type corner_list[8];
 
   point_set( &p , x , y , z);
   /*
@@ -3766,50 +3972,51 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
   if (GET_CELL_FLAG(cell , CELL_FLAG_TAINTED))
     return false;
 
-  if (p.z < ecl_cell_min_z( cell ))
+  ecl_grid_get_cell_corners( ecl_grid , global_index , corner_list );
+
+  if (p.z < ecl_cell_min_z( corner_list ))
     return false;
 
-  if (p.z > ecl_cell_max_z( cell ))
+  if (p.z > ecl_cell_max_z( corner_list ))
     return false;
 
-  if (p.x < ecl_cell_min_x( cell ))
+  if (p.x < ecl_cell_min_x( corner_list ))
     return false;
 
-  if (p.x > ecl_cell_max_x( cell ))
+  if (p.x > ecl_cell_max_x( corner_list ))
     return false;
 
-  if (p.y < ecl_cell_min_y( cell ))
+  if (p.y < ecl_cell_min_y( corner_list ))
     return false;
 
-  if (p.y > ecl_cell_max_y( cell ))
+  if (p.y > ecl_cell_max_y( corner_list ))
     return false;
 
   {
     int i,j,k;
     ecl_grid_get_ijk1( ecl_grid , global_index , &i , &j , &k);
-    ecl_cell_assert_center( cell );
 
     /*
       Special case checks for the corner points.
     */
-    if (point_equal( &p , &cell->corner_list[0]))
+    if (point_equal( &p , &corner_list[0]))
       return true;
 
-    if (point_equal( &p , &cell->corner_list[1] )) {
+    if (point_equal( &p , &corner_list[1] )) {
       if (i == (ecl_grid->nx - 1))
         return true;
       else
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[2])) {
+    if (point_equal( &p , &corner_list[2])) {
       if (j == (ecl_grid->ny - 1))
         return true;
       else
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[3])) {
+    if (point_equal( &p , &corner_list[3])) {
       if ((j == (ecl_grid->ny - 1)) &&
           (i == (ecl_grid->nx - 1)))
         return true;
@@ -3817,14 +4024,14 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[4])) {
+    if (point_equal( &p , &corner_list[4])) {
       if (k == (ecl_grid->nz - 1))
         return true;
       else
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[5] )) {
+    if (point_equal( &p , &corner_list[5] )) {
       if ((i == (ecl_grid->nx - 1)) &&
           (k == (ecl_grid->nz - 1)))
         return true;
@@ -3832,7 +4039,7 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[6] )) {
+    if (point_equal( &p , &corner_list[6] )) {
       if ((j == (ecl_grid->ny - 1)) &&
           (k == (ecl_grid->nz - 1)))
         return true;
@@ -3840,7 +4047,7 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[7] )) {
+    if (point_equal( &p , &corner_list[7] )) {
       if ((i == (ecl_grid->nx - 1)) &&
           (j == (ecl_grid->ny - 1)) &&
           (k == (ecl_grid->nz - 1)))
@@ -3852,7 +4059,7 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
     {
       double sign = 1.0;
       int plane_nr = 0;
-      double signed_volume = ecl_cell_get_signed_volume( cell );
+      double signed_volume = ecl_cell_get_signed_volume( corner_list );
       if (fabs(signed_volume) > min_volume) {
         point_type * p0;
         point_type * p1;
@@ -3862,9 +4069,9 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
           sign = -1;
         {
           while (true) {
-            p0 = &cell->corner_list[ bounding_planes[plane_nr][0] ];
-            p1 = &cell->corner_list[ bounding_planes[plane_nr][1] ];
-            p2 = &cell->corner_list[ bounding_planes[plane_nr][2] ];
+            p0 = &corner_list[ bounding_planes[plane_nr][0] ];
+            p1 = &corner_list[ bounding_planes[plane_nr][1] ];
+            p2 = &corner_list[ bounding_planes[plane_nr][2] ];
 
             if (point_equal(p0, p1) || point_equal(p0,p2) || point_equal(p1,p2))
               return false;
@@ -3900,7 +4107,10 @@ int ecl_grid_get_global_index_from_xy( const ecl_grid_type * ecl_grid , int k ,
   for (j=0; j < ecl_grid->ny; j++)
     for (i=0; i < ecl_grid->nx; i++) {
       int global_index = ecl_grid_get_global_index3( ecl_grid , i , j , k );
-      if (ecl_cell_layer_contains_xy( ecl_grid_get_cell( ecl_grid , global_index ) , lower_layer , x , y))
+      point_type corner_list[8];
+
+      ecl_grid_get_cell_corners( ecl_grid , global_index , corner_list );
+      if (ecl_cell_layer_contains_xy( ecl_grid_get_cell( ecl_grid , global_index ) , corner_list , lower_layer , x , y))
         return global_index;
     }
   return -1; /* Did not find x,y */
@@ -3999,6 +4209,9 @@ static int ecl_grid_get_global_index_from_xyz_around_box(ecl_grid_type * grid ,
         2. Check the neighbours (i +/- 1, j +/- 1, k +/- 1 ).
         3. Give up and do a linear search starting from start_index.
 
+   The function updates the internal visited table of the grid, and
+   can not be used from several threads. For repeated lookups of many
+   points use the ecl_grid_lookup structure instead.
 */
 int ecl_grid_get_global_index_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index) {
   int global_index;
@@ -4232,15 +4445,15 @@ void ecl_grid_free__( void * arg ) {
 
 
 void ecl_grid_get_distance(const ecl_grid_type * grid , int global_index1, int global_index2 , double *dx , double *dy , double *dz) {
-  ecl_cell_type * cell1 = ecl_grid_get_cell( grid , global_index1);
-  ecl_cell_type * cell2 = ecl_grid_get_cell( grid , global_index2);
+  point_type center1;
+  point_type center2;
 
-  ecl_cell_assert_center( cell1 );
-  ecl_cell_assert_center( cell2 );
+  ecl_grid_get_cell_center( grid , global_index1 , &center1 );
+  ecl_grid_get_cell_center( grid , global_index2 , &center2 );
   {
-    *dx = cell1->center.x - cell2->center.x;
-    *dy = cell1->center.y - cell2->center.y;
-    *dz = cell1->center.z - cell2->center.z;
+    *dx = center1.x - center2.x;
+    *dy = center1.y - center2.y;
+    *dz = center1.z - center2.z;
   }
 }
 
@@ -4323,8 +4536,7 @@ int ecl_grid_get_nactive_fracture( const ecl_grid_type * grid ) {
 
 
 int ecl_grid_get_parent_cell1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid, global_index );
-  return cell->host_cell;
+  return ecl_grid_get_cell_host( grid , global_index );
 }
 
 
@@ -4447,12 +4659,12 @@ void ecl_grid_get_ijk1A(const ecl_grid_type *ecl_grid , int active_index , int *
 */
 
 void ecl_grid_get_xyz1(const ecl_grid_type * grid , int global_index , double *xpos , double *ypos , double *zpos) {
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  ecl_cell_assert_center( cell );
+  point_type center;
+  ecl_grid_get_cell_center( grid , global_index , &center );
   {
-    *xpos = cell->center.x;
-    *ypos = cell->center.y;
-    *zpos = cell->center.z;
+    *xpos = center.x;
+    *ypos = center.y;
+    *zpos = center.z;
   }
 }
 
@@ -4476,8 +4688,11 @@ void ecl_grid_get_xyz3(const ecl_grid_type * grid , int i, int j , int k, double
 
 void ecl_grid_get_cell_corner_xyz1(const ecl_grid_type * grid , int global_index , int corner_nr , double * xpos , double * ypos , double * zpos ) {
   if ((corner_nr >= 0) &&  (corner_nr <= 7)) {
-    const ecl_cell_type * cell  = ecl_grid_get_cell( grid , global_index );
-    const point_type      point = cell->corner_list[ corner_nr ];
+    point_type corner_list[8];
+    point_type point;
+
+    ecl_grid_get_cell_corners( grid , global_index , corner_list );
+    point = corner_list[ corner_nr ];
     *xpos = point.x;
     *ypos = point.y;
     *zpos = point.z;
@@ -4485,6 +4700,25 @@ void ecl_grid_get_cell_corner_xyz1(const ecl_grid_type * grid , int global_index
 }
 
 
+/**
+   Will return (by reference) the axis aligned bounding box of the
+   cell, i.e. the min and max values of the eight corners in each
+   direction.
+*/
+
+void ecl_grid_get_cell_bbox1(const ecl_grid_type * grid , int global_index , double * xmin , double * xmax , double * ymin , double * ymax , double * zmin , double * zmax) {
+  point_type corner_list[8];
+  ecl_grid_get_cell_corners( grid , global_index , corner_list );
+
+  *xmin = ecl_cell_min_x( corner_list );
+  *xmax = ecl_cell_max_x( corner_list );
+  *ymin = ecl_cell_min_y( corner_list );
+  *ymax = ecl_cell_max_y( corner_list );
+  *zmin = ecl_cell_min_z( corner_list );
+  *zmax = ecl_cell_max_z( corner_list );
+}
+
+
 void ecl_grid_get_cell_corner_xyz3(const ecl_grid_type * grid , int i , int j , int k, int corner_nr , double * xpos , double * ypos , double * zpos ) {
   const int global_index = ecl_grid_get_global_index__(grid , i , j , k );
   ecl_grid_get_cell_corner_xyz1( grid , global_index , corner_nr , xpos , ypos , zpos);
@@ -4532,9 +4766,9 @@ void ecl_grid_get_xyz1A(const ecl_grid_type * grid , int active_index , double *
 
 
 double ecl_grid_get_cdepth1(const ecl_grid_type * grid , int global_index) {
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  ecl_cell_assert_center( cell );
-  return cell->center.z;
+  point_type center;
+  ecl_grid_get_cell_center( grid , global_index , &center );
+  return center.z;
 }
 
 
@@ -4582,12 +4816,13 @@ int ecl_grid_locate_depth( const ecl_grid_type * grid , double depth , int i , i
 */
 
 double ecl_grid_get_top1(const ecl_grid_type * grid , int global_index) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+  double z[8];
   double depth = 0;
   int ij;
 
+  ecl_grid_get_cell_corners_z( grid , global_index , z );
   for (ij = 0; ij < 4; ij++)
-    depth += cell->corner_list[ij].z;
+    depth += z[ij];
 
   return depth * 0.25;
 }
@@ -4624,12 +4859,13 @@ double ecl_grid_get_top1A(const ecl_grid_type * grid , int active_index) {
 */
 
 double ecl_grid_get_bottom1(const ecl_grid_type * grid , int global_index) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  double z[8];
   double depth = 0;
   int ij;
 
+  ecl_grid_get_cell_corners_z( grid , global_index , z );
   for (ij = 0; ij < 4; ij++)
-    depth += cell->corner_list[ij + 4].z;
+    depth += z[ij + 4];
 
   return depth * 0.25;
 }
@@ -4650,12 +4886,13 @@ double ecl_grid_get_bottom1A(const ecl_grid_type * grid , int active_index) {
 
 
 double ecl_grid_get_cell_dz1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  double z[8];
   double dz = 0;
   int ij;
 
+  ecl_grid_get_cell_corners_z( grid , global_index , z );
   for (ij = 0; ij < 4; ij++)
-    dz += (cell->corner_list[ij + 4].z - cell->corner_list[ij].z);
+    dz += (z[ij + 4] - z[ij]);
 
   return dz * 0.25;
 }
@@ -4690,14 +4927,15 @@ double ecl_grid_get_cell_thickness1A( const ecl_grid_type * grid , int active_in
 
 
 double ecl_grid_get_cell_dx1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type corner_list[8];
   double dx = 0;
   double dy = 0;
   int c;
 
+  ecl_grid_get_cell_corners( grid , global_index , corner_list );
   for (c = 1; c < 8; c += 2) {
-    dx += cell->corner_list[c].x - cell->corner_list[c - 1].x;
-    dy += cell->corner_list[c].y - cell->corner_list[c - 1].y;
+    dx += corner_list[c].x - corner_list[c - 1].x;
+    dy += corner_list[c].y - corner_list[c - 1].y;
   }
   dx *= 0.25;
   dy *= 0.25;
@@ -4728,16 +4966,17 @@ double ecl_grid_get_cell_dx1A( const ecl_grid_type * grid , int active_index) {
 */
 
 double ecl_grid_get_cell_dy1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type corner_list[8];
   double dx = 0;
   double dy = 0;
 
+  ecl_grid_get_cell_corners( grid , global_index , corner_list );
   for (int k = 0; k < 2; k++) {
     for (int i = 0; i < 2; i++) {
       int c1 = i + k*4;
       int c2 = c1 + 2;
-      dx += cell->corner_list[c2].x - cell->corner_list[c1].x;
-      dy += cell->corner_list[c2].y - cell->corner_list[c1].y;
+      dx += corner_list[c2].x - corner_list[c1].x;
+      dy += corner_list[c2].y - corner_list[c1].y;
     }
   }
   dx *= 0.25;
@@ -4759,8 +4998,7 @@ double ecl_grid_get_cell_dy1A( const ecl_grid_type * grid , int active_index) {
 
 
 const nnc_info_type * ecl_grid_get_cell_nnc_info1( const ecl_grid_type * grid , int global_index) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  return cell->nnc_info;
+  return ecl_grid_get_cell_nnc_info__( grid , global_index );
 }
 
 const nnc_info_type * ecl_grid_get_cell_nnc_info3( const ecl_grid_type * grid , int i , int j , int k) {
@@ -4941,8 +5179,10 @@ ecl_grid_type * ecl_grid_get_lgr_from_lgr_nr(const ecl_grid_type * main_grid, in
 
 
 const ecl_grid_type * ecl_grid_get_cell_lgr1(const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  return cell->lgr;
+  if (grid->cell_lgr)
+    return grid->cell_lgr[ global_index ];
+  else
+    return NULL;
 }
 
 
@@ -5058,10 +5298,9 @@ bool ecl_grid_cell_regular3( const ecl_grid_type * ecl_grid, int i,int j,int k)
 
 
 double ecl_grid_get_cell_volume1( const ecl_grid_type * ecl_grid, int global_index ) {
-  ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-  int i,j,k;
-  ecl_grid_get_ijk1( ecl_grid , global_index, &i , &j , &k);
-  return ecl_cell_get_volume( cell );
+  point_type corner_list[8];
+  ecl_grid_get_cell_corners( ecl_grid , global_index , corner_list );
+  return ecl_cell_get_volume( corner_list );
 }
 
 
@@ -5073,8 +5312,9 @@ double ecl_grid_get_cell_volume1A( const ecl_grid_type * ecl_grid, int active_in
 
 
 double ecl_grid_get_cell_volume1_tskille( const ecl_grid_type * ecl_grid, int global_index ) {
-  ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-  return ecl_cell_get_volume_tskille( cell );
+  point_type corner_list[8];
+  ecl_grid_get_cell_corners( ecl_grid , global_index , corner_list );
+  return ecl_cell_get_volume_tskille( corner_list );
 }
 
 
@@ -5455,8 +5695,9 @@ static void ecl_grid_dump__(const ecl_grid_type * grid , FILE * stream) {
   {
     int i;
     for (i=0; i < grid->size; i++) {
-      const ecl_cell_type * cell = ecl_grid_get_cell( grid , i );
-      ecl_cell_dump( cell , stream );
+      point_type corner_list[8];
+      ecl_grid_get_cell_corners( grid , i , corner_list );
+      ecl_cell_dump( corner_list , stream );
     }
   }
 }
@@ -5477,8 +5718,10 @@ static void ecl_grid_dump_ascii__(ecl_grid_type * grid , bool active_only , FILE
       ecl_cell_type * cell = ecl_grid_get_cell( grid , l );
       if (cell->active_index[MATRIX_INDEX] >= 0 || !active_only) {
         int i,j,k;
+        point_type corner_list[8];
         ecl_grid_get_ijk1( grid , l , &i , &j , &k);
-        ecl_cell_dump_ascii( cell , i,j,k , stream , NULL);
+        ecl_grid_get_cell_corners( grid , l , corner_list );
+        ecl_cell_dump_ascii( cell , corner_list , ecl_grid_get_cell_host( grid , l ) , ecl_grid_get_cell_coarse_group( grid , l ) , i,j,k , stream , NULL);
       }
     }
   }
@@ -5515,16 +5758,17 @@ void ecl_grid_dump_ascii(ecl_grid_type * grid , bool active_only , FILE * stream
 
 void ecl_grid_dump_ascii_cell1(ecl_grid_type * grid , int global_index , FILE * stream , const double * offset) {
   ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+  point_type corner_list[8];
   int i,j,k;
   ecl_grid_get_ijk1( grid , global_index , &i , &j , &k);
-  ecl_cell_dump_ascii(cell , i,j,k, stream , offset);
+  ecl_grid_get_cell_corners( grid , global_index , corner_list );
+  ecl_cell_dump_ascii(cell , corner_list , ecl_grid_get_cell_host( grid , global_index ) , ecl_grid_get_cell_coarse_group( grid , global_index ) , i,j,k, stream , offset);
 }
 
 
 void ecl_grid_dump_ascii_cell3(ecl_grid_type * grid , int i , int j , int k , FILE * stream , const double * offset) {
   int global_index  = ecl_grid_get_global_index3(grid , i,j,k);
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
-  ecl_cell_dump_ascii(cell , i,j,k, stream , offset);
+  ecl_grid_dump_ascii_cell1( grid , global_index , stream , offset );
 }
 
 /*****************************************************************/
@@ -5690,8 +5934,10 @@ static void ecl_grid_fwrite_GRID__( const ecl_grid_type * grid , int coords_size
         for (i=0; i < grid->nx; i++) {
           int global_index = ecl_grid_get_global_index__(grid , i , j , k );
           const ecl_cell_type * cell = ecl_grid_get_cell( grid ,  global_index );
+          point_type corner_list[8];
 
-          ecl_cell_fwrite_GRID( grid , cell , false , coords_size , i,j,k,global_index,coords_kw , corners_kw , fortio );
+          ecl_grid_get_cell_corners( grid , global_index , corner_list );
+          ecl_cell_fwrite_GRID( grid , cell , corner_list , ecl_grid_get_cell_host( grid , global_index ) , ecl_grid_get_cell_coarse_group( grid , global_index ) , false , coords_size , i,j,k,global_index,coords_kw , corners_kw , fortio );
         }
       }
     }
@@ -5702,8 +5948,10 @@ static void ecl_grid_fwrite_GRID__( const ecl_grid_type * grid , int coords_size
           for (i=0; i < grid->nx; i++) {
             int global_index = ecl_grid_get_global_index__(grid , i , j , k - grid->nz );
             const ecl_cell_type * cell = ecl_grid_get_cell( grid ,  global_index );
+            point_type corner_list[8];
 
-            ecl_cell_fwrite_GRID( grid , cell , true , coords_size , i,j,k,global_index ,  coords_kw , corners_kw , fortio );
+            ecl_grid_get_cell_corners( grid , global_index , corner_list );
+            ecl_cell_fwrite_GRID( grid , cell , corner_list , ecl_grid_get_cell_host( grid , global_index ) , ecl_grid_get_cell_coarse_group( grid , global_index ) , true , coords_size , i,j,k,global_index ,  coords_kw , corners_kw , fortio );
           }
         }
       }
@@ -5855,8 +6103,8 @@ static bool ecl_grid_init_coord_section__( const ecl_grid_type * grid , int i, i
     point_type top_point;
     point_type bottom_point;
 
-    const ecl_cell_type * bottom_cell = ecl_grid_get_cell( grid , bottom_index );
-    const ecl_cell_type * top_cell    = ecl_grid_get_cell( grid , top_index);
+    point_type bottom_corners[8];
+    point_type top_corners[8];
 
     /*
       2---3
@@ -5866,8 +6114,10 @@ static bool ecl_grid_init_coord_section__( const ecl_grid_type * grid , int i, i
     int corner_index = j_corner*2 + i_corner;
     int coord_offset = 6 * ( (j + j_corner) * (grid->nx + 1) + (i + i_corner) );
     {
-      point_copy_values( &top_point    , &top_cell->corner_list[corner_index]);
-      point_copy_values( &bottom_point , &bottom_cell->corner_list[ corner_index + 4]);
+      ecl_grid_get_cell_corners( grid , bottom_index , bottom_corners );
+      ecl_grid_get_cell_corners( grid , top_index , top_corners );
+      point_copy_values( &top_point    , &top_corners[corner_index]);
+      point_copy_values( &bottom_point , &bottom_corners[ corner_index + 4]);
 
 
       if ((top_point.z == bottom_point.z) && (force_set == false)) {
@@ -5990,14 +6240,15 @@ static void ecl_grid_init_zcorn_data__( const ecl_grid_type * grid , float * zco
     for (i=0; i < nx; i++) {
       for (k=0; k < nz; k++) {
         const int cell_index   = ecl_grid_get_global_index3( grid , i,j,k);
-        const ecl_cell_type * cell = ecl_grid_get_cell( grid , cell_index );
+        double corner_z[8];
         int l;
 
+        ecl_grid_get_cell_corners_z( grid , cell_index , corner_z );
         for (l=0; l < 2; l++) {
-          point_type p0 = cell->corner_list[ 4*l];
-          point_type p1 = cell->corner_list[ 4*l + 1];
-          point_type p2 = cell->corner_list[ 4*l + 2];
-          point_type p3 = cell->corner_list[ 4*l + 3];
+          double p0 = corner_z[ 4*l];
+          double p1 = corner_z[ 4*l + 1];
+          double p2 = corner_z[ 4*l + 2];
+          double p3 = corner_z[ 4*l + 3];
 
           int z1 = k*8*nx*ny + j*4*nx + 2*i            + l*4*nx*ny;
           int z2 = k*8*nx*ny + j*4*nx + 2*i  +  1      + l*4*nx*ny;
@@ -6005,17 +6256,17 @@ static void ecl_grid_init_zcorn_data__( const ecl_grid_type * grid , float * zco
           int z4 = k*8*nx*ny + j*4*nx + 2*nx + 2*i + 1 + l*4*nx*ny;
 
           if (zcorn_float) {
-            zcorn_float[z1] = p0.z;
-            zcorn_float[z2] = p1.z;
-            zcorn_float[z3] = p2.z;
-            zcorn_float[z4] = p3.z;
+            zcorn_float[z1] = p0;
+            zcorn_float[z2] = p1;
+            zcorn_float[z3] = p2;
+            zcorn_float[z4] = p3;
           }
 
           if (zcorn_double) {
-            zcorn_double[z1] = p0.z;
-            zcorn_double[z2] = p1.z;
-            zcorn_double[z3] = p2.z;
-            zcorn_double[z4] = p3.z;
+            zcorn_double[z1] = p0;
+            zcorn_double[z2] = p1;
+            zcorn_double[z3] = p2;
+            zcorn_double[z4] = p3;
           }
         }
       }
@@ -6057,12 +6308,13 @@ void ecl_grid_init_actnum_data( const ecl_grid_type * grid , int * actnum ) {
   int i;
   for (i=0; i < grid->size; i++) {
     const ecl_cell_type * cell = ecl_grid_get_cell( grid , i );
-    if (cell->coarse_group == COARSE_GROUP_NONE)
+    int coarse_group = ecl_grid_get_cell_coarse_group( grid , i );
+    if (coarse_group == COARSE_GROUP_NONE)
       actnum[i] = cell->active;
     else {
       /* In the case of coarse cells we must query the coarse cell for
          the original, uncoarsened distribution of actnum values. */
-      ecl_coarse_cell_type * coarse_cell = ecl_grid_iget_coarse_group( grid , cell->coarse_group );
+      ecl_coarse_cell_type * coarse_cell = ecl_grid_iget_coarse_group( grid , coarse_group );
 
       /* 1: Set all the elements in the coarse group to inactive. */
       {
@@ -6140,10 +6392,8 @@ void ecl_grid_global_kw_copy( const ecl_grid_type * grid , ecl_kw_type * target_
 
 static void ecl_grid_init_hostnum_data( const ecl_grid_type * grid , int * hostnum ) {
   int i;
-  for (i=0; i < grid->size; i++) {
-    const ecl_cell_type * cell = ecl_grid_get_cell(grid , i );
-    hostnum[i] = cell->host_cell;
-  }
+  for (i=0; i < grid->size; i++)
+    hostnum[i] = ecl_grid_get_cell_host( grid , i );
 }
 
 int * ecl_grid_alloc_hostnum_data( const ecl_grid_type * grid ) {
@@ -6163,10 +6413,8 @@ ecl_kw_type * ecl_grid_alloc_hostnum_kw( const ecl_grid_type * grid ) {
 
 static void ecl_grid_init_corsnum_data( const ecl_grid_type * grid , int * corsnum ) {
   int i;
-  for (i=0; i < grid->size; i++) {
-    const ecl_cell_type * cell = ecl_grid_get_cell(grid , i );
-    corsnum[i] = cell->coarse_group + 1;
-  }
+  for (i=0; i < grid->size; i++)
+    corsnum[i] = ecl_grid_get_cell_coarse_group( grid , i ) + 1;
 }
 
 int * ecl_grid_alloc_corsnum_data( const ecl_grid_type * grid ) {
@@ -6221,8 +6469,7 @@ static void  ecl_grid_fwrite_self_nnc( const ecl_grid_type * grid , fortio_type
   int g;
 
   for (g=0; g < ecl_grid_get_global_size(grid); g++) {
-    ecl_cell_type * cell = ecl_grid_get_cell( grid , g );
-    const nnc_info_type * nnc_info = cell->nnc_info;
+    const nnc_info_type * nnc_info = ecl_grid_get_cell_nnc_info__( grid , g );
     if (nnc_info) {
       const nnc_vector_type * nnc_vector = nnc_info_get_self_vector(nnc_info);
       int i;
@@ -6485,9 +6732,10 @@ void ecl_grid_fprintf_grdecl(ecl_grid_type * grid , FILE * stream ) {
 */
 
 void ecl_grid_cell_ri_export( const ecl_grid_type * ecl_grid , int global_index , double * ri_points) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
+  point_type corner_list[8];
   int offset = global_index * 8 * 3;
-  ecl_cell_ri_export( cell , &ri_points[ offset ] );
+  ecl_grid_get_cell_corners( ecl_grid , global_index , corner_list );
+  ecl_cell_ri_export( corner_list , &ri_points[ offset ] );
 }
 
 
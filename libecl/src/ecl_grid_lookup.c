@@ -0,0 +1,350 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_grid_lookup.c' is part of ERT - Ensemble based
+   Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_grid_lookup.h>
+
+
+/**
+   The ecl_grid_lookup structure is a spatial index used to find the
+   cell containing a (x,y,z) point without scanning through the whole
+   grid as ecl_grid_get_global_index_from_xyz() does.
+
+   The index has two levels:
+
+     1. The (i,j) columns of the grid are binned in a regular 2D
+        grid in the xy plane; each bin holds a list of the columns
+        whose xy bounding box overlaps the bin.
+
+     2. For each column the cells are sorted on their minimum z
+        value, and a running maximum of the maximum z value is
+        stored alongside. The cells which can contain a given z are
+        found with a binary search, and a backwards scan which stops
+        as soon as the running maximum is below z.
+
+   The final check is done with ecl_grid_cell_contains_xyz1(). When
+   the point is on the boundary between cells the lowest global index
+   is returned, i.e. the same cell as a linear scan starting from
+   global index zero would find.
+
+   The lookup structure is not modified after it has been allocated,
+   hence many threads can do lookups concurrently. The lookup holds a
+   reference to the grid, and must be discarded before the grid.
+*/
+
+struct ecl_grid_lookup_struct {
+  const ecl_grid_type * grid;
+  int                   num_columns;
+  double              * column_bbox;      /* xmin, xmax, ymin, ymax for each (i,j) column. */
+  int                 * column_offset;    /* The cells of column c are at [column_offset[c], column_offset[c+1]) in the cell arrays. */
+
+  double              * cell_zmin;        /* Sorted on zmin within each column. */
+  double              * cell_zmax;
+  double              * cell_zmax_prefix; /* Running max of cell_zmax within each column. */
+  int                 * cell_global_index;
+
+  int                   bin_nx;
+  int                   bin_ny;
+  double                bin_x0;
+  double                bin_y0;
+  double                bin_dx;
+  double                bin_dy;
+  int                 * bin_offset;       /* The columns of bin b are at [bin_offset[b], bin_offset[b+1]) in bin_columns. */
+  int                 * bin_columns;
+};
+
+
+typedef struct {
+  double zmin;
+  double zmax;
+  int    global_index;
+} lookup_cell_type;
+
+
+static int lookup_cell_cmp( const void * arg1 , const void * arg2 ) {
+  const lookup_cell_type * cell1 = arg1;
+  const lookup_cell_type * cell2 = arg2;
+
+  if (cell1->zmin < cell2->zmin)
+    return -1;
+  else if (cell1->zmin > cell2->zmin)
+    return 1;
+  else
+    return cell1->global_index - cell2->global_index;
+}
+
+
+static int ecl_grid_lookup_bin_index( int num_bins , double x0 , double dx , double x) {
+  int bin = (int) floor( (x - x0) / dx );
+  return util_int_min( num_bins - 1 , util_int_max( 0 , bin ));
+}
+
+
+static void ecl_grid_lookup_init_columns( ecl_grid_lookup_type * lookup ) {
+  const ecl_grid_type * grid = lookup->grid;
+  const int nx = ecl_grid_get_nx( grid );
+  const int ny = ecl_grid_get_ny( grid );
+  const int nz = ecl_grid_get_nz( grid );
+  lookup_cell_type * column_cells = util_calloc( nz , sizeof * column_cells );
+  int i,j,k;
+
+  for (j=0; j < ny; j++) {
+    for (i=0; i < nx; i++) {
+      const int column = i + j*nx;
+      const int offset = column * nz;
+      double * bbox = &lookup->column_bbox[ 4 * column ];
+
+      bbox[0] = bbox[2] =  INFINITY;
+      bbox[1] = bbox[3] = -INFINITY;
+      for (k=0; k < nz; k++) {
+        int global_index = ecl_grid_get_global_index3( grid , i , j , k );
+        double xmin,xmax,ymin,ymax,zmin,zmax;
+
+        ecl_grid_get_cell_bbox1( grid , global_index , &xmin , &xmax , &ymin , &ymax , &zmin , &zmax );
+        bbox[0] = util_double_min( bbox[0] , xmin );
+        bbox[1] = util_double_max( bbox[1] , xmax );
+        bbox[2] = util_double_min( bbox[2] , ymin );
+        bbox[3] = util_double_max( bbox[3] , ymax );
+
+        column_cells[k].zmin = zmin;
+        column_cells[k].zmax = zmax;
+        column_cells[k].global_index = global_index;
+      }
+
+      qsort( column_cells , nz , sizeof * column_cells , lookup_cell_cmp );
+      for (k=0; k < nz; k++) {
+        lookup->cell_zmin[ offset + k ] = column_cells[k].zmin;
+        lookup->cell_zmax[ offset + k ] = column_cells[k].zmax;
+        lookup->cell_global_index[ offset + k ] = column_cells[k].global_index;
+        if (k == 0)
+          lookup->cell_zmax_prefix[ offset ] = column_cells[k].zmax;
+        else
+          lookup->cell_zmax_prefix[ offset + k ] = util_double_max( lookup->cell_zmax_prefix[ offset + k - 1] , column_cells[k].zmax );
+      }
+      lookup->column_offset[ column ] = offset;
+    }
+  }
+  lookup->column_offset[ lookup->num_columns ] = lookup->num_columns * nz;
+  free( column_cells );
+}
+
+
+/*
+  The columns are inserted in the bins in two passes; the first pass
+  counts the number of columns in each bin and the second pass fills
+  in the column numbers.
+*/
+
+static void ecl_grid_lookup_init_bins( ecl_grid_lookup_type * lookup ) {
+  const int num_bins = lookup->bin_nx * lookup->bin_ny;
+  int * bin_count = util_calloc( num_bins , sizeof * bin_count );
+  int pass , b , c;
+
+  lookup->bin_offset = util_calloc( num_bins + 1 , sizeof * lookup->bin_offset );
+  for (b = 0; b < num_bins; b++)
+    bin_count[b] = 0;
+
+  for (pass = 0; pass < 2; pass++) {
+    for (c = 0; c < lookup->num_columns; c++) {
+      const double * bbox = &lookup->column_bbox[ 4 * c ];
+      int bx1 = ecl_grid_lookup_bin_index( lookup->bin_nx , lookup->bin_x0 , lookup->bin_dx , bbox[0] );
+      int bx2 = ecl_grid_lookup_bin_index( lookup->bin_nx , lookup->bin_x0 , lookup->bin_dx , bbox[1] );
+      int by1 = ecl_grid_lookup_bin_index( lookup->bin_ny , lookup->bin_y0 , lookup->bin_dy , bbox[2] );
+      int by2 = ecl_grid_lookup_bin_index( lookup->bin_ny , lookup->bin_y0 , lookup->bin_dy , bbox[3] );
+      int bx , by;
+
+      for (by = by1; by <= by2; by++) {
+        for (bx = bx1; bx <= bx2; bx++) {
+          b = bx + by * lookup->bin_nx;
+          if (pass == 0)
+            bin_count[b]++;
+          else {
+            lookup->bin_columns[ lookup->bin_offset[b] + bin_count[b] ] = c;
+            bin_count[b]++;
+          }
+        }
+      }
+    }
+
+    if (pass == 0) {
+      lookup->bin_offset[0] = 0;
+      for (b = 0; b < num_bins; b++) {
+        lookup->bin_offset[b + 1] = lookup->bin_offset[b] + bin_count[b];
+        bin_count[b] = 0;
+      }
+      lookup->bin_columns = util_calloc( lookup->bin_offset[ num_bins ] , sizeof * lookup->bin_columns );
+    }
+  }
+  free( bin_count );
+}
+
+
+ecl_grid_lookup_type * ecl_grid_lookup_alloc( const ecl_grid_type * grid ) {
+  ecl_grid_lookup_type * lookup = util_malloc( sizeof * lookup );
+  const int nx = ecl_grid_get_nx( grid );
+  const int ny = ecl_grid_get_ny( grid );
+  const int size = ecl_grid_get_global_size( grid );
+
+  lookup->grid              = grid;
+  lookup->num_columns       = nx * ny;
+  lookup->column_bbox       = util_calloc( 4 * lookup->num_columns , sizeof * lookup->column_bbox );
+  lookup->column_offset     = util_calloc( lookup->num_columns + 1 , sizeof * lookup->column_offset );
+  lookup->cell_zmin         = util_calloc( size , sizeof * lookup->cell_zmin );
+  lookup->cell_zmax         = util_calloc( size , sizeof * lookup->cell_zmax );
+  lookup->cell_zmax_prefix  = util_calloc( size , sizeof * lookup->cell_zmax_prefix );
+  lookup->cell_global_index = util_calloc( size , sizeof * lookup->cell_global_index );
+  ecl_grid_lookup_init_columns( lookup );
+
+  {
+    double xmin =  INFINITY;
+    double xmax = -INFINITY;
+    double ymin =  INFINITY;
+    double ymax = -INFINITY;
+    int c;
+
+    for (c = 0; c < lookup->num_columns; c++) {
+      const double * bbox = &lookup->column_bbox[ 4 * c ];
+      xmin = util_double_min( xmin , bbox[0] );
+      xmax = util_double_max( xmax , bbox[1] );
+      ymin = util_double_min( ymin , bbox[2] );
+      ymax = util_double_max( ymax , bbox[3] );
+    }
+
+    lookup->bin_nx = util_int_max( 1 , nx );
+    lookup->bin_ny = util_int_max( 1 , ny );
+    lookup->bin_x0 = xmin;
+    lookup->bin_y0 = ymin;
+    lookup->bin_dx = (xmax - xmin) / lookup->bin_nx;
+    lookup->bin_dy = (ymax - ymin) / lookup->bin_ny;
+
+    if (!(lookup->bin_dx > 0))
+      lookup->bin_dx = 1;
+
+    if (!(lookup->bin_dy > 0))
+      lookup->bin_dy = 1;
+  }
+  ecl_grid_lookup_init_bins( lookup );
+
+  return lookup;
+}
+
+
+void ecl_grid_lookup_free( ecl_grid_lookup_type * lookup ) {
+  free( lookup->column_bbox );
+  free( lookup->column_offset );
+  free( lookup->cell_zmin );
+  free( lookup->cell_zmax );
+  free( lookup->cell_zmax_prefix );
+  free( lookup->cell_global_index );
+  free( lookup->bin_offset );
+  free( lookup->bin_columns );
+  free( lookup );
+}
+
+
+/*
+  Will return the number of cells in the column with zmin <= z.
+*/
+
+static int ecl_grid_lookup_column_upper( const ecl_grid_lookup_type * lookup , int column , double z) {
+  int lower = lookup->column_offset[ column ];
+  int upper = lookup->column_offset[ column + 1 ];
+
+  while (lower < upper) {
+    int mid = lower + (upper - lower) / 2;
+    if (lookup->cell_zmin[ mid ] <= z)
+      lower = mid + 1;
+    else
+      upper = mid;
+  }
+  return lower;
+}
+
+
+/**
+   Will return the global index of the cell containing the point
+   (x,y,z), or -1 if no such cell exists.
+*/
+
+int ecl_grid_lookup_get_global_index( const ecl_grid_lookup_type * lookup , double x , double y , double z) {
+  int global_index = -1;
+  int bx = (int) floor( (x - lookup->bin_x0) / lookup->bin_dx );
+  int by = (int) floor( (y - lookup->bin_y0) / lookup->bin_dy );
+
+  /*
+    Points exactly on the max edge of the grid end up in the last bin.
+  */
+  if (bx == lookup->bin_nx)
+    bx--;
+
+  if (by == lookup->bin_ny)
+    by--;
+
+  if ((bx < 0) || (bx >= lookup->bin_nx) || (by < 0) || (by >= lookup->bin_ny))
+    return -1;
+
+  {
+    const int b = bx + by * lookup->bin_nx;
+    int ic;
+
+    for (ic = lookup->bin_offset[b]; ic < lookup->bin_offset[b + 1]; ic++) {
+      const int column = lookup->bin_columns[ic];
+      const double * bbox = &lookup->column_bbox[ 4 * column ];
+
+      if ((x < bbox[0]) || (x > bbox[1]) || (y < bbox[2]) || (y > bbox[3]))
+        continue;
+
+      {
+        const int first = lookup->column_offset[ column ];
+        int index = ecl_grid_lookup_column_upper( lookup , column , z ) - 1;
+
+        while ((index >= first) && (lookup->cell_zmax_prefix[ index ] >= z)) {
+          const int g = lookup->cell_global_index[ index ];
+
+          if ((lookup->cell_zmax[ index ] >= z) && ((global_index < 0) || (g < global_index))) {
+            if (ecl_grid_cell_contains_xyz1( lookup->grid , g , x , y , z ))
+              global_index = g;
+          }
+          index--;
+        }
+      }
+    }
+  }
+
+  return global_index;
+}
+
+
+/**
+   Batch version of ecl_grid_lookup_get_global_index(); the result for
+   point (x[i], y[i], z[i]) is stored in global_index[i].
+*/
+
+void ecl_grid_lookup_get_global_index_list( const ecl_grid_lookup_type * lookup , int size , const double * x , const double * y , const double * z , int * global_index) {
+  int i;
+#pragma omp parallel for
+  for (i = 0; i < size; i++)
+    global_index[i] = ecl_grid_lookup_get_global_index( lookup , x[i] , y[i] , z[i] );
+}
@@ -21,7 +21,11 @@
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
+#include <limits.h>
+#include <stdint.h>
 
+#include "ert/util/build_config.h"
 #include <ert/util/util.h>
 #include <ert/util/buffer.h>
 #include <ert/util/int_vector.h>
@@ -41,7 +45,7 @@
 struct ecl_kw_struct {
   UTIL_TYPE_ID_DECLARATION;
   int               size;
-  int               sizeof_ctype;
+  size_t            sizeof_ctype;         /* size_t to ensure that size * sizeof_ctype is evaluated with 64 bit arithmetic. */
   ecl_type_enum     ecl_type;
   char            * header8;              /* Header which is right padded with ' ' to become exactly 8 characters long. Should only be used internally.*/
   char            * header;               /* Header which is trimmed to no-space. */
@@ -94,32 +98,22 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw , ECL_KW_TYPE_ID )
 
 
 /*****************************************************************/
-/* Format string used when reading and writing formatted
-   files. Observe the following about these format strings:
+/* Format string used when writing formatted files. Observe the
+   following about these format strings:
 
-    1. The format string for reading double contains two '%'
-       identifiers, that is because doubles are read by parsing a
-       prefix and power separately.
-
-    2. For both double and float the write format contains two '%'
+    1. For both double and float the write format contains two '%'
        characters - that is because the values are split in a prefix
        and a power prior to writing - see the function
-       __fprintf_scientific().
+       __sprintf_scientific().
 
-    3. The logical type involves converting back and forth between 'T'
+    2. The logical type involves converting back and forth between 'T'
        and 'F' and internal logical representation. The format strings
-       are therefor for reading/writing a character.
+       are therefor for writing a character.
 
+   Formatted files are read with the small tokenizer in the
+   ecl_kw_fmt_xxx() functions, and not with fscanf() format strings.
 */
 
-#define READ_FMT_CHAR     "%8c"
-#define READ_FMT_FLOAT    "%gE"
-#define READ_FMT_INT      "%d"
-#define READ_FMT_MESS     "%8c"
-#define READ_FMT_BOOL     "  %c"
-#define READ_FMT_DOUBLE   "%lgD%d"
-
-
 #define WRITE_FMT_CHAR    " '%-8s'"
 #define WRITE_FMT_INT     " %11d"
 #define WRITE_FMT_FLOAT   "  %11.8fE%+03d"
@@ -157,33 +151,6 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw , ECL_KW_TYPE_ID )
 
 
 
-static const char * get_read_fmt( ecl_type_enum ecl_type ) {
-  switch(ecl_type) {
-  case(ECL_CHAR_TYPE):
-    return READ_FMT_CHAR;
-    break;
-  case(ECL_INT_TYPE):
-    return READ_FMT_INT;
-    break;
-  case(ECL_FLOAT_TYPE):
-    return READ_FMT_FLOAT;
-    break;
-  case(ECL_DOUBLE_TYPE):
-    return READ_FMT_DOUBLE;
-    break;
-  case(ECL_BOOL_TYPE):
-    return READ_FMT_BOOL;
-    break;
-  case(ECL_MESS_TYPE):
-    return READ_FMT_MESS;
-    break;
-  default:
-    util_abort("%s: invalid ecl_type:%d \n",__func__ , ecl_type);
-    return NULL;
-  }
-}
-
-
 const char * ecl_kw_get_write_fmt( ecl_type_enum ecl_type ) {
   switch(ecl_type) {
   case(ECL_CHAR_TYPE):
@@ -520,8 +487,8 @@ static size_t ecl_kw_fortio_data_size( const ecl_kw_type * ecl_kw) {
   const int blocksize  = get_blocksize( ecl_kw->ecl_type );
   const int num_blocks = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
 
-  return num_blocks * (4 + 4) +                                           // Fortran fluff for each block
-    ecl_kw->size * ecl_util_get_sizeof_ctype_fortio( ecl_kw->ecl_type );  // Actual data
+  return (size_t) num_blocks * (4 + 4) +                                           // Fortran fluff for each block
+    (size_t) ecl_kw->size * ecl_util_get_sizeof_ctype_fortio( ecl_kw->ecl_type );  // Actual data
 }
 
 
@@ -675,7 +642,7 @@ ecl_kw_type * ecl_kw_alloc_slice_copy( const ecl_kw_type * src, int index1, int
           int target_index = 0;
           const char * src_ptr = src->data;
           char * new_ptr = new_kw->data;
-          int sizeof_ctype = new_kw->sizeof_ctype;
+          size_t sizeof_ctype = new_kw->sizeof_ctype;
 
           while ( src_index < index2 ) {
             memcpy( &new_ptr[ target_index * sizeof_ctype ] , &src_ptr[ src_index * sizeof_ctype ] , sizeof_ctype );
@@ -1056,96 +1023,408 @@ static bool ecl_kw_fscanf_qstring(char *s , const char *fmt , int len, FILE *str
 
 
 /*
-  This rather painful parsing is because formatted eclipse double
-  format : 0.ddddD+01 - difficult to parse the 'D';
+  The functions ecl_kw_fmt_xxx() implement a small tokenizer for the
+  formatted ECLIPSE files. The files are read with one getc() call per
+  character from the already buffered FILE stream, instead of one
+  fscanf() call - with format string parsing - per element. The
+  tokenizer never reads more than one character past the current
+  token, and that character is pushed back with ungetc(), i.e. the
+  position of the FILE stream is exactly the same as it would have
+  been with fscanf().
+
+  Numbers are accumulated in an integer mantissa and a decimal
+  exponent while the characters are read. When the mantissa and the
+  power of ten can both be represented exactly as double the value is
+  found with one correctly rounded multiplication or division;
+  otherwise the token is converted with strtod(). Both 'E' and the
+  Fortran 'D' are accepted as exponent marker, and also the Fortran
+  form 0.123+100 where the marker is dropped for three digit
+  exponents.
+*/
+
+#ifdef HAVE_GETC_UNLOCKED
+#define ECL_KW_GETC(stream) getc_unlocked(stream)
+#else
+#define ECL_KW_GETC(stream) getc(stream)
+#endif
+
+#define ECL_KW_FMT_TOKEN_SIZE    64
+#define ECL_KW_FMT_MAX_MANTISSA  9007199254740992LL   /* 2^53 */
+#define ECL_KW_FMT_MAX_POW10     22
+
+static const double ecl_kw_fmt_pow10[ECL_KW_FMT_MAX_POW10 + 1] = {1e0  , 1e1  , 1e2  , 1e3  , 1e4  , 1e5  , 1e6  , 1e7  ,
+                                                                  1e8  , 1e9  , 1e10 , 1e11 , 1e12 , 1e13 , 1e14 , 1e15 ,
+                                                                  1e16 , 1e17 , 1e18 , 1e19 , 1e20 , 1e21 , 1e22};
+
+
+static void ecl_kw_fmt_lock( FILE * stream ) {
+#ifdef HAVE_GETC_UNLOCKED
+  flockfile( stream );
+#endif
+}
+
+
+static void ecl_kw_fmt_unlock( FILE * stream ) {
+#ifdef HAVE_GETC_UNLOCKED
+  funlockfile( stream );
+#endif
+}
+
+
+static int ecl_kw_fmt_skip_space( FILE * stream ) {
+  int c;
+  do {
+    c = ECL_KW_GETC( stream );
+  } while (c == ' ' || c == '\n' || c == '\t' || c == '\r');
+  return c;
+}
+
+
+/*
+  Reads one number; the token is stored in @token with the exponent
+  marker normalized to 'E', so that it can be passed to strtod() or
+  strtof() by the calling scope.
 */
-/** Should be: NESTED */
-
-static double __fscanf_ECL_double( FILE * stream , const char * fmt) {
-  int    read_count , power;
-  double value , arg;
-  read_count = fscanf( stream , fmt , &arg , &power);
-  if (read_count == 2)
-    value = arg * pow(10 , power );
+
+static bool ecl_kw_fmt_fread_number( FILE * stream , char * token , double * value) {
+  long long mantissa = 0;
+  int  exp10         = 0;
+  int  digits        = 0;
+  int  length        = 0;
+  bool exact         = true;
+  bool negative      = false;
+  int c = ecl_kw_fmt_skip_space( stream );
+
+  if (c == '-' || c == '+') {
+    negative = (c == '-');
+    token[length++] = c;
+    c = ECL_KW_GETC( stream );
+  }
+
+  {
+    bool fraction = false;
+    while (true) {
+      if (c >= '0' && c <= '9') {
+        if (mantissa < (ECL_KW_FMT_MAX_MANTISSA - 9) / 10) {
+          mantissa = 10 * mantissa + (c - '0');
+          if (fraction)
+            exp10--;
+        } else {
+          exact = false;
+          if (!fraction)
+            exp10++;
+        }
+        digits++;
+      } else if (c == '.' && !fraction)
+        fraction = true;
+      else
+        break;
+
+      if (length == ECL_KW_FMT_TOKEN_SIZE - 8)
+        return false;
+      token[length++] = c;
+      c = ECL_KW_GETC( stream );
+    }
+  }
+
+  if (digits == 0)
+    return false;
+
+  if (c == 'E' || c == 'e' || c == 'D' || c == 'd' || c == '+' || c == '-') {
+    int  exponent = 0;
+    bool negative_exponent = false;
+
+    token[length++] = 'E';
+    if (c != '+' && c != '-')
+      c = ECL_KW_GETC( stream );
+
+    if (c == '+' || c == '-') {
+      negative_exponent = (c == '-');
+      token[length++] = c;
+      c = ECL_KW_GETC( stream );
+    }
+
+    if (!(c >= '0' && c <= '9'))
+      return false;
+
+    while (c >= '0' && c <= '9') {
+      if (exponent < 100000)
+        exponent = 10 * exponent + (c - '0');
+
+      if (length == ECL_KW_FMT_TOKEN_SIZE - 1)
+        return false;
+      token[length++] = c;
+      c = ECL_KW_GETC( stream );
+    }
+    exp10 += negative_exponent ? -exponent : exponent;
+  }
+  token[length] = '\0';
+  if (c != EOF)
+    ungetc( c , stream );
+
+  if (exact && (exp10 >= -ECL_KW_FMT_MAX_POW10) && (exp10 <= ECL_KW_FMT_MAX_POW10)) {
+    double abs_value = (double) mantissa;
+    if (exp10 < 0)
+      abs_value /= ecl_kw_fmt_pow10[-exp10];
+    else
+      abs_value *= ecl_kw_fmt_pow10[exp10];
+    *value = negative ? -abs_value : abs_value;
+  } else
+    *value = strtod( token , NULL );
+
+  return true;
+}
+
+
+/*
+  The float values are first parsed as double and then rounded to
+  float; this is only different from rounding the decimal value
+  directly to float when the double value lands exactly on the
+  midpoint between two floats, or the value is outside the normal
+  float range. In those rare cases the token is passed to strtof().
+*/
+
+static float ecl_kw_fmt_float( double value , const char * token ) {
+  float float_value = (float) value;
+  if ((double) float_value != value) {
+    const double abs_value = fabs( value );
+    uint64_t bits;
+    memcpy( &bits , &value , sizeof bits );
+    if (((bits & 0x1FFFFFFF) == 0x10000000) || (abs_value < FLT_MIN) || (abs_value > FLT_MAX))
+      float_value = strtof( token , NULL );
+  }
+  return float_value;
+}
+
+
+static bool ecl_kw_fmt_fread_int( FILE * stream , int * value ) {
+  long long abs_value = 0;
+  bool negative = false;
+  int  digits   = 0;
+  int c = ecl_kw_fmt_skip_space( stream );
+
+  if (c == '-' || c == '+') {
+    negative = (c == '-');
+    c = ECL_KW_GETC( stream );
+  }
+
+  while (c >= '0' && c <= '9') {
+    abs_value = 10 * abs_value + (c - '0');
+    if (abs_value > 2147483648LL)
+      return false;
+    digits++;
+    c = ECL_KW_GETC( stream );
+  }
+  if (c != EOF)
+    ungetc( c , stream );
+
+  if (digits == 0)
+    return false;
+
+  if (negative)
+    abs_value = -abs_value;
+
+  if (abs_value > INT_MAX)
+    return false;
+
+  *value = (int) abs_value;
+  return true;
+}
+
+
+/*
+  Reads a string of the form 'xxxxxxxx'; everything up to the first
+  quote is skipped, and the closing quote is consumed.
+*/
+
+static bool ecl_kw_fmt_fread_qstring( FILE * stream , char * s , int len) {
+  int c;
+  do {
+    c = ECL_KW_GETC( stream );
+    if (c == EOF)
+      return false;
+  } while (c != '\'');
+
+  {
+    int i;
+    for (i = 0; i < len; i++) {
+      c = ECL_KW_GETC( stream );
+      if (c == EOF)
+        return false;
+      s[i] = c;
+    }
+    s[len] = '\0';
+  }
+  return (ECL_KW_GETC( stream ) != EOF);
+}
+
+
+static bool ecl_kw_fmt_fread_bool( FILE * stream , int * value ) {
+  int c = ecl_kw_fmt_skip_space( stream );
+  if (c == BOOL_TRUE_CHAR)
+    *value = ECL_BOOL_TRUE_INT;
+  else if (c == BOOL_FALSE_CHAR)
+    *value = ECL_BOOL_FALSE_INT;
   else {
-    util_abort("%s: read failed \n",__func__);
-    value = -1;
+    if (c == EOF)
+      util_abort("%s: read failed - premature file end? \n",__func__ );
+    else
+      util_abort("%s: Logical value: [%c] not recogniced - aborting \n", __func__ , c);
+    return false;
+  }
+  return true;
+}
+
+
+/*
+  Reads one block of @count elements starting at element @index; the
+  type switch is done once per block and not once per element. Will
+  return the number of elements which were successfully read.
+*/
+
+static int ecl_kw_fmt_fread_block( ecl_kw_type * ecl_kw , FILE * stream , int index , int count) {
+  char token[ECL_KW_FMT_TOKEN_SIZE];
+  int i;
+
+  switch(ecl_kw->ecl_type) {
+  case(ECL_CHAR_TYPE):
+  case(ECL_MESS_TYPE):
+    for (i = 0; i < count; i++) {
+      if (!ecl_kw_fmt_fread_qstring( stream , &ecl_kw->data[(size_t) (index + i) * ecl_kw->sizeof_ctype] , ECL_STRING_LENGTH ))
+        break;
+    }
+    break;
+  case(ECL_INT_TYPE):
+    {
+      int * data = (int *) ecl_kw->data;
+      for (i = 0; i < count; i++) {
+        if (!ecl_kw_fmt_fread_int( stream , &data[index + i] ))
+          break;
+      }
+    }
+    break;
+  case(ECL_FLOAT_TYPE):
+    {
+      float * data = (float *) ecl_kw->data;
+      for (i = 0; i < count; i++) {
+        double value;
+        if (!ecl_kw_fmt_fread_number( stream , token , &value ))
+          break;
+        data[index + i] = ecl_kw_fmt_float( value , token );
+      }
+    }
+    break;
+  case(ECL_DOUBLE_TYPE):
+    {
+      double * data = (double *) ecl_kw->data;
+      for (i = 0; i < count; i++) {
+        if (!ecl_kw_fmt_fread_number( stream , token , &data[index + i] ))
+          break;
+      }
+    }
+    break;
+  case(ECL_BOOL_TYPE):
+    {
+      int * data = (int *) ecl_kw->data;
+      for (i = 0; i < count; i++) {
+        if (!ecl_kw_fmt_fread_bool( stream , &data[index + i] ))
+          break;
+      }
+    }
+    break;
+  default:
+    util_abort("%s: Internal error: internal eclipse_type: %d not recognized - aborting \n",__func__ , ecl_kw->ecl_type);
+    i = 0;
+  }
+  return i;
+}
+
+
+static bool ecl_kw_fread_data_formatted(ecl_kw_type *ecl_kw, fortio_type *fortio) {
+  const int blocksize = get_blocksize( ecl_kw->ecl_type );
+  FILE * stream       = fortio_get_FILE(fortio);
+  int    index        = 0;
+
+  ecl_kw_fmt_lock( stream );
+  while (index < ecl_kw->size) {
+    int read_elm = util_int_min( blocksize , ecl_kw->size - index );
+    int read_count = ecl_kw_fmt_fread_block( ecl_kw , stream , index , read_elm );
+    if (read_count != read_elm) {
+      ecl_kw_fmt_unlock( stream );
+      util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ ,
+                 index + read_count ,
+                 ecl_kw->header8 ,
+                 fortio_filename_ref(fortio));
+      return false;
+    }
+    index += read_elm;
+  }
+  ecl_kw_fmt_unlock( stream );
+
+  /* Skip the trailing newline */
+  fortio_fseek( fortio , 1 , SEEK_CUR);
+  return true;
+}
+
+
+/*
+  Reads the data directly out of a memory mapped fortio instance. The
+  numeric data is copied record by record into the ecl_kw storage and
+  endian converted while the record is still in cache; the record
+  headers have already been validated when the file was mapped.
+*/
+
+static bool ecl_kw_fread_data_mmap(ecl_kw_type *ecl_kw, fortio_type *fortio) {
+  const char null_char    = '\0';
+  const bool string_type  = (ecl_kw->ecl_type == ECL_CHAR_TYPE || ecl_kw->ecl_type == ECL_MESS_TYPE);
+  const int  element_size = string_type ? ECL_STRING_LENGTH : ecl_kw->sizeof_ctype;
+  offset_type offset      = fortio_ftell( fortio );
+  int index               = 0;
+
+  while (index < ecl_kw->size) {
+    int record_size;
+    const char * record = fortio_mmap_fread_record( fortio , &offset , &record_size );
+    if (record == NULL)
+      return false;
+
+    {
+      int record_elements = record_size / element_size;
+      if ((record_elements * element_size != record_size) || (record_elements > (ecl_kw->size - index)))
+        return false;
+
+      if (string_type) {
+        int ir;
+        for (ir = 0; ir < record_elements; ir++) {
+          char * target = &ecl_kw->data[(index + ir) * ecl_kw->sizeof_ctype];
+          memcpy( target , &record[ir * ECL_STRING_LENGTH] , ECL_STRING_LENGTH );
+          target[ECL_STRING_LENGTH] = null_char;
+        }
+      } else {
+        char * target = &ecl_kw->data[index * ecl_kw->sizeof_ctype];
+        memcpy( target , record , record_size );
+        if (ECL_ENDIAN_FLIP)
+          util_endian_flip_vector( target , ecl_kw->sizeof_ctype , record_elements );
+      }
+      index += record_elements;
+    }
   }
-  return value;
+
+  fortio_fseek( fortio , offset , SEEK_SET );
+  return true;
 }
 
+
 bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
   const char null_char         = '\0';
   bool fmt_file                = fortio_fmt_file( fortio );
   if (ecl_kw->size > 0) {
-    const int blocksize = get_blocksize( ecl_kw->ecl_type );
-    if (fmt_file) {
-      const int blocks      = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
-      const char * read_fmt = get_read_fmt( ecl_kw->ecl_type );
-      FILE * stream         = fortio_get_FILE(fortio);
-      int    offset         = 0;
-      int    index          = 0;
-      int    ib,ir;
-      for (ib = 0; ib < blocks; ib++) {
-        int read_elm = util_int_min((ib + 1) * blocksize , ecl_kw->size) - ib * blocksize;
-        for (ir = 0; ir < read_elm; ir++) {
-          switch(ecl_kw->ecl_type) {
-          case(ECL_CHAR_TYPE):
-            ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8, stream);
-            break;
-          case(ECL_INT_TYPE):
-            {
-              int iread = fscanf(stream , read_fmt , (int *) &ecl_kw->data[offset]);
-              if (iread != 1)
-                util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ , offset / ecl_kw->sizeof_ctype , ecl_kw->header8 , fortio_filename_ref(fortio));
-            }
-            break;
-          case(ECL_FLOAT_TYPE):
-            {
-              int iread = fscanf(stream , read_fmt , (float *) &ecl_kw->data[offset]);
-              if (iread != 1) {
-                util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ ,
-                           offset / ecl_kw->sizeof_ctype ,
-                           ecl_kw->header8 ,
-                           fortio_filename_ref(fortio));
-              }
-            }
-            break;
-          case(ECL_DOUBLE_TYPE):
-            {
-              double value = __fscanf_ECL_double( stream , read_fmt );
-              ecl_kw_iset(ecl_kw , index , &value);
-            }
-            break;
-          case(ECL_BOOL_TYPE):
-            {
-              char bool_char;
-              if (fscanf(stream , read_fmt , &bool_char) == 1) {
-                if (bool_char == BOOL_TRUE_CHAR)
-                  ecl_kw_iset_bool(ecl_kw , index , true);
-                else if (bool_char == BOOL_FALSE_CHAR)
-                  ecl_kw_iset_bool(ecl_kw , index , false);
-                else
-                  util_abort("%s: Logical value: [%c] not recogniced - aborting \n", __func__ , bool_char);
-              } else
-                util_abort("%s: read failed - premature file end? \n",__func__ );
-            }
-            break;
-          case(ECL_MESS_TYPE):
-            ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8 , stream);
-            break;
-          default:
-            util_abort("%s: Internal error: internal eclipse_type: %d not recognized - aborting \n",__func__ , ecl_kw->ecl_type);
-          }
-          offset += ecl_kw->sizeof_ctype;
-          index++;
-        }
-      }
+    if (fortio_is_mmapped( fortio ))
+      return ecl_kw_fread_data_mmap( ecl_kw , fortio );
 
-      /* Skip the trailing newline */
-      fortio_fseek( fortio , 1 , SEEK_CUR);
-      return true;
-    } else {
+    const int blocksize = get_blocksize( ecl_kw->ecl_type );
+    if (fmt_file)
+      return ecl_kw_fread_data_formatted( ecl_kw , fortio );
+    else {
       bool read_ok = true;
       if (ecl_kw->ecl_type == ECL_CHAR_TYPE || ecl_kw->ecl_type == ECL_MESS_TYPE) {
         const int blocks = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
@@ -1161,8 +1440,9 @@ bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
           if (record_size >= 0) {
             int ir;
             for (ir = 0; ir < read_elm; ir++) {
-              util_fread( &ecl_kw->data[(ib * blocksize + ir) * ecl_kw->sizeof_ctype] , 1 , ECL_STRING_LENGTH , stream , __func__);
-              ecl_kw->data[(ib * blocksize + ir) * ecl_kw->sizeof_ctype + ECL_STRING_LENGTH] = null_char;
+              size_t data_offset = (size_t) (ib * blocksize + ir) * ecl_kw->sizeof_ctype;
+              util_fread( &ecl_kw->data[data_offset] , 1 , ECL_STRING_LENGTH , stream , __func__);
+              ecl_kw->data[data_offset + ECL_STRING_LENGTH] = null_char;
             }
             read_ok = fortio_complete_read(fortio , record_size);
           } else
@@ -1209,8 +1489,19 @@ void ecl_kw_fread_indexed_data(fortio_type * fortio, offset_type data_offset, ec
         if(element_index < 0 || element_index >= element_count) {
             util_abort("%s: Element index is out of range 0 <= %d < %d\n", __func__, element_index, element_count);
         }
-        fortio_data_fseek(fortio, data_offset, element_index, element_size, element_count, block_size);
-        util_fread(&buffer[index * element_size], element_size, 1, stream, __func__);
+
+        if (fortio_is_mmapped( fortio )) {
+            int block_index = element_index / block_size;
+            offset_type element_offset = data_offset + (block_index + 1) * 4 + block_index * 4 + (offset_type) element_index * element_size;
+            const char * src = fortio_mmap_ptr( fortio , element_offset , element_size );
+
+            if (src == NULL)
+                util_abort("%s: Element %d is outside the file:%s \n",__func__ , element_index , fortio_filename_ref( fortio ));
+            memcpy(&buffer[index * element_size], src , element_size);
+        } else {
+            fortio_data_fseek(fortio, data_offset, element_index, element_size, element_count, block_size);
+            util_fread(&buffer[index * element_size], element_size, 1, stream, __func__);
+        }
     }
 
     if (ECL_ENDIAN_FLIP) {
@@ -1302,6 +1593,23 @@ bool ecl_kw_fread_header(ecl_kw_type *ecl_kw , fortio_type * fortio) {
       } else
         util_abort("%s: reading failed - at end of file?\n",__func__);
     }
+  } else if (fortio_is_mmapped( fortio )) {
+    offset_type offset = fortio_ftell( fortio );
+    const char * buffer = fortio_mmap_fread_record( fortio , &offset , &record_size );
+
+    header[ECL_STRING_LENGTH]     = null_char;
+    ecl_type_str[ECL_TYPE_LENGTH] = null_char;
+    if (buffer && (record_size == ECL_KW_HEADER_DATA_SIZE)) {
+      memcpy( header , &buffer[0] , ECL_STRING_LENGTH);
+      memcpy( &size , &buffer[ECL_STRING_LENGTH] , sizeof size );
+      memcpy( ecl_type_str , &buffer[ECL_STRING_LENGTH + sizeof(size)] , ECL_TYPE_LENGTH);
+
+      if (ECL_ENDIAN_FLIP)
+        util_endian_flip_vector(&size , sizeof size , 1);
+
+      fortio_fseek( fortio , offset , SEEK_SET );
+    } else
+      OK = false;
   } else {
     header[ECL_STRING_LENGTH]     = null_char;
     ecl_type_str[ECL_TYPE_LENGTH] = null_char;
@@ -1519,39 +1827,52 @@ void ecl_kw_fskip(fortio_type *fortio) {
 
 
 
-static void ecl_kw_fwrite_data_unformatted( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
-  if (ECL_ENDIAN_FLIP)
-    ecl_kw_endian_convert_data(ecl_kw);
-
-  {
-    const int blocksize  = get_blocksize( ecl_kw->ecl_type );
-    const int num_blocks = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
-    int block_nr;
+/*
+  The data is written one fortran record at a time; for numeric data
+  the record is copied to a scratch buffer of one block and endian
+  converted there, i.e. the keyword itself is not modified, and no
+  size larger than a single block is ever computed with int
+  arithmetic.
+*/
 
-    for (block_nr = 0; block_nr < num_blocks; block_nr++) {
-      int this_blocksize = util_int_min((block_nr + 1)*blocksize , ecl_kw->size) - block_nr*blocksize;
-      if (ecl_kw->ecl_type == ECL_CHAR_TYPE || ecl_kw->ecl_type == ECL_MESS_TYPE) {
-        /*
-           Due to the terminating \0 characters there is not a
-           continous file/memory mapping - the \0 characters arel
-           skipped.
-        */
-        FILE *stream      = fortio_get_FILE(fortio);
-        int   record_size = this_blocksize * ECL_STRING_LENGTH;     /* The total size in bytes of the record written by the fortio layer. */
-        int   i;
-        fortio_init_write(fortio , record_size );
-        for (i = 0; i < this_blocksize; i++)
-          fwrite(&ecl_kw->data[(block_nr * blocksize + i) * ecl_kw->sizeof_ctype] , 1 , ECL_STRING_LENGTH , stream);
-        fortio_complete_write(fortio , record_size);
-      } else {
-        int   record_size = this_blocksize * ecl_kw->sizeof_ctype;  /* The total size in bytes of the record written by the fortio layer. */
-        fortio_fwrite_record(fortio , &ecl_kw->data[block_nr * blocksize * ecl_kw->sizeof_ctype] , record_size);
+static void ecl_kw_fwrite_data_unformatted( const ecl_kw_type * ecl_kw , fortio_type * fortio ) {
+  const int blocksize  = get_blocksize( ecl_kw->ecl_type );
+  const int num_blocks = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
+  const bool string_type = (ecl_kw->ecl_type == ECL_CHAR_TYPE || ecl_kw->ecl_type == ECL_MESS_TYPE);
+  char * block_buffer = NULL;
+  int block_nr;
+
+  if (!string_type && ECL_ENDIAN_FLIP)
+    block_buffer = util_malloc( blocksize * ecl_kw->sizeof_ctype );
+
+  for (block_nr = 0; block_nr < num_blocks; block_nr++) {
+    int this_blocksize = util_int_min((block_nr + 1)*blocksize , ecl_kw->size) - block_nr*blocksize;
+    const char * block_data = &ecl_kw->data[(size_t) block_nr * blocksize * ecl_kw->sizeof_ctype];
+    if (string_type) {
+      /*
+         Due to the terminating \0 characters there is not a
+         continous file/memory mapping - the \0 characters arel
+         skipped.
+      */
+      FILE *stream      = fortio_get_FILE(fortio);
+      int   record_size = this_blocksize * ECL_STRING_LENGTH;     /* The total size in bytes of the record written by the fortio layer. */
+      int   i;
+      fortio_init_write(fortio , record_size );
+      for (i = 0; i < this_blocksize; i++)
+        fwrite(&block_data[i * ecl_kw->sizeof_ctype] , 1 , ECL_STRING_LENGTH , stream);
+      fortio_complete_write(fortio , record_size);
+    } else {
+      int   record_size = this_blocksize * ecl_kw->sizeof_ctype;  /* The total size in bytes of the record written by the fortio layer. */
+      if (block_buffer) {
+        memcpy( block_buffer , block_data , record_size );
+        util_endian_flip_vector( block_buffer , ecl_kw->sizeof_ctype , this_blocksize );
+        block_data = block_buffer;
       }
+      fortio_fwrite_record(fortio , block_data , record_size);
     }
   }
 
-  if (ECL_ENDIAN_FLIP)
-    ecl_kw_endian_convert_data(ecl_kw);
+  util_safe_free( block_buffer );
 }
 
 
@@ -1571,90 +1892,114 @@ static void ecl_kw_fwrite_data_unformatted( ecl_kw_type * ecl_kw , fortio_type *
         2. To use 'D' as the exponent start for double values.
 
      If you are more proficient with C fprintf() format strings than I
-     am, the __fprintf_scientific() function should be removed, and
+     am, the __sprintf_scientific() function should be removed, and
      the WRITE_FMT_DOUBLE and WRITE_FMT_FLOAT format specifiers
      updated accordingly.
   */
 
-   static void __fprintf_scientific(FILE * stream, const char * fmt , double x) {
-    double pow_x = ceil(log10(fabs(x)));
-    double arg_x   = x / pow(10.0 , pow_x);
-    if (x != 0.0) {
-      if (fabs(arg_x) == 1.0) {
-        arg_x *= 0.10;
-        pow_x += 1;
-      }
-    } else {
-      arg_x = 0.0;
-      pow_x = 0.0;
+static int __sprintf_scientific(char * buffer , size_t buffer_size , const char * fmt , double x) {
+  double pow_x = ceil(log10(fabs(x)));
+  double arg_x   = x / pow(10.0 , pow_x);
+  if (x != 0.0) {
+    if (fabs(arg_x) == 1.0) {
+      arg_x *= 0.10;
+      pow_x += 1;
     }
-    fprintf(stream , fmt , arg_x , (int) pow_x);
+  } else {
+    arg_x = 0.0;
+    pow_x = 0.0;
   }
+  return snprintf(buffer , buffer_size , fmt , arg_x , (int) pow_x);
+}
 
 
-static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
+/*
+  Equivalent to sprintf(buffer , WRITE_FMT_INT , value).
+*/
 
-  {
+static int ecl_kw_fmt_sprintf_int( char * buffer , int value ) {
+  const int width = 12;
+  unsigned int abs_value = (value < 0) ? 0U - (unsigned int) value : (unsigned int) value;
+  int pos = width;
 
-    FILE * stream           = fortio_get_FILE( fortio );
-    const int blocksize     = get_blocksize( ecl_kw->ecl_type );
-    const  int columns      = get_columns( ecl_kw->ecl_type );
-    const  char * write_fmt = ecl_kw_get_write_fmt( ecl_kw->ecl_type );
-    const int num_blocks    = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
-    int block_nr;
-
-    for (block_nr = 0; block_nr < num_blocks; block_nr++) {
-      int this_blocksize = util_int_min((block_nr + 1)*blocksize , ecl_kw->size) - block_nr*blocksize;
-      int num_lines      = this_blocksize / columns + ( this_blocksize % columns == 0 ? 0 : 1);
-      int line_nr;
-      for (line_nr = 0; line_nr < num_lines; line_nr++) {
-        int num_columns = util_int_min( (line_nr + 1)*columns , this_blocksize) - columns * line_nr;
-        int col_nr;
-        for (col_nr =0; col_nr < num_columns; col_nr++) {
-          int data_index  = block_nr * blocksize + line_nr * columns + col_nr;
-          void * data_ptr = ecl_kw_iget_ptr_static( ecl_kw , data_index );
-          switch (ecl_kw->ecl_type) {
-          case(ECL_CHAR_TYPE):
-            fprintf(stream , write_fmt , data_ptr);
-            break;
-          case(ECL_INT_TYPE):
-            {
-              int int_value = ((int *) data_ptr)[0];
-              fprintf(stream , write_fmt , int_value);
-            }
-            break;
-          case(ECL_BOOL_TYPE):
-            {
-              bool bool_value = ((bool *) data_ptr)[0];
-              if (bool_value)
-                fprintf(stream , write_fmt , BOOL_TRUE_CHAR);
-              else
-                fprintf(stream , write_fmt , BOOL_FALSE_CHAR);
-            }
-            break;
-          case(ECL_FLOAT_TYPE):
-            {
-              float float_value = ((float *) data_ptr)[0];
-              __fprintf_scientific( stream , write_fmt , float_value );
-            }
-            break;
-          case(ECL_DOUBLE_TYPE):
-            {
-              double double_value = ((double *) data_ptr)[0];
-              __fprintf_scientific( stream , write_fmt , double_value );
-            }
-            break;
-          case(ECL_MESS_TYPE):
-            util_abort("%s: internal fuckup : message type keywords should NOT have data ??\n",__func__);
-            break;
-          }
-        }
-        fprintf(stream , "\n");
+  do {
+    buffer[--pos] = '0' + (abs_value % 10);
+    abs_value /= 10;
+  } while (abs_value > 0);
+
+  if (value < 0)
+    buffer[--pos] = '-';
+
+  while (pos > 0)
+    buffer[--pos] = ' ';
+
+  return width;
+}
+
+
+/*
+  The formatted data is assembled one block at a time in a memory
+  buffer, and the buffer is written to the stream with one fwrite()
+  call per block. The line layout is exactly the same as when writing
+  element by element with the WRITE_FMT_XXX format strings.
+*/
+
+#define ECL_KW_FMT_MAX_ELEMENT_WIDTH 32
+
+static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
+  FILE * stream           = fortio_get_FILE( fortio );
+  const int blocksize     = get_blocksize( ecl_kw->ecl_type );
+  const int columns       = get_columns( ecl_kw->ecl_type );
+  const char * write_fmt  = ecl_kw_get_write_fmt( ecl_kw->ecl_type );
+  const int num_blocks    = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
+  const size_t buffer_size = (size_t) blocksize * ECL_KW_FMT_MAX_ELEMENT_WIDTH + blocksize / columns + 2;
+  char * buffer           = util_calloc( buffer_size , sizeof * buffer );
+  int block_nr;
+
+  if (ecl_kw->ecl_type == ECL_MESS_TYPE && ecl_kw->size > 0)
+    util_abort("%s: internal fuckup : message type keywords should NOT have data ??\n",__func__);
+
+  for (block_nr = 0; block_nr < num_blocks; block_nr++) {
+    const int block_start    = block_nr * blocksize;
+    const int this_blocksize = util_int_min( blocksize , ecl_kw->size - block_start );
+    size_t pos = 0;
+    int i;
+
+    for (i = 0; i < this_blocksize; i++) {
+      const int data_index = block_start + i;
+      switch (ecl_kw->ecl_type) {
+      case(ECL_CHAR_TYPE):
+        pos += snprintf( &buffer[pos] , buffer_size - pos , write_fmt , &ecl_kw->data[(size_t) data_index * ecl_kw->sizeof_ctype] );
+        break;
+      case(ECL_INT_TYPE):
+        pos += ecl_kw_fmt_sprintf_int( &buffer[pos] , ((const int *) ecl_kw->data)[data_index] );
+        break;
+      case(ECL_BOOL_TYPE):
+        buffer[pos++] = ' ';
+        buffer[pos++] = ' ';
+        buffer[pos++] = (((const int *) ecl_kw->data)[data_index] != ECL_BOOL_FALSE_INT) ? BOOL_TRUE_CHAR : BOOL_FALSE_CHAR;
+        break;
+      case(ECL_FLOAT_TYPE):
+        pos += __sprintf_scientific( &buffer[pos] , buffer_size - pos , write_fmt , ((const float *) ecl_kw->data)[data_index] );
+        break;
+      case(ECL_DOUBLE_TYPE):
+        pos += __sprintf_scientific( &buffer[pos] , buffer_size - pos , write_fmt , ((const double *) ecl_kw->data)[data_index] );
+        break;
+      default:
+        break;
       }
+
+      if (((i + 1) % columns == 0) || (i == this_blocksize - 1))
+        buffer[pos++] = '\n';
     }
+    fwrite( buffer , 1 , pos , stream );
   }
+
+  free( buffer );
 }
 
+#undef ECL_KW_FMT_MAX_ELEMENT_WIDTH
+
 
 void ecl_kw_fwrite_data(const ecl_kw_type *_ecl_kw , fortio_type *fortio) {
   ecl_kw_type *ecl_kw = (ecl_kw_type *) _ecl_kw;
@@ -1854,7 +2199,7 @@ ecl_kw_type * ecl_kw_alloc_scatter_copy( const ecl_kw_type * src_kw , int target
   }
 
   {
-    int sizeof_ctype = ecl_util_get_sizeof_ctype( src_kw->ecl_type );
+    size_t sizeof_ctype = ecl_util_get_sizeof_ctype( src_kw->ecl_type );
     int i;
         for( i =0; i < src_kw->size; i++) {
       int target_index = mapping[i];
@@ -1940,7 +2285,7 @@ void ecl_kw_scalar_set_float_or_double( ecl_kw_type * ecl_kw , double value ) {
   Untyped - low level alternative.
 */
 void ecl_kw_scalar_set__(ecl_kw_type * ecl_kw , const void * value) {
-  int sizeof_ctype = ecl_util_get_sizeof_ctype( ecl_kw->ecl_type );
+  size_t sizeof_ctype = ecl_util_get_sizeof_ctype( ecl_kw->ecl_type );
   int i;
   for (i=0;i < ecl_kw->size; i++)
     memcpy( &ecl_kw->data[ i * sizeof_ctype ] , value , sizeof_ctype);
@@ -2072,7 +2417,7 @@ void ecl_kw_copy_indexed( ecl_kw_type * target_kw , const int_vector_type * inde
   {
     char * target_data = ecl_kw_get_data_ref( target_kw );
     const char * src_data = ecl_kw_get_data_ref( src_kw );
-    int sizeof_ctype = ecl_util_get_sizeof_ctype(target_kw->ecl_type);
+    size_t sizeof_ctype = ecl_util_get_sizeof_ctype(target_kw->ecl_type);
     int set_size     = int_vector_size( index_set );
     const int * index_data = int_vector_get_const_ptr( index_set );
     int i;
@@ -162,6 +162,36 @@ static double ecl_subsidence_survey_eval( const ecl_subsidence_survey_type * bas
   return deltaz;
 }
 
+static void ecl_subsidence_survey_eval_stations( const ecl_subsidence_survey_type * base_survey ,
+                                                 const ecl_subsidence_survey_type * monitor_survey,
+                                                 ecl_region_type * region ,
+                                                 int num_stations ,
+                                                 const double * utm_x , const double * utm_y , const double * depth ,
+                                                 double compressibility, double poisson_ratio,
+                                                 double * deltaz) {
+
+  const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
+  const int size  = ecl_grid_cache_get_size( grid_cache );
+  double * weight = util_calloc( size , sizeof * weight );
+  const double scale = compressibility * 31.83099*(1-poisson_ratio);
+  int index;
+
+  if (monitor_survey != NULL) {
+    for (index = 0; index < size; index++)
+      weight[index] = base_survey->porv[index] * (base_survey->pressure[index] - monitor_survey->pressure[index]);
+  } else {
+    for (index = 0; index < size; index++)
+      weight[index] = base_survey->porv[index] * base_survey->pressure[index];
+  }
+
+  ecl_grav_common_eval_biot_savart_stations( grid_cache , region , base_survey->aquifer_cell , weight ,
+                                             num_stations , utm_x , utm_y , depth , deltaz , util_get_num_cpu() );
+  for (index = 0; index < num_stations; index++)
+    deltaz[index] *= scale;
+
+  free( weight );
+}
+
 /*****************************************************************/
 /**
    The grid instance is only used during the construction phase. The
@@ -213,6 +243,22 @@ double ecl_subsidence_eval( const ecl_subsidence_type * subsidence , const char
   return ecl_subsidence_survey_eval( base_survey , monitor_survey , region , utm_x , utm_y , depth , compressibility, poisson_ratio);
 }
 
+/**
+   Evaluates the subsidence at @num_stations stations in one go, station
+   i is at (utm_x[i], utm_y[i], depth[i]) and the result is stored in
+   deltaz[i]. The weights are calculated once for all the stations, and
+   the result for each station is the same as from
+   ecl_subsidence_eval().
+*/
+
+void ecl_subsidence_eval_stations( const ecl_subsidence_type * subsidence , const char * base, const char * monitor , ecl_region_type * region ,
+                                   int num_stations , const double * utm_x, const double * utm_y , const double * depth,
+                                   double compressibility, double poisson_ratio, double * deltaz) {
+  ecl_subsidence_survey_type * base_survey    = ecl_subsidence_get_survey( subsidence , base );
+  ecl_subsidence_survey_type * monitor_survey = ecl_subsidence_get_survey( subsidence , monitor );
+  ecl_subsidence_survey_eval_stations( base_survey , monitor_survey , region , num_stations , utm_x , utm_y , depth , compressibility , poisson_ratio , deltaz );
+}
+
 void ecl_subsidence_free( ecl_subsidence_type * ecl_subsidence ) {
   ecl_grid_cache_free( ecl_subsidence->grid_cache );
   free( ecl_subsidence->aquifer_cell );
@@ -167,11 +167,12 @@ static ecl_sum_type * ecl_sum_alloc__( const char * input_arg , const char * key
 }
 
 
-static bool ecl_sum_fread_data( ecl_sum_type * ecl_sum , const stringlist_type * data_files , bool include_restart) {
+static bool ecl_sum_fread_data( ecl_sum_type * ecl_sum , const stringlist_type * data_files , bool include_restart , bool lazy_load) {
   if (ecl_sum->data != NULL)
     ecl_sum_free_data( ecl_sum );
 
   ecl_sum->data = ecl_sum_data_alloc( ecl_sum->smspec );
+  ecl_sum_data_set_lazy_load( ecl_sum->data , lazy_load );
   if (ecl_sum_data_fread( ecl_sum->data , data_files )) {
     if (include_restart) {
       const char * path                     = ecl_sum->path;
@@ -192,7 +193,7 @@ static bool ecl_sum_fread_data( ecl_sum_type * ecl_sum , const stringlist_type *
 
 
 
-static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , const stringlist_type *data_files , bool include_restart) {
+static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , const stringlist_type *data_files , bool include_restart , bool lazy_load) {
   ecl_sum->smspec = ecl_smspec_fread_alloc( header_file , ecl_sum->key_join_string , include_restart);
   if (ecl_sum->smspec) {
     bool fmt_file;
@@ -201,7 +202,7 @@ static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , con
   } else
     return false;
 
-  if (ecl_sum_fread_data( ecl_sum , data_files , include_restart )) {
+  if (ecl_sum_fread_data( ecl_sum , data_files , include_restart , lazy_load )) {
     ecl_file_enum file_type = ecl_util_get_file_type( stringlist_iget( data_files , 0 ) , NULL , NULL);
 
     if (file_type == ECL_SUMMARY_FILE)
@@ -217,7 +218,7 @@ static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , con
 }
 
 
-static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart) {
+static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart , bool lazy_load) {
   char * header_file;
   stringlist_type * summary_file_list = stringlist_alloc_new();
 
@@ -225,7 +226,7 @@ static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart) {
 
   ecl_util_alloc_summary_files( ecl_sum->path , ecl_sum->base , ecl_sum->ext , &header_file , summary_file_list );
   if ((header_file != NULL) && (stringlist_get_size( summary_file_list ) > 0)) {
-    caseOK = ecl_sum_fread( ecl_sum , header_file , summary_file_list , include_restart );
+    caseOK = ecl_sum_fread( ecl_sum , header_file , summary_file_list , include_restart , lazy_load );
   }
   util_safe_free( header_file );
   stringlist_free( summary_file_list );
@@ -247,7 +248,7 @@ static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart) {
 
 ecl_sum_type * ecl_sum_fread_alloc(const char *header_file , const stringlist_type *data_files , const char * key_join_string) {
   ecl_sum_type * ecl_sum = ecl_sum_alloc__( header_file , key_join_string );
-  ecl_sum_fread( ecl_sum , header_file , data_files , false );
+  ecl_sum_fread( ecl_sum , header_file , data_files , false , false );
   return ecl_sum;
 }
 
@@ -383,12 +384,16 @@ void ecl_sum_free__(void * __ecl_sum) {
    If the SMSPEC file contains the RESTART keyword the function will
    iterate backwards to load summary information from previous runs
    (this is goverened by the local variable include_restart).
+
+   With @lazy_load == true the PARAMS data is not loaded up front;
+   the vectors are read from the summary files when they are accessed,
+   see ecl_sum_data_set_lazy_load().
 */
 
 
-ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char * key_join_string , bool include_restart){
+ecl_sum_type * ecl_sum_fread_alloc_case2__(const char * input_file , const char * key_join_string , bool include_restart , bool lazy_load){
   ecl_sum_type * ecl_sum     = ecl_sum_alloc__(input_file , key_join_string);
-  if (ecl_sum_fread_case( ecl_sum , include_restart))
+  if (ecl_sum_fread_case( ecl_sum , include_restart , lazy_load))
     return ecl_sum;
   else {
     /*
@@ -402,6 +407,11 @@ ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char *
 
 
 
+ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char * key_join_string , bool include_restart){
+  return ecl_sum_fread_alloc_case2__( input_file , key_join_string , include_restart , false );
+}
+
+
 ecl_sum_type * ecl_sum_fread_alloc_case(const char * input_file , const char * key_join_string){
   bool include_restart = true;
   return ecl_sum_fread_alloc_case__( input_file , key_join_string , include_restart );
@@ -790,6 +800,16 @@ double_vector_type * ecl_sum_alloc_data_vector( const ecl_sum_type * ecl_sum  ,
 }
 
 
+void ecl_sum_load_columns( ecl_sum_type * ecl_sum , const ecl_sum_vector_type * keylist ) {
+  ecl_sum_data_load_columns( ecl_sum->data , keylist );
+}
+
+
+void ecl_sum_get_interp_vector( const ecl_sum_type * ecl_sum , time_t sim_time , const ecl_sum_vector_type * keylist , double_vector_type * data) {
+  ecl_sum_data_get_interp_vector( ecl_sum->data , sim_time , keylist , data );
+}
+
+
 
 void ecl_sum_summarize( const ecl_sum_type * ecl_sum , FILE * stream ) {
   ecl_sum_data_summarize( ecl_sum->data , stream );
@@ -22,6 +22,8 @@
 #include <ert/util/vector.h>
 #include <ert/util/time_t_vector.h>
 #include <ert/util/int_vector.h>
+#include <ert/util/long_vector.h>
+#include <ert/util/float_vector.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/time_interval.h>
 
@@ -32,6 +34,8 @@
 #include <ert/ecl/smspec_node.h>
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_file_kw.h>
+#include <ert/ecl/fortio.h>
 #include <ert/ecl/ecl_endian_flip.h>
 #include <ert/ecl/ecl_kw_magic.h>
 #include <ert/ecl/ecl_sum_vector.h>
@@ -206,6 +210,8 @@
 
 
 #define INVALID_MINISTEP_NR -1
+#define ECL_SUM_INDEX_ID    88633
+#define ECL_SUM_INDEX_EXT   "SMRY_INDEX"
 
 
 struct ecl_sum_data_struct {
@@ -225,6 +231,10 @@ struct ecl_sum_data_struct {
   time_interval_type     * sim_time;               /* The time interval sim_time goes from the first time value where we have
                                                       data to the end of the simulation. In the case of restarts the start
                                                       value might disagree with the simulation start reported by the smspec file. */
+  int                      num_columns;
+  float                 ** columns;                /* Optional column major copy of selected vectors - indexed by params_index; see ecl_sum_data_load_columns(). */
+  bool                     lazy_load;              /* If true the tsteps do not hold data, and all access goes through the columns. */
+  stringlist_type        * src_files;              /* The files the lazy loaded tsteps point into; see ecl_sum_tstep_get_src_file_index(). */
 };
 
 
@@ -233,7 +243,46 @@ struct ecl_sum_data_struct {
 
 /*****************************************************************/
 
+static void ecl_sum_data_free_columns( ecl_sum_data_type * data ) {
+  if (data->columns) {
+    int i;
+    for (i=0; i < data->num_columns; i++)
+      util_safe_free( data->columns[i] );
+
+    free( data->columns );
+    data->columns = NULL;
+    data->num_columns = 0;
+  }
+}
+
+
+static void ecl_sum_data_load_column_list( ecl_sum_data_type * data , const int_vector_type * params_list );
+
+/*
+  For lazy loaded data the column is loaded on first access. Observe
+  that this modifies the data instance also through the const
+  accessors; lazy loaded instances should therefore not be shared
+  between threads without loading the columns up front with
+  ecl_sum_data_load_columns().
+*/
+
+static const float * ecl_sum_data_get_column( const ecl_sum_data_type * data , int params_index ) {
+  if ((params_index < data->num_columns) && data->columns[ params_index ])
+    return data->columns[ params_index ];
+
+  if (data->lazy_load) {
+    int_vector_type * params_list = int_vector_alloc( 1 , params_index );
+    ecl_sum_data_load_column_list( (ecl_sum_data_type *) data , params_list );
+    int_vector_free( params_list );
+    return data->columns[ params_index ];
+  } else
+    return NULL;
+}
+
+
  void ecl_sum_data_free( ecl_sum_data_type * data ) {
+  ecl_sum_data_free_columns( data );
+  stringlist_free( data->src_files );
   vector_free( data->data );
   int_vector_free( data->report_first_index );
   int_vector_free( data->report_last_index  );
@@ -272,12 +321,38 @@ ecl_sum_data_type * ecl_sum_data_alloc(ecl_smspec_type * smspec) {
   data->report_first_index    = int_vector_alloc( 0 , INVALID_MINISTEP_NR );
   data->report_last_index     = int_vector_alloc( 0 , INVALID_MINISTEP_NR );
   data->sim_time              = time_interval_alloc_open();
+  data->num_columns           = 0;
+  data->columns               = NULL;
+  data->lazy_load             = false;
+  data->src_files             = stringlist_alloc_new();
 
   ecl_sum_data_clear_index( data );
   return data;
 }
 
 
+/**
+   When lazy loading is enabled the PARAMS data is not read when the
+   summary files are loaded; only the position of the PARAMS keywords
+   and the time information is recorded. The vectors are read from
+   the files when they are first accessed, or explicitly with
+   ecl_sum_data_load_columns(). Must be called before the data is
+   loaded; lazy loading is only supported for unformatted files.
+*/
+
+void ecl_sum_data_set_lazy_load( ecl_sum_data_type * data , bool lazy_load ) {
+  if (vector_get_size( data->data ) > 0)
+    util_abort("%s: lazy loading must be selected before the data is loaded \n",__func__);
+
+  data->lazy_load = lazy_load;
+}
+
+
+bool ecl_sum_data_get_lazy_load( const ecl_sum_data_type * data ) {
+  return data->lazy_load;
+}
+
+
 /**
    This function will take a report as input , and update the two
    pointers ministep1 and ministep2 with the range of the report step
@@ -323,6 +398,9 @@ ecl_sum_data_type * ecl_sum_data_alloc_writer( ecl_smspec_type * smspec ) {
 
 
 static void ecl_sum_data_fwrite_report__( const ecl_sum_data_type * data , int report_step , fortio_type * fortio) {
+  if (data->lazy_load)
+    util_abort("%s: can not write lazy loaded summary data \n",__func__);
+
   {
     ecl_kw_type * seqhdr_kw = ecl_kw_alloc( SEQHDR_KW , SEQHDR_SIZE , ECL_INT_TYPE );
     ecl_kw_iset_int( seqhdr_kw , 0 , 0 );
@@ -671,7 +749,7 @@ double_vector_type * ecl_sum_data_alloc_seconds_solution( const ecl_sum_data_typ
     int index = 0;
     const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , index );
     const ecl_sum_tstep_type * prev_ministep;
-    double value = ecl_sum_tstep_iget( ministep , param_index );
+    double value = ecl_sum_data_iget( data , index , param_index );
     double prev_value;
 
     while (true) {
@@ -683,7 +761,7 @@ double_vector_type * ecl_sum_data_alloc_seconds_solution( const ecl_sum_data_typ
       prev_value = value;
 
       ministep = ecl_sum_data_iget_ministep( data , index );
-      value = ecl_sum_tstep_iget( ministep , param_index );
+      value = ecl_sum_data_iget( data , index , param_index );
 
       if ((value == cmp_value) ||
           (((value - cmp_value) * (cmp_value - prev_value)) > 0)) {
@@ -750,6 +828,7 @@ static void ecl_sum_data_append_tstep__( ecl_sum_data_type * data , int ministep
 
   vector_append_owned_ref( data->data , tstep , ecl_sum_tstep_free__);
   data->index_valid = false;
+  ecl_sum_data_free_columns( data );
 }
 
 
@@ -780,6 +859,7 @@ static int cmp_ministep( const void * arg1 , const void * arg2) {
 static void ecl_sum_data_build_index( ecl_sum_data_type * sum_data ) {
   /* Clear the existing index (if any): */
   ecl_sum_data_clear_index( sum_data );
+  ecl_sum_data_free_columns( sum_data );
 
   /*
     Sort the internal storage vector after sim_time.
@@ -959,6 +1039,288 @@ static bool ecl_sum_data_check_file( ecl_file_type * ecl_file ) {
 }
 
 
+/*****************************************************************/
+/*
+  Lazy loading: the summary files are scanned once and the position
+  of all the PARAMS keywords is recorded in an index, together with
+  the report step, the ministep number and the time information of
+  each ministep. The index for one set of files is stored in a
+  sidecar file BASE.SMRY_INDEX next to the summary files, and reused
+  as long as the summary files have the same size and modification
+  time.
+*/
+
+typedef struct {
+  stringlist_type   * files;
+  int_vector_type   * file_index;
+  int_vector_type   * report_step;
+  int_vector_type   * ministep;
+  long_vector_type  * params_offset;
+  float_vector_type * time_data;      /* int_vector_size( time_map ) elements per ministep. */
+} ecl_sum_index_type;
+
+
+static ecl_sum_index_type * ecl_sum_index_alloc( ) {
+  ecl_sum_index_type * index = util_malloc( sizeof * index );
+  index->files         = stringlist_alloc_new( );
+  index->file_index    = int_vector_alloc( 0 , 0 );
+  index->report_step   = int_vector_alloc( 0 , 0 );
+  index->ministep      = int_vector_alloc( 0 , 0 );
+  index->params_offset = long_vector_alloc( 0 , 0 );
+  index->time_data     = float_vector_alloc( 0 , 0 );
+  return index;
+}
+
+
+static void ecl_sum_index_free( ecl_sum_index_type * index ) {
+  stringlist_free( index->files );
+  int_vector_free( index->file_index );
+  int_vector_free( index->report_step );
+  int_vector_free( index->ministep );
+  long_vector_free( index->params_offset );
+  float_vector_free( index->time_data );
+  free( index );
+}
+
+
+/*
+  The params indices which hold the time information; see
+  ecl_sum_tstep_set_time_info().
+*/
+
+static int_vector_type * ecl_sum_data_alloc_time_map( const ecl_sum_data_type * data ) {
+  int_vector_type * time_map = int_vector_alloc( 0 , 0 );
+
+  if (ecl_smspec_get_time_index( data->smspec ) >= 0)
+    int_vector_append( time_map , ecl_smspec_get_time_index( data->smspec ));
+  else if (ecl_smspec_get_date_day_index( data->smspec ) >= 0) {
+    int_vector_append( time_map , ecl_smspec_get_date_day_index( data->smspec ));
+    int_vector_append( time_map , ecl_smspec_get_date_month_index( data->smspec ));
+    int_vector_append( time_map , ecl_smspec_get_date_year_index( data->smspec ));
+  } else
+    util_abort("%s: Hmmm - could not extract date/time information from SMSPEC header file? \n",__func__);
+
+  return time_map;
+}
+
+
+static void ecl_sum_index_add_view( ecl_sum_index_type * index ,
+                                    int file_index ,
+                                    int report_step ,
+                                    const ecl_file_view_type * summary_view ,
+                                    const int_vector_type * time_map ,
+                                    int params_size) {
+  int num_ministep = ecl_file_view_get_num_named_kw( summary_view , PARAMS_KW );
+  float * time_data = util_calloc( int_vector_size( time_map ) , sizeof * time_data );
+  int ikw;
+
+  for (ikw = 0; ikw < num_ministep; ikw++) {
+    if (ecl_file_view_iget_named_size( summary_view , PARAMS_KW , ikw ) == params_size) {
+      ecl_kw_type * ministep_kw = ecl_file_view_iget_named_kw( summary_view , MINISTEP_KW , ikw);
+      ecl_file_kw_type * params_file_kw = ecl_file_view_iget_named_file_kw( summary_view , PARAMS_KW , ikw );
+      int i;
+
+      ecl_file_view_index_fload_kw( summary_view , PARAMS_KW , ikw , time_map , (char *) time_data );
+      for (i=0; i < int_vector_size( time_map ); i++)
+        float_vector_append( index->time_data , time_data[i] );
+
+      int_vector_append( index->file_index , file_index );
+      int_vector_append( index->report_step , report_step );
+      int_vector_append( index->ministep , ecl_kw_iget_int( ministep_kw , 0 ));
+      long_vector_append( index->params_offset , ecl_file_kw_get_offset( params_file_kw ));
+    } else
+      fprintf(stderr , "** Warning size mismatch between timestep loaded from:%s and header - timestep discarded.\n" ,
+              stringlist_iget( index->files , file_index ));
+  }
+  free( time_data );
+}
+
+
+static ecl_sum_index_type * ecl_sum_index_alloc_scan( const stringlist_type * filelist , const int_vector_type * time_map , int params_size) {
+  ecl_sum_index_type * index = ecl_sum_index_alloc( );
+  int filenr;
+
+  for (filenr = 0; filenr < stringlist_get_size( filelist ); filenr++) {
+    const char * data_file = stringlist_iget( filelist , filenr );
+    int report_step;
+    ecl_file_enum file_type = ecl_util_get_file_type( data_file , NULL , &report_step );
+    ecl_file_type * ecl_file = ecl_file_open( data_file , 0 );
+
+    stringlist_append_copy( index->files , data_file );
+    if (ecl_file && ecl_sum_data_check_file( ecl_file )) {
+      if (file_type == ECL_UNIFIED_SUMMARY_FILE) {
+        /* ECLIPSE counts report steps from 1; the SEQHDR blocks from 0. */
+        report_step = 1;
+        while (true) {
+          ecl_file_view_type * summary_view = ecl_file_get_summary_view( ecl_file , report_step - 1 );
+          if (summary_view) {
+            ecl_sum_index_add_view( index , filenr , report_step , summary_view , time_map , params_size );
+            report_step++;
+          } else break;
+        }
+      } else
+        ecl_sum_index_add_view( index , filenr , report_step , ecl_file_get_global_view( ecl_file ) , time_map , params_size );
+    }
+
+    if (ecl_file)
+      ecl_file_close( ecl_file );
+  }
+  return index;
+}
+
+
+static char * ecl_sum_index_alloc_filename( const stringlist_type * filelist ) {
+  char * path;
+  char * base;
+  char * index_file;
+
+  util_alloc_file_components( stringlist_iget( filelist , 0 ) , &path , &base , NULL );
+  index_file = util_alloc_filename( path , base , ECL_SUM_INDEX_EXT );
+
+  util_safe_free( path );
+  free( base );
+  return index_file;
+}
+
+
+static void ecl_sum_index_fwrite( const ecl_sum_index_type * index , const char * index_file , int params_size , int time_size) {
+  char * tmp_file = util_alloc_sprintf( "%s.tmp" , index_file );
+  FILE * stream = util_fopen__( tmp_file , "w" );
+
+  /* The sidecar file is only a cache; if it can not be written we just carry on. */
+  if (stream) {
+    int i;
+    util_fwrite_int( ECL_SUM_INDEX_ID , stream );
+    util_fwrite_int( params_size , stream );
+    util_fwrite_int( time_size , stream );
+    util_fwrite_int( stringlist_get_size( index->files ) , stream );
+    for (i=0; i < stringlist_get_size( index->files ); i++) {
+      const char * data_file = stringlist_iget( index->files , i );
+      util_fwrite_string( data_file , stream );
+      util_fwrite_long( util_file_size( data_file ) , stream );
+      util_fwrite_time_t( util_file_mtime( data_file ) , stream );
+    }
+
+    int_vector_fwrite( index->file_index , stream );
+    int_vector_fwrite( index->report_step , stream );
+    int_vector_fwrite( index->ministep , stream );
+    long_vector_fwrite( index->params_offset , stream );
+    float_vector_fwrite( index->time_data , stream );
+    fclose( stream );
+
+    if (rename( tmp_file , index_file ) != 0)
+      util_unlink_existing( tmp_file );
+  }
+  free( tmp_file );
+}
+
+
+/*
+  Will return NULL if the index file does not exist, or if it does not
+  match the current summary files.
+*/
+
+static ecl_sum_index_type * ecl_sum_index_fread_alloc( const char * index_file , const stringlist_type * filelist , int params_size , int time_size) {
+  ecl_sum_index_type * index = NULL;
+  FILE * stream;
+
+  if (!util_file_exists( index_file ))
+    return NULL;
+
+  stream = util_fopen__( index_file , "r" );
+  if (stream) {
+    bool valid = false;
+
+    if ((util_fread_int( stream ) == ECL_SUM_INDEX_ID) &&
+        (util_fread_int( stream ) == params_size) &&
+        (util_fread_int( stream ) == time_size) &&
+        (util_fread_int( stream ) == stringlist_get_size( filelist ))) {
+      int i;
+
+      valid = true;
+      for (i=0; i < stringlist_get_size( filelist ); i++) {
+        const char * data_file = stringlist_iget( filelist , i );
+        char * index_data_file = util_fread_alloc_string( stream );
+        long   size = util_fread_long( stream );
+        time_t mtime = util_fread_time_t( stream );
+
+        if (!util_string_equal( data_file , index_data_file ) ||
+            (size != util_file_size( data_file )) ||
+            (mtime != util_file_mtime( data_file )))
+          valid = false;
+
+        free( index_data_file );
+        if (!valid)
+          break;
+      }
+    }
+
+    if (valid) {
+      index = ecl_sum_index_alloc( );
+      stringlist_deep_copy( index->files , filelist );
+      int_vector_fread( index->file_index , stream );
+      int_vector_fread( index->report_step , stream );
+      int_vector_fread( index->ministep , stream );
+      long_vector_fread( index->params_offset , stream );
+      float_vector_fread( index->time_data , stream );
+    }
+    fclose( stream );
+  }
+  return index;
+}
+
+
+static void ecl_sum_data_add_index( ecl_sum_data_type * data , time_t load_end , const ecl_sum_index_type * index , const int_vector_type * time_map) {
+  int params_size = ecl_smspec_get_params_size( data->smspec );
+  int time_size = int_vector_size( time_map );
+  int file_offset = stringlist_get_size( data->src_files );
+  float * time_data = util_calloc( params_size , sizeof * time_data );
+  int i;
+
+  stringlist_append_stringlist_copy( data->src_files , index->files );
+  for (i=0; i < int_vector_size( index->ministep ); i++) {
+    int ministep_nr = int_vector_iget( index->ministep , i );
+    ecl_sum_tstep_type * tstep;
+    int j;
+
+    for (j=0; j < time_size; j++)
+      time_data[ int_vector_iget( time_map , j ) ] = float_vector_iget( index->time_data , i * time_size + j );
+
+    tstep = ecl_sum_tstep_alloc_lazy( int_vector_iget( index->report_step , i ) ,
+                                      ministep_nr ,
+                                      time_data ,
+                                      file_offset + int_vector_iget( index->file_index , i ) ,
+                                      long_vector_iget( index->params_offset , i ) ,
+                                      data->smspec );
+
+    if (load_end == 0 || (ecl_sum_tstep_get_sim_time( tstep ) < load_end))
+      ecl_sum_data_append_tstep__( data , ministep_nr , tstep );
+    else
+      ecl_sum_tstep_free( tstep );
+  }
+  free( time_data );
+}
+
+
+static void ecl_sum_data_fread_lazy( ecl_sum_data_type * data , time_t load_end , const stringlist_type * filelist) {
+  int params_size = ecl_smspec_get_params_size( data->smspec );
+  int_vector_type * time_map = ecl_sum_data_alloc_time_map( data );
+  char * index_file = ecl_sum_index_alloc_filename( filelist );
+  ecl_sum_index_type * index = ecl_sum_index_fread_alloc( index_file , filelist , params_size , int_vector_size( time_map ));
+
+  if (index == NULL) {
+    index = ecl_sum_index_alloc_scan( filelist , time_map , params_size );
+    ecl_sum_index_fwrite( index , index_file , params_size , int_vector_size( time_map ));
+  }
+
+  ecl_sum_data_add_index( data , load_end , index , time_map );
+
+  ecl_sum_index_free( index );
+  free( index_file );
+  int_vector_free( time_map );
+}
+
+
 /*
   Observe that this can be called several times (but not with the same
   data - that will die).
@@ -973,13 +1335,18 @@ static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , c
     return false;
 
   {
-    ecl_file_enum file_type = ecl_util_get_file_type( stringlist_iget( filelist , 0 ) , NULL , NULL);
+    bool fmt_file;
+    ecl_file_enum file_type = ecl_util_get_file_type( stringlist_iget( filelist , 0 ) , &fmt_file , NULL);
     if ((stringlist_get_size( filelist ) > 1) && (file_type != ECL_SUMMARY_FILE))
       util_abort("%s: internal error - when calling with more than one file - you can not supply a unified file - come on?! \n",__func__);
 
     {
       int filenr;
-      if (file_type == ECL_SUMMARY_FILE) {
+      if (data->lazy_load && !fmt_file) {
+        if ((file_type != ECL_SUMMARY_FILE) && (file_type != ECL_UNIFIED_SUMMARY_FILE))
+          util_abort("%s: invalid file type:%s \n",__func__ , ecl_util_file_type_name(file_type ));
+        ecl_sum_data_fread_lazy( data , load_end , filelist );
+      } else if (file_type == ECL_SUMMARY_FILE) {
 
         /* Not unified. */
         for (filenr = 0; filenr < stringlist_get_size( filelist ); filenr++) {
@@ -1155,8 +1522,13 @@ int ecl_sum_data_iget_mini_step(const ecl_sum_data_type * data , int internal_in
 
 
 double ecl_sum_data_iget( const ecl_sum_data_type * data , int time_index , int params_index ) {
-  const ecl_sum_tstep_type * ministep_data = ecl_sum_data_iget_ministep( data , time_index  );
-  return ecl_sum_tstep_iget( ministep_data , params_index);
+  const float * column = ecl_sum_data_get_column( data , params_index );
+  if (column)
+    return column[ time_index ];
+  else {
+    const ecl_sum_tstep_type * ministep_data = ecl_sum_data_iget_ministep( data , time_index  );
+    return ecl_sum_tstep_iget( ministep_data , params_index);
+  }
 }
 
 
@@ -1173,42 +1545,58 @@ double ecl_sum_data_iget( const ecl_sum_data_type * data , int time_index , int
 */
 
 double ecl_sum_data_interp_get(const ecl_sum_data_type * data , int time_index1 , int time_index2 , double weight1 , double weight2 , int params_index) {
-  const ecl_sum_tstep_type * ministep_data1 = ecl_sum_data_iget_ministep( data , time_index1 );
-  const ecl_sum_tstep_type * ministep_data2 = ecl_sum_data_iget_ministep( data , time_index2 );
-
-  return ecl_sum_tstep_iget( ministep_data1 , params_index ) * weight1 + ecl_sum_tstep_iget( ministep_data2 , params_index ) * weight2;
+  return ecl_sum_data_iget( data , time_index1 , params_index ) * weight1 + ecl_sum_data_iget( data , time_index2 , params_index ) * weight2;
 }
 
 
-void ecl_sum_data_fwrite_interp_csv_line(const ecl_sum_data_type * data , time_t sim_time, const ecl_sum_vector_type * keylist, FILE *fp){
-    int num_keywords = ecl_sum_vector_get_size(keylist);
-    double weight1 , weight2;
-    int    time_index1 , time_index2;
-    double value = 0.0;
-    int i;
+/**
+   Will fill the results vector with the values of all the variables
+   in the keylist at time sim_time; rate variables are not
+   interpolated, see ecl_sum_data_get_from_sim_time(). The time
+   lookup is only done once for all the variables.
+*/
 
-    ecl_sum_data_init_interp_from_sim_time( data , sim_time , &time_index1 , &time_index2 , &weight1 , &weight2);
-    for(i = 0; i< num_keywords; i++  ){
-        bool is_rate = ecl_sum_vector_iget_is_rate(keylist, i);
-        int params_index = ecl_sum_vector_iget_param_index(keylist , i);
-        if(is_rate){
-            int time_index;
-            if (sim_time == time_interval_get_start( data->sim_time ))
-                time_index = 0;
-            else
-                time_index = ecl_sum_data_get_index_from_sim_time( data , sim_time );
+void ecl_sum_data_get_interp_vector( const ecl_sum_data_type * data , time_t sim_time , const ecl_sum_vector_type * keylist , double_vector_type * results) {
+  int num_keywords = ecl_sum_vector_get_size( keylist );
+  double weight1 , weight2;
+  int    time_index1 , time_index2;
+  int    rate_index = INVALID_MINISTEP_NR;
+  int i;
 
-           value = ecl_sum_data_iget( data , time_index , params_index);
-        } else {
-           value = ecl_sum_data_interp_get( data , time_index1 , time_index2 , weight1 , weight2 , params_index);
+  ecl_sum_data_init_interp_from_sim_time( data , sim_time , &time_index1 , &time_index2 , &weight1 , &weight2);
+  double_vector_reset( results );
+  for (i = 0; i < num_keywords; i++) {
+    int params_index = ecl_sum_vector_iget_param_index( keylist , i );
+    double value;
+
+    if (ecl_sum_vector_iget_is_rate( keylist , i )) {
+      if (rate_index == INVALID_MINISTEP_NR) {
+        if (sim_time == time_interval_get_start( data->sim_time ))
+          rate_index = 0;
+        else
+          rate_index = ecl_sum_data_get_index_from_sim_time( data , sim_time );
+      }
+      value = ecl_sum_data_iget( data , rate_index , params_index );
+    } else
+      value = ecl_sum_data_interp_get( data , time_index1 , time_index2 , weight1 , weight2 , params_index );
 
-        }
-        if(i == 0){
-            fprintf(fp , "%f",value);
-        }else{
-            fprintf(fp , ",%f",value);
-        }
-    }
+    double_vector_iset( results , i , value );
+  }
+}
+
+
+void ecl_sum_data_fwrite_interp_csv_line(const ecl_sum_data_type * data , time_t sim_time, const ecl_sum_vector_type * keylist, FILE *fp){
+  double_vector_type * values = double_vector_alloc( 0 , 0 );
+  int i;
+
+  ecl_sum_data_get_interp_vector( data , sim_time , keylist , values );
+  for (i = 0; i < double_vector_size( values ); i++) {
+    if (i == 0)
+      fprintf(fp , "%f", double_vector_iget( values , i ));
+    else
+      fprintf(fp , ",%f", double_vector_iget( values , i ));
+  }
+  double_vector_free( values );
 }
 
 
@@ -1421,22 +1809,137 @@ time_t_vector_type *  ecl_sum_data_alloc_time_vector( const ecl_sum_data_type *
 
 
 void ecl_sum_data_init_data_vector( const ecl_sum_data_type * data , double_vector_type * data_vector , int data_index , bool report_only) {
+  const float * column = ecl_sum_data_get_column( data , data_index );
   double_vector_reset( data_vector );
   double_vector_append( data_vector , ecl_smspec_get_start_time( data->smspec ));
   if (report_only) {
     int report_step;
     for (report_step = data->first_report_step; report_step <= data->last_report_step; report_step++) {
       int last_index = int_vector_iget(data->report_last_index , report_step);
-      const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , last_index );
-      double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+      double_vector_append( data_vector , ecl_sum_data_iget( data , last_index , data_index ));
     }
   } else {
+    int size = vector_get_size(data->data);
     int i;
-    for (i = 0; i < vector_get_size(data->data); i++) {
-      const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , i  );
-      double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+
+    if (column) {
+      double * values;
+      double_vector_resize( data_vector , size + 1 );
+      values = double_vector_get_ptr( data_vector );
+      for (i = 0; i < size; i++)
+        values[i + 1] = column[i];
+    } else {
+      for (i = 0; i < size; i++) {
+        const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , i  );
+        double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+      }
+    }
+  }
+}
+
+
+/**
+   The summary data is stored as one row per ministep; extracting one
+   vector therefore involves visiting all the ministeps. This function
+   will create a column major copy of the vectors in the keylist; all
+   the vectors are extracted in one pass through the ministeps. When a
+   column has been loaded the _iget(), _interp_get() and
+   _init_data_vector() functions will use the column.
+
+   The columns are discarded when more timesteps are added; and they
+   are not updated if the data of an existing timestep is modified
+   with ecl_sum_tstep_iset(). For lazy loaded data the columns are
+   read directly from the summary files; this is the only way to get
+   to the data of a lazy loaded instance.
+*/
+
+static void ecl_sum_data_fread_column_list( ecl_sum_data_type * data , const int_vector_type * params_list ) {
+  int params_size = ecl_smspec_get_params_size( data->smspec );
+  int num_load = int_vector_size( params_list );
+  float * buffer = util_calloc( num_load , sizeof * buffer );
+  fortio_type * fortio = NULL;
+  int current_file = -1;
+  int time_index;
+
+  for (time_index = 0; time_index < vector_get_size( data->data ); time_index++) {
+    const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , time_index );
+    int j;
+
+    if (ecl_sum_tstep_has_data( ministep )) {
+      for (j = 0; j < num_load; j++)
+        buffer[j] = ecl_sum_tstep_iget( ministep , int_vector_iget( params_list , j ));
+    } else {
+      int file_index = ecl_sum_tstep_get_src_file_index( ministep );
+      if (file_index != current_file) {
+        const char * src_file = stringlist_iget( data->src_files , file_index );
+
+        if (fortio)
+          fortio_fclose( fortio );
+
+        fortio = fortio_open_reader( src_file , false , ECL_ENDIAN_FLIP );
+        if (fortio == NULL)
+          util_abort("%s: failed to open summary file:%s \n",__func__ , src_file);
+        current_file = file_index;
+      }
+
+      ecl_kw_fread_indexed_data( fortio ,
+                                 ecl_sum_tstep_get_params_offset( ministep ) + ECL_KW_HEADER_FORTIO_SIZE ,
+                                 ECL_FLOAT_TYPE ,
+                                 params_size ,
+                                 params_list ,
+                                 (char *) buffer );
+    }
+
+    for (j = 0; j < num_load; j++)
+      data->columns[ int_vector_iget( params_list , j ) ][ time_index ] = buffer[j];
+  }
+
+  if (fortio)
+    fortio_fclose( fortio );
+  free( buffer );
+}
+
+
+static void ecl_sum_data_load_column_list( ecl_sum_data_type * data , const int_vector_type * params_list ) {
+  int params_size = ecl_smspec_get_params_size( data->smspec );
+  int size = vector_get_size( data->data );
+  int_vector_type * load_list = int_vector_alloc( 0 , 0 );
+  int i;
+
+  if (data->num_columns < params_size) {
+    data->columns = util_realloc( data->columns , params_size * sizeof * data->columns );
+    for (i = data->num_columns; i < params_size; i++)
+      data->columns[i] = NULL;
+    data->num_columns = params_size;
+  }
+
+  for (i = 0; i < int_vector_size( params_list ); i++) {
+    int params_index = int_vector_iget( params_list , i );
+    if ((params_index < 0) || (params_index >= params_size))
+      util_abort("%s: param index:%d invalid: Valid range: [0,%d) \n",__func__ , params_index , params_size);
+
+    if (data->columns[ params_index ] == NULL) {
+      data->columns[ params_index ] = util_calloc( size , sizeof * data->columns[ params_index ]);
+      int_vector_append( load_list , params_index );
     }
   }
+
+  if (int_vector_size( load_list ) > 0)
+    ecl_sum_data_fread_column_list( data , load_list );
+
+  int_vector_free( load_list );
+}
+
+
+void ecl_sum_data_load_columns( ecl_sum_data_type * data , const ecl_sum_vector_type * keylist ) {
+  int_vector_type * params_list = int_vector_alloc( 0 , 0 );
+  int i;
+
+  for (i = 0; i < ecl_sum_vector_get_size( keylist ); i++)
+    int_vector_append( params_list , ecl_sum_vector_iget_param_index( keylist , i ));
+
+  ecl_sum_data_load_column_list( data , params_list );
+  int_vector_free( params_list );
 }
 
 
@@ -1460,6 +1963,17 @@ int ecl_sum_data_get_length( const ecl_sum_data_type * data ) {
 
 void ecl_sum_data_scale_vector(ecl_sum_data_type * data, int index, double scalar) {
   int len = vector_get_size(data->data);
+  if (data->lazy_load) {
+    float * column = (float *) ecl_sum_data_get_column( data , index );
+    for (int i = 0; i < len; i++)
+      column[i] *= scalar;
+    return;
+  }
+
+  if (ecl_sum_data_get_column( data , index )) {
+    free( data->columns[ index ] );
+    data->columns[ index ] = NULL;
+  }
   for (int i = 0; i < len; i++) {
     ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep(data,i);
     ecl_sum_tstep_iscale(ministep, index, scalar);
@@ -1468,6 +1982,17 @@ void ecl_sum_data_scale_vector(ecl_sum_data_type * data, int index, double scala
 
 void ecl_sum_data_shift_vector(ecl_sum_data_type * data, int index, double addend) {
   int len = vector_get_size(data->data);
+  if (data->lazy_load) {
+    float * column = (float *) ecl_sum_data_get_column( data , index );
+    for (int i = 0; i < len; i++)
+      column[i] += addend;
+    return;
+  }
+
+  if (ecl_sum_data_get_column( data , index )) {
+    free( data->columns[ index ] );
+    data->columns[ index ] = NULL;
+  }
   for (int i = 0; i < len; i++) {
     ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep(data,i);
     ecl_sum_tstep_ishift(ministep, index, addend);
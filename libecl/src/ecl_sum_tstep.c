@@ -65,6 +65,8 @@ struct ecl_sum_tstep_struct {
   double                   sim_seconds;     /* Accumulated simulation time up to this ministep. */
   int                      data_size;       /* Number of elements in data - only used for checking indices. */
   int                      internal_index;  /* Used for lookups of the next / previous ministep based on an existing ministep. */
+  int                      src_file_index;  /* For lazy loaded tsteps: index of the file the PARAMS keyword is in - otherwise -1. */
+  offset_type              params_offset;   /* For lazy loaded tsteps: offset of the PARAMS keyword header in the file. */
   const ecl_smspec_type  * smspec;          /* The smespec header information for this tstep - must be compatible. */
 };
 
@@ -77,6 +79,8 @@ static ecl_sum_tstep_type * ecl_sum_tstep_alloc( int report_step , int ministep_
   tstep->ministep    = ministep_nr;
   tstep->data_size   = ecl_smspec_get_params_size( smspec );
   tstep->data        = util_calloc( tstep->data_size , sizeof * tstep->data );
+  tstep->src_file_index = -1;
+  tstep->params_offset  = 0;
   return tstep;
 }
 
@@ -134,7 +138,7 @@ static void ecl_sum_tstep_set_time_info_from_date( ecl_sum_tstep_type * tstep ,
 }
 
 
-static void ecl_sum_tstep_set_time_info( ecl_sum_tstep_type * tstep , const ecl_smspec_type * smspec ) {
+static void ecl_sum_tstep_set_time_info( ecl_sum_tstep_type * tstep , const ecl_smspec_type * smspec , const float * data) {
   int date_day_index   = ecl_smspec_get_date_day_index( smspec );
   int date_month_index = ecl_smspec_get_date_month_index( smspec );
   int date_year_index  = ecl_smspec_get_date_year_index( smspec );
@@ -142,13 +146,13 @@ static void ecl_sum_tstep_set_time_info( ecl_sum_tstep_type * tstep , const ecl_
   time_t sim_start     = ecl_smspec_get_start_time( smspec );
 
   if (sim_time_index >= 0) {
-    float sim_time = tstep->data[ sim_time_index ];
+    float sim_time = data[ sim_time_index ];
     double sim_seconds = sim_time * ecl_smspec_get_time_seconds( smspec );
     ecl_sum_tstep_set_time_info_from_seconds( tstep , sim_start , sim_seconds );
   } else if ( date_day_index >= 0) {
-    int day   = util_roundf(tstep->data[date_day_index]);
-    int month = util_roundf(tstep->data[date_month_index]);
-    int year  = util_roundf(tstep->data[date_year_index]);
+    int day   = util_roundf(data[date_day_index]);
+    int month = util_roundf(data[date_month_index]);
+    int year  = util_roundf(data[date_year_index]);
 
     time_t sim_time = ecl_util_make_date(day , month , year);
     ecl_sum_tstep_set_time_info_from_date( tstep , sim_start , sim_time );
@@ -176,7 +180,7 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_from_file( int report_step    ,
   if (data_size == ecl_smspec_get_params_size( smspec )) {
     ecl_sum_tstep_type * ministep = ecl_sum_tstep_alloc( report_step , ministep_nr , smspec);
     ecl_kw_get_memcpy_data( params_kw , ministep->data );
-    ecl_sum_tstep_set_time_info( ministep , smspec );
+    ecl_sum_tstep_set_time_info( ministep , smspec , ministep->data );
     return ministep;
   } else {
     /*
@@ -191,6 +195,35 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_from_file( int report_step    ,
 }
 
 
+/**
+   Allocates a tstep without the PARAMS data; only the position of
+   the PARAMS keyword in the source file is recorded, and the data
+   must be read by the owner (i.e. ecl_sum_data) when needed. The
+   @time_data vector is indexed with params_index, but only the
+   elements holding time information (DAYS or DAY/MONTH/YEAR) are
+   used.
+*/
+
+ecl_sum_tstep_type * ecl_sum_tstep_alloc_lazy( int report_step ,
+                                               int ministep_nr ,
+                                               const float * time_data ,
+                                               int src_file_index ,
+                                               offset_type params_offset ,
+                                               const ecl_smspec_type * smspec) {
+  ecl_sum_tstep_type * tstep = util_malloc( sizeof * tstep );
+  UTIL_TYPE_ID_INIT( tstep , ECL_SUM_TSTEP_ID);
+  tstep->smspec         = smspec;
+  tstep->report_step    = report_step;
+  tstep->ministep       = ministep_nr;
+  tstep->data_size      = ecl_smspec_get_params_size( smspec );
+  tstep->data           = NULL;
+  tstep->src_file_index = src_file_index;
+  tstep->params_offset  = params_offset;
+  ecl_sum_tstep_set_time_info( tstep , smspec , time_data );
+  return tstep;
+}
+
+
 /*
   Should be called in write mode.
 */
@@ -209,6 +242,11 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_new( int report_step , int ministep , f
 
 
 double ecl_sum_tstep_iget(const ecl_sum_tstep_type * ministep , int index) {
+  if (ministep->data == NULL) {
+    util_abort("%s: the data of lazy loaded ministep:%d has not been loaded \n",__func__ , ministep->ministep);
+    return -1;
+  }
+
   if ((index >= 0) && (index < ministep->data_size))
     return ministep->data[index];
   else {
@@ -241,6 +279,24 @@ int ecl_sum_tstep_get_ministep(const ecl_sum_tstep_type * ministep) {
 }
 
 
+bool ecl_sum_tstep_has_data(const ecl_sum_tstep_type * ministep) {
+  if (ministep->data)
+    return true;
+  else
+    return false;
+}
+
+
+int ecl_sum_tstep_get_src_file_index(const ecl_sum_tstep_type * ministep) {
+  return ministep->src_file_index;
+}
+
+
+offset_type ecl_sum_tstep_get_params_offset(const ecl_sum_tstep_type * ministep) {
+  return ministep->params_offset;
+}
+
+
 /*****************************************************************/
 
 void ecl_sum_tstep_fwrite( const ecl_sum_tstep_type * ministep , const int_vector_type * index_map , fortio_type * fortio) {
@@ -272,6 +328,9 @@ void ecl_sum_tstep_fwrite( const ecl_sum_tstep_type * ministep , const int_vecto
 /*****************************************************************/
 
 void ecl_sum_tstep_iset( ecl_sum_tstep_type * tstep , int index , float value) {
+  if (tstep->data == NULL)
+    util_abort("%s: can not modify lazy loaded ministep:%d \n",__func__ , tstep->ministep);
+
   if ((index < tstep->data_size) && (index >= 0))
     tstep->data[index] = value;
   else
@@ -22,6 +22,12 @@
 #include <string.h>
 #include <errno.h>
 
+#include "ert/util/build_config.h"
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 #include <ert/util/util.h>
 #include <ert/util/type_macros.h>
 #include <ert/ecl/fortio.h>
@@ -90,6 +96,17 @@ struct fortio_struct {
   */
   bool               readable;
   offset_type        read_size;
+
+  /*
+    If the file has been memory mapped with fortio_mmap() the
+    mmap_data pointer points to the start of a read-only mapping of
+    the complete file; the record structure of the mapped region has
+    been validated once when the mapping was created. The FILE stream
+    is still used as the file position, i.e. fortio_ftell() and
+    fortio_fseek() work as before.
+  */
+  char             * mmap_data;
+  size_t             mmap_size;
 };
 
 
@@ -105,6 +122,8 @@ static fortio_type * fortio_alloc__(const char *filename , bool fmt_file , bool
   fortio->stream_owner       = stream_owner;
   fortio->read_size          = 0;
   fortio->readable           = readable;
+  fortio->mmap_data          = NULL;
+  fortio->mmap_size          = 0;
   return fortio;
 }
 
@@ -395,7 +414,10 @@ bool fortio_assert_stream_open( fortio_type * fortio ) {
 /*****************************************************************/
 
 
+static void fortio_munmap( fortio_type * fortio );
+
 static void fortio_free__(fortio_type * fortio) {
+  fortio_munmap( fortio );
   util_safe_free(fortio->filename);
   free(fortio);
 }
@@ -466,9 +488,9 @@ int fortio_init_read(fortio_type *fortio) {
 
 
 bool fortio_data_fskip(fortio_type* fortio, const int element_size, const int element_count, const int block_count) {
-  int headers = block_count * 4;
-  int trailers = block_count * 4;
-  int bytes_to_skip = headers + trailers + (element_size * element_count);
+  offset_type headers = (offset_type) block_count * 4;
+  offset_type trailers = (offset_type) block_count * 4;
+  offset_type bytes_to_skip = headers + trailers + ((offset_type) element_size * element_count);
 
   return fortio_fseek(fortio, bytes_to_skip, SEEK_CUR);
 }
@@ -479,10 +501,10 @@ void fortio_data_fseek(fortio_type* fortio, offset_type data_offset, size_t data
         util_abort("%s: Element index is out of range: 0 <= %d < %d \n", __func__, data_element, element_count);
     }
     {
-      int block_index = data_element / block_size;
-      int headers = (block_index + 1) * 4;
-      int trailers = block_index * 4;
-      offset_type bytes_to_skip = data_offset + headers + trailers + (data_element * element_size);
+      offset_type block_index = data_element / block_size;
+      offset_type headers = (block_index + 1) * 4;
+      offset_type trailers = block_index * 4;
+      offset_type bytes_to_skip = data_offset + headers + trailers + ((offset_type) data_element * element_size);
 
       fortio_fseek(fortio, bytes_to_skip, SEEK_SET);
     }
@@ -533,10 +555,19 @@ static int fortio_fread_record(fortio_type *fortio , char *buffer) {
    read. The point of this is to handle the ECLIPSE system with blocks
    of e.g. 1000 floats (which then become one fortran record), in a
    transparent, low-level way.
+
+   Observe that each individual record is limited to 2GB by the 32 bit
+   record header, whereas the total buffer can be arbitrarily large;
+   all the accumulation is therefor done with size_t.
 */
 
-bool fortio_fread_buffer(fortio_type * fortio, char * buffer , int buffer_size) {
-  int total_bytes_read = 0;
+static bool fortio_fread_buffer_mmap(fortio_type * fortio, char * buffer , size_t buffer_size);
+
+bool fortio_fread_buffer(fortio_type * fortio, char * buffer , size_t buffer_size) {
+  size_t total_bytes_read = 0;
+
+  if (fortio->mmap_data)
+    return fortio_fread_buffer_mmap( fortio , buffer , buffer_size );
 
   while (true) {
     char * buffer_ptr = &buffer[total_bytes_read];
@@ -557,7 +588,7 @@ bool fortio_fread_buffer(fortio_type * fortio, char * buffer , int buffer_size)
   if (total_bytes_read < buffer_size)
     return false;
 
-  util_abort("%s: internal inconsistency: buffer_size:%d  read %d bytes \n",__func__ , buffer_size , total_bytes_read);
+  util_abort("%s: internal inconsistency: buffer_size:%zu  read %zu bytes \n",__func__ , buffer_size , total_bytes_read);
   return false;
 }
 
@@ -569,8 +600,8 @@ int fortio_fskip_record(fortio_type *fortio) {
   return record_size;
 }
 
-void fortio_fskip_buffer(fortio_type * fortio, int buffer_size) {
-  int bytes_skipped = 0;
+void fortio_fskip_buffer(fortio_type * fortio, size_t buffer_size) {
+  size_t bytes_skipped = 0;
   while (bytes_skipped < buffer_size)
     bytes_skipped += fortio_fskip_record(fortio);
 
@@ -820,6 +851,184 @@ bool fortio_read_at_eof( fortio_type * fortio ) {
 }
 
 
+/*****************************************************************/
+/*
+  Memory mapped reading. When a binary file is opened for reading the
+  complete file can be mapped into memory with fortio_mmap(); the
+  record headers and trailers of the whole file are validated once
+  when the mapping is established, and subsequent reads through
+  fortio_fread_buffer() will copy the data directly out of the mapped
+  region instead of going through one fread() per record.
+
+  The FILE stream is still used to hold the current file position; the
+  mmap functions will leave the stream positioned at the end of the
+  data which has been consumed, so the mapped and unmapped read
+  functions can be mixed freely. Observe that the mapping is
+  private and read-only, i.e. it should not be used for files which
+  are updated while they are open.
+*/
+
+static int fortio_mmap_iget_int( const fortio_type * fortio , offset_type offset) {
+  int value;
+  memcpy( &value , &fortio->mmap_data[offset] , sizeof value );
+  if (fortio->endian_flip_header)
+    util_endian_flip_vector(&value , sizeof value , 1);
+  return value;
+}
+
+
+/*
+  Walks through all the records in the mapped region and verifies
+  that header and trailer agree, and that all the records are
+  complete.
+*/
+
+static bool fortio_mmap_check_records( const fortio_type * fortio ) {
+  offset_type offset = 0;
+  offset_type size   = fortio->mmap_size;
+
+  while (offset < size) {
+    int header , tail;
+
+    if ((offset + sizeof header) > size)
+      return false;
+
+    header = fortio_mmap_iget_int( fortio , offset );
+    if (header < 0)
+      return false;
+
+    if ((offset + header + sizeof header + sizeof tail) > size)
+      return false;
+
+    tail = fortio_mmap_iget_int( fortio , offset + sizeof header + header );
+    if (tail != header)
+      return false;
+
+    offset += header + sizeof header + sizeof tail;
+  }
+  return true;
+}
+
+
+static void fortio_munmap( fortio_type * fortio ) {
+#ifdef HAVE_MMAP
+  if (fortio->mmap_data) {
+    munmap( fortio->mmap_data , fortio->mmap_size );
+    fortio->mmap_data = NULL;
+    fortio->mmap_size = 0;
+  }
+#endif
+}
+
+
+/*
+  Will try to memory map the file; the function will return false if
+  the file can not be mapped, that includes formatted files, files
+  which are not opened for reading, empty files and files where the
+  record structure is broken. In that case the fortio instance will
+  continue to work with ordinary stream reads.
+
+  The mapping is independent of the FILE stream, i.e. it will survive
+  a fortio_fclose_stream() / fortio_fopen_stream() cycle.
+*/
+
+bool fortio_mmap( fortio_type * fortio ) {
+#ifdef HAVE_MMAP
+  if (fortio->mmap_data)
+    return true;
+
+  if (fortio->fmt_file || !fortio->readable || (fortio->stream == NULL))
+    return false;
+
+  if (fortio->read_size > 0) {
+    void * data = mmap( NULL , fortio->read_size , PROT_READ , MAP_PRIVATE , fortio_fileno( fortio ) , 0);
+    if (data != MAP_FAILED) {
+      fortio->mmap_data = data;
+      fortio->mmap_size = fortio->read_size;
+
+      if (fortio_mmap_check_records( fortio ))
+        return true;
+
+      fortio_munmap( fortio );
+    }
+  }
+#endif
+  return false;
+}
+
+
+bool fortio_is_mmapped( const fortio_type * fortio ) {
+  if (fortio->mmap_data)
+    return true;
+  else
+    return false;
+}
+
+
+/*
+  Will return a pointer to the data section of the record starting at
+  file offset *offset, the size of the record is returned by reference
+  in *record_size, and *offset is updated to point to the start of the
+  next record. The data is returned exactly as it is on disk, i.e.
+  without any endian conversion. Will return NULL if the file is not
+  mapped, or if there is no record starting at *offset.
+*/
+
+const char * fortio_mmap_fread_record( const fortio_type * fortio , offset_type * offset , int * record_size) {
+  if (fortio->mmap_data == NULL)
+    return NULL;
+
+  if ((*offset + sizeof * record_size) > fortio->mmap_size)
+    return NULL;
+
+  *record_size = fortio_mmap_iget_int( fortio , *offset );
+  {
+    const char * data = &fortio->mmap_data[*offset + sizeof * record_size];
+    *offset += *record_size + 2 * sizeof * record_size;
+    return data;
+  }
+}
+
+
+/*
+  Will return a pointer to raw data in the mapped region, or NULL if
+  the file is not mapped or the range [offset, offset + size) is
+  outside the file.
+*/
+
+const char * fortio_mmap_ptr( const fortio_type * fortio , offset_type offset , size_t size) {
+  if (fortio->mmap_data == NULL)
+    return NULL;
+
+  if ((offset < 0) || ((offset + size) > fortio->mmap_size))
+    return NULL;
+
+  return &fortio->mmap_data[offset];
+}
+
+
+static bool fortio_fread_buffer_mmap(fortio_type * fortio, char * buffer , size_t buffer_size) {
+  offset_type offset = fortio_ftell( fortio );
+  size_t total_bytes_read = 0;
+
+  while (total_bytes_read < buffer_size) {
+    int record_size;
+    const char * record = fortio_mmap_fread_record( fortio , &offset , &record_size );
+    if (record == NULL)
+      break;
+
+    if ((total_bytes_read + record_size) > buffer_size)
+      util_abort("%s: internal inconsistency: buffer_size:%zu  read %zu bytes \n",__func__ , buffer_size , total_bytes_read + record_size);
+
+    memcpy( &buffer[total_bytes_read] , record , record_size );
+    total_bytes_read += record_size;
+  }
+  fortio_fseek__( fortio , offset , SEEK_SET );
+
+  return (total_bytes_read == buffer_size);
+}
+
+
 /*****************************************************************/
 void          fortio_fflush(fortio_type * fortio) { fflush( fortio->stream); }
 FILE        * fortio_get_FILE(const fortio_type *fortio)        { return fortio->stream; }
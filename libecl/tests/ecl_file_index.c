@@ -0,0 +1,173 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_file_index.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <utime.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void write_file( const char * filename , const char * int_header , int num_int ) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  {
+    ecl_kw_type * int_kw = ecl_kw_alloc( int_header , 2500 , ECL_INT_TYPE );
+    ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , 1001 , ECL_DOUBLE_TYPE );
+    ecl_kw_type * char_kw = ecl_kw_alloc( "CHAR" , 25 , ECL_CHAR_TYPE );
+    int i;
+
+    for (i=0; i < ecl_kw_get_size( int_kw ); i++)
+      ecl_kw_iset_int( int_kw , i , i );
+
+    for (i=0; i < ecl_kw_get_size( double_kw ); i++)
+      ecl_kw_iset_double( double_kw , i , i * 0.25 );
+
+    for (i=0; i < ecl_kw_get_size( char_kw ); i++)
+      ecl_kw_iset_string8( char_kw , i , "CHAR" );
+
+    for (i=0; i < num_int; i++) {
+      ecl_kw_fwrite( int_kw , fortio );
+      ecl_kw_fwrite( double_kw , fortio );
+      ecl_kw_fwrite( char_kw , fortio );
+    }
+
+    ecl_kw_free( int_kw );
+    ecl_kw_free( double_kw );
+    ecl_kw_free( char_kw );
+  }
+  fortio_fclose( fortio );
+}
+
+
+void test_equal( const char * filename ) {
+  ecl_file_type * scan_file = ecl_file_open( filename , 0 );
+  ecl_file_type * index_file = ecl_file_open( filename , ECL_FILE_INDEX );
+
+  test_assert_not_NULL( index_file );
+  test_assert_int_equal( ecl_file_get_size( scan_file ) , ecl_file_get_size( index_file ));
+  test_assert_int_equal( ecl_file_get_num_named_kw( scan_file , "INT" ) , ecl_file_get_num_named_kw( index_file , "INT" ));
+  {
+    int i;
+    for (i=0; i < ecl_file_get_size( scan_file ); i++) {
+      ecl_kw_type * kw1 = ecl_file_iget_kw( scan_file , i );
+      ecl_kw_type * kw2 = ecl_file_iget_kw( index_file , i );
+      test_assert_true( ecl_kw_equal( kw1 , kw2 ));
+    }
+  }
+
+  ecl_file_close( scan_file );
+  ecl_file_close( index_file );
+}
+
+
+void test_create_index( const char * filename ) {
+  char * index_filename = ecl_file_alloc_index_filename( filename );
+  test_assert_false( util_file_exists( index_filename ));
+  {
+    ecl_file_type * ecl_file = ecl_file_open( filename , 0 );
+    ecl_file_close( ecl_file );
+    test_assert_false( util_file_exists( index_filename ));
+  }
+  test_equal( filename );
+  test_assert_true( util_file_exists( index_filename ));
+  test_equal( filename );
+  free( index_filename );
+}
+
+
+/*
+  The file is rewritten with identical size, and the mtime is reset;
+  the index is then assumed to be valid and the old header is found.
+*/
+
+void test_index_used( const char * filename ) {
+  time_t mtime = util_file_mtime( filename );
+  write_file( filename , "XNT" , 10 );
+  {
+    struct utimbuf times;
+    times.actime = mtime;
+    times.modtime = mtime;
+    test_assert_int_equal( utime( filename , &times ) , 0 );
+  }
+  {
+    ecl_file_type * ecl_file = ecl_file_open( filename , ECL_FILE_INDEX );
+    test_assert_true( ecl_file_has_kw( ecl_file , "INT" ));
+    test_assert_false( ecl_file_has_kw( ecl_file , "XNT" ));
+    ecl_file_close( ecl_file );
+  }
+  write_file( filename , "INT" , 10 );
+  {
+    struct utimbuf times;
+    times.actime = mtime;
+    times.modtime = mtime;
+    test_assert_int_equal( utime( filename , &times ) , 0 );
+  }
+}
+
+
+void test_file_changed( const char * filename ) {
+  write_file( filename , "INT" , 12 );
+  {
+    ecl_file_type * ecl_file = ecl_file_open( filename , ECL_FILE_INDEX );
+    test_assert_int_equal( ecl_file_get_num_named_kw( ecl_file , "INT" ) , 12 );
+    ecl_file_close( ecl_file );
+  }
+  test_equal( filename );
+}
+
+
+void test_broken_index( const char * filename ) {
+  char * index_filename = ecl_file_alloc_index_filename( filename );
+  offset_type index_size = util_file_size( index_filename );
+  {
+    FILE * stream = util_fopen( index_filename , "r+");
+    util_ftruncate( stream , index_size - 4 );
+    fclose( stream );
+  }
+  test_equal( filename );
+  test_assert_int_equal( util_file_size( index_filename ) , index_size );
+
+  {
+    FILE * stream = util_fopen( index_filename , "w");
+    fprintf(stream , "Not an index file\n");
+    fclose( stream );
+  }
+  test_equal( filename );
+  test_assert_int_equal( util_file_size( index_filename ) , index_size );
+  free( index_filename );
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_file_index" );
+  {
+    write_file( "TEST.UNRST" , "INT" , 10 );
+    test_create_index( "TEST.UNRST" );
+    test_index_used( "TEST.UNRST" );
+    test_file_changed( "TEST.UNRST" );
+    test_broken_index( "TEST.UNRST" );
+  }
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -0,0 +1,152 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_file_mmap.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void write_file( const char * filename ) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  {
+    ecl_kw_type * int_kw = ecl_kw_alloc( "INT" , 2500 , ECL_INT_TYPE );
+    ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , 1001 , ECL_DOUBLE_TYPE );
+    ecl_kw_type * char_kw = ecl_kw_alloc( "CHAR" , 250 , ECL_CHAR_TYPE );
+    ecl_kw_type * bool_kw = ecl_kw_alloc( "BOOL" , 10 , ECL_BOOL_TYPE );
+    ecl_kw_type * empty_kw = ecl_kw_alloc( "EMPTY" , 0 , ECL_FLOAT_TYPE );
+    int i;
+
+    for (i=0; i < ecl_kw_get_size( int_kw ); i++)
+      ecl_kw_iset_int( int_kw , i , i );
+
+    for (i=0; i < ecl_kw_get_size( double_kw ); i++)
+      ecl_kw_iset_double( double_kw , i , i * 0.25 );
+
+    for (i=0; i < ecl_kw_get_size( char_kw ); i++) {
+      char * s = util_alloc_sprintf("S%d" , i);
+      ecl_kw_iset_string8( char_kw , i , s );
+      free( s );
+    }
+
+    for (i=0; i < ecl_kw_get_size( bool_kw ); i++)
+      ecl_kw_iset_bool( bool_kw , i , (i % 2) == 0 );
+
+    ecl_kw_fwrite( int_kw , fortio );
+    ecl_kw_fwrite( double_kw , fortio );
+    ecl_kw_fwrite( empty_kw , fortio );
+    ecl_kw_fwrite( char_kw , fortio );
+    ecl_kw_fwrite( bool_kw , fortio );
+    ecl_kw_fwrite( int_kw , fortio );
+
+    ecl_kw_free( int_kw );
+    ecl_kw_free( double_kw );
+    ecl_kw_free( char_kw );
+    ecl_kw_free( bool_kw );
+    ecl_kw_free( empty_kw );
+  }
+  fortio_fclose( fortio );
+}
+
+
+void test_equal( const char * filename , int flags ) {
+  ecl_file_type * stream_file = ecl_file_open( filename , 0 );
+  ecl_file_type * mmap_file = ecl_file_open( filename , ECL_FILE_MMAP | flags );
+
+  test_assert_not_NULL( mmap_file );
+  test_assert_int_equal( ecl_file_get_size( stream_file ) , ecl_file_get_size( mmap_file ));
+  {
+    int i;
+    for (i=0; i < ecl_file_get_size( stream_file ); i++) {
+      ecl_kw_type * kw1 = ecl_file_iget_kw( stream_file , i );
+      ecl_kw_type * kw2 = ecl_file_iget_kw( mmap_file , i );
+      test_assert_true( ecl_kw_equal( kw1 , kw2 ));
+    }
+  }
+
+  {
+    int_vector_type * index_map = int_vector_alloc( 0 , 0 );
+    int buffer[3];
+
+    int_vector_append( index_map , 7 );
+    int_vector_append( index_map , 1000 );
+    int_vector_append( index_map , 2499 );
+    ecl_file_indexed_read( mmap_file , "INT" , 1 , index_map , (char *) buffer );
+    test_assert_int_equal( buffer[0] , 7 );
+    test_assert_int_equal( buffer[1] , 1000 );
+    test_assert_int_equal( buffer[2] , 2499 );
+    int_vector_free( index_map );
+  }
+
+  ecl_file_close( stream_file );
+  ecl_file_close( mmap_file );
+}
+
+
+void test_fortio_mmap( const char * filename ) {
+  fortio_type * fortio = fortio_open_reader( filename , false , ECL_ENDIAN_FLIP );
+  test_assert_false( fortio_is_mmapped( fortio ));
+  test_assert_true( fortio_mmap( fortio ));
+  test_assert_true( fortio_is_mmapped( fortio ));
+  {
+    ecl_kw_type * kw = ecl_kw_fread_alloc( fortio );
+    test_assert_string_equal( ecl_kw_get_header( kw ) , "INT" );
+    test_assert_int_equal( ecl_kw_iget_int( kw , 2000 ) , 2000 );
+    ecl_kw_free( kw );
+  }
+  test_assert_true( fortio_fclose_stream( fortio ));
+  test_assert_true( fortio_is_mmapped( fortio ));
+  fortio_fclose( fortio );
+}
+
+
+void test_broken_file( const char * filename ) {
+  offset_type file_size = util_file_size( filename );
+  {
+    FILE * stream = util_fopen(filename , "r+");
+    util_ftruncate( stream , file_size - 4 );
+    fclose( stream );
+  }
+  {
+    fortio_type * fortio = fortio_open_reader( filename , false , ECL_ENDIAN_FLIP );
+    test_assert_false( fortio_mmap( fortio ));
+    test_assert_false( fortio_is_mmapped( fortio ));
+    fortio_fclose( fortio );
+  }
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_file_mmap" );
+  {
+    write_file( "TEST.INIT" );
+    test_fortio_mmap( "TEST.INIT" );
+    test_equal( "TEST.INIT" , 0 );
+    test_equal( "TEST.INIT" , ECL_FILE_CLOSE_STREAM );
+    test_broken_file( "TEST.INIT" );
+  }
+  test_work_area_free( work_area );
+  exit(0);
+}
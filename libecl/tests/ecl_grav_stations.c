@@ -0,0 +1,243 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_grav_stations.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/test_work_area.h>
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_region.h>
+#include <ert/ecl/ecl_endian_flip.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_init_file.h>
+#include <ert/ecl/ecl_grav.h>
+#include <ert/ecl/ecl_subsidence.h>
+#include <ert/ecl/ecl_grid_cache.h>
+#include <ert/ecl/ecl_grav_common.h>
+
+/*
+  Compares ecl_grav_eval_stations() and ecl_subsidence_eval_stations()
+  with evaluating one station at a time, and checks that the number of
+  threads used for the stations does not change the result. With arguments the timing of
+  a larger case is printed:
+
+     ecl_grav_stations  [nx  [num_stations]]
+*/
+
+
+static void write_init( const ecl_grid_type * grid ) {
+  fortio_type * f = fortio_open_writer( "CASE.INIT" , false , ECL_ENDIAN_FLIP );
+  ecl_kw_type * poro = ecl_kw_alloc( "PORO" , ecl_grid_get_global_size( grid ) , ECL_FLOAT_TYPE );
+  ecl_kw_type * pvtnum = ecl_kw_alloc( "PVTNUM" , ecl_grid_get_active_size( grid ) , ECL_INT_TYPE );
+
+  ecl_kw_scalar_set_float( poro , 0.25 );
+  ecl_kw_scalar_set_int( pvtnum , 1 );
+  ecl_init_file_fwrite_header( f , grid , poro , 7 , util_make_date_utc( 1 , 1 , 2010 ));
+  ecl_kw_fwrite( pvtnum , f );
+
+  ecl_kw_free( pvtnum );
+  ecl_kw_free( poro );
+  fortio_fclose( f );
+}
+
+
+static void write_restart( const ecl_grid_type * grid , const char * filename , int step ) {
+  const char * kw_list[4] = { "FIPOIL" , "FIPWAT" , "FIPGAS" , "PRESSURE" };
+  const int size = ecl_grid_get_active_size( grid );
+  fortio_type * f = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+
+  for (int ikw = 0; ikw < 4; ikw++) {
+    ecl_kw_type * kw = ecl_kw_alloc( kw_list[ikw] , size , ECL_FLOAT_TYPE );
+    for (int i = 0; i < size; i++)
+      ecl_kw_iset_float( kw , i , 100 + ikw + (i % 7) + step * ((i * (ikw + 1)) % 11));
+    ecl_kw_fwrite( kw , f );
+    ecl_kw_free( kw );
+  }
+  fortio_fclose( f );
+}
+
+
+static void init_stations( int num_stations , double * x , double * y , double * z , double extent) {
+  for (int i = 0; i < num_stations; i++) {
+    x[i] = extent * (i % 13) / 13.0 + 0.3;
+    y[i] = extent * (i % 17) / 17.0 + 0.7;
+    z[i] = -1.0 - (i % 5);
+  }
+}
+
+
+static void test_common( const ecl_grid_type * grid , ecl_region_type * region , int num_stations , const double * x , const double * y , const double * z ) {
+  ecl_grid_cache_type * grid_cache = ecl_grid_cache_alloc( grid );
+  const int size = ecl_grid_cache_get_size( grid_cache );
+  bool * aquifer = util_calloc( size , sizeof * aquifer );
+  double * weight = util_calloc( size , sizeof * weight );
+  double * result1 = util_calloc( num_stations , sizeof * result1 );
+  double * result4 = util_calloc( num_stations , sizeof * result4 );
+
+  for (int i = 0; i < size; i++) {
+    aquifer[i] = ((i % 9) == 0);
+    weight[i] = 1 + (i % 3);
+  }
+
+  ecl_grav_common_eval_biot_savart_stations( grid_cache , region , aquifer , weight , num_stations , x , y , z , result1 , 1 );
+  ecl_grav_common_eval_biot_savart_stations( grid_cache , region , aquifer , weight , num_stations , x , y , z , result4 , 4 );
+  for (int i = 0; i < num_stations; i++) {
+    test_assert_double_equal( result1[i] , ecl_grav_common_eval_biot_savart( grid_cache , region , aquifer , weight , x[i] , y[i] , z[i] ));
+    test_assert_double_equal( result1[i] , result4[i] );
+  }
+  test_assert_true( result1[0] != 0 );
+
+  free( result4 );
+  free( result1 );
+  free( weight );
+  free( aquifer );
+  ecl_grid_cache_free( grid_cache );
+}
+
+
+static void test_grav( const ecl_grav_type * grav , ecl_region_type * region , const char * monitor , int num_stations , const double * x , const double * y , const double * z , bool compare ) {
+  double * deltag = util_calloc( num_stations , sizeof * deltag );
+  timer_type * timer = timer_alloc( false );
+  int phase_mask = ECL_OIL_PHASE + ECL_GAS_PHASE + ECL_WATER_PHASE;
+
+  timer_start( timer );
+  ecl_grav_eval_stations( grav , "BASE" , monitor , region , phase_mask , num_stations , x , y , z , deltag );
+  timer_stop( timer );
+  printf("grav        stations:%6d   batch: %8.3f s" , num_stations , timer_get_total_time( timer ));
+
+  if (compare) {
+    test_assert_true( deltag[0] != 0 );
+    timer_reset( timer );
+    timer_start( timer );
+    for (int i = 0; i < num_stations; i++) {
+      double g = ecl_grav_eval( grav , "BASE" , monitor , region , x[i] , y[i] , z[i] , phase_mask );
+      test_assert_true( fabs( g - deltag[i] ) <= 1e-10 * (1 + fabs( g )));
+    }
+    timer_stop( timer );
+    printf("   one by one: %8.3f s" , timer_get_total_time( timer ));
+  }
+  printf("\n");
+
+  timer_free( timer );
+  free( deltag );
+}
+
+
+static void test_subsidence( const ecl_subsidence_type * subsidence , ecl_region_type * region , const char * monitor , int num_stations , const double * x , const double * y , const double * z , bool compare ) {
+  double * deltaz = util_calloc( num_stations , sizeof * deltaz );
+  timer_type * timer = timer_alloc( false );
+
+  timer_start( timer );
+  ecl_subsidence_eval_stations( subsidence , "BASE" , monitor , region , num_stations , x , y , z , 1e-4 , 0.45 , deltaz );
+  timer_stop( timer );
+  printf("subsidence  stations:%6d   batch: %8.3f s" , num_stations , timer_get_total_time( timer ));
+
+  if (compare) {
+    test_assert_true( deltaz[0] != 0 );
+    timer_reset( timer );
+    timer_start( timer );
+    for (int i = 0; i < num_stations; i++)
+      test_assert_double_equal( ecl_subsidence_eval( subsidence , "BASE" , monitor , region , x[i] , y[i] , z[i] , 1e-4 , 0.45 ) , deltaz[i] );
+    timer_stop( timer );
+    printf("   one by one: %8.3f s" , timer_get_total_time( timer ));
+  }
+  printf("\n");
+
+  timer_free( timer );
+  free( deltaz );
+}
+
+
+
+int main( int argc , char ** argv) {
+  int nx = 10;
+  int num_stations = 300;
+  bool compare = (argc == 1);
+  test_work_area_type * test_area = test_work_area_alloc( "ecl_grav_stations" );
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &nx );
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &num_stations );
+
+  {
+    int_vector_type * actnum = int_vector_alloc( nx*nx*5 , 1 );
+    ecl_grid_type * grid;
+    double * x = util_calloc( num_stations , sizeof * x );
+    double * y = util_calloc( num_stations , sizeof * y );
+    double * z = util_calloc( num_stations , sizeof * z );
+
+    int_vector_iset( actnum , 10 , 0 );
+    grid = ecl_grid_alloc_rectangular( nx , nx , 5 , 1 , 1 , 1 , int_vector_get_ptr( actnum ));
+    write_init( grid );
+    write_restart( grid , "CASE.X0000" , 0 );
+    write_restart( grid , "CASE.X0010" , 1 );
+    init_stations( num_stations , x , y , z , nx );
+
+    {
+      ecl_file_type * init_file = ecl_file_open( "CASE.INIT" , 0 );
+      ecl_file_type * base_file = ecl_file_open( "CASE.X0000" , 0 );
+      ecl_file_type * monitor_file = ecl_file_open( "CASE.X0010" , 0 );
+      ecl_grav_type * grav = ecl_grav_alloc( grid , init_file );
+      ecl_subsidence_type * subsidence = ecl_subsidence_alloc( grid , init_file );
+      ecl_region_type * region = ecl_region_alloc( grid , false );
+
+      ecl_region_select_k1k2( region , 1 , 3 );
+      
+
+      ecl_grav_new_std_density( grav , ECL_OIL_PHASE , 800 );
+      ecl_grav_new_std_density( grav , ECL_WATER_PHASE , 1000 );
+      ecl_grav_new_std_density( grav , ECL_GAS_PHASE , 0.75 );
+      ecl_grav_add_survey_FIP( grav , "BASE" , ecl_file_get_global_view( base_file ));
+      ecl_grav_add_survey_FIP( grav , "MONITOR" , ecl_file_get_global_view( monitor_file ));
+      ecl_subsidence_add_survey_PRESSURE( subsidence , "BASE" , ecl_file_get_global_view( base_file ));
+      ecl_subsidence_add_survey_PRESSURE( subsidence , "MONITOR" , ecl_file_get_global_view( monitor_file ));
+
+      test_grav( grav , NULL , "MONITOR" , num_stations , x , y , z , compare );
+      test_subsidence( subsidence , NULL , "MONITOR" , num_stations , x , y , z , compare );
+      if (compare) {
+        test_common( grid , NULL , num_stations , x , y , z );
+        test_common( grid , region , num_stations , x , y , z );
+        test_grav( grav , region , "MONITOR" , num_stations , x , y , z , compare );
+        test_grav( grav , NULL , NULL , num_stations , x , y , z , compare );
+        test_subsidence( subsidence , region , "MONITOR" , num_stations , x , y , z , compare );
+        test_subsidence( subsidence , NULL , NULL , num_stations , x , y , z , compare );
+      }
+
+      ecl_region_free( region );
+      ecl_subsidence_free( subsidence );
+      ecl_grav_free( grav );
+      ecl_file_close( monitor_file );
+      ecl_file_close( base_file );
+      ecl_file_close( init_file );
+    }
+
+    free( z );
+    free( y );
+    free( x );
+    ecl_grid_free( grid );
+    int_vector_free( actnum );
+  }
+  test_work_area_free( test_area );
+  exit(0);
+}
@@ -0,0 +1,91 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_grid_corner_storage.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_grid.h>
+
+
+/*
+  The rectangular grid stores the cell corners explicitly, whereas the
+  grid created from the COORD and ZCORN data recalculates the corners
+  from the pillars. The two grids should be indistinguishable.
+*/
+
+void test_pillar_grid( const ecl_grid_type * rect_grid ) {
+  int nx = ecl_grid_get_nx( rect_grid );
+  int ny = ecl_grid_get_ny( rect_grid );
+  int nz = ecl_grid_get_nz( rect_grid );
+  float * coord  = util_calloc( ecl_grid_get_coord_size( rect_grid ) , sizeof * coord );
+  float * zcorn  = ecl_grid_alloc_zcorn_data( rect_grid );
+  int   * actnum = ecl_grid_alloc_actnum_data( rect_grid );
+  ecl_grid_type * pillar_grid;
+
+  ecl_grid_init_coord_data( rect_grid , coord );
+  pillar_grid = ecl_grid_alloc_GRDECL_data( nx , ny , nz , zcorn , coord , actnum , false , NULL );
+  test_assert_true( ecl_grid_compare( rect_grid , pillar_grid , false , false , true ));
+
+  {
+    int g;
+    for (g = 0; g < ecl_grid_get_global_size( rect_grid ); g++) {
+      double x1,y1,z1;
+      double x2,y2,z2;
+
+      test_assert_double_equal( ecl_grid_get_cell_volume1( rect_grid , g ) , ecl_grid_get_cell_volume1( pillar_grid , g ));
+      test_assert_double_equal( ecl_grid_get_cell_dz1( rect_grid , g ) , ecl_grid_get_cell_dz1( pillar_grid , g ));
+
+      ecl_grid_get_xyz1( rect_grid , g , &x1 , &y1 , &z1 );
+      ecl_grid_get_xyz1( pillar_grid , g , &x2 , &y2 , &z2 );
+      test_assert_double_equal( x1 , x2 );
+      test_assert_double_equal( y1 , y2 );
+      test_assert_double_equal( z1 , z2 );
+    }
+  }
+
+  {
+    ecl_grid_type * grid_copy = ecl_grid_alloc_copy( pillar_grid );
+    test_assert_true( ecl_grid_compare( pillar_grid , grid_copy , true , true , true ));
+    ecl_grid_free( grid_copy );
+  }
+
+  ecl_grid_free( pillar_grid );
+  free( actnum );
+  free( zcorn );
+  free( coord );
+}
+
+
+
+int main( int argc , char ** argv) {
+  int actnum[4*5*6];
+  int g;
+
+  for (g = 0; g < 4*5*6; g++)
+    actnum[g] = (g % 7) ? 1 : 0;
+
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_rectangular( 4,5,6,1,2,3 , actnum );
+    test_pillar_grid( grid );
+    ecl_grid_free( grid );
+  }
+
+  exit(0);
+}
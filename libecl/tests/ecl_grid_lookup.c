@@ -0,0 +1,127 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_grid_lookup.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_grid_lookup.h>
+
+
+/*
+  Corner point grid with sloping pillars and uneven layers.
+*/
+
+ecl_grid_type * alloc_skewed_grid( int nx , int ny , int nz ) {
+  float * coord = util_calloc( 6 * (nx + 1) * (ny + 1) , sizeof * coord );
+  float * zcorn = util_calloc( 8 * nx * ny * nz , sizeof * zcorn );
+  ecl_grid_type * grid;
+  int i,j,k;
+
+  for (j=0; j <= ny; j++) {
+    for (i=0; i <= nx; i++) {
+      float * pillar = &coord[ 6 * (i + j*(nx + 1)) ];
+      pillar[0] = i * 10;
+      pillar[1] = j * 10;
+      pillar[2] = 0;
+      pillar[3] = i * 10 + (i % 3);
+      pillar[4] = j * 10 - (j % 2);
+      pillar[5] = 100;
+    }
+  }
+
+  for (k=0; k < nz; k++) {
+    for (j=0; j < ny; j++) {
+      for (i=0; i < nx; i++) {
+        int c;
+        for (c=0; c < 8; c++) {
+          int di = c % 2;
+          int dj = (c % 4) / 2;
+          int dk = c / 4;
+          int zcorn_index = k*8*nx*ny + j*4*nx + 2*i + dj*2*nx + di + dk*4*nx*ny;
+          zcorn[ zcorn_index ] = 10 * (k + dk) + ((i + di + j + dj) % 4);
+        }
+      }
+    }
+  }
+
+  grid = ecl_grid_alloc_GRDECL_data( nx , ny , nz , zcorn , coord , NULL , false , NULL );
+  free( zcorn );
+  free( coord );
+  return grid;
+}
+
+
+void test_lookup( const ecl_grid_type * grid ) {
+  ecl_grid_lookup_type * lookup = ecl_grid_lookup_alloc( grid );
+  int size = ecl_grid_get_global_size( grid );
+  double * x = util_calloc( size , sizeof * x );
+  double * y = util_calloc( size , sizeof * y );
+  double * z = util_calloc( size , sizeof * z );
+  int * global_index = util_calloc( size , sizeof * global_index );
+  int g;
+
+  for (g = 0; g < size; g++) {
+    ecl_grid_get_xyz1( grid , g , &x[g] , &y[g] , &z[g] );
+    test_assert_int_equal( ecl_grid_get_global_index_from_xyz( (ecl_grid_type *) grid , x[g] , y[g] , z[g] , 0 ) ,
+                           ecl_grid_lookup_get_global_index( lookup , x[g] , y[g] , z[g] ));
+  }
+
+  ecl_grid_lookup_get_global_index_list( lookup , size , x , y , z , global_index );
+  for (g = 0; g < size; g++)
+    test_assert_int_equal( global_index[g] , ecl_grid_lookup_get_global_index( lookup , x[g] , y[g] , z[g] ));
+
+  /* Points on the corners, i.e. on the cell boundaries. */
+  for (g = 0; g < size; g += 7) {
+    int c;
+    for (c = 0; c < 8; c++) {
+      double xc,yc,zc;
+      ecl_grid_get_cell_corner_xyz1( grid , g , c , &xc , &yc , &zc );
+      test_assert_int_equal( ecl_grid_get_global_index_from_xyz( (ecl_grid_type *) grid , xc , yc , zc , 0 ) ,
+                             ecl_grid_lookup_get_global_index( lookup , xc , yc , zc ));
+    }
+  }
+
+  test_assert_int_equal( -1 , ecl_grid_lookup_get_global_index( lookup , -1 , -1 , -1 ));
+  test_assert_int_equal( -1 , ecl_grid_lookup_get_global_index( lookup , 1 , 1 , 1e6 ));
+
+  free( global_index );
+  free( z );
+  free( y );
+  free( x );
+  ecl_grid_lookup_free( lookup );
+}
+
+
+int main( int argc , char ** argv) {
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_rectangular( 6 , 7 , 8 , 1 , 2 , 3 , NULL );
+    test_lookup( grid );
+    ecl_grid_free( grid );
+  }
+
+  {
+    ecl_grid_type * grid = alloc_skewed_grid( 9 , 8 , 5 );
+    test_lookup( grid );
+    ecl_grid_free( grid );
+  }
+
+  exit(0);
+}
@@ -0,0 +1,243 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_kw_fmt.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void write_text( const char * filename , const char * text ) {
+  FILE * stream = util_fopen( filename , "w");
+  fprintf(stream , "%s" , text );
+  fclose( stream );
+}
+
+
+ecl_kw_type * read_kw( const char * filename ) {
+  fortio_type * fortio = fortio_open_reader( filename , true , ECL_ENDIAN_FLIP );
+  ecl_kw_type * kw = ecl_kw_fread_alloc( fortio );
+  fortio_fclose( fortio );
+  test_assert_not_NULL( kw );
+  return kw;
+}
+
+
+void write_kw( const char * filename , const ecl_kw_type * kw ) {
+  fortio_type * fortio = fortio_open_writer( filename , true , ECL_ENDIAN_FLIP );
+  ecl_kw_fwrite( kw , fortio );
+  fortio_fclose( fortio );
+}
+
+
+void test_write_layout() {
+  ecl_kw_type * int_kw = ecl_kw_alloc( "INT" , 7 , ECL_INT_TYPE );
+  ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , 4 , ECL_DOUBLE_TYPE );
+  ecl_kw_type * float_kw = ecl_kw_alloc( "FLOAT" , 2 , ECL_FLOAT_TYPE );
+  ecl_kw_type * bool_kw = ecl_kw_alloc( "BOOL" , 3 , ECL_BOOL_TYPE );
+  ecl_kw_type * char_kw = ecl_kw_alloc( "CHAR" , 2 , ECL_CHAR_TYPE );
+  int i;
+
+  for (i=0; i < 7; i++)
+    ecl_kw_iset_int( int_kw , i , (i - 3) * 1000 );
+  ecl_kw_iset_int( int_kw , 6 , -2147483647 - 1 );
+
+  ecl_kw_iset_double( double_kw , 0 , 0 );
+  ecl_kw_iset_double( double_kw , 1 , 1 );
+  ecl_kw_iset_double( double_kw , 2 , -0.125 );
+  ecl_kw_iset_double( double_kw , 3 , 1e-300 );
+
+  ecl_kw_iset_float( float_kw , 0 , 100 );
+  ecl_kw_iset_float( float_kw , 1 , -2.5 );
+
+  ecl_kw_iset_bool( bool_kw , 0 , true );
+  ecl_kw_iset_bool( bool_kw , 1 , false );
+  ecl_kw_iset_bool( bool_kw , 2 , true );
+
+  ecl_kw_iset_string8( char_kw , 0 , "ABC" );
+  ecl_kw_iset_string8( char_kw , 1 , "12345678" );
+
+  {
+    fortio_type * fortio = fortio_open_writer( "LAYOUT" , true , ECL_ENDIAN_FLIP );
+    ecl_kw_fwrite( int_kw , fortio );
+    ecl_kw_fwrite( double_kw , fortio );
+    ecl_kw_fwrite( float_kw , fortio );
+    ecl_kw_fwrite( bool_kw , fortio );
+    ecl_kw_fwrite( char_kw , fortio );
+    fortio_fclose( fortio );
+  }
+
+  {
+    const char * expected =
+      " 'INT     '           7 'INTE'\n"
+      "       -3000       -2000       -1000           0        1000        2000\n"
+      " -2147483648\n"
+      " 'DOUBLE  '           4 'DOUB'\n"
+      "   0.00000000000000D+00   0.10000000000000D+01  -0.12500000000000D+00\n"
+      "   0.10000000000000D-299\n"
+      " 'FLOAT   '           2 'REAL'\n"
+      "   0.10000000E+03  -0.25000000E+01\n"
+      " 'BOOL    '           3 'LOGI'\n"
+      "  T  F  T\n"
+      " 'CHAR    '           2 'CHAR'\n"
+      " 'ABC     ' '12345678'\n";
+    char * content = util_fread_alloc_file_content( "LAYOUT" , NULL );
+    test_assert_string_equal( content , expected );
+    free( content );
+  }
+
+  ecl_kw_free( int_kw );
+  ecl_kw_free( double_kw );
+  ecl_kw_free( float_kw );
+  ecl_kw_free( bool_kw );
+  ecl_kw_free( char_kw );
+}
+
+
+void test_read_variants() {
+  write_text( "DOUBLE" ,
+              " 'DOUBLE  '           6 'DOUB'\n"
+              "   0.12345678901234D+03  -0.50000000000000d-01   0.1234567E+02\n"
+              "   0.12345678901234+100   1.5   -0.98765432109876D-250\n");
+  {
+    ecl_kw_type * kw = read_kw( "DOUBLE" );
+    test_assert_true( ecl_kw_iget_double( kw , 0 ) == strtod("0.12345678901234E+03" , NULL));
+    test_assert_true( ecl_kw_iget_double( kw , 1 ) == -0.05 );
+    test_assert_true( ecl_kw_iget_double( kw , 2 ) == strtod("0.1234567E+02" , NULL));
+    test_assert_true( ecl_kw_iget_double( kw , 3 ) == strtod("0.12345678901234E+100" , NULL));
+    test_assert_true( ecl_kw_iget_double( kw , 4 ) == 1.5 );
+    test_assert_true( ecl_kw_iget_double( kw , 5 ) == strtod("-0.98765432109876E-250" , NULL));
+    ecl_kw_free( kw );
+  }
+
+  write_text( "FLOAT" ,
+              " 'FLOAT   '           3 'REAL'\n"
+              "   0.12345678E+03  -0.10000000E-40   0.33333334E+00\n");
+  {
+    ecl_kw_type * kw = read_kw( "FLOAT" );
+    test_assert_true( ecl_kw_iget_float( kw , 0 ) == strtof("0.12345678E+03" , NULL));
+    test_assert_true( ecl_kw_iget_float( kw , 1 ) == strtof("-0.10000000E-40" , NULL));
+    test_assert_true( ecl_kw_iget_float( kw , 2 ) == strtof("0.33333334E+00" , NULL));
+    ecl_kw_free( kw );
+  }
+
+  write_text( "MIXED" ,
+              " 'INT     '           3 'INTE'\n"
+              "  -17 +4 2147483647\n"
+              " 'BOOL    '           2 'LOGI'\n"
+              "  F  T\n"
+              " 'CHAR    '           2 'CHAR'\n"
+              " 'A       ' 'B C D   '\n");
+  {
+    fortio_type * fortio = fortio_open_reader( "MIXED" , true , ECL_ENDIAN_FLIP );
+    ecl_kw_type * int_kw = ecl_kw_fread_alloc( fortio );
+    ecl_kw_type * bool_kw = ecl_kw_fread_alloc( fortio );
+    ecl_kw_type * char_kw = ecl_kw_fread_alloc( fortio );
+
+    test_assert_int_equal( ecl_kw_iget_int( int_kw , 0 ) , -17 );
+    test_assert_int_equal( ecl_kw_iget_int( int_kw , 1 ) , 4 );
+    test_assert_int_equal( ecl_kw_iget_int( int_kw , 2 ) , 2147483647 );
+    test_assert_false( ecl_kw_iget_bool( bool_kw , 0 ));
+    test_assert_true( ecl_kw_iget_bool( bool_kw , 1 ));
+    test_assert_string_equal( ecl_kw_iget_char_ptr( char_kw , 0 ) , "A       ");
+    test_assert_string_equal( ecl_kw_iget_char_ptr( char_kw , 1 ) , "B C D   ");
+
+    ecl_kw_free( int_kw );
+    ecl_kw_free( bool_kw );
+    ecl_kw_free( char_kw );
+    fortio_fclose( fortio );
+  }
+}
+
+
+/*
+  Keywords spanning several blocks, and several keywords after each
+  other in the same file.
+*/
+
+void test_roundtrip() {
+  ecl_kw_type * int_kw = ecl_kw_alloc( "INT" , 2501 , ECL_INT_TYPE );
+  ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , 2001 , ECL_DOUBLE_TYPE );
+  ecl_kw_type * char_kw = ecl_kw_alloc( "CHAR" , 211 , ECL_CHAR_TYPE );
+  int i;
+
+  for (i=0; i < ecl_kw_get_size( int_kw ); i++)
+    ecl_kw_iset_int( int_kw , i , i * 7919 - 1000000 );
+
+  for (i=0; i < ecl_kw_get_size( double_kw ); i++)
+    ecl_kw_iset_double( double_kw , i , (i - 1000) * 0.125 );
+
+  for (i=0; i < ecl_kw_get_size( char_kw ); i++) {
+    char * s = util_alloc_sprintf("S%d" , i);
+    ecl_kw_iset_string8( char_kw , i , s );
+    free( s );
+  }
+
+  {
+    fortio_type * fortio = fortio_open_writer( "ROUNDTRIP" , true , ECL_ENDIAN_FLIP );
+    ecl_kw_fwrite( int_kw , fortio );
+    ecl_kw_fwrite( double_kw , fortio );
+    ecl_kw_fwrite( char_kw , fortio );
+    ecl_kw_fwrite( int_kw , fortio );
+    fortio_fclose( fortio );
+  }
+
+  {
+    fortio_type * fortio = fortio_open_reader( "ROUNDTRIP" , true , ECL_ENDIAN_FLIP );
+    ecl_kw_type * kw;
+
+    kw = ecl_kw_fread_alloc( fortio );
+    test_assert_true( ecl_kw_equal( kw , int_kw ));
+    ecl_kw_free( kw );
+
+    kw = ecl_kw_fread_alloc( fortio );
+    test_assert_true( ecl_kw_equal( kw , double_kw ));
+    ecl_kw_free( kw );
+
+    kw = ecl_kw_fread_alloc( fortio );
+    test_assert_true( ecl_kw_equal( kw , char_kw ));
+    ecl_kw_free( kw );
+
+    kw = ecl_kw_fread_alloc( fortio );
+    test_assert_true( ecl_kw_equal( kw , int_kw ));
+    ecl_kw_free( kw );
+
+    test_assert_NULL( ecl_kw_fread_alloc( fortio ));
+    fortio_fclose( fortio );
+  }
+
+  ecl_kw_free( int_kw );
+  ecl_kw_free( double_kw );
+  ecl_kw_free( char_kw );
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_fmt" );
+  test_write_layout( );
+  test_read_variants( );
+  test_roundtrip( );
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -0,0 +1,91 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_kw_large.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+/*
+  Writes and reads back a keyword where the data section is larger
+  than 2^31 bytes, i.e. the total byte size can not be represented
+  with a 32 bit int.
+*/
+
+#define LARGE_SIZE 540000000
+
+
+void assert_content( const ecl_kw_type * kw ) {
+  const int * data = ecl_kw_get_int_ptr( kw );
+  int i;
+  test_assert_int_equal( ecl_kw_get_size( kw ) , LARGE_SIZE );
+  for (i=0; i < LARGE_SIZE; i++) {
+    if (data[i] != i)
+      test_error_exit("Element %d: %d != %d \n", i , data[i] , i);
+  }
+}
+
+
+void test_large_kw( ) {
+  ecl_kw_type * kw = ecl_kw_alloc( "LARGE" , LARGE_SIZE , ECL_INT_TYPE );
+  test_assert_true( (size_t) LARGE_SIZE * sizeof(int) > 2147483648UL );
+  {
+    int * data = ecl_kw_get_int_ptr( kw );
+    int i;
+    for (i=0; i < LARGE_SIZE; i++)
+      data[i] = i;
+  }
+
+  {
+    fortio_type * fortio = fortio_open_writer( "LARGE" , false , ECL_ENDIAN_FLIP );
+    ecl_kw_fwrite( kw , fortio );
+    fortio_fclose( fortio );
+  }
+  test_assert_size_t_equal( util_file_size( "LARGE" ) , ecl_kw_fortio_size( kw ));
+  assert_content( kw );
+
+  ecl_kw_scalar_set_int( kw , 0 );
+  {
+    fortio_type * fortio = fortio_open_reader( "LARGE" , false , ECL_ENDIAN_FLIP );
+    ecl_kw_fread( kw , fortio );
+    fortio_fclose( fortio );
+  }
+  assert_content( kw );
+  ecl_kw_free( kw );
+
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "LARGE" , ECL_FILE_MMAP );
+    test_assert_int_equal( ecl_file_get_size( ecl_file ) , 1 );
+    assert_content( ecl_file_iget_kw( ecl_file , 0 ));
+    ecl_file_close( ecl_file );
+  }
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_large" );
+  test_large_kw( );
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -0,0 +1,132 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_sum_columns.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_tstep.h>
+#include <ert/ecl/ecl_sum_vector.h>
+#include <ert/ecl/smspec_node.h>
+
+
+ecl_sum_type * alloc_case( time_t start_time ) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( "CASE" , false , true , ":" , start_time , true , 10 , 10 , 10 );
+  smspec_node_type * fopt = ecl_sum_add_var( ecl_sum , "FOPT" , NULL   , 0 , "SM3" , 0 );
+  smspec_node_type * wopr1 = ecl_sum_add_var( ecl_sum , "WOPR" , "OP-1" , 0 , "SM3/DAY" , 0 );
+  smspec_node_type * wopr2 = ecl_sum_add_var( ecl_sum , "WOPR" , "OP-2" , 0 , "SM3/DAY" , 0 );
+  int report_step , step;
+
+  for (report_step = 0; report_step < 5; report_step++) {
+    for (step = 0; step < 4; step++) {
+      int t = report_step * 4 + step;
+      ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , report_step + 1 , (t + 1) * 86400.0 );
+      ecl_sum_tstep_set_from_node( tstep , fopt  , 100 * t );
+      ecl_sum_tstep_set_from_node( tstep , wopr1 , t );
+      ecl_sum_tstep_set_from_node( tstep , wopr2 , 1000 - t * t );
+    }
+  }
+  return ecl_sum;
+}
+
+
+void test_data_vectors( const ecl_sum_type * ecl_sum , const ecl_sum_vector_type * keylist , double_vector_type ** expected) {
+  int i;
+  for (i=0; i < ecl_sum_vector_get_size( keylist ); i++) {
+    int params_index = ecl_sum_vector_iget_param_index( keylist , i );
+    double_vector_type * data = ecl_sum_alloc_data_vector( ecl_sum , params_index , false );
+    double_vector_type * report_data = ecl_sum_alloc_data_vector( ecl_sum , params_index , true );
+    test_assert_true( double_vector_equal( data , expected[2*i] ));
+    test_assert_true( double_vector_equal( report_data , expected[2*i + 1] ));
+    double_vector_free( data );
+    double_vector_free( report_data );
+  }
+}
+
+
+void test_interp_vector( const ecl_sum_type * ecl_sum , const ecl_sum_vector_type * keylist , const stringlist_type * keys) {
+  double_vector_type * values = double_vector_alloc( 0 , 0 );
+  time_t sim_time = ecl_sum_get_data_start( ecl_sum );
+
+  while (sim_time <= ecl_sum_get_end_time( ecl_sum )) {
+    int i;
+    ecl_sum_get_interp_vector( ecl_sum , sim_time , keylist , values );
+    test_assert_int_equal( double_vector_size( values ) , stringlist_get_size( keys ));
+    for (i=0; i < stringlist_get_size( keys ); i++)
+      test_assert_double_equal( double_vector_iget( values , i ) ,
+                                ecl_sum_get_general_var_from_sim_time( ecl_sum , sim_time , stringlist_iget( keys , i )));
+
+    sim_time += 3600 * 7;
+  }
+  double_vector_free( values );
+}
+
+
+int main( int argc , char ** argv) {
+  ecl_sum_type * ecl_sum = alloc_case( util_make_date_utc( 1,1,2010 ));
+  ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( ecl_sum );
+  stringlist_type * keys = stringlist_alloc_new( );
+  double_vector_type ** expected;
+  int i;
+
+  stringlist_append_ref( keys , "WOPR:OP-2" );
+  stringlist_append_ref( keys , "FOPT" );
+  stringlist_append_ref( keys , "WOPR:OP-1" );
+  for (i=0; i < stringlist_get_size( keys ); i++)
+    ecl_sum_vector_add_key( keylist , stringlist_iget( keys , i ));
+
+  expected = util_calloc( 2 * ecl_sum_vector_get_size( keylist ) , sizeof * expected );
+  for (i=0; i < ecl_sum_vector_get_size( keylist ); i++) {
+    int params_index = ecl_sum_vector_iget_param_index( keylist , i );
+    expected[2*i]     = ecl_sum_alloc_data_vector( ecl_sum , params_index , false );
+    expected[2*i + 1] = ecl_sum_alloc_data_vector( ecl_sum , params_index , true );
+  }
+
+  test_interp_vector( ecl_sum , keylist , keys );
+  ecl_sum_load_columns( ecl_sum , keylist );
+  ecl_sum_load_columns( ecl_sum , keylist );
+  test_data_vectors( ecl_sum , keylist , expected );
+  test_interp_vector( ecl_sum , keylist , keys );
+
+  {
+    int params_index = ecl_sum_vector_iget_param_index( keylist , 2 );
+    ecl_sum_scale_vector( ecl_sum , params_index , 2.0 );
+    test_assert_double_equal( ecl_sum_get_general_var( ecl_sum , 3 , "WOPR:OP-1" ) , 6 );
+    ecl_sum_load_columns( ecl_sum , keylist );
+    test_assert_double_equal( ecl_sum_get_general_var( ecl_sum , 3 , "WOPR:OP-1" ) , 6 );
+  }
+
+  {
+    ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , 6 , 21 * 86400.0 );
+    ecl_sum_tstep_iset( tstep , ecl_sum_vector_iget_param_index( keylist , 1 ) , 12345 );
+    test_assert_double_equal( ecl_sum_get_general_var( ecl_sum , 20 , "FOPT" ) , 12345 );
+    ecl_sum_load_columns( ecl_sum , keylist );
+    test_assert_double_equal( ecl_sum_get_general_var( ecl_sum , 20 , "FOPT" ) , 12345 );
+  }
+
+  for (i=0; i < 2 * ecl_sum_vector_get_size( keylist ); i++)
+    double_vector_free( expected[i] );
+  free( expected );
+  stringlist_free( keys );
+  ecl_sum_vector_free( keylist );
+  ecl_sum_free( ecl_sum );
+  exit(0);
+}
@@ -0,0 +1,141 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_sum_lazy_load.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/test_work_area.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/time_t_vector.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_tstep.h>
+#include <ert/ecl/ecl_sum_vector.h>
+#include <ert/ecl/smspec_node.h>
+
+
+void write_case( const char * name , bool unified , int num_wells , int num_report , int num_ministep) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( name , false , unified , ":" , util_make_date_utc( 1,1,2010 ) , true , 10 , 10 , 10 );
+  smspec_node_type ** nodes = util_calloc( num_wells , sizeof * nodes );
+  double sim_seconds = 0;
+  int w, report_step, step;
+
+  for (w=0; w < num_wells; w++) {
+    char * well = util_alloc_sprintf( "W%d" , w );
+    nodes[w] = ecl_sum_add_var( ecl_sum , (w % 2) ? "WOPR" : "WOPT" , well , 0 , "SM3" , 0 );
+    free( well );
+  }
+
+  for (report_step = 0; report_step < num_report; report_step++) {
+    for (step = 0; step < num_ministep; step++) {
+      ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , report_step + 1 , sim_seconds );
+      for (w=0; w < num_wells; w++)
+        ecl_sum_tstep_set_from_node( tstep , nodes[w] , w * 1000 + sim_seconds / 3600 );
+      sim_seconds += 7200;
+    }
+  }
+  ecl_sum_fwrite( ecl_sum );
+  ecl_sum_free( ecl_sum );
+  free( nodes );
+}
+
+
+void test_equal( const ecl_sum_type * ecl_sum , const ecl_sum_type * lazy_sum ) {
+  stringlist_type * keys = ecl_sum_alloc_matching_general_var_list( ecl_sum , "*" );
+  int i;
+
+  test_assert_int_equal( ecl_sum_get_data_length( ecl_sum ) , ecl_sum_get_data_length( lazy_sum ));
+  test_assert_time_t_equal( ecl_sum_get_end_time( ecl_sum ) , ecl_sum_get_end_time( lazy_sum ));
+  test_assert_int_equal( ecl_sum_get_last_report_step( ecl_sum ) , ecl_sum_get_last_report_step( lazy_sum ));
+  {
+    time_t_vector_type * time1 = ecl_sum_alloc_time_vector( ecl_sum , false );
+    time_t_vector_type * time2 = ecl_sum_alloc_time_vector( lazy_sum , false );
+    test_assert_true( time_t_vector_equal( time1 , time2 ));
+    time_t_vector_free( time1 );
+    time_t_vector_free( time2 );
+  }
+
+  for (i=0; i < stringlist_get_size( keys ); i++) {
+    const char * key = stringlist_iget( keys , i );
+    int params_index = ecl_sum_get_general_var_params_index( ecl_sum , key );
+    double_vector_type * data1 = ecl_sum_alloc_data_vector( ecl_sum , params_index , false );
+    double_vector_type * data2 = ecl_sum_alloc_data_vector( lazy_sum , params_index , false );
+
+    test_assert_true( double_vector_equal( data1 , data2 ));
+    test_assert_double_equal( ecl_sum_get_general_var( ecl_sum , 7 , key ) , ecl_sum_get_general_var( lazy_sum , 7 , key ));
+    double_vector_free( data1 );
+    double_vector_free( data2 );
+  }
+  stringlist_free( keys );
+}
+
+
+void test_case( bool unified ) {
+  test_work_area_type * work_area = test_work_area_alloc( "sum/lazy" );
+  ecl_sum_type * ecl_sum;
+
+  write_case( "CASE" , unified , 20 , 10 , 7 );
+  ecl_sum = ecl_sum_fread_alloc_case( "CASE" , ":" );
+  test_assert_false( util_file_exists( "CASE.SMRY_INDEX" ));
+
+  {
+    ecl_sum_type * lazy_sum = ecl_sum_fread_alloc_case2__( "CASE" , ":" , true , true );
+    test_assert_true( util_file_exists( "CASE.SMRY_INDEX" ));
+    test_equal( ecl_sum , lazy_sum );
+    ecl_sum_free( lazy_sum );
+  }
+
+  /* Second time around the index is read from the sidecar file. */
+  {
+    ecl_sum_type * lazy_sum = ecl_sum_fread_alloc_case2__( "CASE" , ":" , true , true );
+    ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( lazy_sum );
+
+    ecl_sum_vector_add_keys( keylist , "WOPR:*" );
+    ecl_sum_load_columns( lazy_sum , keylist );
+    test_equal( ecl_sum , lazy_sum );
+
+    ecl_sum_scale_vector( lazy_sum , ecl_sum_get_general_var_params_index( lazy_sum , "WOPT:W2" ) , 2.0 );
+    test_assert_double_equal( ecl_sum_get_general_var( lazy_sum , 3 , "WOPT:W2" ) , 2 * ecl_sum_get_general_var( ecl_sum , 3 , "WOPT:W2" ));
+
+    ecl_sum_vector_free( keylist );
+    ecl_sum_free( lazy_sum );
+  }
+
+  /* A stale index file is ignored and rewritten. */
+  {
+    ecl_sum_free( ecl_sum );
+    write_case( "CASE" , unified , 20 , 12 , 3 );
+    ecl_sum = ecl_sum_fread_alloc_case( "CASE" , ":" );
+    {
+      ecl_sum_type * lazy_sum = ecl_sum_fread_alloc_case2__( "CASE" , ":" , true , true );
+      test_equal( ecl_sum , lazy_sum );
+      ecl_sum_free( lazy_sum );
+    }
+  }
+
+  ecl_sum_free( ecl_sum );
+  test_work_area_free( work_area );
+}
+
+
+int main( int argc , char ** argv) {
+  test_case( true );
+  test_case( false );
+  exit(0);
+}
@@ -14,10 +14,30 @@ add_executable( ecl_init_file ecl_init_file.c )
 target_link_libraries( ecl_init_file ecl test_util )
 add_test( ecl_init_file ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_init  )
 
+add_executable( ecl_grav_stations ecl_grav_stations.c )
+target_link_libraries( ecl_grav_stations ecl test_util )
+add_test( ecl_grav_stations ${EXECUTABLE_OUTPUT_PATH}/ecl_grav_stations )
+
 add_executable( ecl_kw_fread ecl_kw_fread.c )
 target_link_libraries( ecl_kw_fread ecl test_util )
 add_test( ecl_kw_fread ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_fread  )
 
+add_executable( ecl_file_mmap ecl_file_mmap.c )
+target_link_libraries( ecl_file_mmap ecl test_util )
+add_test( ecl_file_mmap ${EXECUTABLE_OUTPUT_PATH}/ecl_file_mmap  )
+
+add_executable( ecl_file_index ecl_file_index.c )
+target_link_libraries( ecl_file_index ecl test_util )
+add_test( ecl_file_index ${EXECUTABLE_OUTPUT_PATH}/ecl_file_index  )
+
+add_executable( ecl_kw_fmt ecl_kw_fmt.c )
+target_link_libraries( ecl_kw_fmt ecl test_util )
+add_test( ecl_kw_fmt ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_fmt  )
+
+add_executable( ecl_kw_large ecl_kw_large.c )
+target_link_libraries( ecl_kw_large ecl test_util )
+add_test( ecl_kw_large ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_large  )
+
 add_executable( ecl_valid_basename ecl_valid_basename.c )
 target_link_libraries( ecl_valid_basename ecl test_util )
 add_test( ecl_valid_basename ${EXECUTABLE_OUTPUT_PATH}/ecl_valid_basename)
@@ -30,6 +50,14 @@ add_executable( ecl_sum_writer ecl_sum_writer.c )
 target_link_libraries( ecl_sum_writer ecl test_util )
 add_test( ecl_sum_writer ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_writer )
 
+add_executable( ecl_sum_columns ecl_sum_columns.c )
+target_link_libraries( ecl_sum_columns ecl test_util )
+add_test( ecl_sum_columns ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_columns )
+
+add_executable( ecl_sum_lazy_load ecl_sum_lazy_load.c )
+target_link_libraries( ecl_sum_lazy_load ecl test_util )
+add_test( ecl_sum_lazy_load ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_lazy_load )
+
 add_executable( ecl_grid_add_nnc ecl_grid_add_nnc.c )
 target_link_libraries( ecl_grid_add_nnc ecl test_util )
 add_test( ecl_grid_add_nnc ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_add_nnc )
@@ -88,6 +116,14 @@ add_executable( ecl_grid_copy ecl_grid_copy.c )
 target_link_libraries( ecl_grid_copy ecl test_util )
 add_test( ecl_grid_copy ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_copy )
 
+add_executable( ecl_grid_corner_storage ecl_grid_corner_storage.c )
+target_link_libraries( ecl_grid_corner_storage ecl test_util )
+add_test( ecl_grid_corner_storage ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_corner_storage )
+
+add_executable( ecl_grid_lookup ecl_grid_lookup.c )
+target_link_libraries( ecl_grid_lookup ecl test_util )
+add_test( ecl_grid_lookup ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_lookup )
+
 add_executable( ecl_get_num_cpu ecl_get_num_cpu_test.c )
 target_link_libraries( ecl_get_num_cpu ecl test_util )
 add_test( ecl_get_num_cpu ${EXECUTABLE_OUTPUT_PATH}/ecl_get_num_cpu 
@@ -105,6 +105,10 @@ void                   analysis_config_set_stop_long_running( analysis_config_ty
 bool                   analysis_config_get_stop_long_running( const analysis_config_type * config);
 void                   analysis_config_set_max_runtime( analysis_config_type * config, int max_runtime  );
 int                    analysis_config_get_max_runtime( const analysis_config_type * config );
+void                   analysis_config_set_num_threads( analysis_config_type * config, int num_threads );
+int                    analysis_config_get_num_threads( const analysis_config_type * config );
+void                   analysis_config_set_memory_limit( analysis_config_type * config, double memory_limit );
+double                 analysis_config_get_memory_limit( const analysis_config_type * config );
 const char           * analysis_config_get_active_module_name( const analysis_config_type * config );
 bool                   analysis_config_get_std_scale_correlated_obs( const analysis_config_type * config);
 void                   analysis_config_set_std_scale_correlated_obs( analysis_config_type * config, bool std_scale_correlated_obs);
@@ -53,6 +53,8 @@ extern "C" {
 #define  ANALYSIS_LOAD_KEY                 "ANALYSIS_LOAD"
 #define  ANALYSIS_SET_VAR_KEY              "ANALYSIS_SET_VAR"
 #define  ANALYSIS_SELECT_KEY               "ANALYSIS_SELECT"
+#define  ANALYSIS_THREADS_KEY              "ANALYSIS_THREADS"
+#define  ANALYSIS_MEMORY_LIMIT_KEY         "ANALYSIS_MEMORY_LIMIT"
 #define  CASE_TABLE_KEY                    "CASE_TABLE"
 #define  CONTAINER_KEY                     "CONTAINER"
 #define  CUSTOM_KW_KEY                     "CUSTOM_KW"
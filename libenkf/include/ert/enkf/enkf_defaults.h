@@ -128,6 +128,8 @@
 #define DEFAULT_ANALYSIS_MIN_REALISATIONS  0   // 0: No lower limit
 #define DEFAULT_ANALYSIS_STOP_LONG_RUNNING false 
 #define DEFAULT_MAX_RUNTIME                0
+#define DEFAULT_ANALYSIS_THREADS           0   // 0: Use the number of cpus detected at runtime
+#define DEFAULT_ANALYSIS_MEMORY_LIMIT      0   // 0: No limit; in Mb
 #define DEFAULT_ITER_RETRY_COUNT           4
 
 
@@ -27,6 +27,7 @@ extern "C" {
 #include <ert/util/stringlist.h>
 #include <ert/util/type_macros.h>
 #include <ert/util/buffer.h>
+#include <ert/util/double_vector.h>
 #include <ert/util/stringlist.h>
 
 #include <ert/enkf/fs_driver.h>
@@ -38,6 +39,7 @@ extern "C" {
 #include <ert/enkf/state_map.h>
 #include <ert/enkf/misfit_ensemble_typedef.h>
 #include <ert/enkf/summary_key_set.h>
+#include <ert/enkf/summary_store.h>
 #include <ert/enkf/custom_kw_config_set.h>
 
   const      char * enkf_fs_get_mount_point( const enkf_fs_type * fs );
@@ -77,6 +79,9 @@ extern "C" {
   
 
   bool              enkf_fs_has_vector(enkf_fs_type * enkf_fs , const char * node_key , enkf_var_type var_type , int iens);
+  bool              enkf_fs_has_summary_vector( enkf_fs_type * enkf_fs , const char * node_key , int iens );
+  bool              enkf_fs_fread_summary_vector( enkf_fs_type * enkf_fs , const char * node_key , int iens , double_vector_type * vector );
+  void              enkf_fs_fwrite_summary_vector( enkf_fs_type * enkf_fs , const char * node_key , int iens , const double_vector_type * vector );
   bool              enkf_fs_has_node(enkf_fs_type * enkf_fs , const char * node_key , enkf_var_type var_type , int report_step , int iens);
 
   void              enkf_fs_debug_fprintf( const enkf_fs_type * fs);
@@ -106,6 +111,7 @@ extern "C" {
   cases_config_type         * enkf_fs_get_cases_config( const enkf_fs_type * fs);
   misfit_ensemble_type      * enkf_fs_get_misfit_ensemble( const enkf_fs_type * fs );
   summary_key_set_type      * enkf_fs_get_summary_key_set( const enkf_fs_type * fs );
+  summary_store_type        * enkf_fs_get_summary_store( const enkf_fs_type * fs );
   custom_kw_config_set_type * enkf_fs_get_custom_kw_config_set( const enkf_fs_type * fs );
 
   void             enkf_fs_increase_write_count(enkf_fs_type * fs);
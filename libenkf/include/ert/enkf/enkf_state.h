@@ -52,6 +52,7 @@ extern "C" {
 #include <ert/enkf/enkf_util.h>
 #include <ert/enkf/enkf_serialize.h>
 #include <ert/enkf/run_arg.h>
+#include <ert/enkf/runpath_file_cache.h>
 
 typedef struct enkf_state_struct    enkf_state_type;
 
@@ -82,7 +83,7 @@ typedef struct enkf_state_struct    enkf_state_type;
   int enkf_state_forward_init(enkf_state_type * enkf_state ,
                               run_arg_type * run_arg);
 
-  void enkf_state_init_eclipse(enkf_state_type *enkf_state, const run_arg_type * run_arg );
+  void enkf_state_init_eclipse(enkf_state_type *enkf_state, const run_arg_type * run_arg , runpath_file_cache_type * file_cache);
 
   enkf_state_type  * enkf_state_alloc(int ,
                                       rng_type        * main_rng ,
@@ -28,6 +28,8 @@ extern "C" {
 #include <ert/util/hash.h>
 #include <ert/util/rng.h>
 
+#include <ert/analysis/obs_covar.h>
+
 #include <ert/enkf/enkf_types.h>
 #include <ert/enkf/meas_data.h>
 
@@ -59,11 +61,13 @@ void                 obs_data_free(obs_data_type *);
 void                 obs_data_reset(obs_data_type * obs_data);
 matrix_type        * obs_data_allocD(const obs_data_type * obs_data , const matrix_type * E  , const matrix_type * S);
 matrix_type        * obs_data_allocR(const obs_data_type * obs_data );
+obs_covar_type     * obs_data_alloc_covar(const obs_data_type * obs_data );
 matrix_type        * obs_data_allocdObs(const obs_data_type * obs_data );
 //matrix_type        * obs_data_alloc_innov(const obs_data_type * obs_data , const meas_data_type * meas_data , int active_size);
 matrix_type        * obs_data_allocE(const obs_data_type * obs_data , rng_type * rng , int active_ens_size);
 matrix_type        * obs_data_allocE_non_centred(const obs_data_type * obs_data , rng_type * rng , int ens_size);
   void                 obs_data_scale(const obs_data_type * obs_data , matrix_type *S , matrix_type *E , matrix_type *D , matrix_type *R , matrix_type * O);
+  void                 obs_data_scale_covar(const obs_data_type * obs_data , obs_covar_type * covar);
 void                 obs_data_scale_kernel(const obs_data_type * obs_data , matrix_type *S , matrix_type *E , matrix_type *D , double *dObs);
 void                 obs_data_fprintf(const obs_data_type * , FILE *);
 void                 obs_data_iget_value_std(const obs_data_type * obs_data , int index , double * value ,  double * std);
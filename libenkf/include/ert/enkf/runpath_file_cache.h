@@ -0,0 +1,46 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'runpath_file_cache.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_RUNPATH_FILE_CACHE_H
+#define ERT_RUNPATH_FILE_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+
+#include <ert/util/type_macros.h>
+#include <ert/util/subst_list.h>
+
+  typedef struct runpath_file_cache_struct runpath_file_cache_type;
+
+  runpath_file_cache_type * runpath_file_cache_alloc( void );
+  void                      runpath_file_cache_free( runpath_file_cache_type * cache );
+  bool                      runpath_file_cache_has_key( runpath_file_cache_type * cache , const char * key );
+  bool                      runpath_file_cache_install( runpath_file_cache_type * cache , const char * key , const subst_list_type * subst_list , const char * target_file );
+  void                      runpath_file_cache_add( runpath_file_cache_type * cache , const char * key , const char * source_text , const subst_list_type * subst_list , const char * rendered_file );
+  int                       runpath_file_cache_get_size( runpath_file_cache_type * cache );
+  int                       runpath_file_cache_get_hits( runpath_file_cache_type * cache );
+
+  UTIL_IS_INSTANCE_HEADER( runpath_file_cache );
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -26,6 +26,7 @@
 #include <ert/enkf/enkf_macros.h>
 #include <ert/enkf/enkf_util.h>
 #include <ert/enkf/summary_config.h>
+#include <ert/enkf/enkf_fs_type.h>
 
 
 
@@ -34,6 +35,8 @@
 
 double    summary_get(const summary_type * summary, int report_step );
 bool      summary_active_value( double value );
+bool      summary_fread_vector( summary_type * summary , enkf_fs_type * fs , int iens );
+void      summary_fwrite_vector( const summary_type * summary , enkf_fs_type * fs , int iens );
 
 VOID_HAS_DATA_HEADER(summary);
 UTIL_SAFE_CAST_HEADER(summary);
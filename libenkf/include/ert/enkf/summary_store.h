@@ -0,0 +1,50 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'summary_store.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_SUMMARY_STORE_H
+#define ERT_SUMMARY_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+
+#include <ert/util/type_macros.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/stringlist.h>
+
+  typedef struct summary_store_struct summary_store_type;
+
+  summary_store_type * summary_store_alloc( const char * filename );
+  void                 summary_store_free( summary_store_type * store );
+  void                 summary_store_fsync( summary_store_type * store );
+
+  int                  summary_store_get_size( summary_store_type * store );
+  bool                 summary_store_has_key( summary_store_type * store , const char * key );
+  stringlist_type    * summary_store_alloc_keys( summary_store_type * store );
+  bool                 summary_store_has_vector( summary_store_type * store , const char * key , int iens );
+  bool                 summary_store_get_vector( summary_store_type * store , const char * key , int iens , double_vector_type * vector );
+  void                 summary_store_set_vector( summary_store_type * store , const char * key , int iens , const double_vector_type * vector );
+
+  UTIL_IS_INSTANCE_HEADER( summary_store );
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -62,6 +62,8 @@ struct analysis_config_struct {
   bool                            stop_long_running;
   bool                            std_scale_correlated_obs;
   int                             max_runtime;
+  int                             num_threads;                 /* Size of the thread pools used in the update. */
+  double                          memory_limit;                /* Memory for the A matrix in the update, in Mb; 0 means no limit. */
   double                          global_std_scaling;
 };
 
@@ -167,6 +169,36 @@ void analysis_config_set_max_runtime( analysis_config_type * config, int max_run
   config->max_runtime = max_runtime;
 }
 
+int analysis_config_get_num_threads( const analysis_config_type * config ) {
+  return config->num_threads;
+}
+
+/*
+  A value <= 0 will use the number of cpus available on the current
+  host.
+*/
+
+void analysis_config_set_num_threads( analysis_config_type * config, int num_threads ) {
+  if (num_threads <= 0)
+    num_threads = util_get_num_cpu();
+  config->num_threads = num_threads;
+}
+
+double analysis_config_get_memory_limit( const analysis_config_type * config ) {
+  return config->memory_limit;
+}
+
+/*
+  A value <= 0 means no limit, i.e. all the parameters in a dataset
+  are serialized to one A matrix.
+*/
+
+void analysis_config_set_memory_limit( analysis_config_type * config, double memory_limit ) {
+  if (memory_limit < 0)
+    memory_limit = 0;
+  config->memory_limit = memory_limit;
+}
+
 static void analysis_config_set_min_realisations( analysis_config_type * config , int min_realisations) {
   config->min_realisations = min_realisations;
 }
@@ -502,6 +534,12 @@ void analysis_config_init( analysis_config_type * analysis , const config_conten
     analysis_config_set_max_runtime( analysis, config_content_get_value_as_int( config, MAX_RUNTIME_KEY ));
   }
 
+  if (config_content_has_item( config, ANALYSIS_THREADS_KEY))
+    analysis_config_set_num_threads( analysis, config_content_get_value_as_int( config, ANALYSIS_THREADS_KEY ));
+
+  if (config_content_has_item( config, ANALYSIS_MEMORY_LIMIT_KEY))
+    analysis_config_set_memory_limit( analysis, config_content_get_value_as_double( config, ANALYSIS_MEMORY_LIMIT_KEY ));
+
 
   /* Loading external modules */
   analysis_config_load_all_external_modules_from_config(analysis, config);
@@ -603,6 +641,8 @@ analysis_config_type * analysis_config_alloc( rng_type * rng ) {
   analysis_config_set_min_realisations( config         , DEFAULT_ANALYSIS_MIN_REALISATIONS );
   analysis_config_set_stop_long_running( config        , DEFAULT_ANALYSIS_STOP_LONG_RUNNING );
   analysis_config_set_max_runtime( config              , DEFAULT_MAX_RUNTIME );
+  analysis_config_set_num_threads( config              , DEFAULT_ANALYSIS_THREADS );
+  analysis_config_set_memory_limit( config             , DEFAULT_ANALYSIS_MEMORY_LIMIT );
 
   config->analysis_module      = NULL;
   config->analysis_modules     = hash_alloc();
@@ -643,6 +683,8 @@ void analysis_config_add_config_items( config_parser_type * config ) {
   config_add_key_value( config , UPDATE_LOG_PATH_KEY         , false , CONFIG_STRING);
   config_add_key_value( config , MIN_REALIZATIONS_KEY        , false , CONFIG_STRING );
   config_add_key_value( config , MAX_RUNTIME_KEY             , false , CONFIG_INT );
+  config_add_key_value( config , ANALYSIS_THREADS_KEY        , false , CONFIG_INT );
+  config_add_key_value( config , ANALYSIS_MEMORY_LIMIT_KEY   , false , CONFIG_FLOAT );
   config_add_key_value( config , STD_SCALE_CORRELATED_OBS_KEY, false , CONFIG_BOOL );
 
   item = config_add_key_value( config , STOP_LONG_RUNNING_KEY, false,  CONFIG_BOOL );
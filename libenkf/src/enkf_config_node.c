@@ -106,8 +106,11 @@ bool enkf_config_node_has_node( const enkf_config_node_type * node , enkf_fs_typ
 
 
 bool enkf_config_node_has_vector( const enkf_config_node_type * node , enkf_fs_type * fs , int iens) {
-  bool has_vector = enkf_fs_has_vector( fs , node->key , node->var_type , iens );
-  return has_vector;
+  if (node->impl_type == SUMMARY) {
+    if (enkf_fs_has_summary_vector( fs , node->key , iens ))
+      return true;
+  }
+  return enkf_fs_has_vector( fs , node->key , node->var_type , iens );
 }
 
 
@@ -44,6 +44,7 @@
 #include <ert/enkf/time_map.h>
 #include <ert/enkf/state_map.h>
 #include <ert/enkf/summary_key_set.h>
+#include <ert/enkf/summary_store.h>
 #include <ert/enkf/misfit_ensemble.h>
 #include <ert/enkf/cases_config.h>
 #include <ert/enkf/custom_kw_config_set.h>
@@ -207,6 +208,7 @@
 #define ENKF_FS_TYPE_ID           1089763
 #define ENKF_MOUNT_MAP            "enkf_mount_info"
 #define SUMMARY_KEY_SET_FILE      "summary-key-set"
+#define SUMMARY_STORE_FILE        "summary-store"
 #define TIME_MAP_FILE             "time-map"
 #define STATE_MAP_FILE            "state-map"
 #define MISFIT_ENSEMBLE_FILE      "misfit-ensemble"
@@ -231,6 +233,7 @@ struct enkf_fs_struct {
   cases_config_type         * cases_config;
   state_map_type            * state_map;
   summary_key_set_type      * summary_key_set;
+  summary_store_type        * summary_store;
   misfit_ensemble_type      * misfit_ensemble;
   custom_kw_config_set_type * custom_kw_config_set;
   /*
@@ -294,6 +297,7 @@ static enkf_fs_type * enkf_fs_alloc_empty( const char * mount_point ) {
   fs->cases_config           = cases_config_alloc();
   fs->state_map              = state_map_alloc();
   fs->summary_key_set        = summary_key_set_alloc();
+  fs->summary_store          = NULL;
   fs->custom_kw_config_set   = custom_kw_config_set_alloc();
   fs->misfit_ensemble        = misfit_ensemble_alloc();
   fs->index                  = NULL;
@@ -558,6 +562,17 @@ static void enkf_fs_fread_summary_key_set( enkf_fs_type * fs ) {
   free( filename );
 }
 
+static void enkf_fs_fsync_summary_store( enkf_fs_type * fs ) {
+  if (fs->summary_store)
+    summary_store_fsync( fs->summary_store );
+}
+
+static void enkf_fs_fread_summary_store( enkf_fs_type * fs ) {
+  char * filename = enkf_fs_alloc_case_filename( fs , SUMMARY_STORE_FILE );
+  fs->summary_store = summary_store_alloc( filename );
+  free( filename );
+}
+
 static void enkf_fs_fread_custom_kw_config_set(enkf_fs_type * fs) {
   char * filename = enkf_fs_alloc_case_filename(fs, CUSTOM_KW_CONFIG_SET_FILE);
   custom_kw_config_set_fread(fs->custom_kw_config_set, filename);
@@ -674,6 +689,7 @@ enkf_fs_type * enkf_fs_mount( const char * mount_point ) {
     enkf_fs_fread_cases_config( fs );
     enkf_fs_fread_state_map( fs );
     enkf_fs_fread_summary_key_set( fs );
+    enkf_fs_fread_summary_store( fs );
     enkf_fs_fread_custom_kw_config_set( fs );
     enkf_fs_fread_misfit( fs );
 
@@ -738,6 +754,8 @@ static void enkf_fs_umount( enkf_fs_type * fs ) {
       custom_kw_config_set_free( fs->custom_kw_config_set );
       state_map_free( fs->state_map );
       summary_key_set_free(fs->summary_key_set);
+      if (fs->summary_store)
+        summary_store_free( fs->summary_store );
       time_map_free( fs->time_map );
       cases_config_free( fs->cases_config );
       misfit_ensemble_free( fs->misfit_ensemble );
@@ -791,6 +809,7 @@ void enkf_fs_fsync( enkf_fs_type * fs ) {
   enkf_fs_fsync_cases_config( fs) ;
   enkf_fs_fsync_state_map( fs );
   enkf_fs_fsync_summary_key_set( fs );
+  enkf_fs_fsync_summary_store( fs );
   enkf_fs_fsync_custom_kw_config_set(fs);
 }
 
@@ -855,6 +874,32 @@ void enkf_fs_fwrite_node(enkf_fs_type * enkf_fs , buffer_type * buffer , const c
 }
 
 
+/**
+   The summary vectors are not stored through the fs_driver
+   instances, but in the dedicated summary_store; see summary_store.c
+   for the storage layout. For filesystems created before the
+   summary_store was introduced the summary vectors are still found
+   through enkf_fs_has_vector() and enkf_fs_fread_vector().
+*/
+
+bool enkf_fs_has_summary_vector( enkf_fs_type * enkf_fs , const char * node_key , int iens ) {
+  return summary_store_has_vector( enkf_fs->summary_store , node_key , iens );
+}
+
+
+bool enkf_fs_fread_summary_vector( enkf_fs_type * enkf_fs , const char * node_key , int iens , double_vector_type * vector ) {
+  return summary_store_get_vector( enkf_fs->summary_store , node_key , iens , vector );
+}
+
+
+void enkf_fs_fwrite_summary_vector( enkf_fs_type * enkf_fs , const char * node_key , int iens , const double_vector_type * vector ) {
+  if (enkf_fs->read_only)
+    util_abort("%s: attempt to write to read_only filesystem mounted at:%s - aborting. \n",__func__ , enkf_fs->mount_point);
+
+  summary_store_set_vector( enkf_fs->summary_store , node_key , iens , vector );
+}
+
+
 void enkf_fs_fwrite_vector(enkf_fs_type * enkf_fs , buffer_type * buffer , const char * node_key, enkf_var_type var_type,
                            int iens ) {
   if (enkf_fs->read_only)
@@ -1032,6 +1077,10 @@ state_map_type * enkf_fs_get_state_map( const enkf_fs_type * fs ) {
   return fs->state_map;
 }
 
+summary_store_type * enkf_fs_get_summary_store( const enkf_fs_type * fs ) {
+  return fs->summary_store;
+}
+
 summary_key_set_type * enkf_fs_get_summary_key_set( const enkf_fs_type * fs ) {
   return fs->summary_key_set;
 }
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <signal.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <pthread.h>
 #include <dirent.h>
 #include <pwd.h>
@@ -31,6 +32,7 @@
 
 #define HAVE_THREAD_POOL 1
 #include <ert/util/matrix.h>
+#include <ert/util/matrix_blas.h>
 #include <ert/util/subst_list.h>
 #include <ert/util/rng.h>
 #include <ert/util/subst_func.h>
@@ -38,6 +40,7 @@
 #include <ert/util/bool_vector.h>
 #include <ert/util/util.h>
 #include <ert/util/hash.h>
+#include <ert/util/vector.h>
 #include <ert/util/path_fmt.h>
 #include <ert/util/thread_pool.h>
 #include <ert/util/arg_pack.h>
@@ -69,6 +72,7 @@
 #include <ert/analysis/analysis_table.h>
 #include <ert/analysis/enkf_linalg.h>
 #include <ert/analysis/module_info.h>
+#include <ert/analysis/obs_covar.h>
 
 #include <ert/enkf/enkf_types.h>
 #include <ert/enkf/enkf_config_node.h>
@@ -640,6 +644,21 @@ static int __get_active_size(const ensemble_config_type * ensemble_config , enkf
 
 
 /*****************************************************************/
+/**
+   One part of a node in the streaming update, see
+   enkf_main_stream_dataset_X() below.
+*/
+
+typedef struct {
+  const enkf_config_node_type * config_node;
+  active_list_type            * active_list;   /* The elements of the node in this segment. */
+  int                           row_offset;    /* Row offset in the chunk. */
+  bool                          first;         /* The node is loaded when the first segment is serialized ... */
+  bool                          last;          /* ... and stored when the last segment is deserialized. */
+  enkf_node_type             ** nodes;         /* One node per realisation, shared by all the segments of the node. */
+} stream_segment_type;
+
+
 /**
    Helper struct used to pass information to the multithreaded
    serialize / deserialize functions.
@@ -659,6 +678,7 @@ typedef struct {
   const active_list_type  * active_list;
   matrix_type             * A;
   const int_vector_type   * iens_active_index;
+  stream_segment_type     * segment;   /* Only used in the streaming update. */
 } serialize_info_type;
 
 
@@ -741,6 +761,8 @@ static int enkf_main_serialize_dataset( const ensemble_config_type * ens_config
   int ens_size      = matrix_get_columns( A );
   int current_row   = 0;
 
+  /* The header of A has been shrunk to the size of the previous dataset. */
+  matrix_full_size( A );
   for (int ikw=0; ikw < num_kw; ikw++) {
     const char             * key         = stringlist_iget(update_keys , ikw);
     enkf_config_node_type * config_node  = ensemble_config_get_node( ens_config , key );
@@ -881,6 +903,277 @@ static serialize_info_type * serialize_info_alloc( enkf_fs_type * src_fs,
   return serialize_info;
 }
 
+/*****************************************************************/
+/*
+  Streaming update. When the analysis module only needs the X matrix,
+  the rows of A are updated independently of each other, and a
+  dataset can be updated in chunks of at most chunk_rows rows. This
+  bounds the memory used for A when the parameter fields are huge;
+  nodes larger than a chunk are split in segments over several chunks,
+  with one partial active_list for each segment.
+
+  Two A buffers are used; the next chunk is serialized into one of them
+  while the current chunk is multiplied with X in the other. The
+  current chunk is deserialized when both are complete.
+
+  The nodes are not taken from the enkf_state instances; each node gets
+  one private instance per realisation. It is loaded when the first
+  segment is serialized and stored and freed when the last segment has
+  been deserialized, i.e. the parameters are only read and written
+  once, and only the nodes of the chunks in flight are kept in memory.
+*/
+
+static stream_segment_type * stream_segment_alloc( const enkf_config_node_type * config_node , enkf_node_type ** nodes , int row_offset ) {
+  stream_segment_type * segment = util_malloc( sizeof * segment );
+  segment->config_node = config_node;
+  segment->nodes       = nodes;
+  segment->row_offset  = row_offset;
+  segment->active_list = NULL;
+  segment->first       = false;
+  segment->last        = false;
+  return segment;
+}
+
+
+static void stream_segment_free( stream_segment_type * segment ) {
+  if (segment->last)
+    free( segment->nodes );
+  active_list_free( segment->active_list );
+  free( segment );
+}
+
+
+static void stream_segment_free__( void * arg ) {
+  stream_segment_free( (stream_segment_type *) arg );
+}
+
+
+/*
+  Two buffers of chunk_rows x ens_size doubles must fit in the memory
+  limit, which is given in Mb.
+*/
+
+static int enkf_main_stream_chunk_rows( double memory_limit , int ens_size ) {
+  double rows = memory_limit * 1024 * 1024 / (2.0 * sizeof(double) * util_int_max( 1 , ens_size ));
+  if (rows >= INT_MAX)
+    return INT_MAX;
+  return util_int_max( 1 , (int) rows );
+}
+
+
+/*
+  Splits the nodes of the dataset in a list of chunks, where each chunk
+  is a list of segments with at most chunk_rows rows in total. The
+  number of rows in each chunk is appended to chunk_size.
+*/
+
+static vector_type * enkf_main_alloc_stream_chunks( const ensemble_config_type * ensemble_config ,
+                                                    const local_dataset_type * dataset ,
+                                                    const serialize_info_type * serialize_info ,
+                                                    int chunk_rows ,
+                                                    int_vector_type * chunk_size) {
+  vector_type * chunks = vector_alloc_new( );
+  vector_type * segments = NULL;
+  stringlist_type * update_keys = local_dataset_alloc_keys( dataset );
+  int ens_size = int_vector_size( serialize_info->iens_active_index );
+  int current_row = chunk_rows;
+
+  for (int ikw = 0; ikw < stringlist_get_size( update_keys ); ikw++) {
+    const char * key = stringlist_iget( update_keys , ikw );
+    const enkf_config_node_type * config_node = ensemble_config_get_node( ensemble_config , key );
+    if ((serialize_info->run_mode == SMOOTHER_UPDATE) && (enkf_config_node_get_var_type( config_node ) != PARAMETER))
+      continue;
+    {
+      const active_list_type * active_list = local_dataset_get_node_active_list( dataset , key );
+      const int active_size = __get_active_size( ensemble_config , serialize_info->src_fs , key , serialize_info->report_step , active_list );
+      const int * active_index = active_list_get_active( active_list );
+      enkf_node_type ** nodes;
+      int offset = 0;
+
+      if (active_size == 0)
+        continue;
+
+      nodes = util_calloc( ens_size , sizeof * nodes );
+      while (offset < active_size) {
+        int rows;
+        stream_segment_type * segment;
+
+        if (current_row == chunk_rows) {
+          segments = vector_alloc_new( );
+          vector_append_owned_ref( chunks , segments , vector_free__ );
+          int_vector_append( chunk_size , 0 );
+          current_row = 0;
+        }
+
+        rows = util_int_min( active_size - offset , chunk_rows - current_row );
+        segment = stream_segment_alloc( config_node , nodes , current_row );
+        if (rows == active_size)
+          segment->active_list = active_list_alloc_copy( active_list );
+        else {
+          segment->active_list = active_list_alloc( );
+          for (int i = offset; i < offset + rows; i++)
+            active_list_add_index( segment->active_list , active_index ? active_index[i] : i );
+        }
+        segment->first = (offset == 0);
+        segment->last  = (offset + rows == active_size);
+        vector_append_owned_ref( segments , segment , stream_segment_free__ );
+
+        offset += rows;
+        current_row += rows;
+        int_vector_iset( chunk_size , int_vector_size( chunk_size ) - 1 , current_row );
+      }
+    }
+  }
+  stringlist_free( update_keys );
+  return chunks;
+}
+
+
+static void * stream_serialize_mt( void * arg ) {
+  serialize_info_type * info = (serialize_info_type *) arg;
+  stream_segment_type * segment = info->segment;
+  int iens;
+  for (iens = info->iens1; iens < info->iens2; iens++) {
+    int column = int_vector_iget( info->iens_active_index , iens );
+    if (column >= 0) {
+      node_id_type node_id = {.report_step = info->report_step , .iens = iens };
+      if (segment->first) {
+        segment->nodes[iens] = enkf_node_alloc( segment->config_node );
+        enkf_node_serialize( segment->nodes[iens] , info->src_fs , node_id , segment->active_list , info->A , segment->row_offset , column );
+      } else
+        enkf_node_serialize_data( segment->nodes[iens] , node_id , segment->active_list , info->A , segment->row_offset , column );
+    }
+  }
+  return NULL;
+}
+
+
+static void * stream_deserialize_mt( void * arg ) {
+  serialize_info_type * info = (serialize_info_type *) arg;
+  stream_segment_type * segment = info->segment;
+  int iens;
+  for (iens = info->iens1; iens < info->iens2; iens++) {
+    int column = int_vector_iget( info->iens_active_index , iens );
+    if (column >= 0) {
+      node_id_type node_id = {.report_step = info->target_step , .iens = iens };
+      if (segment->last) {
+        enkf_node_deserialize( segment->nodes[iens] , info->target_fs , node_id , segment->active_list , info->A , segment->row_offset , column );
+        state_map_update_undefined( enkf_fs_get_state_map( info->target_fs ) , iens , STATE_INITIALIZED );
+        enkf_node_free( segment->nodes[iens] );
+        segment->nodes[iens] = NULL;
+      } else
+        enkf_node_deserialize_data( segment->nodes[iens] , node_id , segment->active_list , info->A , segment->row_offset , column );
+    }
+  }
+  return NULL;
+}
+
+
+static void enkf_main_stream_chunk( const vector_type * segments ,
+                                    thread_pool_type * work_pool ,
+                                    serialize_info_type * serialize_info ,
+                                    void * (*func) (void *)) {
+  const int num_cpu_threads = thread_pool_get_max_running( work_pool );
+  for (int iseg = 0; iseg < vector_get_size( segments ); iseg++) {
+    stream_segment_type * segment = vector_iget( segments , iseg );
+    thread_pool_restart( work_pool );
+    for (int icpu = 0; icpu < num_cpu_threads; icpu++) {
+      serialize_info[icpu].segment = segment;
+      thread_pool_add_job( work_pool , func , &serialize_info[icpu] );
+    }
+    thread_pool_join( work_pool );
+  }
+}
+
+
+static void * enkf_main_stream_serialize_chunk_mt( void * arg ) {
+  arg_pack_type * arg_pack             = arg_pack_safe_cast( arg );
+  const vector_type * segments         = arg_pack_iget_const_ptr( arg_pack , 0 );
+  thread_pool_type * work_pool         = arg_pack_iget_ptr( arg_pack , 1 );
+  serialize_info_type * serialize_info = arg_pack_iget_ptr( arg_pack , 2 );
+
+  enkf_main_stream_chunk( segments , work_pool , serialize_info , stream_serialize_mt );
+  return NULL;
+}
+
+
+static void enkf_main_stream_dataset_X( const ensemble_config_type * ensemble_config ,
+                                        const local_dataset_type * dataset ,
+                                        const matrix_type * X ,
+                                        const serialize_info_type * template ,
+                                        int num_threads ,
+                                        double memory_limit ) {
+  const int ens_size = matrix_get_columns( X );
+  int_vector_type * chunk_size = int_vector_alloc( 0 , 0 );
+  vector_type * chunks = enkf_main_alloc_stream_chunks( ensemble_config ,
+                                                        dataset ,
+                                                        template ,
+                                                        enkf_main_stream_chunk_rows( memory_limit , ens_size ) ,
+                                                        chunk_size );
+  const int num_chunks = vector_get_size( chunks );
+
+  if (num_chunks > 0) {
+    const int num_buffers = util_int_min( 2 , num_chunks );
+    thread_pool_type * io_pool   = thread_pool_alloc( num_threads , false );
+    thread_pool_type * mult_pool = thread_pool_alloc( num_threads , false );
+    thread_pool_type * bg_pool   = thread_pool_alloc( 1 , false );
+    arg_pack_type * arg_pack     = arg_pack_alloc( );
+    matrix_type * A[2] = { NULL , NULL };
+    serialize_info_type * serialize_info[2] = { NULL , NULL };
+
+    for (int ib = 0; ib < num_buffers; ib++) {
+      A[ib] = matrix_alloc( int_vector_get_max( chunk_size ) , ens_size );
+      serialize_info[ib] = serialize_info_alloc( template->src_fs ,
+                                                 template->target_fs ,
+                                                 template->iens_active_index ,
+                                                 template->target_step ,
+                                                 template->ensemble ,
+                                                 template->run_mode ,
+                                                 template->report_step ,
+                                                 A[ib] ,
+                                                 num_threads );
+    }
+
+    enkf_main_stream_chunk( vector_iget_const( chunks , 0 ) , io_pool , serialize_info[0] , stream_serialize_mt );
+    for (int ichunk = 0; ichunk < num_chunks; ichunk++) {
+      const int ib = ichunk % 2;
+      const bool prefetch = (ichunk + 1 < num_chunks);
+
+      if (prefetch) {
+        arg_pack_clear( arg_pack );
+        arg_pack_append_const_ptr( arg_pack , vector_iget_const( chunks , ichunk + 1 ));
+        arg_pack_append_ptr( arg_pack , io_pool );
+        arg_pack_append_ptr( arg_pack , serialize_info[1 - ib] );
+
+        thread_pool_restart( bg_pool );
+        thread_pool_add_job( bg_pool , enkf_main_stream_serialize_chunk_mt , arg_pack );
+      }
+
+      matrix_shrink_header( A[ib] , int_vector_iget( chunk_size , ichunk ) , ens_size );
+      matrix_inplace_dgemm_mt( A[ib] , X , mult_pool );
+
+      if (prefetch)
+        thread_pool_join( bg_pool );
+
+      enkf_main_stream_chunk( vector_iget_const( chunks , ichunk ) , io_pool , serialize_info[ib] , stream_deserialize_mt );
+      matrix_full_size( A[ib] );
+    }
+
+    for (int ib = 0; ib < num_buffers; ib++) {
+      serialize_info_free( serialize_info[ib] );
+      matrix_free( A[ib] );
+    }
+    arg_pack_free( arg_pack );
+    thread_pool_free( bg_pool );
+    thread_pool_free( mult_pool );
+    thread_pool_free( io_pool );
+  }
+
+  vector_free( chunks );
+  int_vector_free( chunk_size );
+}
+
+
 static module_info_type * enkf_main_module_info_alloc( const local_ministep_type* ministep,
                                                        const obs_data_type * obs_data,
                                                        const local_dataset_type * dataset ,
@@ -982,6 +1275,161 @@ static void assert_size_equal(int ens_size , const bool_vector_type * ens_mask)
 }
 
 
+/*
+  Modules with the ANALYSIS_OBS_COVAR option get the observation error
+  covariance as the block structured obs_covar, and the dense R matrix
+  is not allocated; for all other modules R is non NULL.
+*/
+
+static void enkf_main_initX( analysis_module_type * module ,
+                             matrix_type * X ,
+                             matrix_type * A ,
+                             matrix_type * S ,
+                             matrix_type * R ,
+                             const obs_covar_type * covar ,
+                             matrix_type * dObs ,
+                             matrix_type * E ,
+                             matrix_type * D ) {
+  if (R == NULL)
+    analysis_module_initX_covar( module , X , A , S , covar , dObs , E , D );
+  else
+    analysis_module_initX( module , X , A , S , R , dObs , E , D );
+}
+
+
+/*
+  Updating a dataset with a precomputed X matrix is a matter of
+  serializing the dataset into A, the multiplication A = A*X and
+  deserializing again; the A matrix is the one in serialize_info.
+*/
+
+static void enkf_main_update_dataset_X( ensemble_config_type * ensemble_config ,
+                                        const local_dataset_type * dataset ,
+                                        int report_step ,
+                                        hash_type * use_count ,
+                                        const matrix_type * X ,
+                                        thread_pool_type * tp ,
+                                        serialize_info_type * serialize_info) {
+  int * active_size = util_calloc( local_dataset_get_size( dataset ) , sizeof * active_size );
+  int * row_offset  = util_calloc( local_dataset_get_size( dataset ) , sizeof * row_offset  );
+
+  if (enkf_main_serialize_dataset( ensemble_config , dataset , report_step , use_count , active_size , row_offset , tp , serialize_info) > 0) {
+    matrix_inplace_dgemm_mt( serialize_info->A , X , tp );
+    enkf_main_deserialize_dataset( ensemble_config , dataset , active_size , row_offset , serialize_info , tp);
+  }
+
+  free( active_size );
+  free( row_offset );
+}
+
+
+static void * enkf_main_update_dataset_X_mt( void * arg ) {
+  arg_pack_type * arg_pack                 = arg_pack_safe_cast( arg );
+  ensemble_config_type * ensemble_config   = arg_pack_iget_ptr( arg_pack , 0 );
+  const local_dataset_type * dataset       = arg_pack_iget_const_ptr( arg_pack , 1 );
+  hash_type * use_count                    = arg_pack_iget_ptr( arg_pack , 2 );
+  const matrix_type * X                    = arg_pack_iget_const_ptr( arg_pack , 3 );
+  const serialize_info_type * template     = arg_pack_iget_const_ptr( arg_pack , 4 );
+  int num_threads                          = arg_pack_iget_int( arg_pack , 5 );
+
+  /*
+    Each dataset gets a private A matrix; it starts small and is grown
+    by the serialization, to avoid allocating a full size A matrix for
+    every dataset in flight.
+  */
+  matrix_type * A = matrix_alloc( 1 , matrix_get_columns( X ));
+  thread_pool_type * tp = thread_pool_alloc( num_threads , false );
+  serialize_info_type * serialize_info = serialize_info_alloc( template->src_fs ,
+                                                               template->target_fs ,
+                                                               template->iens_active_index ,
+                                                               template->target_step ,
+                                                               template->ensemble ,
+                                                               template->run_mode ,
+                                                               template->report_step ,
+                                                               A ,
+                                                               num_threads );
+
+  enkf_main_update_dataset_X( ensemble_config , dataset , template->report_step , use_count , X , tp , serialize_info );
+
+  serialize_info_free( serialize_info );
+  thread_pool_free( tp );
+  matrix_free( A );
+  return NULL;
+}
+
+
+/*
+  When the update is based on one X matrix for the whole ministep the
+  datasets can be updated concurrently, as long as no node is found
+  in more than one dataset. Returns the list of non empty datasets, or
+  NULL if they must be updated in order.
+*/
+
+static vector_type * enkf_main_alloc_independent_datasets( const local_ministep_type * ministep ) {
+  vector_type * datasets = vector_alloc_new( );
+  hash_type * keys = hash_alloc( );
+  bool independent = true;
+  hash_iter_type * dataset_iter = local_ministep_alloc_dataset_iter( ministep );
+
+  while (independent && !hash_iter_is_complete( dataset_iter )) {
+    const char * dataset_name = hash_iter_get_next_key( dataset_iter );
+    const local_dataset_type * dataset = local_ministep_get_dataset( ministep , dataset_name );
+    if (local_dataset_get_size( dataset )) {
+      stringlist_type * update_keys = local_dataset_alloc_keys( dataset );
+      for (int ikw = 0; ikw < stringlist_get_size( update_keys ); ikw++) {
+        const char * key = stringlist_iget( update_keys , ikw );
+        if (hash_has_key( keys , key ))
+          independent = false;
+        else
+          hash_insert_ref( keys , key , NULL );
+      }
+      stringlist_free( update_keys );
+      vector_append_ref( datasets , dataset );
+    }
+  }
+  hash_iter_free( dataset_iter );
+  hash_free( keys );
+
+  if (!independent || vector_get_size( datasets ) < 2) {
+    vector_free( datasets );
+    datasets = NULL;
+  }
+  return datasets;
+}
+
+
+static void enkf_main_update_datasets_X( ensemble_config_type * ensemble_config ,
+                                         const vector_type * datasets ,
+                                         hash_type * use_count ,
+                                         const matrix_type * X ,
+                                         const serialize_info_type * serialize_info ,
+                                         int num_threads ) {
+  const int num_datasets = vector_get_size( datasets );
+  const int outer_threads = util_int_min( num_datasets , num_threads );
+  const int inner_threads = util_int_max( 1 , num_threads / outer_threads );
+  thread_pool_type * tp = thread_pool_alloc( outer_threads , true );
+  arg_pack_type ** arg_list = util_calloc( num_datasets , sizeof * arg_list );
+
+  for (int i = 0; i < num_datasets; i++) {
+    arg_pack_type * arg_pack = arg_pack_alloc( );
+    arg_pack_append_ptr( arg_pack , ensemble_config );
+    arg_pack_append_const_ptr( arg_pack , vector_iget_const( datasets , i ));
+    arg_pack_append_ptr( arg_pack , use_count );
+    arg_pack_append_const_ptr( arg_pack , X );
+    arg_pack_append_const_ptr( arg_pack , serialize_info );
+    arg_pack_append_int( arg_pack , inner_threads );
+    arg_list[i] = arg_pack;
+    thread_pool_add_job( tp , enkf_main_update_dataset_X_mt , arg_pack );
+  }
+  thread_pool_join( tp );
+  thread_pool_free( tp );
+
+  for (int i = 0; i < num_datasets; i++)
+    arg_pack_free( arg_list[i] );
+  free( arg_list );
+}
+
+
 static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
                                        enkf_fs_type * target_fs ,
                                        const bool_vector_type * ens_mask ,
@@ -994,14 +1442,16 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
                                        const meas_data_type * forecast ,
                                        obs_data_type * obs_data) {
 
-  const int cpu_threads       = 4;
-  const int matrix_start_size = 250000;
+  const int cpu_threads       = analysis_config_get_num_threads( enkf_main->analysis_config );
+  const double memory_limit   = analysis_config_get_memory_limit( enkf_main->analysis_config );
+  const int matrix_start_size = (memory_limit > 0) ? 1 : 250000;   /* With a memory limit A is grown on demand. */
   thread_pool_type * tp       = thread_pool_alloc( cpu_threads , false );
   int active_ens_size   = meas_data_get_active_ens_size( forecast );
   int active_size       = obs_data_get_active_size( obs_data );
   matrix_type * X       = matrix_alloc( active_ens_size , active_ens_size );
   matrix_type * S       = meas_data_allocS( forecast );
-  matrix_type * R       = obs_data_allocR( obs_data );
+  obs_covar_type * covar = obs_data_alloc_covar( obs_data );
+  matrix_type * R       = NULL;
   matrix_type * dObs    = obs_data_allocdObs( obs_data );
   matrix_type * A       = matrix_alloc( matrix_start_size , active_ens_size );
   matrix_type * E       = NULL;
@@ -1015,7 +1465,6 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
 
   assert_matrix_size(X , "X" , active_ens_size , active_ens_size);
   assert_matrix_size(S , "S" , active_size , active_ens_size);
-  assert_matrix_size(R , "R" , active_size , active_size);
   assert_size_equal( enkf_main_get_ensemble_size( enkf_main ) , ens_mask );
 
   if (analysis_module_check_option( module , ANALYSIS_NEED_ED)) {
@@ -1026,17 +1475,31 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
     assert_matrix_size( D , "D" , active_size , active_ens_size);
   }
 
-  if (analysis_module_check_option( module , ANALYSIS_SCALE_DATA))
-    obs_data_scale( obs_data , S , E , D , R , dObs );
+  if (analysis_module_check_option( module , ANALYSIS_SCALE_DATA)) {
+    obs_data_scale( obs_data , S , E , D , NULL , dObs );
+    obs_data_scale_covar( obs_data , covar );
+  }
+
+  if (!analysis_module_check_option( module , ANALYSIS_OBS_COVAR)) {
+    R = obs_covar_alloc_matrix( covar );
+    assert_matrix_size(R , "R" , active_size , active_size);
+  }
 
   if (analysis_module_check_option( module , ANALYSIS_USE_A) || analysis_module_check_option(module , ANALYSIS_UPDATE_A))
     localA = A;
 
+  if (analysis_module_has_var( module , ANALYSIS_NUM_THREADS_KEY )) {
+    char * num_threads = util_alloc_sprintf( "%d" , cpu_threads );
+    analysis_module_set_var( module , ANALYSIS_NUM_THREADS_KEY , num_threads );
+    free( num_threads );
+  }
+
   /*****************************************************************/
 
   analysis_module_init_update( module , ens_mask , S , R , dObs , E , D );
   {
     hash_iter_type * dataset_iter = local_ministep_alloc_dataset_iter( ministep );
+    vector_type * datasets = NULL;
     serialize_info_type * serialize_info = serialize_info_alloc( target_fs, //src_fs - we have already copied the parameters from the src_fs to the target_fs
                                                                  target_fs ,
                                                                  iens_active_index,
@@ -1073,42 +1536,57 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
       double_vector_free( singular_values );
     }
 
-    if (localA == NULL)
-      analysis_module_initX( module , X , NULL , S , R , dObs , E , D );
-
-
-    while (!hash_iter_is_complete( dataset_iter )) {
-      const char * dataset_name = hash_iter_get_next_key( dataset_iter );
-      const local_dataset_type * dataset = local_ministep_get_dataset( ministep , dataset_name );
-      if (local_dataset_get_size( dataset )) {
-        int * active_size = util_calloc( local_dataset_get_size( dataset ) , sizeof * active_size );
-        int * row_offset  = util_calloc( local_dataset_get_size( dataset ) , sizeof * row_offset  );
-        local_obsdata_type   * local_obsdata = local_ministep_get_obsdata( ministep );
+    if (localA == NULL) {
+      enkf_main_initX( module , X , NULL , S , R , covar , dObs , E , D );
+      if ((cpu_threads > 1) && (memory_limit <= 0))
+        datasets = enkf_main_alloc_independent_datasets( ministep );
+    }
 
-        enkf_main_serialize_dataset( enkf_main->ensemble_config , dataset , step2 ,  use_count , active_size , row_offset , tp , serialize_info);
-        module_info_type * module_info = enkf_main_module_info_alloc(ministep, obs_data, dataset, local_obsdata, active_size , row_offset);
 
-        if (analysis_module_check_option( module , ANALYSIS_UPDATE_A)){
-          if (analysis_module_check_option( module , ANALYSIS_ITERABLE)){
-            analysis_module_updateA( module , localA , S , R , dObs , E , D , module_info );
-          }
-          else
-            analysis_module_updateA( module , localA , S , R , dObs , E , D , module_info );
-        }
-        else {
-          if (analysis_module_check_option( module , ANALYSIS_USE_A)){
-            analysis_module_initX( module , X , localA , S , R , dObs , E , D );
+    if ((localA == NULL) && (memory_limit > 0)) {
+      while (!hash_iter_is_complete( dataset_iter )) {
+        const char * dataset_name = hash_iter_get_next_key( dataset_iter );
+        const local_dataset_type * dataset = local_ministep_get_dataset( ministep , dataset_name );
+        if (local_dataset_get_size( dataset ))
+          enkf_main_stream_dataset_X( enkf_main->ensemble_config , dataset , X , serialize_info , cpu_threads , memory_limit );
+      }
+    } else if (datasets) {
+      enkf_main_update_datasets_X( enkf_main->ensemble_config , datasets , use_count , X , serialize_info , cpu_threads );
+      vector_free( datasets );
+    } else {
+      while (!hash_iter_is_complete( dataset_iter )) {
+        const char * dataset_name = hash_iter_get_next_key( dataset_iter );
+        const local_dataset_type * dataset = local_ministep_get_dataset( ministep , dataset_name );
+        if (local_dataset_get_size( dataset )) {
+          int * active_size = util_calloc( local_dataset_get_size( dataset ) , sizeof * active_size );
+          int * row_offset  = util_calloc( local_dataset_get_size( dataset ) , sizeof * row_offset  );
+          local_obsdata_type   * local_obsdata = local_ministep_get_obsdata( ministep );
+
+          enkf_main_serialize_dataset( enkf_main->ensemble_config , dataset , step2 ,  use_count , active_size , row_offset , tp , serialize_info);
+          module_info_type * module_info = enkf_main_module_info_alloc(ministep, obs_data, dataset, local_obsdata, active_size , row_offset);
+
+          if (analysis_module_check_option( module , ANALYSIS_UPDATE_A)){
+            if (analysis_module_check_option( module , ANALYSIS_ITERABLE)){
+              analysis_module_updateA( module , localA , S , R , dObs , E , D , module_info );
+            }
+            else
+              analysis_module_updateA( module , localA , S , R , dObs , E , D , module_info );
           }
+          else {
+            if (analysis_module_check_option( module , ANALYSIS_USE_A)){
+              enkf_main_initX( module , X , localA , S , R , covar , dObs , E , D );
+            }
 
-          matrix_inplace_matmul_mt2( A , X , tp );
-        }
+            matrix_inplace_dgemm_mt( A , X , tp );
+          }
 
-        // The deserialize also calls enkf_node_store() functions.
-        enkf_main_deserialize_dataset( enkf_main_get_ensemble_config( enkf_main ) , dataset , active_size , row_offset , serialize_info , tp);
+          // The deserialize also calls enkf_node_store() functions.
+          enkf_main_deserialize_dataset( enkf_main_get_ensemble_config( enkf_main ) , dataset , active_size , row_offset , serialize_info , tp);
 
-        free( active_size );
-        free( row_offset );
-        enkf_main_module_info_free( module_info );
+          free( active_size );
+          free( row_offset );
+          enkf_main_module_info_free( module_info );
+        }
       }
     }
     hash_iter_free( dataset_iter );
@@ -1123,7 +1601,8 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
   matrix_safe_free( E );
   matrix_safe_free( D );
   matrix_free( S );
-  matrix_free( R );
+  matrix_safe_free( R );
+  obs_covar_free( covar );
   matrix_free( dObs );
   matrix_free( X );
   matrix_free( A );
@@ -1414,7 +1893,7 @@ void enkf_main_isubmit_job( enkf_main_type * enkf_main , run_arg_type * run_arg
 
 }
 
-void * enkf_main_icreate_run_path( enkf_main_type * enkf_main, run_arg_type * run_arg){
+static void enkf_main_icreate_run_path__( enkf_main_type * enkf_main, run_arg_type * run_arg , runpath_file_cache_type * file_cache){
   enkf_state_type * enkf_state = enkf_main->ensemble[ run_arg_get_iens(run_arg) ];
   {
     runpath_list_type * runpath_list = hook_manager_get_runpath_list( enkf_main->hook_manager );
@@ -1424,28 +1903,90 @@ void * enkf_main_icreate_run_path( enkf_main_type * enkf_main, run_arg_type * ru
                       run_arg_get_runpath( run_arg ),
                       enkf_state_get_eclbase( enkf_state ));
   }
-  enkf_state_init_eclipse( enkf_state , run_arg );
+  enkf_state_init_eclipse( enkf_state , run_arg , file_cache );
+}
+
+
+void * enkf_main_icreate_run_path( enkf_main_type * enkf_main, run_arg_type * run_arg){
+  enkf_main_icreate_run_path__( enkf_main , run_arg , NULL );
+  return NULL;
+}
+
+
+static void * enkf_main_icreate_run_path_mt( void * arg ) {
+  arg_pack_type * arg_pack             = arg_pack_safe_cast( arg );
+  enkf_main_type * enkf_main           = enkf_main_safe_cast( arg_pack_iget_ptr( arg_pack , 0 ));
+  run_arg_type * run_arg               = run_arg_safe_cast( arg_pack_iget_ptr( arg_pack , 1 ));
+  runpath_file_cache_type * file_cache = arg_pack_iget_ptr( arg_pack , 2 );
+  bool * created                       = arg_pack_iget_ptr( arg_pack , 3 );
+
+  enkf_main_icreate_run_path__( enkf_main , run_arg , file_cache );
+  *created = util_is_directory( run_arg_get_runpath( run_arg ));
   return NULL;
 }
 
 
-static void * enkf_main_create_run_path__( enkf_main_type * enkf_main,
-                                           const ert_init_context_type * init_context) {
+/*
+  The runpaths of the different realisations are created concurrently
+  by a pool of num_threads workers. All the state involved is private
+  to the realisation, i.e. the enkf_state instance and the run_arg,
+  apart from the runpath_list which is locked internally, and the
+  configuration which is only read. The result of each realisation is
+  stored separately and reported when all the workers have completed;
+  the function returns true if all the runpaths were created.
+
+  The files which come out identical for several realisations,
+  e.g. the SCHEDULE file, are only rendered once for the batch; the
+  other realisations get a copy from the runpath_file_cache.
+*/
+
+static bool enkf_main_create_run_path__( enkf_main_type * enkf_main,
+                                         const ert_init_context_type * init_context ,
+                                         int num_threads) {
 
   const bool_vector_type * iactive = ert_init_context_get_iactive(init_context);
   const int active_ens_size = util_int_min( bool_vector_size( iactive ) , enkf_main_get_ensemble_size( enkf_main ));
+  bool * created = util_calloc( util_int_max( 1 , active_ens_size ) , sizeof * created );
+  arg_pack_type ** arg_list = util_calloc( util_int_max( 1 , active_ens_size ) , sizeof * arg_list );
+  thread_pool_type * tp = thread_pool_alloc( num_threads , true );
+  runpath_file_cache_type * file_cache = runpath_file_cache_alloc( );
+  bool all_created = true;
   int iens;
+
   for (iens = 0; iens < active_ens_size; iens++) {
+    arg_list[iens] = arg_pack_alloc();
+    created[iens] = true;
     if (bool_vector_iget(iactive , iens)) {
       run_arg_type * run_arg = ert_init_context_iens_get_arg( init_context , iens);
-      enkf_main_icreate_run_path(enkf_main, run_arg);
+
+      arg_pack_append_ptr( arg_list[iens] , enkf_main );
+      arg_pack_append_ptr( arg_list[iens] , run_arg );
+      arg_pack_append_ptr( arg_list[iens] , file_cache );
+      arg_pack_append_ptr( arg_list[iens] , &created[iens] );
+      thread_pool_add_job( tp , enkf_main_icreate_run_path_mt , arg_list[iens] );
     }
   }
-  return NULL;
+  thread_pool_join( tp );
+  thread_pool_free( tp );
+
+  for (iens = 0; iens < active_ens_size; iens++) {
+    if (!created[iens]) {
+      run_arg_type * run_arg = ert_init_context_iens_get_arg( init_context , iens);
+      ert_log_add_fmt_message( 1 , stderr , "** Warning: Function %s: Realization %d: failed to create runpath:%s" , __func__ , iens , run_arg_get_runpath( run_arg ));
+      all_created = false;
+    }
+    arg_pack_free( arg_list[iens] );
+  }
+
+  runpath_file_cache_free( file_cache );
+  free( arg_list );
+  free( created );
+  return all_created;
 }
 
-void enkf_main_create_run_path(enkf_main_type * enkf_main , const bool_vector_type * iactive , int iter) {
+bool enkf_main_create_run_path(enkf_main_type * enkf_main , const bool_vector_type * iactive , int iter) {
   init_mode_type init_mode = INIT_CONDITIONAL;
+  bool all_created;
 
   enkf_main_init_internalization(enkf_main , init_mode);
   {
@@ -1465,7 +2006,7 @@ void enkf_main_create_run_path(enkf_main_type * enkf_main , const bool_vector_ty
                                                                              iactive ,
                                                                              init_mode ,
                                                                              iter );
-    enkf_main_create_run_path__( enkf_main , init_context );
+    all_created = enkf_main_create_run_path__( enkf_main , init_context , analysis_config_get_num_threads( enkf_main->analysis_config ));
     ert_init_context_free( init_context );
   }
 
@@ -1482,6 +2023,7 @@ void enkf_main_create_run_path(enkf_main_type * enkf_main , const bool_vector_ty
     runpath_list_type * runpath_list = hook_manager_get_runpath_list(enkf_main->hook_manager );
     runpath_list_fprintf( runpath_list );
   }
+  return all_created;
 }
 
 
@@ -3084,7 +3626,7 @@ void enkf_main_load_from_forward_model_with_fs(enkf_main_type * enkf_main, int i
 
   ert_run_context_type * run_context = ert_run_context_alloc_ENSEMBLE_EXPERIMENT( fs , iactive , model_config_get_runpath_fmt( model_config ) , enkf_main->subst_list , iter );
   arg_pack_type ** arg_list = util_calloc( ens_size , sizeof * arg_list );
-  thread_pool_type * tp     = thread_pool_alloc( 4 , true );  /* num_cpu - HARD coded. */
+  thread_pool_type * tp     = thread_pool_alloc( analysis_config_get_num_threads( enkf_main->analysis_config ) , true );
 
   int iens = 0;
   for (; iens < ens_size; ++iens) {
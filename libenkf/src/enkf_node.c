@@ -467,7 +467,11 @@ static bool enkf_node_store_buffer( enkf_node_type * enkf_node , enkf_fs_type *
 }
 
 bool enkf_node_store_vector(enkf_node_type *enkf_node , enkf_fs_type * fs , int iens ) {
-  return enkf_node_store_buffer( enkf_node , fs , -1 , iens );
+  if (enkf_node_get_impl_type( enkf_node ) == SUMMARY) {
+    summary_fwrite_vector( enkf_node->data , fs , iens );
+    return true;
+  } else
+    return enkf_node_store_buffer( enkf_node , fs , -1 , iens );
 }
 
 
@@ -532,7 +536,16 @@ static void enkf_node_buffer_load( enkf_node_type * enkf_node , enkf_fs_type * f
 
 
 
+/*
+  Summary vectors are loaded from the summary_store, with fallback to
+  the fs_driver for cases stored before the summary_store existed.
+*/
+
 void enkf_node_load_vector( enkf_node_type * enkf_node , enkf_fs_type * fs , int iens ) {
+  if (enkf_node_get_impl_type( enkf_node ) == SUMMARY) {
+    if (summary_fread_vector( enkf_node->data , fs , iens ))
+      return;
+  }
   enkf_node_buffer_load( enkf_node , fs , -1 , iens );
 }
 
@@ -698,13 +711,34 @@ enkf_node_type ** enkf_node_load_alloc_ensemble( const enkf_config_node_type * c
 
 
 
-void enkf_node_serialize(enkf_node_type *enkf_node , enkf_fs_type * fs, node_id_type node_id ,
-                         const active_list_type * active_list , matrix_type * A , int row_offset , int column) {
+/*
+  The _data variants of serialize / deserialize do not load or store
+  the node; they are used when a node which is already loaded is
+  serialized in several parts, with one partial active_list for each
+  part.
+*/
+
+void enkf_node_serialize_data(enkf_node_type *enkf_node , node_id_type node_id ,
+                              const active_list_type * active_list , matrix_type * A , int row_offset , int column) {
 
   FUNC_ASSERT(enkf_node->serialize);
-  enkf_node_load( enkf_node , fs , node_id);
   enkf_node->serialize(enkf_node->data , node_id , active_list , A , row_offset , column);
+}
 
+
+void enkf_node_deserialize_data(enkf_node_type *enkf_node , node_id_type node_id ,
+                                const active_list_type * active_list , const matrix_type * A , int row_offset , int column) {
+
+  FUNC_ASSERT(enkf_node->deserialize);
+  enkf_node->deserialize(enkf_node->data , node_id , active_list , A , row_offset , column);
+}
+
+
+void enkf_node_serialize(enkf_node_type *enkf_node , enkf_fs_type * fs, node_id_type node_id ,
+                         const active_list_type * active_list , matrix_type * A , int row_offset , int column) {
+
+  enkf_node_load( enkf_node , fs , node_id);
+  enkf_node_serialize_data( enkf_node , node_id , active_list , A , row_offset , column );
 }
 
 
@@ -712,8 +746,7 @@ void enkf_node_serialize(enkf_node_type *enkf_node , enkf_fs_type * fs, node_id_
 void enkf_node_deserialize(enkf_node_type *enkf_node , enkf_fs_type * fs , node_id_type node_id,
                            const active_list_type * active_list , const matrix_type * A , int row_offset , int column) {
 
-  FUNC_ASSERT(enkf_node->deserialize);
-  enkf_node->deserialize(enkf_node->data , node_id , active_list , A , row_offset , column);
+  enkf_node_deserialize_data( enkf_node , node_id , active_list , A , row_offset , column );
   enkf_node_store( enkf_node , fs , true , node_id );
 }
 
@@ -25,6 +25,8 @@
 #include <ert/util/msg.h>
 #include <ert/util/vector.h>
 #include <ert/util/type_vector_functions.h>
+#include <ert/util/arg_pack.h>
+#include <ert/util/thread_pool.h>
 
 #include <ert/config/conf.h>
 
@@ -330,7 +332,66 @@ int enkf_obs_get_size( const enkf_obs_type * obs ) {
 
 
 
-static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf_obs,
+/*
+  The simulated values for a summary observation are measured with
+  one enkf_node_load() per realization; the whole summary vector is
+  loaded and all the active steps are copied into the meas_block. For
+  summary nodes without vector storage the node must be loaded for
+  each step.
+*/
+
+static void enkf_obs_measure_summary( const obs_vector_type * obs_vector ,
+                                      enkf_fs_type * fs ,
+                                      const int_vector_type * ens_active_list ,
+                                      const int_vector_type * active_steps ,
+                                      meas_block_type * meas_block ) {
+
+  enkf_node_type * work_node = enkf_node_alloc( obs_vector_get_config_node( obs_vector ));
+  bool vector_storage = enkf_node_vector_storage( work_node );
+
+  for (int iens_index = 0; iens_index < int_vector_size( ens_active_list ); iens_index++) {
+    node_id_type node_id = {.report_step = int_vector_get_last( active_steps ),
+                            .iens        = int_vector_iget( ens_active_list , iens_index )};
+
+    if (vector_storage)
+      enkf_node_load( work_node , fs , node_id );
+
+    for (int active_index = 0; active_index < int_vector_size( active_steps ); active_index++) {
+      node_id.report_step = int_vector_iget( active_steps , active_index );
+      if (!vector_storage)
+        enkf_node_load( work_node , fs , node_id );
+
+      meas_block_iset(meas_block ,
+                      node_id.iens , active_index ,
+                      summary_get( enkf_node_value_ptr( work_node ) , node_id.report_step ));
+    }
+  }
+  enkf_node_free( work_node );
+}
+
+
+static void * enkf_obs_measure_summary_mt( void * arg ) {
+  arg_pack_type * arg_pack = arg_pack_safe_cast( arg );
+  const obs_vector_type * obs_vector = arg_pack_iget_const_ptr( arg_pack , 0 );
+  enkf_fs_type * fs = arg_pack_iget_ptr( arg_pack , 1 );
+  const int_vector_type * ens_active_list = arg_pack_iget_const_ptr( arg_pack , 2 );
+  const int_vector_type * active_steps = arg_pack_iget_const_ptr( arg_pack , 3 );
+  meas_block_type * meas_block = arg_pack_iget_ptr( arg_pack , 4 );
+
+  enkf_obs_measure_summary( obs_vector , fs , ens_active_list , active_steps , meas_block );
+  return NULL;
+}
+
+
+/*
+  Will add the obs_block and meas_block of a summary observation. The
+  meas_block is not filled; instead an arg_pack with the arguments to
+  enkf_obs_measure_summary_mt() is returned, or NULL if there are no
+  active steps. The calling scope is responsible for running and
+  freeing the returned arg_pack.
+*/
+
+static arg_pack_type * enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf_obs,
                                                  obs_vector_type          * obs_vector ,
                                                  enkf_fs_type             * fs,
                                                  const local_obsdata_node_type * obs_node ,
@@ -343,6 +404,8 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
   const active_list_type * active_list = local_obsdata_node_get_active_list( obs_node );
 
   matrix_type * error_covar = NULL;
+  arg_pack_type * measure_arg = NULL;
+  int_vector_type * active_steps = int_vector_alloc( 0 , 0 );
   int active_count          = 0;
   int last_step = -1;
   int step = -1;
@@ -362,6 +425,7 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
           const summary_obs_type * summary_obs = obs_vector_iget_node( obs_vector , step );
           double_vector_iset( obs_std   , active_count , summary_obs_get_std( summary_obs ) * summary_obs_get_std_scaling( summary_obs ));
           double_vector_iset( obs_value , active_count , summary_obs_get_value( summary_obs ));
+          int_vector_iset( active_steps , active_count , step );
           last_step = step;
         }
         active_count++;
@@ -407,66 +471,58 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
     {
       obs_block_type  * obs_block  = obs_data_add_block( obs_data , obs_vector_get_obs_key( obs_vector ) , active_count , error_covar , true);
       meas_block_type * meas_block = meas_data_add_block( meas_data, obs_vector_get_obs_key( obs_vector ) , last_step , active_count );
-      enkf_node_type * work_node = enkf_node_alloc( obs_vector_get_config_node( obs_vector ));
 
       for (int i=0; i < active_count; i++)
         obs_block_iset( obs_block , i , double_vector_iget( obs_value , i) , double_vector_iget( obs_std , i ));
 
-      active_count = 0;
-      step = -1;
-      while (true) {
-        step = obs_vector_get_next_active_step( obs_vector , step );
-        if (step < 0)
-          break;
-
-        if (local_obsdata_node_tstep_active(obs_node, step)) {
-          if (obs_vector_iget_active( obs_vector , step ) && active_list_iget( active_list , 0 /* Index into the scalar summary observation */)) {
-            for (int iens_index = 0; iens_index < int_vector_size( ens_active_list ); iens_index++) {
-
-              const int iens = int_vector_iget( ens_active_list , iens_index );
-              node_id_type node_id = {.report_step = step,
-                                      .iens        = iens};
-
-              enkf_node_load( work_node , fs , node_id );
-
-              meas_block_iset(meas_block ,
-                              iens , active_count ,
-                              summary_get( enkf_node_value_ptr( work_node ) , node_id.report_step ));
-
-            }
-            active_count++;
-          }
-        }
-      }
-      enkf_node_free( work_node );
+      measure_arg = arg_pack_alloc( );
+      arg_pack_append_const_ptr( measure_arg , obs_vector );
+      arg_pack_append_ptr( measure_arg , fs );
+      arg_pack_append_const_ptr( measure_arg , ens_active_list );
+      arg_pack_append_owned_ptr( measure_arg , active_steps , int_vector_free__ );
+      arg_pack_append_ptr( measure_arg , meas_block );
     }
   }
+
+  if (measure_arg == NULL)
+    int_vector_free( active_steps );
+
+  return measure_arg;
 }
 
-void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
-                                        enkf_fs_type             * fs,
-                                        const local_obsdata_node_type * obs_node ,
-                                        const int_vector_type    * ens_active_list ,
-                                        meas_data_type           * meas_data,
-                                        obs_data_type            * obs_data) {
+/*
+  Adds the obs_block and meas_block for one local observation node. For
+  summary observations the filling of the meas_block is deferred, and
+  the arg_pack for enkf_obs_measure_summary_mt() is returned; for all
+  other observation types the measurements are done immediately and
+  NULL is returned.
+*/
+
+static arg_pack_type * enkf_obs_add_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
+                                                          enkf_fs_type             * fs,
+                                                          const local_obsdata_node_type * obs_node ,
+                                                          const int_vector_type    * ens_active_list ,
+                                                          meas_data_type           * meas_data,
+                                                          obs_data_type            * obs_data) {
 
   const char * obs_key         = local_obsdata_node_get_key( obs_node );
   obs_vector_type * obs_vector = hash_get( enkf_obs->obs_hash , obs_key );
   obs_impl_type obs_type       = obs_vector_get_impl_type( obs_vector );
+  arg_pack_type * measure_arg  = NULL;
 
   if ((obs_type == SUMMARY_OBS))  { //&& ((end_step - start_step) > 1))
     double_vector_type * work_value  = double_vector_alloc( 0 , -1 );
     double_vector_type * work_std    = double_vector_alloc( 0 , -1 );
 
-    enkf_obs_get_obs_and_measure_summary( enkf_obs ,
-                                          obs_vector ,
-                                          fs ,
-                                          obs_node ,
-                                          ens_active_list ,
-                                          meas_data ,
-                                          obs_data ,
-                                          work_value,
-                                          work_std);
+    measure_arg = enkf_obs_get_obs_and_measure_summary( enkf_obs ,
+                                                        obs_vector ,
+                                                        fs ,
+                                                        obs_node ,
+                                                        ens_active_list ,
+                                                        meas_data ,
+                                                        obs_data ,
+                                                        work_value,
+                                                        work_std);
 
     double_vector_free( work_value );
     double_vector_free( work_std   );
@@ -486,6 +542,22 @@ void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
       }
     }
   }
+  return measure_arg;
+}
+
+
+void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
+                                        enkf_fs_type             * fs,
+                                        const local_obsdata_node_type * obs_node ,
+                                        const int_vector_type    * ens_active_list ,
+                                        meas_data_type           * meas_data,
+                                        obs_data_type            * obs_data) {
+
+  arg_pack_type * measure_arg = enkf_obs_add_obs_and_measure_node( enkf_obs , fs , obs_node , ens_active_list , meas_data , obs_data );
+  if (measure_arg != NULL) {
+    enkf_obs_measure_summary_mt( measure_arg );
+    arg_pack_free( measure_arg );
+  }
 }
 
 
@@ -495,6 +567,10 @@ void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
   report_step to obs_data and meas_data.
   Call obs_data_reset and meas_data_reset on obs_data and meas_data
   if you want to use fresh instances.
+
+  The obs_blocks and meas_blocks are added sequentially, in the order
+  of the local_obsdata; the simulated summary responses are then
+  loaded in parallel, one job per observation key.
 */
 
 void enkf_obs_get_obs_and_measure_data(const enkf_obs_type      * enkf_obs,
@@ -504,17 +580,34 @@ void enkf_obs_get_obs_and_measure_data(const enkf_obs_type      * enkf_obs,
                                        meas_data_type           * meas_data,
                                        obs_data_type            * obs_data) {
 
-
+  vector_type * measure_jobs = vector_alloc_new();
   int iobs;
   for (iobs = 0; iobs < local_obsdata_get_size( local_obsdata ); iobs++) {
     const local_obsdata_node_type * obs_node = local_obsdata_iget( local_obsdata , iobs );
-    enkf_obs_get_obs_and_measure_node( enkf_obs ,
-                                       fs ,
-                                       obs_node ,
-                                       ens_active_list ,
-                                       meas_data ,
-                                       obs_data);
+    arg_pack_type * measure_arg = enkf_obs_add_obs_and_measure_node( enkf_obs ,
+                                                                     fs ,
+                                                                     obs_node ,
+                                                                     ens_active_list ,
+                                                                     meas_data ,
+                                                                     obs_data);
+    if (measure_arg != NULL)
+      vector_append_owned_ref( measure_jobs , measure_arg , arg_pack_free__ );
+  }
+
+  if (vector_get_size( measure_jobs ) == 1)
+    enkf_obs_measure_summary_mt( vector_iget( measure_jobs , 0 ));
+  else if (vector_get_size( measure_jobs ) > 1) {
+    const int num_cpu = 4;
+    thread_pool_type * tp = thread_pool_alloc( num_cpu , true );
+    int ijob;
+
+    for (ijob = 0; ijob < vector_get_size( measure_jobs ); ijob++)
+      thread_pool_add_job( tp , enkf_obs_measure_summary_mt , vector_iget( measure_jobs , ijob ));
+
+    thread_pool_join( tp );
+    thread_pool_free( tp );
   }
+  vector_free( measure_jobs );
 }
 
 
@@ -615,7 +615,14 @@ static bool enkf_state_internalize_dynamic_eclipse_results(enkf_state_type * enk
                 enkf_config_node_type * config_node = ensemble_config_get_or_create_summary_node(enkf_state->ensemble_config, key);
                 enkf_node_type * node = enkf_state_get_or_create_node(enkf_state, config_node);
 
-                enkf_node_try_load_vector( node , result_fs , iens );  // Ensure that what is currently on file is loaded before we update.
+                /*
+                  When loading from a restart the steps before load_start are
+                  kept from what is currently on file; otherwise all the steps
+                  are loaded and reading back the old vector is not necessary.
+                */
+                enkf_node_clear( node );
+                if (load_start > 1)
+                  enkf_node_try_load_vector( node , result_fs , iens );
 
                 enkf_node_forward_load_vector( node , load_context , time_index);
                 enkf_node_store_vector( node , result_fs , iens );
@@ -1366,7 +1373,48 @@ void enkf_state_printf_subst_list(enkf_state_type * enkf_state , int step1 , int
 */
 
 
-void enkf_state_init_eclipse(enkf_state_type *enkf_state, const run_arg_type * run_arg ) {
+/*
+  Writes the jobs.py file for the forward model. With a file_cache the
+  first realisation also writes the file without the global
+  substitutions, to get the source text for the cache.
+*/
+
+static void enkf_state_write_forward_model( const enkf_state_type * enkf_state , const run_arg_type * run_arg , runpath_file_cache_type * file_cache) {
+  const forward_model_type * forward_model = model_config_get_forward_model( enkf_state->shared_info->model_config );
+  mode_t umask = site_config_get_umask(enkf_state->shared_info->site_config);
+  const char * runpath = run_arg_get_runpath( run_arg );
+
+  if (file_cache == NULL)
+    forward_model_python_fprintf( forward_model , runpath , enkf_state->subst_list , umask);
+  else {
+    char * job_file = forward_model_alloc_python_filename( runpath );
+    if (!runpath_file_cache_install( file_cache , "FORWARD_MODEL" , enkf_state->subst_list , job_file )) {
+      char * source_text = NULL;
+      if (!runpath_file_cache_has_key( file_cache , "FORWARD_MODEL" )) {
+        forward_model_python_fprintf( forward_model , runpath , NULL , umask);
+        source_text = util_fread_alloc_file_content( job_file , NULL );
+      }
+
+      forward_model_python_fprintf( forward_model , runpath , enkf_state->subst_list , umask);
+      if (source_text != NULL) {
+        runpath_file_cache_add( file_cache , "FORWARD_MODEL" , source_text , enkf_state->subst_list , job_file );
+        free( source_text );
+      }
+    }
+    free( job_file );
+  }
+}
+
+
+/*
+  Creates the runpath and all the files the forward model needs. If
+  @file_cache is non NULL it is used to write the files which are
+  identical for several realisations from memory, instead of rendering
+  them again; see runpath_file_cache.c. The file_cache is shared by
+  all the realisations in one batch of runpaths.
+*/
+
+void enkf_state_init_eclipse(enkf_state_type *enkf_state, const run_arg_type * run_arg , runpath_file_cache_type * file_cache) {
   const member_config_type  * my_config = enkf_state->my_config;
   const ecl_config_type * ecl_config = enkf_state->shared_info->ecl_config;
   {
@@ -1382,7 +1430,11 @@ void enkf_state_init_eclipse(enkf_state_type *enkf_state, const run_arg_type * r
         util_make_path(schedule_file_target_path);
         free(schedule_file_target_path);
 
-        sched_file_fprintf( ecl_config_get_sched_file( ecl_config ) , schedule_file_target);
+        if (file_cache == NULL || !runpath_file_cache_install( file_cache , "SCHEDULE" , enkf_state->subst_list , schedule_file_target)) {
+          sched_file_fprintf( ecl_config_get_sched_file( ecl_config ) , schedule_file_target);
+          if (file_cache != NULL)
+            runpath_file_cache_add( file_cache , "SCHEDULE" , NULL , enkf_state->subst_list , schedule_file_target );
+        }
 
         free(schedule_file_target);
       }
@@ -1406,28 +1458,32 @@ void enkf_state_init_eclipse(enkf_state_type *enkf_state, const run_arg_type * r
         enkf_state_fread_state_nodes( enkf_state , init_fs , run_arg_get_step1(run_arg));
 
       enkf_state_set_dynamic_subst_kw(  enkf_state , run_arg );
-      ert_templates_instansiate( enkf_state->shared_info->templates , run_arg_get_runpath( run_arg ) , enkf_state->subst_list );
+      ert_templates_instansiate( enkf_state->shared_info->templates , run_arg_get_runpath( run_arg ) , enkf_state->subst_list , file_cache );
       enkf_state_ecl_write( enkf_state , run_arg , init_fs);
 
       if (member_config_get_eclbase( my_config ) != NULL) {
 
         /* Writing the ECLIPSE data file. */
         if (ecl_config_get_data_file( ecl_config ) != NULL) {
+          const char * src_file = ecl_config_get_data_file(ecl_config);
           char * data_file = ecl_util_alloc_filename(run_arg_get_runpath( run_arg ) , member_config_get_eclbase( my_config ) , ECL_DATA_FILE , true , -1);
-          subst_list_filter_file(enkf_state->subst_list , ecl_config_get_data_file(ecl_config) , data_file);
+
+          if (file_cache == NULL || !runpath_file_cache_install( file_cache , "DATA_FILE" , enkf_state->subst_list , data_file )) {
+            subst_list_filter_file(enkf_state->subst_list , src_file , data_file);
+            if (file_cache != NULL && !runpath_file_cache_has_key( file_cache , "DATA_FILE" )) {
+              char * source_text = util_fread_alloc_file_content( src_file , NULL );
+              runpath_file_cache_add( file_cache , "DATA_FILE" , source_text , enkf_state->subst_list , data_file );
+              free( source_text );
+            }
+          }
           free( data_file );
         }
       }
     }
     member_config_get_jobname( my_config );
-    mode_t umask = site_config_get_umask(enkf_state->shared_info->site_config);
-
 
     /* This is where the job script is created */
-    forward_model_python_fprintf( model_config_get_forward_model( enkf_state->shared_info->model_config ) ,
-                                  run_arg_get_runpath( run_arg ) ,
-                                  enkf_state->subst_list,
-                                  umask);
+    enkf_state_write_forward_model( enkf_state , run_arg , file_cache );
   }
 }
 
@@ -1479,7 +1535,7 @@ static void enkf_state_internal_retry(enkf_state_type * enkf_state , run_arg_typ
       stringlist_free( init_keys );
     }
 
-    enkf_state_init_eclipse( enkf_state , run_arg  );                                               /* Possibly clear the directory and do a FULL rewrite of ALL the necessary files. */
+    enkf_state_init_eclipse( enkf_state , run_arg , NULL );                                         /* Possibly clear the directory and do a FULL rewrite of ALL the necessary files. */
     job_queue_iset_external_restart( shared_info->job_queue , run_arg_get_queue_index(run_arg) );   /* Here we inform the queue system that it should pick up this job and try again. */
     run_arg_increase_submit_count( run_arg );
   }
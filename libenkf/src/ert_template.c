@@ -93,9 +93,34 @@ void ert_template_free( ert_template_type * template ) {
 }
 
 
-void ert_template_instantiate( ert_template_type * template , const char * path , const subst_list_type * arg_list) {
+/*
+  If @file_cache is non NULL the instance is written from the cache
+  when an earlier realisation has instantiated the template with the
+  same values for the keys used in the template.
+*/
+
+void ert_template_instantiate( ert_template_type * template , const char * path , const subst_list_type * arg_list , runpath_file_cache_type * file_cache) {
   char * target_file = util_alloc_filename( path , template->target_file , NULL );
-  template_instantiate( template->template , target_file , arg_list , true );
+
+  if (file_cache == NULL)
+    template_instantiate( template->template , target_file , arg_list , true );
+  else {
+    char * cache_key = util_alloc_sprintf( "TEMPLATE:%s:%s" , template_get_template_file( template->template ) , template->target_file );
+    char * instance_file = template_alloc_target_file( template->template , target_file , arg_list );
+
+    if (util_is_link( instance_file ))
+      remove( instance_file );
+
+    if (!runpath_file_cache_install( file_cache , cache_key , arg_list , instance_file )) {
+      char * source_text = template_alloc_source_text( template->template , arg_list );
+      template_instantiate( template->template , target_file , arg_list , true );
+      runpath_file_cache_add( file_cache , cache_key , source_text , arg_list , instance_file );
+      free( source_text );
+    }
+
+    free( instance_file );
+    free( cache_key );
+  }
   free( target_file );
 }
 
@@ -187,11 +212,11 @@ ert_template_type * ert_templates_add_template( ert_templates_type * ert_templat
 }
 
 
-void ert_templates_instansiate( ert_templates_type * ert_templates , const char * path , const subst_list_type * arg_list) {
+void ert_templates_instansiate( ert_templates_type * ert_templates , const char * path , const subst_list_type * arg_list , runpath_file_cache_type * file_cache) {
   hash_iter_type * iter = hash_iter_alloc( ert_templates->templates );
   while (!hash_iter_is_complete( iter )) {
     ert_template_type * ert_template = hash_iter_get_next_value( iter );
-    ert_template_instantiate( ert_template , path , arg_list);
+    ert_template_instantiate( ert_template , path , arg_list , file_cache);
   }
   hash_iter_free( iter );
 }
@@ -71,6 +71,8 @@ Matrices: S, D, E and various internal variables.
 #include <ert/util/matrix.h>
 #include <ert/util/rng.h>
 
+#include <ert/analysis/obs_covar.h>
+
 #include <ert/enkf/obs_data.h>
 #include <ert/enkf/meas_data.h>
 #include <ert/enkf/enkf_util.h>
@@ -87,7 +89,7 @@ struct obs_block_struct {
   active_type        * active_mode;
   int                  active_size;
   matrix_type        * error_covar;
-  bool                 error_covar_owner;   /* If true the error_covar matrix is free'd when construction of the R matrix is complete. */
+  bool                 error_covar_owner;   /* If true the error_covar matrix is free'd with the obs_block. */
   double               global_std_scaling;
 };
 
@@ -125,6 +127,9 @@ obs_block_type * obs_block_alloc( const char * obs_key , int obs_size , matrix_t
 
 
 void obs_block_free( obs_block_type * obs_block ) {
+  if ((obs_block->error_covar_owner) && (obs_block->error_covar != NULL))
+    matrix_free( obs_block->error_covar );
+
   free( obs_block->obs_key );
   free( obs_block->value );
   free( obs_block->std );
@@ -249,37 +254,36 @@ static void obs_block_initdObs( const obs_block_type * obs_block , matrix_type *
 
 
 
-static void obs_block_initR( const obs_block_type * obs_block , matrix_type * R, int * __obs_offset) {
-  int obs_offset = *__obs_offset;
+/*
+  Uncorrelated observations are added as variances, and a block with
+  an error_covar matrix is added as one dense block with the rows and
+  columns of the active observations.
+*/
+
+static void obs_block_init_covar( const obs_block_type * obs_block , obs_covar_type * covar ) {
   if (obs_block->error_covar == NULL) {
     int iobs;
-    int iactive = 0;
     for (iobs =0; iobs < obs_block->size; iobs++) {
-      if (obs_block->active_mode[iobs] == ACTIVE) {
-        double var = obs_block_iget_std(obs_block, iobs) * obs_block_iget_std(obs_block, iobs);
-        matrix_iset_safe(R , obs_offset + iactive, obs_offset + iactive, var);
-        iactive++;
-      }
+      if (obs_block->active_mode[iobs] == ACTIVE)
+        obs_covar_add_var( covar , obs_block_iget_std(obs_block, iobs) * obs_block_iget_std(obs_block, iobs));
     }
-  } else {
-    int row_active = 0;   /* We have a covar matrix */
+  } else if (obs_block->active_size > 0) {
+    matrix_type * block = matrix_alloc( obs_block->active_size , obs_block->active_size );
+    int row_active = 0;
     for (int row = 0; row < obs_block->size; row++) {
       if (obs_block->active_mode[row] == ACTIVE) {
         int col_active = 0;
         for (int col = 0; col < obs_block->size; col++) {
           if (obs_block->active_mode[col] == ACTIVE) {
-            matrix_iset_safe(R , obs_offset + row_active , obs_offset + col_active , matrix_iget( obs_block->error_covar , row , col ));
+            matrix_iset( block , row_active , col_active , matrix_iget( obs_block->error_covar , row , col ));
             col_active++;
           }
         }
         row_active++;
       }
     }
+    obs_covar_add_block( covar , block );
   }
-
-  *__obs_offset = obs_offset + obs_block->active_size;
-  if ((obs_block->error_covar_owner) && (obs_block->error_covar != NULL))
-    matrix_free( obs_block->error_covar );
 }
 
 
@@ -511,18 +515,29 @@ matrix_type * obs_data_allocD(const obs_data_type * obs_data , const matrix_type
 
 
 
-matrix_type * obs_data_allocR(const obs_data_type * obs_data) {
-  int active_size = obs_data_get_active_size( obs_data );
-  matrix_type * R = matrix_alloc( active_size , active_size );
-  {
-    int obs_offset = 0;
-    for (int block_nr = 0; block_nr < vector_get_size( obs_data->data ); block_nr++) {
-      const obs_block_type * obs_block = vector_iget_const( obs_data->data , block_nr);
-      obs_block_initR( obs_block , R , &obs_offset);
-    }
+/*
+  The observation error covariance R as a block diagonal obs_covar;
+  the memory needed is proportional to the number of observations
+  and the size of the error_covar blocks.
+*/
+
+obs_covar_type * obs_data_alloc_covar(const obs_data_type * obs_data) {
+  obs_covar_type * covar = obs_covar_alloc( );
+
+  for (int block_nr = 0; block_nr < vector_get_size( obs_data->data ); block_nr++) {
+    const obs_block_type * obs_block = vector_iget_const( obs_data->data , block_nr);
+    obs_block_init_covar( obs_block , covar );
   }
 
-  matrix_set_name( R , "R");
+  return covar;
+}
+
+
+matrix_type * obs_data_allocR(const obs_data_type * obs_data) {
+  obs_covar_type * covar = obs_data_alloc_covar( obs_data );
+  matrix_type * R = obs_covar_alloc_matrix( covar );
+
+  obs_covar_free( covar );
   matrix_assert_finite( R );
   return R;
 }
@@ -609,6 +624,13 @@ void obs_data_scale_Rmatrix(const obs_data_type * obs_data , matrix_type * R) {
 }
 
 
+void obs_data_scale_covar(const obs_data_type * obs_data , obs_covar_type * covar) {
+  double * scale_factor  = obs_data_alloc_scale_factor( obs_data );
+  obs_covar_scale( covar , scale_factor );
+  free( scale_factor );
+}
+
+
 void obs_data_scale(const obs_data_type * obs_data , matrix_type *S , matrix_type *E , matrix_type *D , matrix_type *R , matrix_type * dObs) {
   double * scale_factor  = obs_data_alloc_scale_factor( obs_data );
 
@@ -0,0 +1,230 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'runpath_file_cache.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include <ert/util/util.h>
+#include <ert/util/hash.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/subst_list.h>
+#include <ert/util/type_macros.h>
+
+#include <ert/enkf/runpath_file_cache.h>
+
+/*
+  The runpath_file_cache is used when the runpaths of a batch of
+  realisations are created, to avoid rendering files which come out
+  identical for many realisations more than once; e.g. the SCHEDULE
+  file, templates without realisation specific keys and the jobs.py
+  file.
+
+  Each file is identified with a key, e.g. the name of the template,
+  and the content of the file is a function of some source text which
+  is common to all the realisations, and the substitutions from the
+  realisation's subst_list. When the first realisation has rendered
+  the file it is added to the cache along with the source text; the
+  keys which are used when the source text is filtered are stored
+  along with the filtered values of those keys - the fingerprint.
+
+  For the following realisations runpath_file_cache_install() will
+  compare the fingerprint of the realisation with the stored
+  fingerprint, and if they are equal the file is written directly from
+  the cached content. The files are written as plain copies, and not
+  as links, because the forward model is free to modify the files in
+  the runpath.
+
+  Only the first rendering of a key is stored; if the substitutions of
+  the later realisations differ they must render the file themselves.
+  If the source text contains one of the substitution functions,
+  e.g. __RANDINT__(), the file is never cached.
+*/
+
+
+#define RUNPATH_FILE_CACHE_TYPE_ID 71066231
+
+typedef struct {
+  stringlist_type * used_keys;      /* NULL if the file can not be cached. */
+  stringlist_type * fingerprint;
+  char            * content;
+  int               content_size;
+} runpath_file_node_type;
+
+
+struct runpath_file_cache_struct {
+  UTIL_TYPE_ID_DECLARATION;
+  pthread_mutex_t   lock;
+  hash_type       * files;
+  int               hits;
+};
+
+
+static runpath_file_node_type * runpath_file_node_alloc( const char * source_text , const subst_list_type * subst_list , const char * rendered_file ) {
+  runpath_file_node_type * node = util_malloc( sizeof * node );
+  node->used_keys = subst_list_alloc_used_keys( subst_list , source_text ? source_text : "" );
+  node->fingerprint = NULL;
+  node->content = NULL;
+  node->content_size = 0;
+
+  if (node->used_keys != NULL) {
+    node->fingerprint = stringlist_alloc_new();
+    for (int i = 0; i < stringlist_get_size( node->used_keys ); i++)
+      stringlist_append_owned_ref( node->fingerprint , subst_list_alloc_filtered_string( subst_list , stringlist_iget( node->used_keys , i )));
+
+    node->content = util_fread_alloc_file_content( rendered_file , &node->content_size );
+  }
+  return node;
+}
+
+
+static void runpath_file_node_free( runpath_file_node_type * node ) {
+  if (node->used_keys != NULL) {
+    stringlist_free( node->used_keys );
+    stringlist_free( node->fingerprint );
+    free( node->content );
+  }
+  free( node );
+}
+
+
+static void runpath_file_node_free__( void * arg ) {
+  runpath_file_node_free( arg );
+}
+
+
+static bool runpath_file_node_match( const runpath_file_node_type * node , const subst_list_type * subst_list ) {
+  bool match = true;
+  if (node->used_keys == NULL)
+    return false;
+
+  for (int i = 0; i < stringlist_get_size( node->used_keys ); i++) {
+    char * value = subst_list_alloc_filtered_string( subst_list , stringlist_iget( node->used_keys , i ));
+    match = util_string_equal( value , stringlist_iget( node->fingerprint , i ));
+    free( value );
+    if (!match)
+      break;
+  }
+  return match;
+}
+
+
+static void runpath_file_node_fwrite( const runpath_file_node_type * node , const char * target_file ) {
+  FILE * stream = util_mkdir_fopen( target_file , "w" );
+  util_fwrite( node->content , 1 , node->content_size , stream , __func__ );
+  fclose( stream );
+}
+
+
+/*****************************************************************/
+
+UTIL_IS_INSTANCE_FUNCTION( runpath_file_cache , RUNPATH_FILE_CACHE_TYPE_ID )
+
+
+runpath_file_cache_type * runpath_file_cache_alloc( void ) {
+  runpath_file_cache_type * cache = util_malloc( sizeof * cache );
+  UTIL_TYPE_ID_INIT( cache , RUNPATH_FILE_CACHE_TYPE_ID );
+  pthread_mutex_init( &cache->lock , NULL );
+  cache->files = hash_alloc_unlocked();
+  cache->hits = 0;
+  return cache;
+}
+
+
+void runpath_file_cache_free( runpath_file_cache_type * cache ) {
+  hash_free( cache->files );
+  pthread_mutex_destroy( &cache->lock );
+  free( cache );
+}
+
+
+/*
+  Will write the file @target_file from the cache and return true if
+  the cache has an entry @key which was rendered with the same
+  substitutions as @subst_list; otherwise the function returns false
+  and the caller must render the file. The nodes are never modified or
+  removed after they have been added, so the file is written without
+  holding the lock.
+*/
+
+bool runpath_file_cache_install( runpath_file_cache_type * cache , const char * key , const subst_list_type * subst_list , const char * target_file ) {
+  const runpath_file_node_type * node = NULL;
+
+  pthread_mutex_lock( &cache->lock );
+  if (hash_has_key( cache->files , key ))
+    node = hash_get( cache->files , key );
+  pthread_mutex_unlock( &cache->lock );
+
+  if (node != NULL && runpath_file_node_match( node , subst_list )) {
+    runpath_file_node_fwrite( node , target_file );
+
+    pthread_mutex_lock( &cache->lock );
+    cache->hits++;
+    pthread_mutex_unlock( &cache->lock );
+    return true;
+  } else
+    return false;
+}
+
+
+bool runpath_file_cache_has_key( runpath_file_cache_type * cache , const char * key ) {
+  bool has_key;
+  pthread_mutex_lock( &cache->lock );
+  has_key = hash_has_key( cache->files , key );
+  pthread_mutex_unlock( &cache->lock );
+  return has_key;
+}
+
+
+/*
+  Adds the file @rendered_file, which has been rendered from
+  @source_text with the substitutions in @subst_list, to the cache. If
+  the cache already has an entry for @key the call is ignored.
+*/
+
+void runpath_file_cache_add( runpath_file_cache_type * cache , const char * key , const char * source_text , const subst_list_type * subst_list , const char * rendered_file ) {
+  if (!runpath_file_cache_has_key( cache , key )) {
+    runpath_file_node_type * node = runpath_file_node_alloc( source_text , subst_list , rendered_file );
+
+    pthread_mutex_lock( &cache->lock );
+    if (hash_has_key( cache->files , key ))
+      runpath_file_node_free( node );
+    else
+      hash_insert_hash_owned_ref( cache->files , key , node , runpath_file_node_free__ );
+    pthread_mutex_unlock( &cache->lock );
+  }
+}
+
+
+int runpath_file_cache_get_size( runpath_file_cache_type * cache ) {
+  int size;
+  pthread_mutex_lock( &cache->lock );
+  size = hash_get_size( cache->files );
+  pthread_mutex_unlock( &cache->lock );
+  return size;
+}
+
+
+int runpath_file_cache_get_hits( runpath_file_cache_type * cache ) {
+  int hits;
+  pthread_mutex_lock( &cache->lock );
+  hits = cache->hits;
+  pthread_mutex_unlock( &cache->lock );
+  return hits;
+}
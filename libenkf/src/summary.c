@@ -143,6 +143,21 @@ bool summary_write_to_buffer(const summary_type * summary , buffer_type * buffer
 }
 
 
+/**
+   Load and store the summary vector through the summary_store of
+   the filesystem, see summary_store.c.
+*/
+
+bool summary_fread_vector( summary_type * summary , enkf_fs_type * fs , int iens ) {
+  return enkf_fs_fread_summary_vector( fs , summary_config_get_var( summary->config ) , iens , summary->data_vector );
+}
+
+
+void summary_fwrite_vector( const summary_type * summary , enkf_fs_type * fs , int iens ) {
+  enkf_fs_fwrite_summary_vector( fs , summary_config_get_var( summary->config ) , iens , summary->data_vector );
+}
+
+
 bool summary_has_data( const summary_type * summary , int report_step) {
   if (summary->vector_storage) {
     return (double_vector_size( summary->data_vector ) > report_step) ? true : false;
@@ -0,0 +1,686 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'summary_store.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#define  _GNU_SOURCE
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <ert/util/util.h>
+#include <ert/util/hash.h>
+#include <ert/util/vector.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/type_macros.h>
+
+#include <ert/enkf/summary_store.h>
+
+/*
+  The summary_store is a dedicated storage for the summary vectors of
+  an ensemble. Where the block_fs based storage holds one small record
+  per key per realization, the summary_store holds one contiguous
+  [ens_size x time_size] float block per key in a single data file:
+
+     <filename>.data  : The blocks, one after another. Realization iens
+                        of a key is stored at
+
+                            offset + iens * time_size * sizeof(float)
+
+     <filename>.index : The dimensions, and for each key the offset of
+                        the block and the number of time steps stored
+                        for each realization (-1: no data).
+
+  Writing: summary_store_set_vector() only adds the vector to a list
+  of pending rows in memory. When the pending rows become large, or
+  when summary_store_fsync() is called, the rows are sorted and rows
+  for consecutive realizations are written with one pwrite() per key.
+
+  Reading: the block of a key is read with one pread() and kept in a
+  one-key cache, so that reading a key for all realizations - as done
+  when plotting or when measuring observations - costs one read. To
+  avoid reading complete blocks when the access pattern is by
+  realization, the first cache miss of a key only reads the requested
+  row, the complete block is read on the second consecutive miss.
+
+  If a vector longer than time_size, or a realization >= ens_size, is
+  added the data file is rewritten with larger dimensions. The data
+  is stored in native byte order.
+
+  All the exported functions are protected by a mutex, the loading of
+  the realizations is done from several threads.
+*/
+
+#define SUMMARY_STORE_TYPE_ID      661730255
+#define SUMMARY_STORE_INDEX_ID     661730256
+#define SUMMARY_STORE_VERSION      1
+#define SUMMARY_STORE_MAX_PENDING  (64 * 1024 * 1024)     /* Bytes of pending rows before they are written to disk. */
+
+
+typedef struct {
+  int     iens;
+  int     length;
+  float * data;
+} summary_store_row_type;
+
+
+typedef struct {
+  char            * key;
+  offset_type       offset;         /* Offset of the block in the data file; -1 if the key has not been written. */
+  int_vector_type * length;         /* The number of time steps stored for each realization; -1 if no data. */
+  vector_type     * pending;        /* Rows not yet written to the data file. */
+} summary_store_node_type;
+
+
+struct summary_store_struct {
+  UTIL_TYPE_ID_DECLARATION;
+  char                    * index_file;
+  char                    * data_file;
+  int                       data_fd;
+  bool                      data_writable;
+  int                       ens_size;
+  int                       time_size;
+  offset_type               data_size;
+  hash_type               * nodes;
+  vector_type             * node_list;
+  size_t                    pending_size;
+  bool                      dirty;
+
+  summary_store_node_type * cache_node;     /* The node with the block currently in the cache. */
+  float                   * cache;
+  int                       cache_rows;
+  summary_store_node_type * last_miss;      /* The node of the last cache miss. */
+
+  pthread_mutex_t           lock;
+};
+
+
+UTIL_IS_INSTANCE_FUNCTION( summary_store , SUMMARY_STORE_TYPE_ID )
+
+/*****************************************************************/
+
+static summary_store_row_type * summary_store_row_alloc( int iens , const double_vector_type * vector ) {
+  summary_store_row_type * row = util_malloc( sizeof * row );
+  const double * values = double_vector_get_const_ptr( vector );
+  int i;
+
+  row->iens = iens;
+  row->length = double_vector_size( vector );
+  row->data = util_calloc( row->length + 1 , sizeof * row->data );
+  for (i=0; i < row->length; i++)
+    row->data[i] = values[i];
+
+  return row;
+}
+
+
+static void summary_store_row_free__( void * arg ) {
+  summary_store_row_type * row = arg;
+  free( row->data );
+  free( row );
+}
+
+
+static int summary_store_row_cmp( const void * arg1 , const void * arg2 ) {
+  const summary_store_row_type * row1 = arg1;
+  const summary_store_row_type * row2 = arg2;
+
+  return row1->iens - row2->iens;
+}
+
+
+static size_t summary_store_row_size( const summary_store_row_type * row ) {
+  return sizeof * row + row->length * sizeof * row->data;
+}
+
+
+static void summary_store_row_copy( const float * data , int length , double_vector_type * vector ) {
+  int i;
+  double_vector_reset( vector );
+  for (i=0; i < length; i++)
+    double_vector_append( vector , data[i] );
+}
+
+/*****************************************************************/
+
+static summary_store_node_type * summary_store_node_alloc( const char * key , offset_type offset ) {
+  summary_store_node_type * node = util_malloc( sizeof * node );
+  node->key = util_alloc_string_copy( key );
+  node->offset = offset;
+  node->length = int_vector_alloc( 0 , -1 );
+  node->pending = vector_alloc_new( );
+  return node;
+}
+
+
+static void summary_store_node_free__( void * arg ) {
+  summary_store_node_type * node = arg;
+  free( node->key );
+  int_vector_free( node->length );
+  vector_free( node->pending );
+  free( node );
+}
+
+
+static summary_store_row_type * summary_store_node_get_pending( const summary_store_node_type * node , int iens ) {
+  int i;
+  for (i=0; i < vector_get_size( node->pending ); i++) {
+    summary_store_row_type * row = vector_iget( node->pending , i );
+    if (row->iens == iens)
+      return row;
+  }
+  return NULL;
+}
+
+/*****************************************************************/
+
+static void summary_store_pread( summary_store_type * store , void * data , size_t size , offset_type offset ) {
+  char * ptr = data;
+  while (size > 0) {
+    ssize_t bytes = pread( store->data_fd , ptr , size , offset );
+    if (bytes > 0) {
+      ptr += bytes;
+      size -= bytes;
+      offset += bytes;
+    } else if (bytes == 0) {
+      /* Rows at the end of the file which have never been written. */
+      memset( ptr , 0 , size );
+      break;
+    } else if (errno != EINTR)
+      util_abort("%s: failed to read from %s: %s \n",__func__ , store->data_file , strerror( errno ));
+  }
+}
+
+
+static void summary_store_pwrite( int fd , const char * filename , const void * data , size_t size , offset_type offset ) {
+  const char * ptr = data;
+  while (size > 0) {
+    ssize_t bytes = pwrite( fd , ptr , size , offset );
+    if (bytes >= 0) {
+      ptr += bytes;
+      size -= bytes;
+      offset += bytes;
+    } else if (errno != EINTR)
+      util_abort("%s: failed to write to %s: %s \n",__func__ , filename , strerror( errno ));
+  }
+}
+
+
+static bool summary_store_open_data( summary_store_type * store , bool writable ) {
+  if (store->data_fd >= 0) {
+    if (store->data_writable || !writable)
+      return true;
+
+    close( store->data_fd );
+    store->data_fd = -1;
+  }
+
+  if (writable) {
+    char * path = util_split_alloc_dirname( store->data_file );
+    if (path) {
+      util_make_path( path );
+      free( path );
+    }
+    store->data_fd = open( store->data_file , O_RDWR | O_CREAT , S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH );
+    if (store->data_fd < 0)
+      util_abort("%s: failed to open %s for writing: %s \n",__func__ , store->data_file , strerror( errno ));
+  } else
+    store->data_fd = open( store->data_file , O_RDONLY );
+
+  store->data_writable = writable;
+  return (store->data_fd >= 0);
+}
+
+
+static size_t summary_store_row_bytes( const summary_store_type * store ) {
+  return store->time_size * sizeof(float);
+}
+
+
+static offset_type summary_store_block_bytes( const summary_store_type * store ) {
+  return (offset_type) store->ens_size * summary_store_row_bytes( store );
+}
+
+/*****************************************************************/
+
+static void summary_store_fwrite_index( const summary_store_type * store ) {
+  char * tmp_file = util_alloc_sprintf("%s.tmp" , store->index_file );
+  FILE * stream = util_mkdir_fopen( tmp_file , "w" );
+  int i;
+
+  util_fwrite_int( SUMMARY_STORE_INDEX_ID , stream );
+  util_fwrite_int( SUMMARY_STORE_VERSION , stream );
+  util_fwrite_int( store->ens_size , stream );
+  util_fwrite_int( store->time_size , stream );
+  util_fwrite( &store->data_size , sizeof store->data_size , 1 , stream , __func__ );
+  util_fwrite_int( vector_get_size( store->node_list ) , stream );
+  for (i=0; i < vector_get_size( store->node_list ); i++) {
+    const summary_store_node_type * node = vector_iget_const( store->node_list , i );
+    util_fwrite_string( node->key , stream );
+    util_fwrite( &node->offset , sizeof node->offset , 1 , stream , __func__ );
+    int_vector_fwrite( node->length , stream );
+  }
+  fclose( stream );
+
+  if (rename( tmp_file , store->index_file ) != 0)
+    util_abort("%s: failed to rename %s -> %s: %s \n",__func__ , tmp_file , store->index_file , strerror( errno ));
+
+  free( tmp_file );
+}
+
+
+static void summary_store_add_node( summary_store_type * store , summary_store_node_type * node ) {
+  hash_insert_ref( store->nodes , node->key , node );
+  vector_append_owned_ref( store->node_list , node , summary_store_node_free__ );
+}
+
+
+static void summary_store_fread_index( summary_store_type * store ) {
+  FILE * stream = util_fopen( store->index_file , "r" );
+  int num_nodes , i;
+
+  if (util_fread_int( stream ) != SUMMARY_STORE_INDEX_ID)
+    util_abort("%s: the file %s is not a summary store index \n",__func__ , store->index_file );
+
+  if (util_fread_int( stream ) != SUMMARY_STORE_VERSION)
+    util_abort("%s: the summary store %s has wrong version \n",__func__ , store->index_file );
+
+  store->ens_size = util_fread_int( stream );
+  store->time_size = util_fread_int( stream );
+  util_fread( &store->data_size , sizeof store->data_size , 1 , stream , __func__ );
+  num_nodes = util_fread_int( stream );
+  for (i=0; i < num_nodes; i++) {
+    char * key = util_fread_alloc_string( stream );
+    offset_type offset;
+    summary_store_node_type * node;
+
+    util_fread( &offset , sizeof offset , 1 , stream , __func__ );
+    node = summary_store_node_alloc( key , offset );
+    int_vector_fread( node->length , stream );
+    summary_store_add_node( store , node );
+    free( key );
+  }
+  fclose( stream );
+}
+
+
+summary_store_type * summary_store_alloc( const char * filename ) {
+  summary_store_type * store = util_malloc( sizeof * store );
+  UTIL_TYPE_ID_INIT( store , SUMMARY_STORE_TYPE_ID );
+  store->index_file = util_alloc_sprintf("%s.index" , filename );
+  store->data_file = util_alloc_sprintf("%s.data" , filename );
+  store->data_fd = -1;
+  store->data_writable = false;
+  store->ens_size = 0;
+  store->time_size = 0;
+  store->data_size = 0;
+  store->nodes = hash_alloc();
+  store->node_list = vector_alloc_new();
+  store->pending_size = 0;
+  store->dirty = false;
+  store->cache_node = NULL;
+  store->cache = NULL;
+  store->cache_rows = 0;
+  store->last_miss = NULL;
+  pthread_mutex_init( &store->lock , NULL );
+
+  if (util_file_exists( store->index_file ))
+    summary_store_fread_index( store );
+
+  return store;
+}
+
+
+void summary_store_free( summary_store_type * store ) {
+  if (store->data_fd >= 0)
+    close( store->data_fd );
+
+  hash_free( store->nodes );
+  vector_free( store->node_list );
+  util_safe_free( store->cache );
+  free( store->index_file );
+  free( store->data_file );
+  pthread_mutex_destroy( &store->lock );
+  free( store );
+}
+
+/*****************************************************************/
+
+static void summary_store_drop_cache( summary_store_type * store ) {
+  store->cache_node = NULL;
+  store->last_miss = NULL;
+}
+
+
+/*
+  Will rewrite the data file with new dimensions. The new file is
+  written to a temporary file which is renamed into place, and the
+  index is written immediately after.
+*/
+
+static void summary_store_resize( summary_store_type * store , int ens_size , int time_size ) {
+  if (store->data_size > 0) {
+    char * tmp_file = util_alloc_sprintf("%s.tmp" , store->data_file );
+    size_t old_row_bytes = summary_store_row_bytes( store );
+    size_t new_row_bytes = time_size * sizeof(float);
+    offset_type old_block_bytes = summary_store_block_bytes( store );
+    offset_type new_block_bytes = (offset_type) ens_size * new_row_bytes;
+    char * old_block = util_malloc( old_block_bytes );
+    char * new_block = util_malloc( new_block_bytes );
+    offset_type new_offset = 0;
+    int fd , i;
+
+    summary_store_open_data( store , false );
+    fd = open( tmp_file , O_WRONLY | O_CREAT | O_TRUNC , S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH );
+    if (fd < 0)
+      util_abort("%s: failed to open %s for writing: %s \n",__func__ , tmp_file , strerror( errno ));
+
+    for (i=0; i < vector_get_size( store->node_list ); i++) {
+      summary_store_node_type * node = vector_iget( store->node_list , i );
+      if (node->offset >= 0) {
+        int iens;
+
+        summary_store_pread( store , old_block , old_block_bytes , node->offset );
+        memset( new_block , 0 , new_block_bytes );
+        for (iens = 0; iens < store->ens_size; iens++)
+          memcpy( &new_block[ iens * new_row_bytes ] , &old_block[ iens * old_row_bytes ] , old_row_bytes );
+
+        summary_store_pwrite( fd , tmp_file , new_block , new_block_bytes , new_offset );
+        node->offset = new_offset;
+        new_offset += new_block_bytes;
+      }
+    }
+    close( fd );
+
+    if (rename( tmp_file , store->data_file ) != 0)
+      util_abort("%s: failed to rename %s -> %s: %s \n",__func__ , tmp_file , store->data_file , strerror( errno ));
+
+    close( store->data_fd );
+    store->data_fd = -1;
+    store->data_size = new_offset;
+
+    free( old_block );
+    free( new_block );
+    free( tmp_file );
+  }
+
+  store->ens_size = ens_size;
+  store->time_size = time_size;
+  summary_store_drop_cache( store );
+
+  if (store->data_size > 0)
+    summary_store_fwrite_index( store );
+}
+
+
+static int summary_store_grow_size( int current_size , int required_size ) {
+  if (current_size == 0)
+    return required_size;
+  else
+    return util_int_max( required_size , current_size + current_size / 2 );
+}
+
+
+static void summary_store_flush_node( summary_store_type * store , summary_store_node_type * node , float * buffer ) {
+  const size_t row_bytes = summary_store_row_bytes( store );
+  int num_rows = vector_get_size( node->pending );
+  int i1 = 0;
+
+  if (node->offset < 0) {
+    node->offset = store->data_size;
+    store->data_size += summary_store_block_bytes( store );
+  }
+
+  vector_sort( node->pending , summary_store_row_cmp );
+  while (i1 < num_rows) {
+    const summary_store_row_type * first_row = vector_iget_const( node->pending , i1 );
+    int i2 = i1 + 1;
+    int i;
+
+    while (i2 < num_rows) {
+      const summary_store_row_type * row = vector_iget_const( node->pending , i2 );
+      if (row->iens != first_row->iens + (i2 - i1))
+        break;
+      i2++;
+    }
+
+    memset( buffer , 0 , (i2 - i1) * row_bytes );
+    for (i = i1; i < i2; i++) {
+      const summary_store_row_type * row = vector_iget_const( node->pending , i );
+      memcpy( &buffer[ (i - i1) * store->time_size ] , row->data , row->length * sizeof * row->data );
+      int_vector_iset( node->length , row->iens , row->length );
+
+      if (store->cache_node == node) {
+        if (row->iens < store->cache_rows)
+          memcpy( &store->cache[ row->iens * store->time_size ] , &buffer[ (i - i1) * store->time_size ] , row_bytes );
+        else
+          store->cache_node = NULL;
+      }
+    }
+
+    summary_store_pwrite( store->data_fd , store->data_file , buffer , (i2 - i1) * row_bytes , node->offset + first_row->iens * row_bytes );
+    i1 = i2;
+  }
+  vector_clear( node->pending );
+}
+
+
+static void summary_store_flush( summary_store_type * store ) {
+  if (store->pending_size > 0) {
+    int ens_size = store->ens_size;
+    int time_size = store->time_size;
+    int i , j;
+
+    for (i=0; i < vector_get_size( store->node_list ); i++) {
+      const summary_store_node_type * node = vector_iget_const( store->node_list , i );
+      for (j=0; j < vector_get_size( node->pending ); j++) {
+        const summary_store_row_type * row = vector_iget_const( node->pending , j );
+        ens_size = util_int_max( ens_size , row->iens + 1 );
+        time_size = util_int_max( time_size , row->length );
+      }
+    }
+
+    if ((ens_size > store->ens_size) || (time_size > store->time_size)) {
+      if (ens_size > store->ens_size)
+        ens_size = summary_store_grow_size( store->ens_size , ens_size );
+
+      if (time_size > store->time_size)
+        time_size = summary_store_grow_size( store->time_size , time_size );
+
+      summary_store_resize( store , ens_size , time_size );
+    }
+
+    summary_store_open_data( store , true );
+    {
+      float * buffer = util_calloc( (size_t) store->ens_size * store->time_size + 1 , sizeof * buffer );
+
+      for (i=0; i < vector_get_size( store->node_list ); i++) {
+        summary_store_node_type * node = vector_iget( store->node_list , i );
+        if (vector_get_size( node->pending ) > 0)
+          summary_store_flush_node( store , node , buffer );
+      }
+
+      free( buffer );
+    }
+    store->pending_size = 0;
+  }
+
+  if (store->dirty) {
+    summary_store_fwrite_index( store );
+    store->dirty = false;
+  }
+}
+
+
+void summary_store_fsync( summary_store_type * store ) {
+  pthread_mutex_lock( &store->lock );
+  summary_store_flush( store );
+  pthread_mutex_unlock( &store->lock );
+}
+
+/*****************************************************************/
+
+int summary_store_get_size( summary_store_type * store ) {
+  int size;
+  pthread_mutex_lock( &store->lock );
+  size = vector_get_size( store->node_list );
+  pthread_mutex_unlock( &store->lock );
+  return size;
+}
+
+
+bool summary_store_has_key( summary_store_type * store , const char * key ) {
+  bool has_key;
+  pthread_mutex_lock( &store->lock );
+  has_key = hash_has_key( store->nodes , key );
+  pthread_mutex_unlock( &store->lock );
+  return has_key;
+}
+
+
+stringlist_type * summary_store_alloc_keys( summary_store_type * store ) {
+  stringlist_type * keys = stringlist_alloc_new( );
+  int i;
+
+  pthread_mutex_lock( &store->lock );
+  for (i=0; i < vector_get_size( store->node_list ); i++) {
+    const summary_store_node_type * node = vector_iget_const( store->node_list , i );
+    stringlist_append_copy( keys , node->key );
+  }
+  pthread_mutex_unlock( &store->lock );
+
+  return keys;
+}
+
+
+bool summary_store_has_vector( summary_store_type * store , const char * key , int iens ) {
+  bool has_vector = false;
+
+  pthread_mutex_lock( &store->lock );
+  {
+    const summary_store_node_type * node = hash_safe_get( store->nodes , key );
+    if (node) {
+      if (summary_store_node_get_pending( node , iens ))
+        has_vector = true;
+      else
+        has_vector = (int_vector_safe_iget( node->length , iens ) >= 0);
+    }
+  }
+  pthread_mutex_unlock( &store->lock );
+
+  return has_vector;
+}
+
+
+static void summary_store_load_cache( summary_store_type * store , summary_store_node_type * node ) {
+  int rows = int_vector_size( node->length );
+
+  store->cache = util_realloc( store->cache , (rows * summary_store_row_bytes( store )) + 1 );
+  summary_store_pread( store , store->cache , rows * summary_store_row_bytes( store ) , node->offset );
+  store->cache_rows = rows;
+  store->cache_node = node;
+}
+
+
+static bool summary_store_load_vector( summary_store_type * store , summary_store_node_type * node , int iens , double_vector_type * vector) {
+  const summary_store_row_type * row = summary_store_node_get_pending( node , iens );
+
+  if (row) {
+    summary_store_row_copy( row->data , row->length , vector );
+    return true;
+  } else {
+    int length = int_vector_safe_iget( node->length , iens );
+    if (length < 0)
+      return false;
+
+    if (!summary_store_open_data( store , false ))
+      return false;
+
+    if (store->cache_node != node) {
+      if (store->last_miss == node)
+        summary_store_load_cache( store , node );
+      else {
+        float * data = util_calloc( length + 1 , sizeof * data );
+
+        store->last_miss = node;
+        summary_store_pread( store , data , length * sizeof * data , node->offset + iens * summary_store_row_bytes( store ));
+        summary_store_row_copy( data , length , vector );
+        free( data );
+        return true;
+      }
+    }
+
+    summary_store_row_copy( &store->cache[ iens * store->time_size ] , length , vector );
+    return true;
+  }
+}
+
+
+bool summary_store_get_vector( summary_store_type * store , const char * key , int iens , double_vector_type * vector ) {
+  bool has_vector = false;
+
+  pthread_mutex_lock( &store->lock );
+  {
+    summary_store_node_type * node = hash_safe_get( store->nodes , key );
+    if (node)
+      has_vector = summary_store_load_vector( store , node , iens , vector );
+  }
+  pthread_mutex_unlock( &store->lock );
+
+  return has_vector;
+}
+
+
+void summary_store_set_vector( summary_store_type * store , const char * key , int iens , const double_vector_type * vector ) {
+  pthread_mutex_lock( &store->lock );
+  {
+    summary_store_node_type * node = hash_safe_get( store->nodes , key );
+    summary_store_row_type * new_row = summary_store_row_alloc( iens , vector );
+    summary_store_row_type * old_row;
+
+    if (node == NULL) {
+      node = summary_store_node_alloc( key , -1 );
+      summary_store_add_node( store , node );
+    }
+
+    old_row = summary_store_node_get_pending( node , iens );
+    if (old_row) {
+      store->pending_size -= summary_store_row_size( old_row );
+      free( old_row->data );
+      old_row->length = new_row->length;
+      old_row->data = new_row->data;
+      free( new_row );
+      new_row = old_row;
+    } else
+      vector_append_owned_ref( node->pending , new_row , summary_store_row_free__ );
+
+    store->pending_size += summary_store_row_size( new_row );
+    store->dirty = true;
+
+    if (store->pending_size > SUMMARY_STORE_MAX_PENDING)
+      summary_store_flush( store );
+  }
+  pthread_mutex_unlock( &store->lock );
+}
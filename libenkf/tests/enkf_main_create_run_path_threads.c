@@ -0,0 +1,155 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'enkf_main_create_run_path_threads.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/bool_vector.h>
+
+#include <ert/enkf/enkf_main.h>
+#include <ert/enkf/analysis_config.h>
+#include <ert/enkf/ert_test_context.h>
+
+/*
+  Creates the runpaths with 1, 2, 4, ... max_threads threads and checks
+  that the generated files do not depend on the number of threads, and
+  that they are equal to the files created one realisation at a time
+  with enkf_main_icreate_run_path(), which does not use the
+  runpath_file_cache. The time used is printed, with a large ensemble
+  the test can be used as a benchmark of the runpath creation:
+
+     enkf_main_create_run_path_threads  config_file  [ens_size  [max_threads]]
+
+  The config is assumed to be the snake_oil case.
+*/
+
+#define RUNPATH_ROOT "storage/snake_oil/runpath"
+
+static const char * runpath_files[] = {"snake_oil_params.txt" , "seed.txt" , "jobs.py"};
+#define NUM_RUNPATH_FILES 3
+
+
+static stringlist_type * alloc_runpath_content( int ens_size ) {
+  stringlist_type * content = stringlist_alloc_new( );
+  for (int iens = 0; iens < ens_size; iens++) {
+    for (int ifile = 0; ifile < NUM_RUNPATH_FILES; ifile++) {
+      char * filename = util_alloc_sprintf( RUNPATH_ROOT "/realisation-%d/iter-0/%s" , iens , runpath_files[ifile] );
+      test_assert_true( util_file_exists( filename ));
+      stringlist_append_owned_ref( content , util_fread_alloc_file_content( filename , NULL ));
+      free( filename );
+    }
+  }
+  return content;
+}
+
+
+static stringlist_type * create_run_path( enkf_main_type * enkf_main , int num_threads ) {
+  int ens_size = enkf_main_get_ensemble_size( enkf_main );
+  bool_vector_type * iactive = bool_vector_alloc( ens_size , true );
+  timer_type * timer = timer_alloc( false );
+  stringlist_type * content;
+
+  if (util_is_directory( RUNPATH_ROOT ))
+    util_clear_directory( RUNPATH_ROOT , true , true );
+
+  analysis_config_set_num_threads( enkf_main_get_analysis_config( enkf_main ) , num_threads );
+  timer_start( timer );
+  test_assert_true( enkf_main_create_run_path( enkf_main , iactive , 0 ));
+  timer_stop( timer );
+  printf("realisations:%5d   threads:%3d   create_run_path: %8.3f s\n" , ens_size , num_threads , timer_get_total_time( timer ));
+
+  content = alloc_runpath_content( ens_size );
+  timer_free( timer );
+  bool_vector_free( iactive );
+  return content;
+}
+
+
+static stringlist_type * create_run_path_serial( enkf_main_type * enkf_main ) {
+  int ens_size = enkf_main_get_ensemble_size( enkf_main );
+  bool_vector_type * iactive = bool_vector_alloc( ens_size , true );
+  ert_init_context_type * init_context;
+  stringlist_type * content;
+
+  if (util_is_directory( RUNPATH_ROOT ))
+    util_clear_directory( RUNPATH_ROOT , true , true );
+
+  init_context = enkf_main_alloc_ert_init_context( enkf_main , enkf_main_get_fs( enkf_main ) , iactive , INIT_CONDITIONAL , 0 );
+  for (int iens = 0; iens < ens_size; iens++)
+    enkf_main_icreate_run_path( enkf_main , ert_init_context_iens_get_arg( init_context , iens ));
+
+  content = alloc_runpath_content( ens_size );
+  ert_init_context_free( init_context );
+  bool_vector_free( iactive );
+  return content;
+}
+
+
+static void assert_content_equal( const stringlist_type * content , const stringlist_type * content0 ) {
+  test_assert_int_equal( stringlist_get_size( content ) , stringlist_get_size( content0 ));
+  for (int i = 0; i < stringlist_get_size( content ); i++)
+    test_assert_string_equal( stringlist_iget( content , i ) , stringlist_iget( content0 , i ));
+}
+
+
+int main(int argc , char ** argv) {
+  const char * config_file = argv[1];
+  int ens_size = 0;
+  int max_threads = 4;
+  ert_test_context_type * test_context;
+
+  util_install_signals();
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &ens_size );
+  if (argc > 3)
+    util_sscanf_int( argv[3] , &max_threads );
+
+  test_context = ert_test_context_alloc( "CREATE_RUN_PATH_THREADS" , config_file );
+  {
+    enkf_main_type * enkf_main = ert_test_context_get_main( test_context );
+    stringlist_type * content0;
+    int num_threads = 1;
+
+    if (ens_size > 0)
+      enkf_main_resize_ensemble( enkf_main , ens_size );
+
+    content0 = create_run_path( enkf_main , 1 );
+    while (num_threads < max_threads) {
+      stringlist_type * content;
+
+      num_threads = util_int_min( 2 * num_threads , max_threads );
+      content = create_run_path( enkf_main , num_threads );
+      assert_content_equal( content , content0 );
+      stringlist_free( content );
+    }
+
+    {
+      stringlist_type * content = create_run_path_serial( enkf_main );
+      assert_content_equal( content , content0 );
+      stringlist_free( content );
+    }
+    stringlist_free( content0 );
+  }
+  ert_test_context_free( test_context );
+  exit(0);
+}
@@ -0,0 +1,227 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'enkf_main_update_threads.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+#include <ert/util/matrix.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/hash.h>
+
+#include <ert/enkf/enkf_main.h>
+#include <ert/enkf/enkf_node.h>
+#include <ert/enkf/enkf_fs.h>
+#include <ert/enkf/ensemble_config.h>
+#include <ert/enkf/analysis_config.h>
+#include <ert/enkf/active_list.h>
+#include <ert/enkf/local_config.h>
+#include <ert/enkf/local_ministep.h>
+#include <ert/enkf/local_dataset.h>
+#include <ert/enkf/local_obsdata.h>
+#include <ert/enkf/local_obsdata_node.h>
+#include <ert/enkf/local_updatestep.h>
+#include <ert/enkf/ert_test_context.h>
+
+/*
+  Runs the smoother update with 1, 2, 4, ... max_threads threads and
+  checks that the updated parameters do not depend on the number of
+  threads. The streaming update, with a memory limit so small that the
+  nodes are split over several chunks, must also give the same result.
+  The time used for each update is printed, with a larger case the
+  test can be used as a benchmark of the update:
+
+     enkf_main_update_threads  config_file  [max_threads]
+
+  The rng is reinitialized before each update, so the config must use
+  LOAD_SEED for the updates to be comparable.
+*/
+
+
+static matrix_type * alloc_parameters( enkf_main_type * enkf_main , enkf_fs_type * fs ) {
+  ensemble_config_type * ens_config = enkf_main_get_ensemble_config( enkf_main );
+  stringlist_type * keys = ensemble_config_alloc_keylist_from_var_type( ens_config , PARAMETER );
+  active_list_type * active_list = active_list_alloc( );
+  int ens_size = enkf_main_get_ensemble_size( enkf_main );
+  int rows = 0;
+  matrix_type * A;
+
+  for (int ikey = 0; ikey < stringlist_get_size( keys ); ikey++)
+    rows += enkf_config_node_get_data_size( ensemble_config_get_node( ens_config , stringlist_iget( keys , ikey )) , 0 );
+
+  A = matrix_alloc( rows , ens_size );
+  for (int iens = 0; iens < ens_size; iens++) {
+    int row_offset = 0;
+    for (int ikey = 0; ikey < stringlist_get_size( keys ); ikey++) {
+      const enkf_config_node_type * config_node = ensemble_config_get_node( ens_config , stringlist_iget( keys , ikey ));
+      enkf_node_type * node = enkf_node_alloc( config_node );
+      node_id_type node_id = {.report_step = 0 , .iens = iens };
+
+      enkf_node_serialize( node , fs , node_id , active_list , A , row_offset , iens );
+      row_offset += enkf_config_node_get_data_size( config_node , 0 );
+      enkf_node_free( node );
+    }
+  }
+
+  active_list_free( active_list );
+  stringlist_free( keys );
+  return A;
+}
+
+
+static matrix_type * run_update( enkf_main_type * enkf_main , enkf_fs_type * source_fs , int num_threads , const char * label) {
+  char * case_name = util_alloc_sprintf( "%s_%d" , label , num_threads );
+  enkf_fs_type * target_fs = enkf_main_mount_alt_fs( enkf_main , case_name , true );
+  timer_type * timer = timer_alloc( false );
+  matrix_type * A;
+
+  analysis_config_set_num_threads( enkf_main_get_analysis_config( enkf_main ) , num_threads );
+  enkf_main_rng_init( enkf_main );
+
+  timer_start( timer );
+  test_assert_true( enkf_main_smoother_update( enkf_main , source_fs , target_fs ));
+  timer_stop( timer );
+  printf("%-12s threads:%3d   update: %8.3f s\n" , label , num_threads , timer_get_total_time( timer ));
+
+  A = alloc_parameters( enkf_main , target_fs );
+  timer_free( timer );
+  enkf_fs_decref( target_fs );
+  free( case_name );
+  return A;
+}
+
+
+static void assert_parameters_equal( const matrix_type * A , const matrix_type * A0 ) {
+  test_assert_int_equal( matrix_get_rows( A ) , matrix_get_rows( A0 ));
+  test_assert_int_equal( matrix_get_columns( A ) , matrix_get_columns( A0 ));
+  for (int j = 0; j < matrix_get_columns( A ); j++)
+    for (int i = 0; i < matrix_get_rows( A ); i++) {
+      double a0 = matrix_iget( A0 , i , j );
+      test_assert_true( fabs( matrix_iget( A , i , j ) - a0 ) <= 1e-10 * (1 + fabs( a0 )));
+    }
+}
+
+
+static void run_updates( enkf_main_type * enkf_main , enkf_fs_type * source_fs , int max_threads , const char * label , const matrix_type * A0) {
+  int num_threads = 1;
+  while (true) {
+    matrix_type * A = run_update( enkf_main , source_fs , num_threads , label );
+    assert_parameters_equal( A , A0 );
+    matrix_free( A );
+
+    if (num_threads == max_threads)
+      break;
+    num_threads = util_int_min( 2 * num_threads , max_threads );
+  }
+}
+
+
+/*
+  One ministep with one dataset for each PARAMETER node and one for
+  the first dynamic node. In smoother mode there is nothing to update
+  in the dynamic dataset, but it is passed through the same machinery
+  as the parameter datasets; all the datasets are independent.
+*/
+
+static void create_split_config( enkf_main_type * enkf_main ) {
+  local_config_type * local_config = enkf_main_get_local_config( enkf_main );
+  ensemble_config_type * ens_config = enkf_main_get_ensemble_config( enkf_main );
+  local_updatestep_type * updatestep;
+  local_ministep_type * ministep;
+  local_obsdata_type * obsdata;
+
+  local_config_clear( local_config );
+  updatestep = local_config_get_updatestep( local_config );
+  ministep = local_config_alloc_ministep( local_config , "SPLIT" , NULL );
+  obsdata = local_config_alloc_obsdata( local_config , "ALL_OBS" );
+  local_updatestep_add_ministep( updatestep , ministep );
+
+  {
+    hash_iter_type * obs_iter = enkf_obs_alloc_iter( enkf_main_get_obs( enkf_main ));
+    while (!hash_iter_is_complete( obs_iter )) {
+      const char * obs_key = hash_iter_get_next_key( obs_iter );
+      local_obsdata_add_node( obsdata , local_obsdata_node_alloc( obs_key , true ));
+    }
+    hash_iter_free( obs_iter );
+    local_ministep_add_obsdata( ministep , obsdata );
+  }
+
+  {
+    stringlist_type * keys = ensemble_config_alloc_keylist_from_var_type( ens_config , PARAMETER );
+    stringlist_type * dynamic_keys = ensemble_config_alloc_keylist_from_var_type( ens_config , DYNAMIC_RESULT );
+
+    if (stringlist_get_size( dynamic_keys ) > 0)
+      stringlist_append_copy( keys , stringlist_iget( dynamic_keys , 0 ));
+
+    for (int ikey = 0; ikey < stringlist_get_size( keys ); ikey++) {
+      const char * key = stringlist_iget( keys , ikey );
+      local_dataset_type * dataset = local_config_alloc_dataset( local_config , key );
+      local_dataset_add_node( dataset , key );
+      local_ministep_add_dataset( ministep , dataset );
+    }
+    stringlist_free( dynamic_keys );
+    stringlist_free( keys );
+  }
+}
+
+
+
+int main(int argc , char ** argv) {
+  const char * config_file = argv[1];
+  int max_threads = 4;
+  ert_test_context_type * test_context;
+
+  util_install_signals();
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &max_threads );
+
+  test_context = ert_test_context_alloc( "UPDATE_THREADS" , config_file );
+  {
+    enkf_main_type * enkf_main = ert_test_context_get_main( test_context );
+    enkf_fs_type * source_fs = enkf_main_get_fs( enkf_main );
+    matrix_type * A0;
+
+    A0 = run_update( enkf_main , source_fs , 1 , "reference" );
+    run_updates( enkf_main , source_fs , max_threads , "default" , A0 );
+
+    {
+      analysis_config_type * analysis_config = enkf_main_get_analysis_config( enkf_main );
+
+      /* One row in each chunk. */
+      analysis_config_set_memory_limit( analysis_config , 1e-6 );
+      run_updates( enkf_main , source_fs , max_threads , "stream_1" , A0 );
+
+      /* Three rows in each chunk with 25 realisations. */
+      analysis_config_set_memory_limit( analysis_config , 1.2e-3 );
+      run_updates( enkf_main , source_fs , max_threads , "stream_n" , A0 );
+
+      analysis_config_set_memory_limit( analysis_config , 0 );
+    }
+
+    create_split_config( enkf_main );
+    run_updates( enkf_main , source_fs , max_threads , "split" , A0 );
+
+    matrix_free( A0 );
+  }
+  ert_test_context_free( test_context );
+  exit(0);
+}
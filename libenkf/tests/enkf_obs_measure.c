@@ -0,0 +1,180 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'enkf_obs_measure.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <ert/util/test_work_area.h>
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/bool_vector.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/type_vector_functions.h>
+#include <ert/util/vector.h>
+
+#include <ert/enkf/enkf_fs.h>
+#include <ert/enkf/enkf_config_node.h>
+#include <ert/enkf/enkf_obs.h>
+#include <ert/enkf/obs_vector.h>
+#include <ert/enkf/summary_obs.h>
+#include <ert/enkf/local_obsdata.h>
+#include <ert/enkf/local_obsdata_node.h>
+#include <ert/enkf/meas_data.h>
+#include <ert/enkf/obs_data.h>
+
+/*
+  Checks the measurement of simulated summary responses in
+  enkf_obs_get_obs_and_measure_data() against the values stored in
+  the filesystem, and reports the time used. The sizes can be given
+  on the commandline to use the test as a benchmark:
+
+     enkf_obs_measure  [num_keys  [ens_size  [num_steps]]]
+*/
+
+static double test_value( int key , int iens , int step ) {
+  return key * 1000 + iens + step * 0.25;
+}
+
+static char * alloc_key( int key ) {
+  return util_alloc_sprintf("WOPR:W%d" , key);
+}
+
+
+static void create_case( enkf_fs_type * fs , enkf_obs_type * enkf_obs , vector_type * config_nodes , int num_keys , int ens_size , int num_steps) {
+  double_vector_type * vector = double_vector_alloc( 0 , 0 );
+  int key , iens , step;
+
+  for (key = 0; key < num_keys; key++) {
+    char * summary_key = alloc_key( key );
+    enkf_config_node_type * config_node = enkf_config_node_alloc_summary( summary_key , LOAD_FAIL_SILENT );
+    obs_vector_type * obs_vector = obs_vector_alloc( SUMMARY_OBS , summary_key , config_node , num_steps );
+
+    vector_append_owned_ref( config_nodes , config_node , enkf_config_node_free__ );
+    for (iens = 0; iens < ens_size; iens++) {
+      for (step = 0; step < num_steps; step++)
+        double_vector_iset( vector , step , test_value( key , iens , step ));
+      enkf_fs_fwrite_summary_vector( fs , summary_key , iens , vector );
+    }
+
+    /* Observations at every third step, the first key has only one observation. */
+    for (step = 1; step < num_steps; step += 3) {
+      obs_vector_install_node( obs_vector , step , summary_obs_alloc( summary_key , summary_key , step , 1 , NULL , 0 ));
+      if (key == 0)
+        break;
+    }
+    enkf_obs_add_obs_vector( enkf_obs , obs_vector );
+    free( summary_key );
+  }
+  double_vector_free( vector );
+}
+
+
+static void assert_measured( const meas_data_type * meas_data , int num_keys , int ens_size , int num_steps) {
+  int key , iens;
+
+  test_assert_int_equal( meas_data_get_num_blocks( meas_data ) , num_keys );
+  for (key = 0; key < num_keys; key++) {
+    const meas_block_type * meas_block = meas_data_iget_block_const( meas_data , key );
+    int obs_size = (key == 0) ? 1 : (num_steps + 1) / 3;
+
+    test_assert_int_equal( meas_block_get_total_obs_size( meas_block ) , obs_size );
+    for (iens = 0; iens < ens_size; iens++) {
+      int iobs;
+      for (iobs = 0; iobs < obs_size; iobs++)
+        test_assert_double_equal( meas_block_iget( meas_block , iens , iobs ) , test_value( key , iens , 1 + 3 * iobs ));
+    }
+  }
+}
+
+
+int main(int argc , char ** argv) {
+  int num_keys = 50;
+  int ens_size = 25;
+  int num_steps = 100;
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &num_keys );
+
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &ens_size );
+
+  if (argc > 3)
+    util_sscanf_int( argv[3] , &num_steps );
+
+  {
+    test_work_area_type * work_area = test_work_area_alloc("enkf_obs_measure");
+    enkf_fs_type * fs = enkf_fs_create_fs( "mnt" , BLOCK_FS_DRIVER_ID , NULL , true );
+    enkf_obs_type * enkf_obs = enkf_obs_alloc( NULL , NULL , NULL , NULL , NULL );
+    vector_type * config_nodes = vector_alloc_new();
+    local_obsdata_type * local_obsdata = local_obsdata_alloc( "OBS" );
+    bool_vector_type * ens_mask = bool_vector_alloc( ens_size , true );
+    int_vector_type * ens_active_list = bool_vector_alloc_active_list( ens_mask );
+    timer_type * timer = timer_alloc( false );
+    int key;
+
+    create_case( fs , enkf_obs , config_nodes , num_keys , ens_size , num_steps );
+    enkf_fs_fsync( fs );
+    for (key = 0; key < num_keys; key++)
+      local_obsdata_add_node( local_obsdata , obs_vector_alloc_local_node( enkf_obs_iget_vector( enkf_obs , key )));
+
+    {
+      meas_data_type * meas_data = meas_data_alloc( ens_mask );
+      obs_data_type * obs_data = obs_data_alloc( 1.0 );
+
+      timer_start( timer );
+      for (key = 0; key < num_keys; key++)
+        enkf_obs_get_obs_and_measure_node( enkf_obs , fs , local_obsdata_iget( local_obsdata , key ) , ens_active_list , meas_data , obs_data );
+      timer_stop( timer );
+      printf("enkf_obs_get_obs_and_measure_node() : %8.4f s\n" , timer_get_total_time( timer ));
+
+      test_assert_int_equal( obs_data_get_num_blocks( obs_data ) , num_keys );
+      assert_measured( meas_data , num_keys , ens_size , num_steps );
+      meas_data_free( meas_data );
+      obs_data_free( obs_data );
+    }
+
+    {
+      meas_data_type * meas_data = meas_data_alloc( ens_mask );
+      obs_data_type * obs_data = obs_data_alloc( 1.0 );
+
+      timer_reset( timer );
+      timer_start( timer );
+      enkf_obs_get_obs_and_measure_data( enkf_obs , fs , local_obsdata , ens_active_list , meas_data , obs_data );
+      timer_stop( timer );
+      printf("enkf_obs_get_obs_and_measure_data() : %8.4f s\n" , timer_get_total_time( timer ));
+
+      test_assert_int_equal( obs_data_get_num_blocks( obs_data ) , num_keys );
+      assert_measured( meas_data , num_keys , ens_size , num_steps );
+      meas_data_free( meas_data );
+      obs_data_free( obs_data );
+    }
+
+    timer_free( timer );
+    int_vector_free( ens_active_list );
+    bool_vector_free( ens_mask );
+    local_obsdata_free( local_obsdata );
+    enkf_obs_free( enkf_obs );
+    vector_free( config_nodes );
+    enkf_fs_decref( fs );
+    test_work_area_free( work_area );
+  }
+  exit(0);
+}
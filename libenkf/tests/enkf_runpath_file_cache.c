@@ -0,0 +1,110 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'enkf_runpath_file_cache.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/subst_list.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/enkf/runpath_file_cache.h>
+
+
+static void render( const subst_list_type * subst_list , const char * source_text , const char * target_file ) {
+  FILE * stream = util_mkdir_fopen( target_file , "w" );
+  subst_list_filtered_fprintf( subst_list , source_text , stream );
+  fclose( stream );
+}
+
+
+static void assert_file_content( const char * filename , const char * expected ) {
+  char * content = util_fread_alloc_file_content( filename , NULL );
+  test_assert_string_equal( content , expected );
+  free( content );
+}
+
+
+/*
+  Renders the source text for each of the realisations, using the
+  cache the same way as enkf_state_init_eclipse(), and returns the
+  number of realisations which rendered the file themselves.
+*/
+
+static int create_files( runpath_file_cache_type * cache , subst_list_type ** subst_list , int ens_size , const char * key , const char * source_text ) {
+  int rendered = 0;
+  for (int iens = 0; iens < ens_size; iens++) {
+    char * target_file = util_alloc_sprintf( "run%d/%s" , iens , key );
+    if (!runpath_file_cache_install( cache , key , subst_list[iens] , target_file )) {
+      render( subst_list[iens] , source_text , target_file );
+      runpath_file_cache_add( cache , key , source_text , subst_list[iens] , target_file );
+      rendered++;
+    }
+
+    {
+      char * expected = subst_list_alloc_filtered_string( subst_list[iens] , source_text );
+      assert_file_content( target_file , expected );
+      free( expected );
+    }
+    free( target_file );
+  }
+  return rendered;
+}
+
+
+int main(int argc , char ** argv) {
+  const int ens_size = 10;
+  test_work_area_type * work_area = test_work_area_alloc( "runpath_file_cache" );
+  subst_list_type * parent = subst_list_alloc( NULL );
+  subst_list_type ** subst_list = util_calloc( ens_size , sizeof * subst_list );
+  runpath_file_cache_type * cache = runpath_file_cache_alloc( );
+
+  subst_list_append_copy( parent , "<CWD>" , "/work" , NULL );
+  for (int iens = 0; iens < ens_size; iens++) {
+    subst_list[iens] = subst_list_alloc( parent );
+    subst_list_append_owned_ref( subst_list[iens] , "<IENS>" , util_alloc_sprintf( "%d" , iens ) , NULL );
+    subst_list_append_owned_ref( subst_list[iens] , "<GROUP>" , util_alloc_sprintf( "%d" , iens % 2 ) , NULL );
+  }
+
+  test_assert_true( runpath_file_cache_is_instance( cache ));
+  test_assert_int_equal( 0 , runpath_file_cache_get_size( cache ));
+
+  /* Common to all the realisations: rendered once. */
+  test_assert_int_equal( 1 , create_files( cache , subst_list , ens_size , "COMMON" , "Root: <CWD>\nNo realisation keys\n" ));
+  test_assert_true( runpath_file_cache_has_key( cache , "COMMON" ));
+  test_assert_int_equal( ens_size - 1 , runpath_file_cache_get_hits( cache ));
+
+  /* Depends on <IENS>: all the realisations must render. */
+  test_assert_int_equal( ens_size , create_files( cache , subst_list , ens_size , "IENS" , "Realisation: <IENS>\n" ));
+
+  /* Only the realisations with the same <GROUP> as the first can use the cache. */
+  test_assert_int_equal( ens_size / 2 + 1 , create_files( cache , subst_list , ens_size , "GROUP" , "Group: <GROUP> in <CWD>\n" ));
+
+  test_assert_int_equal( 3 , runpath_file_cache_get_size( cache ));
+  test_assert_int_equal( ens_size - 1 + ens_size / 2 - 1 , runpath_file_cache_get_hits( cache ));
+
+  runpath_file_cache_free( cache );
+  for (int iens = 0; iens < ens_size; iens++)
+    subst_list_free( subst_list[iens] );
+  free( subst_list );
+  subst_list_free( parent );
+  test_work_area_free( work_area );
+  exit(0);
+}
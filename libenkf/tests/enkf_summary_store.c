@@ -0,0 +1,217 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'enkf_summary_store.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <ert/util/test_work_area.h>
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/thread_pool.h>
+#include <ert/util/arg_pack.h>
+
+#include <ert/enkf/summary_store.h>
+
+
+double test_value( int key , int iens , int step ) {
+  return key * 1000 + iens + step * 0.25;
+}
+
+
+void set_vector( summary_store_type * store , const char * key , int key_nr , int iens , int length ) {
+  double_vector_type * vector = double_vector_alloc( 0 , 0 );
+  int step;
+  for (step = 0; step < length; step++)
+    double_vector_iset( vector , step , test_value( key_nr , iens , step ));
+  summary_store_set_vector( store , key , iens , vector );
+  double_vector_free( vector );
+}
+
+
+void assert_vector( summary_store_type * store , const char * key , int key_nr , int iens , int length ) {
+  double_vector_type * vector = double_vector_alloc( 0 , 0 );
+  int step;
+
+  test_assert_true( summary_store_has_vector( store , key , iens ));
+  test_assert_true( summary_store_get_vector( store , key , iens , vector ));
+  test_assert_int_equal( double_vector_size( vector ) , length );
+  for (step = 0; step < length; step++)
+    test_assert_double_equal( double_vector_iget( vector , step ) , test_value( key_nr , iens , step ));
+
+  double_vector_free( vector );
+}
+
+
+void test_create() {
+  summary_store_type * store = summary_store_alloc( "create/summary" );
+  double_vector_type * vector = double_vector_alloc( 0 , 0 );
+
+  test_assert_true( summary_store_is_instance( store ));
+  test_assert_int_equal( summary_store_get_size( store ) , 0 );
+  test_assert_false( summary_store_has_key( store , "FOPT" ));
+  test_assert_false( summary_store_has_vector( store , "FOPT" , 0 ));
+  test_assert_false( summary_store_get_vector( store , "FOPT" , 0 , vector ));
+  summary_store_fsync( store );
+  test_assert_false( util_file_exists( "create/summary.index" ));
+
+  double_vector_free( vector );
+  summary_store_free( store );
+}
+
+
+void test_set_get() {
+  summary_store_type * store = summary_store_alloc( "set_get/summary" );
+  int iens;
+
+  for (iens = 0; iens < 10; iens += 2) {
+    set_vector( store , "FOPT" , 1 , iens , 20 );
+    set_vector( store , "FWPT" , 2 , iens , 20 );
+  }
+  test_assert_int_equal( summary_store_get_size( store ) , 2 );
+  test_assert_false( summary_store_has_vector( store , "FOPT" , 1 ));
+  assert_vector( store , "FOPT" , 1 , 4 , 20 );
+
+  summary_store_fsync( store );
+  for (iens = 0; iens < 10; iens += 2) {
+    assert_vector( store , "FOPT" , 1 , iens , 20 );
+    assert_vector( store , "FWPT" , 2 , iens , 20 );
+  }
+  test_assert_false( summary_store_has_vector( store , "FOPT" , 1 ));
+  test_assert_false( summary_store_has_vector( store , "FOPT" , 100 ));
+
+  /* Overwrite an existing vector, both before and after fsync. */
+  set_vector( store , "FOPT" , 3 , 4 , 20 );
+  assert_vector( store , "FOPT" , 3 , 4 , 20 );
+  set_vector( store , "FOPT" , 4 , 4 , 15 );
+  assert_vector( store , "FOPT" , 4 , 4 , 15 );
+  summary_store_fsync( store );
+  assert_vector( store , "FOPT" , 4 , 4 , 15 );
+  assert_vector( store , "FOPT" , 1 , 6 , 20 );
+  summary_store_free( store );
+
+  store = summary_store_alloc( "set_get/summary" );
+  test_assert_int_equal( summary_store_get_size( store ) , 2 );
+  {
+    stringlist_type * keys = summary_store_alloc_keys( store );
+    test_assert_string_equal( stringlist_iget( keys , 0 ) , "FOPT" );
+    test_assert_string_equal( stringlist_iget( keys , 1 ) , "FWPT" );
+    stringlist_free( keys );
+  }
+  assert_vector( store , "FOPT" , 4 , 4 , 15 );
+  for (iens = 0; iens < 10; iens += 2) {
+    if (iens != 4)
+      assert_vector( store , "FOPT" , 1 , iens , 20 );
+    assert_vector( store , "FWPT" , 2 , iens , 20 );
+  }
+  summary_store_free( store );
+}
+
+
+/*
+  Vectors which are longer, and realizations which are larger, than
+  the current dimensions of the store; the data file must be
+  rewritten.
+*/
+
+void test_resize() {
+  summary_store_type * store = summary_store_alloc( "resize/summary" );
+  int iens;
+
+  for (iens = 0; iens < 5; iens++)
+    set_vector( store , "FOPT" , 1 , iens , 10 );
+  summary_store_fsync( store );
+
+  set_vector( store , "FOPT" , 1 , 7 , 30 );
+  set_vector( store , "WOPR:OP1" , 2 , 25 , 3 );
+  summary_store_fsync( store );
+
+  for (iens = 0; iens < 5; iens++)
+    assert_vector( store , "FOPT" , 1 , iens , 10 );
+  assert_vector( store , "FOPT" , 1 , 7 , 30 );
+  assert_vector( store , "WOPR:OP1" , 2 , 25 , 3 );
+  test_assert_false( summary_store_has_vector( store , "WOPR:OP1" , 7 ));
+  summary_store_free( store );
+
+  store = summary_store_alloc( "resize/summary" );
+  for (iens = 0; iens < 5; iens++)
+    assert_vector( store , "FOPT" , 1 , iens , 10 );
+  assert_vector( store , "FOPT" , 1 , 7 , 30 );
+  assert_vector( store , "WOPR:OP1" , 2 , 25 , 3 );
+  summary_store_free( store );
+}
+
+
+void * load_job( void * arg ) {
+  arg_pack_type * arg_pack = arg_pack_safe_cast( arg );
+  summary_store_type * store = arg_pack_iget_ptr( arg_pack , 0 );
+  int iens = arg_pack_iget_int( arg_pack , 1 );
+  int key;
+
+  for (key = 0; key < 50; key++) {
+    char * key_string = util_alloc_sprintf("WOPR:W%d" , key);
+    set_vector( store , key_string , key , iens , 100 );
+    free( key_string );
+  }
+  return NULL;
+}
+
+
+void test_threads() {
+  const int ens_size = 32;
+  summary_store_type * store = summary_store_alloc( "threads/summary" );
+  thread_pool_type * tp = thread_pool_alloc( 8 , true );
+  arg_pack_type ** args = util_calloc( ens_size , sizeof * args );
+  int iens , key;
+
+  for (iens = 0; iens < ens_size; iens++) {
+    args[iens] = arg_pack_alloc( );
+    arg_pack_append_ptr( args[iens] , store );
+    arg_pack_append_int( args[iens] , iens );
+    thread_pool_add_job( tp , load_job , args[iens] );
+  }
+  thread_pool_join( tp );
+  summary_store_fsync( store );
+
+  for (key = 0; key < 50; key++) {
+    char * key_string = util_alloc_sprintf("WOPR:W%d" , key);
+    for (iens = 0; iens < ens_size; iens++)
+      assert_vector( store , key_string , key , iens , 100 );
+    free( key_string );
+  }
+
+  for (iens = 0; iens < ens_size; iens++)
+    arg_pack_free( args[iens] );
+  free( args );
+  thread_pool_free( tp );
+  summary_store_free( store );
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("enkf-summary-store");
+  {
+    test_create();
+    test_set_get();
+    test_resize();
+    test_threads();
+  }
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -2,6 +2,10 @@ add_executable( enkf_runpath_list enkf_runpath_list.c )
 target_link_libraries( enkf_runpath_list enkf test_util )
 add_test( enkf_runpath_list  ${EXECUTABLE_OUTPUT_PATH}/enkf_runpath_list ${CMAKE_CURRENT_SOURCE_DIR}/data/config/runpath_list/config )
 
+add_executable( enkf_runpath_file_cache enkf_runpath_file_cache.c )
+target_link_libraries( enkf_runpath_file_cache enkf test_util )
+add_test( enkf_runpath_file_cache  ${EXECUTABLE_OUTPUT_PATH}/enkf_runpath_file_cache )
+
 add_executable( enkf_plot_tvector enkf_plot_tvector.c )
 target_link_libraries( enkf_plot_tvector enkf test_util )
 add_test( enkf_plot_tvector ${EXECUTABLE_OUTPUT_PATH}/enkf_plot_tvector)
@@ -241,6 +245,11 @@ target_link_libraries( enkf_state_map enkf test_util )
 add_test( enkf_state_map  ${EXECUTABLE_OUTPUT_PATH}/enkf_state_map )
 
 
+add_executable( enkf_summary_store enkf_summary_store.c )
+target_link_libraries( enkf_summary_store enkf test_util )
+add_test( enkf_summary_store  ${EXECUTABLE_OUTPUT_PATH}/enkf_summary_store )
+
+
 add_executable( enkf_meas_data enkf_meas_data.c )
 target_link_libraries( enkf_meas_data enkf test_util )
 add_test( enkf_meas_data  ${EXECUTABLE_OUTPUT_PATH}/enkf_meas_data )
@@ -252,3 +261,19 @@ add_test( enkf_ensemble_GEN_PARAM  ${EXECUTABLE_OUTPUT_PATH}/enkf_ensemble_GEN_P
 add_executable( enkf_ensemble enkf_ensemble.c )
 target_link_libraries( enkf_ensemble enkf test_util )
 add_test( enkf_ensemble  ${EXECUTABLE_OUTPUT_PATH}/enkf_ensemble )
+
+add_executable( enkf_obs_measure enkf_obs_measure.c )
+target_link_libraries( enkf_obs_measure enkf test_util )
+add_test( enkf_obs_measure  ${EXECUTABLE_OUTPUT_PATH}/enkf_obs_measure )
+
+add_executable( enkf_main_update_threads enkf_main_update_threads.c )
+target_link_libraries( enkf_main_update_threads enkf test_util )
+add_test( enkf_main_update_threads
+          ${EXECUTABLE_OUTPUT_PATH}/enkf_main_update_threads
+          ${PROJECT_SOURCE_DIR}/test-data/local/snake_oil/snake_oil.ert )
+
+add_executable( enkf_main_create_run_path_threads enkf_main_create_run_path_threads.c )
+target_link_libraries( enkf_main_create_run_path_threads enkf test_util )
+add_test( enkf_main_create_run_path_threads
+          ${EXECUTABLE_OUTPUT_PATH}/enkf_main_create_run_path_threads
+          ${PROJECT_SOURCE_DIR}/test-data/local/snake_oil/snake_oil.ert )
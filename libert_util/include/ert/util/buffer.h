@@ -91,6 +91,9 @@ extern "C" {
   size_t             buffer_stream_fwrite_n( const buffer_type * buffer , size_t offset , ssize_t write_size , FILE * stream );
   void               buffer_stream_fprintf( const buffer_type * buffer , FILE * stream );
   void               buffer_stream_fread( buffer_type * buffer , size_t byte_size , FILE * stream);
+#ifdef ERT_HAVE_UNISTD
+  void               buffer_fd_pread( buffer_type * buffer , size_t byte_size , int fd , long int offset);
+#endif
   buffer_type      * buffer_fread_alloc(const char * filename);
   void               buffer_fread_realloc(buffer_type * buffer , const char * filename);
 
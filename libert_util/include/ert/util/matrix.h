@@ -27,7 +27,7 @@
 #include <ert/util/type_macros.h>
 #include <ert/util/bool_vector.h>
 
-#ifdef HAVE_THREAD_POOL
+#ifdef ERT_HAVE_THREAD_POOL
 #include <ert/util/thread_pool.h>
 #endif
 
@@ -119,7 +119,7 @@ typedef struct matrix_struct matrix_type;
 
   void          matrix_inplace_matmul(matrix_type * A, const matrix_type * B);
   void          matrix_inplace_matmul_mt1(matrix_type * A, const matrix_type * B , int num_threads);
-#ifdef HAVE_THREAD_POOL
+#ifdef ERT_HAVE_THREAD_POOL
   void          matrix_inplace_matmul_mt2(matrix_type * A, const matrix_type * B , thread_pool_type * thread_pool);
 #endif
 
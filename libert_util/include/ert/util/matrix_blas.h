@@ -22,6 +22,9 @@
 
 #include <ert/util/matrix.h>
 
+#ifdef ERT_HAVE_THREAD_POOL
+#include <ert/util/thread_pool.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +39,11 @@ void          matrix_dgemv(const matrix_type * A , const double * x , double * y
 void          matrix_mul_vector(const matrix_type * A , const double * x , double * y);
 void          matrix_gram_set( const matrix_type * X , matrix_type * G, bool col);
 matrix_type * matrix_alloc_gram( const matrix_type * X , bool col);
+void          matrix_inplace_dgemm( matrix_type * A , const matrix_type * B );
+#ifdef ERT_HAVE_THREAD_POOL
+void          matrix_inplace_dgemm_mt( matrix_type * A , const matrix_type * B , thread_pool_type * thread_pool);
+void          matrix_inplace_dgemm_mt1( matrix_type * A , const matrix_type * B , int num_threads);
+#endif
 
 
 #ifdef __cplusplus
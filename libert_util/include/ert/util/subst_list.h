@@ -57,6 +57,7 @@ extern "C" {
   const char            * subst_list_iget_doc_string( const subst_list_type * subst_list , int index);
   bool                    subst_list_has_key( const subst_list_type * subst_list , const char * key);
   char                  * subst_list_alloc_string_representation( const subst_list_type * subst_list );
+  stringlist_type       * subst_list_alloc_used_keys( const subst_list_type * subst_list , const char * text );
   int                     subst_list_add_from_string( subst_list_type * subst_list , const char * arg_string, bool append);
 
   UTIL_IS_INSTANCE_HEADER( subst_list );
@@ -33,6 +33,8 @@ typedef struct template_struct template_type;
 template_type * template_alloc( const char * template_file , bool internalize_template, subst_list_type * parent_subst);
 void            template_free( template_type * template );
 void            template_instantiate( const template_type * template , const char * __target_file , const subst_list_type * arg_list , bool override_symlink);
+char          * template_alloc_target_file( const template_type * template , const char * __target_file , const subst_list_type * arg_list);
+char          * template_alloc_source_text( const template_type * template , const subst_list_type * arg_list);
 void            template_add_arg( template_type * template , const char * key , const char * value );
 
 void            template_clear_args( template_type * template );
@@ -175,6 +175,7 @@ typedef enum {left_pad   = 0,
 
   void         util_usleep( unsigned long micro_seconds );
   void         util_yield();
+  int          util_get_num_cpu( void );
   char       * util_blocking_alloc_stdin_line(unsigned long );
 
   int          util_roundf( float x );
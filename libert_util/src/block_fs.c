@@ -147,8 +147,7 @@ struct block_fs_struct {
   int              block_size;      /* The size of blocks in bytes. */
   int              lock_fd;         /* The file descriptor for the lock_file. Set to -1 if we do not have write access. */
   
-  pthread_mutex_t  io_lock;         /* Lock held during fread of the data file. */
-  pthread_rwlock_t rw_lock;         /* Read-write lock during all access to the fs. */
+  pthread_rwlock_t rw_lock;         /* Read-write lock during all access to the fs; the data is read with pread() so readers run concurrently. */
   
   int              num_free_nodes;   
   hash_type      * index;           /* THE HASH table of all the nodes/files which have been stored. */
@@ -185,6 +184,45 @@ static inline void block_fs_fseek(block_fs_type * block_fs , long offset) {
 }
 
 
+/*
+  The data of the nodes is read and written with pread() / pwrite()
+  on the file descriptor, whereas the node headers are written
+  through the data_stream. The data_stream must therefor be flushed
+  with fflush() before the write lock is released.
+*/
+
+static void block_fs_pread( const block_fs_type * block_fs , long int offset , void * ptr , size_t size) {
+  char * target = ptr;
+  while (size > 0) {
+    ssize_t bytes = pread( block_fs->data_fd , target , size , offset );
+    if (bytes > 0) {
+      target += bytes;
+      offset += bytes;
+      size   -= bytes;
+    } else if ((bytes < 0) && (errno == EINTR))
+      continue;
+    else
+      util_abort("%s: read from %s failed: %s \n",__func__ , block_fs->data_file , bytes < 0 ? strerror( errno ) : "unexpected end of file");
+  }
+}
+
+
+static void block_fs_pwrite( block_fs_type * block_fs , long int offset , const void * ptr , size_t size) {
+  const char * src = ptr;
+  while (size > 0) {
+    ssize_t bytes = pwrite( block_fs->data_fd , src , size , offset );
+    if (bytes > 0) {
+      src    += bytes;
+      offset += bytes;
+      size   -= bytes;
+    } else if ((bytes < 0) && (errno == EINTR))
+      continue;
+    else
+      util_abort("%s: write to %s failed: %s \n",__func__ , block_fs->data_file , strerror( errno ));
+  }
+}
+
+
 /*****************************************************************/
 /* file_node functions */
 
@@ -661,7 +699,6 @@ static block_fs_type * block_fs_alloc_empty( const char * mount_file ,
   
   block_fs->fragmentation_limit = fragmentation_limit;   
   util_alloc_file_components( mount_file , &block_fs->path , &block_fs->base_name, NULL );
-  pthread_mutex_init( &block_fs->io_lock  , NULL);
   pthread_rwlock_init( &block_fs->rw_lock , NULL);
   {
     FILE * stream            = util_fopen( mount_file , "r");
@@ -717,10 +754,6 @@ static void block_fs_fseek_node_end(block_fs_type * block_fs , const file_node_t
   block_fs_fseek( block_fs , file_node->node_offset + file_node->node_size);
 }
 
-static void block_fs_fseek_node_data(block_fs_type * block_fs , const file_node_type * file_node) {
-  block_fs_fseek( block_fs , file_node->node_offset + file_node->data_offset );
-}
-
 
 
 
@@ -916,6 +949,7 @@ static void block_fs_fix_nodes( block_fs_type * block_fs , long_vector_type * of
       }
       util_safe_free( key );
     }
+    fflush( block_fs->data_stream );
     fsync( block_fs->data_fd );
   }
 }
@@ -1200,6 +1234,7 @@ static void block_fs_unlink_file__( block_fs_type * block_fs , const char * file
     fsync( block_fs->data_fd );
     block_fs_fseek(block_fs , node->node_offset);
     file_node_fwrite( node , NULL , block_fs->data_stream );
+    fflush( block_fs->data_stream );
     fsync( block_fs->data_fd );
   }
   block_fs_insert_free_node( block_fs , node );
@@ -1276,7 +1311,7 @@ void block_fs_fsync( block_fs_type * block_fs ) {
    The single lowest-level write function:
    
    3. seek to correct position.
-   4. Write the data with util_fwrite()
+   4. Write the data with pwrite().
 
    7. increase the write_count
    8. set the data_size field of the node.
@@ -1311,13 +1346,14 @@ static void block_fs_fwrite__(block_fs_type * block_fs , const char * filename ,
     
     /* This marks the node section in the datafile as write in progress with: NODE_WRITE_ACTIVE_START ... NODE_WRITE_ACTIVE_END */
     file_node_init_fwrite( node , block_fs->data_stream );                
+    fflush( block_fs->data_stream );
     
     /* Writes the actual data content. */
-    block_fs_fseek_node_data(block_fs , node);
-    util_fwrite( ptr , 1 , data_size , block_fs->data_stream , __func__);
+    block_fs_pwrite( block_fs , node->node_offset + node->data_offset , ptr , data_size );
     
     /* Writes the file node header data, including the NODE_END_TAG. */
     file_node_fwrite( node , filename , block_fs->data_stream );
+    fflush( block_fs->data_stream );
 
     block_fs_update_cache_node( block_fs , node , data_size , ptr);
     block_fs->write_count++;
@@ -1389,8 +1425,9 @@ void block_fs_fwrite_buffer(block_fs_type * block_fs , const char * filename , c
 
 
 /**
-   Need extra locking here - because the global rwlock allows many
-   concurrent readers.
+   No extra locking needed here; pread() does not use the shared file
+   position, so the many concurrent readers allowed by the global
+   rwlock can read at the same time.
 */
 static void block_fs_fread__(block_fs_type * block_fs , const file_node_type * file_node , void * ptr , size_t read_bytes) {
 
@@ -1403,11 +1440,7 @@ static void block_fs_fread__(block_fs_type * block_fs , const file_node_type * f
 #endif
 
   {
-    pthread_mutex_lock( &block_fs->io_lock );
-    block_fs_fseek_node_data( block_fs , file_node );
-    util_fread( ptr , 1 , read_bytes , block_fs->data_stream , __func__);
-    //file_node_verify_end_tag( file_node , block_fs->data_stream );
-    pthread_mutex_unlock( &block_fs->io_lock );
+    block_fs_pread( block_fs , file_node->node_offset + file_node->data_offset , ptr , read_bytes );
   }
 }
 
@@ -1437,11 +1470,7 @@ void block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * file
 #endif
 
       {
-        pthread_mutex_lock( &block_fs->io_lock );
-        block_fs_fseek_node_data(block_fs , node );
-        buffer_stream_fread( buffer , node->data_size , block_fs->data_stream );
-        //file_node_verify_end_tag( node , block_fs->data_stream );
-        pthread_mutex_unlock( &block_fs->io_lock );
+        buffer_fd_pread( buffer , node->data_size , block_fs->data_fd , node->node_offset + node->data_offset );
       }
       
     }
@@ -24,6 +24,9 @@
 #include <time.h>
 
 #include <ert/util/ert_api_config.h>
+#ifdef ERT_HAVE_UNISTD
+#include <unistd.h>
+#endif
 #include <ert/util/ssize_t.h>
 #include <ert/util/util.h>
 #include <ert/util/type_macros.h>
@@ -715,6 +718,41 @@ void buffer_stream_fread( buffer_type * buffer , size_t byte_size , FILE * strea
 }
 
 
+#ifdef ERT_HAVE_UNISTD
+/**
+   Equivalent to buffer_stream_fread(), but the data is read with
+   pread() from position 'offset' in the file descriptor 'fd'. The
+   file position of 'fd' is not used or updated, i.e. several threads
+   can read from the same file descriptor concurrently.
+*/
+
+void buffer_fd_pread( buffer_type * buffer , size_t byte_size , int fd , long int offset) {
+  size_t min_size = byte_size + buffer->pos;
+  char * target;
+  size_t remaining = byte_size;
+
+  if (buffer->alloc_size < min_size)
+    buffer_resize__(buffer , min_size , true);
+
+  target = &buffer->data[buffer->pos];
+  while (remaining > 0) {
+    ssize_t bytes = pread( fd , target , remaining , offset );
+    if (bytes > 0) {
+      target    += bytes;
+      offset    += bytes;
+      remaining -= bytes;
+    } else if ((bytes < 0) && (errno == EINTR))
+      continue;
+    else
+      util_abort("%s: pread() failed: %s \n",__func__ , bytes < 0 ? strerror( errno ) : "unexpected end of file");
+  }
+
+  buffer->content_size += byte_size;
+  buffer->pos          += byte_size;
+}
+#endif
+
+
 
 
 /**
@@ -22,6 +22,11 @@
 #include <ert/util/matrix.h>
 #include <ert/util/matrix_blas.h>
 
+#ifdef ERT_HAVE_THREAD_POOL
+#include <ert/util/arg_pack.h>
+#include <ert/util/thread_pool.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -232,6 +237,143 @@ matrix_type * matrix_alloc_matmul(const matrix_type * A, const matrix_type * B)
 }
 
 
+/*****************************************************************/
+/*
+   In place multiplication A = A*B with a square B, this is the
+   A = A*X of the EnKF update where A can be very tall. dgemm() can not
+   write to one of its input arguments, so A is processed in panels of
+   rows: a panel is copied to a work buffer and dgemm() writes the
+   product straight back into the panel of A.
+
+   The panel height is chosen so the work buffer holds approximately
+   MATRIX_DGEMM_PANEL_SIZE elements; then the work buffer stays in
+   cache between the copy and the dgemm() call, and A is only streamed
+   through memory once.
+*/
+
+#define MATRIX_DGEMM_PANEL_SIZE 65536
+#define MATRIX_DGEMM_MIN_PANEL_ROWS   16
+
+static int matrix_inplace_dgemm_panel_rows( const matrix_type * A ) {
+  int columns = util_int_max( 1 , matrix_get_columns( A ));
+  return util_int_max( MATRIX_DGEMM_MIN_PANEL_ROWS , MATRIX_DGEMM_PANEL_SIZE / columns );
+}
+
+
+static void matrix_inplace_dgemm_rows( matrix_type * A , const matrix_type * B , int row1 , int row2 , double * work , int panel_rows) {
+  const int columns = matrix_get_columns( A );
+  int row;
+
+  for (row = row1; row < row2; row += panel_rows) {
+    int rows = util_int_min( panel_rows , row2 - row );
+    matrix_type * A_panel = matrix_alloc_shared( A , row , 0 , rows , columns );
+    matrix_type * work_panel = matrix_alloc_view( work , rows , columns );
+
+    matrix_assign( work_panel , A_panel );
+    matrix_dgemm( A_panel , work_panel , B , false , false , 1 , 0 );
+
+    matrix_free( work_panel );
+    matrix_free( A_panel );
+  }
+}
+
+
+static void matrix_inplace_dgemm_assert_dims( const matrix_type * A , const matrix_type * B , const char * caller) {
+  if ((matrix_get_columns( A ) != matrix_get_rows( B )) || (matrix_get_rows( B ) != matrix_get_columns( B )))
+    util_abort("%s: size mismatch: A:[%d,%d]   B:[%d,%d]\n",caller , matrix_get_rows(A) , matrix_get_columns(A) , matrix_get_rows(B) , matrix_get_columns(B));
+}
+
+
+/*
+   dgemm() needs the rows of A to be contiguous in memory; if that is
+   not the case the function falls back to matrix_inplace_matmul().
+*/
+
+void matrix_inplace_dgemm( matrix_type * A , const matrix_type * B ) {
+  matrix_inplace_dgemm_assert_dims( A , B , __func__ );
+  if (matrix_get_row_stride( A ) != 1)
+    matrix_inplace_matmul( A , B );
+  else if (matrix_get_rows( A ) > 0) {
+    int panel_rows = util_int_min( matrix_inplace_dgemm_panel_rows( A ) , matrix_get_rows( A ));
+    double * work  = util_calloc( panel_rows * matrix_get_columns( A ) , sizeof * work );
+
+    matrix_inplace_dgemm_rows( A , B , 0 , matrix_get_rows( A ) , work , panel_rows );
+    free( work );
+  }
+}
+
+
+#ifdef ERT_HAVE_THREAD_POOL
+
+static void * matrix_inplace_dgemm_mt__( void * arg ) {
+  arg_pack_type * arg_pack = arg_pack_safe_cast( arg );
+  int row_offset         = arg_pack_iget_int( arg_pack , 0 );
+  int rows               = arg_pack_iget_int( arg_pack , 1 );
+  matrix_type * A        = arg_pack_iget_ptr( arg_pack , 2 );
+  const matrix_type * B  = arg_pack_iget_const_ptr( arg_pack , 3 );
+
+  if (rows > 0) {
+    int panel_rows = util_int_min( matrix_inplace_dgemm_panel_rows( A ) , rows );
+    double * work  = util_calloc( panel_rows * matrix_get_columns( A ) , sizeof * work );
+
+    matrix_inplace_dgemm_rows( A , B , row_offset , row_offset + rows , work , panel_rows );
+    free( work );
+  }
+  return NULL;
+}
+
+
+/*
+   Multithreaded version of matrix_inplace_dgemm(), the rows of A are
+   split in one contiguous block per thread. The thread_pool must be in
+   the same state as for matrix_inplace_matmul_mt2().
+*/
+
+void matrix_inplace_dgemm_mt( matrix_type * A , const matrix_type * B , thread_pool_type * thread_pool) {
+  matrix_inplace_dgemm_assert_dims( A , B , __func__ );
+  if (matrix_get_row_stride( A ) != 1)
+    matrix_inplace_matmul_mt2( A , B , thread_pool );
+  else {
+    int num_threads  = thread_pool_get_max_running( thread_pool );
+    arg_pack_type ** arglist = util_malloc( num_threads * sizeof * arglist );
+    int rows         = matrix_get_rows( A ) / num_threads;
+    int rows_mod     = matrix_get_rows( A ) % num_threads;
+    int row_offset   = 0;
+    int it;
+
+    thread_pool_restart( thread_pool );
+    for (it = 0; it < num_threads; it++) {
+      int row_size = rows;
+      if (it < rows_mod)
+        row_size += 1;
+
+      arglist[it] = arg_pack_alloc();
+      arg_pack_append_int( arglist[it] , row_offset );
+      arg_pack_append_int( arglist[it] , row_size );
+      arg_pack_append_ptr( arglist[it] , A );
+      arg_pack_append_const_ptr( arglist[it] , B );
+
+      thread_pool_add_job( thread_pool , matrix_inplace_dgemm_mt__ , arglist[it] );
+      row_offset += row_size;
+    }
+    thread_pool_join( thread_pool );
+
+    for (it = 0; it < num_threads; it++)
+      arg_pack_free( arglist[it] );
+    free( arglist );
+  }
+}
+
+
+void matrix_inplace_dgemm_mt1( matrix_type * A , const matrix_type * B , int num_threads) {
+  thread_pool_type * thread_pool = thread_pool_alloc( num_threads , false );
+  matrix_inplace_dgemm_mt( A , B , thread_pool );
+  thread_pool_free( thread_pool );
+}
+
+#endif
+
+
 
 
 
@@ -20,6 +20,12 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include "ert/util/build_config.h"
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 #include <ert/util/util.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/subst_func.h>
@@ -46,6 +52,9 @@ struct subst_func_struct {
   int                 argc_min;
   int                 argc_max; 
   void              * arg;           /* 100% unmanaged void argument passed in from the construction. */ 
+#ifdef HAVE_PTHREAD
+  pthread_mutex_t     lock;          /* The functions can have state in arg, e.g. an rng, which is shared between threads. */
+#endif
 };
 
 
@@ -62,7 +71,18 @@ char * subst_func_eval( const subst_func_type * subst_func , const stringlist_ty
     }
   }
   printf("Running:%s \n",subst_func->name);
-  return subst_func->func( args , subst_func->arg );
+  {
+    subst_func_type * mutable_func = (subst_func_type *) subst_func;
+    char * value;
+#ifdef HAVE_PTHREAD
+    pthread_mutex_lock( &mutable_func->lock );
+#endif
+    value = subst_func->func( args , subst_func->arg );
+#ifdef HAVE_PTHREAD
+    pthread_mutex_unlock( &mutable_func->lock );
+#endif
+    return value;
+  }
 }
 
 
@@ -76,11 +96,17 @@ subst_func_type * subst_func_alloc( const char * func_name , const char * doc_st
   subst_func->argc_max   = argc_max;
   subst_func->doc_string = util_alloc_string_copy( doc_string );
   subst_func->arg        = arg; 
+#ifdef HAVE_PTHREAD
+  pthread_mutex_init( &subst_func->lock , NULL );
+#endif
   return subst_func;
 }
 
 
 void subst_func_free( subst_func_type * subst_func ) {
+#ifdef HAVE_PTHREAD
+  pthread_mutex_destroy( &subst_func->lock );
+#endif
   util_safe_free( subst_func->doc_string );
   free( subst_func->name );
   free( subst_func );
@@ -20,6 +20,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "ert/util/build_config.h"
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 #include <ert/util/util.h>
 #include <ert/util/hash.h>
 #include <ert/util/vector.h>
@@ -68,6 +74,13 @@
 
    You will eventually end up with a string where all capital letters have
    been transformed to 'Z'.
+
+   The string substitutions are performed in one pass through the
+   buffer with a matcher which is compiled from all the keys in the
+   subst_list and its parents; the matcher is cached in the subst_list
+   instance and recompiled when the subst_list or one of its parents
+   has been modified. See the documentation of the
+   subst_list_matcher_type below.
 */
 
 
@@ -77,6 +90,8 @@ typedef enum { SUBST_DEEP_COPY   = 1,
 
 #define SUBST_LIST_TYPE_ID 6614320
 
+typedef struct subst_list_matcher_struct subst_list_matcher_type;
+
 struct subst_list_struct {
   UTIL_TYPE_ID_DECLARATION;
   const subst_list_type       * parent;       /* A parent subst_list instance - can be NULL - no destructor is called for the parent. */
@@ -84,6 +99,11 @@ struct subst_list_struct {
   vector_type                 * func_data;    /* The functions we support. */
   const subst_func_pool_type  * func_pool;    /* NOT owned by the subst_list instance - can be NULL */
   hash_type                   * map;
+  int                           version;      /* Incremented every time the string substitutions or the parent is modified. */
+  subst_list_matcher_type     * matcher;      /* Compiled matcher of this instance and all its parents - can be NULL. */
+#ifdef HAVE_PTHREAD
+  pthread_mutex_t               matcher_lock;
+#endif
 };
 
 
@@ -199,6 +219,549 @@ static char * subst_list_func_eval( const subst_list_func_type * subst_func , co
   return subst_func_eval(subst_func->func , arglist );
 }
 
+/*****************************************************************/
+/*
+  The subst_list_matcher_type is an Aho-Corasick automaton built from
+  all the keys of a subst_list instance and its parents, which is
+  used to perform all the string substitutions in one pass through
+  the buffer - instead of one search-replace pass per key.
+
+  The result must be identical to the result of the sequential
+  implementation in subst_list_replace_strings__(), where the keys
+  are replaced one at a time in order, starting with the top most
+  parent. That has two consequences:
+
+    1. A value which contains a key later in the order will have
+       that key replaced - i.e. ("<PATH>" , "/tmp/run/<CASE>")
+       followed by ("<CASE>" , "Test4"). When the matcher is compiled
+       the values are expanded with the keys following them.
+
+    2. A key can match text which is created by a previous
+       substitution, i.e. text which spans the boundary between an
+       inserted value and the surrounding text.
+
+  The single pass is only used when the keys do not overlap, i.e. no
+  key is a substring of another key and no suffix of a key is a prefix
+  of another key; in that case every occurrence of a key in the input
+  is replaced by exactly one key. When a value is inserted it is
+  checked that no key matches across the boundaries of the value (2);
+  if that test fails - or the keys overlap - the buffer is updated
+  with the sequential implementation instead.
+*/
+
+#define SUBST_MATCHER_ROOT 0
+
+typedef struct {
+  int            first_child;
+  int            next_sibling;
+  int            fail;
+  int            key_index;     /* -1 if no key ends in this node. */
+  unsigned char  c;
+} subst_matcher_node_type;
+
+
+struct subst_list_matcher_struct {
+  int                         num_nodes;
+  int                         alloc_size;
+  subst_matcher_node_type   * nodes;
+  int                         root_child[256];
+
+  int                         num_keys;
+  int                         max_key_length;
+  int                       * key_length;
+  int                       * value_length;
+  char                     ** values;         /* The values after the substitutions of point 1 above. */
+  bool                        single_pass;    /* False if the keys overlap. */
+
+  int                         chain_size;
+  const subst_list_type    ** chain;          /* The subst_list instances the matcher has been compiled from ... */
+  int                       * chain_version;  /* ... and their version when it was compiled. */
+};
+
+
+static int subst_list_matcher_get_child( const subst_list_matcher_type * matcher , int node , unsigned char c) {
+  if (node == SUBST_MATCHER_ROOT)
+    return matcher->root_child[c];
+  else {
+    int child = matcher->nodes[node].first_child;
+    while (child >= 0) {
+      if (matcher->nodes[child].c == c)
+        return child;
+      child = matcher->nodes[child].next_sibling;
+    }
+    return -1;
+  }
+}
+
+
+static int subst_list_matcher_add_node( subst_list_matcher_type * matcher , int parent , unsigned char c) {
+  int node = matcher->num_nodes;
+  if (matcher->num_nodes == matcher->alloc_size) {
+    matcher->alloc_size *= 2;
+    matcher->nodes = util_realloc( matcher->nodes , matcher->alloc_size * sizeof * matcher->nodes );
+  }
+
+  matcher->nodes[node].first_child = -1;
+  matcher->nodes[node].fail = SUBST_MATCHER_ROOT;
+  matcher->nodes[node].key_index = -1;
+  matcher->nodes[node].c = c;
+  if (parent == SUBST_MATCHER_ROOT) {
+    matcher->nodes[node].next_sibling = -1;
+    matcher->root_child[c] = node;
+  } else {
+    matcher->nodes[node].next_sibling = matcher->nodes[parent].first_child;
+    matcher->nodes[parent].first_child = node;
+  }
+  matcher->num_nodes++;
+  return node;
+}
+
+
+/*
+  The automaton transition; when there is no child for the character
+  c we follow the failure links towards the root.
+*/
+
+static int subst_list_matcher_next( const subst_list_matcher_type * matcher , int node , unsigned char c) {
+  while (true) {
+    int child = subst_list_matcher_get_child( matcher , node , c );
+    if (child >= 0)
+      return child;
+
+    if (node == SUBST_MATCHER_ROOT)
+      return SUBST_MATCHER_ROOT;
+
+    node = matcher->nodes[node].fail;
+  }
+}
+
+
+/*
+  Will insert the key in the trie and return the key_index, or -1 if
+  the key is already present.
+*/
+
+static int subst_list_matcher_add_key( subst_list_matcher_type * matcher , const char * key ) {
+  int node = SUBST_MATCHER_ROOT;
+  int length = strlen( key );
+  int i;
+
+  for (i = 0; i < length; i++) {
+    int child = subst_list_matcher_get_child( matcher , node , key[i] );
+    if (child < 0)
+      child = subst_list_matcher_add_node( matcher , node , key[i] );
+    node = child;
+  }
+
+  if (matcher->nodes[node].key_index >= 0)
+    return -1;
+
+  matcher->nodes[node].key_index = matcher->num_keys;
+  matcher->key_length[ matcher->num_keys ] = length;
+  matcher->max_key_length = util_int_max( matcher->max_key_length , length );
+  matcher->num_keys++;
+  return matcher->nodes[node].key_index;
+}
+
+
+/*
+  Breadth first traversal of the trie, setting the failure links. The
+  return value is true if the keys do not overlap, i.e. if a node
+  where a key ends has no children, and the failure link of all the
+  nodes with a key is the root, and no other node has a failure link
+  to a node with a key.
+*/
+
+static bool subst_list_matcher_init_fail( subst_list_matcher_type * matcher ) {
+  bool non_overlapping = true;
+  int * queue = util_calloc( matcher->num_nodes , sizeof * queue );
+  int queue_start = 0;
+  int queue_end = 0;
+  int c;
+
+  for (c = 0; c < 256; c++) {
+    if (matcher->root_child[c] >= 0)
+      queue[queue_end++] = matcher->root_child[c];
+  }
+
+  while (queue_start < queue_end) {
+    int node = queue[queue_start++];
+    int child = matcher->nodes[node].first_child;
+
+    while (child >= 0) {
+      int fail = matcher->nodes[node].fail;
+      unsigned char child_c = matcher->nodes[child].c;
+
+      while (true) {
+        int fail_child = subst_list_matcher_get_child( matcher , fail , child_c );
+        if (fail_child >= 0) {
+          matcher->nodes[child].fail = fail_child;
+          break;
+        }
+        if (fail == SUBST_MATCHER_ROOT) {
+          matcher->nodes[child].fail = SUBST_MATCHER_ROOT;
+          break;
+        }
+        fail = matcher->nodes[fail].fail;
+      }
+
+      queue[queue_end++] = child;
+      child = matcher->nodes[child].next_sibling;
+    }
+
+    {
+      const subst_matcher_node_type * node_ptr = &matcher->nodes[node];
+      if (node_ptr->key_index >= 0) {
+        if ((node_ptr->first_child >= 0) || (node_ptr->fail != SUBST_MATCHER_ROOT))
+          non_overlapping = false;
+      } else if (matcher->nodes[ node_ptr->fail ].key_index >= 0)
+        non_overlapping = false;
+    }
+  }
+
+  free( queue );
+  return non_overlapping;
+}
+
+
+/*
+  Checks whether a key matches text spanning the boundaries of a value
+  inserted between the text 'left' and 'right' - observe that 'right'
+  is the input text, i.e. before any substitutions have been applied.
+  Only valid when the keys do not overlap; then every occurrence of a
+  key ends in a node with that key.
+*/
+
+static bool subst_list_matcher_boundary_match( const subst_list_matcher_type * matcher ,
+                                               const char * left , int left_length ,
+                                               const char * value , int value_length ,
+                                               const char * right , int right_length) {
+  int node = SUBST_MATCHER_ROOT;
+  int value_end = left_length + value_length;
+  int total_length = value_end + right_length;
+  int i;
+
+  for (i = 0; i < total_length; i++) {
+    char c;
+    if (i < left_length)
+      c = left[i];
+    else if (i < value_end)
+      c = value[i - left_length];
+    else
+      c = right[i - value_end];
+
+    node = subst_list_matcher_next( matcher , node , c );
+    if (matcher->nodes[node].key_index >= 0) {
+      int end = i + 1;
+      int start = end - matcher->key_length[ matcher->nodes[node].key_index ];
+
+      if ((start < left_length) && (end > left_length))
+        return true;
+
+      if ((start < value_end) && (end > value_end))
+        return true;
+
+      node = SUBST_MATCHER_ROOT;
+    }
+  }
+  return false;
+}
+
+
+static bool subst_list_matcher_has_match( const subst_list_matcher_type * matcher , const char * string) {
+  int node = SUBST_MATCHER_ROOT;
+  while (*string != '\0') {
+    node = subst_list_matcher_next( matcher , node , *string );
+    if (matcher->nodes[node].key_index >= 0)
+      return true;
+    string++;
+  }
+  return false;
+}
+
+
+/*
+  Checks - without knowledge of the surrounding text - whether a key
+  can match text spanning the boundaries of a value which is later
+  expanded with more substitutions (point 1 above). This is only
+  applied to values containing keys.
+*/
+
+static bool subst_list_matcher_value_is_closed( const vector_type * nodes , const char * value ) {
+  int value_length = strlen( value );
+  int index;
+
+  for (index = 0; index < vector_get_size( nodes ); index++) {
+    const subst_list_string_type * node = vector_iget_const( nodes , index );
+    const char * key = node->key;
+    int key_length = strlen( key );
+    int split;
+
+    for (split = 1; split < key_length; split++) {
+      int head_length = split;
+      int tail_length = key_length - split;
+
+      /* The tail of the key matches the start of the value. */
+      if (strncmp( &key[split] , value , util_int_min( tail_length , value_length )) == 0)
+        return false;
+
+      /* The head of the key matches the end of the value. */
+      if (value_length >= head_length) {
+        if (strncmp( key , &value[value_length - head_length] , head_length ) == 0)
+          return false;
+      } else if (strncmp( &key[head_length - value_length] , value , value_length) == 0)
+        return false;
+    }
+  }
+  return true;
+}
+
+
+static void subst_list_matcher_free( subst_list_matcher_type * matcher ) {
+  int key_index;
+  for (key_index = 0; key_index < matcher->num_keys; key_index++)
+    util_safe_free( matcher->values[key_index] );
+
+  free( matcher->values );
+  free( matcher->value_length );
+  free( matcher->key_length );
+  free( matcher->nodes );
+  free( matcher->chain );
+  free( matcher->chain_version );
+  free( matcher );
+}
+
+
+static bool subst_list_replace_key__( buffer_type * buffer , const char * key , const char * value);
+
+static subst_list_matcher_type * subst_list_matcher_alloc( const subst_list_type * subst_list ) {
+  subst_list_matcher_type * matcher = util_malloc( sizeof * matcher );
+  vector_type * nodes = vector_alloc_new( );
+  int * node_key_index;
+  int c;
+
+  matcher->chain_size = 0;
+  {
+    const subst_list_type * list = subst_list;
+    while (list != NULL) {
+      matcher->chain_size++;
+      list = list->parent;
+    }
+  }
+
+  matcher->chain = util_calloc( matcher->chain_size , sizeof * matcher->chain );
+  matcher->chain_version = util_calloc( matcher->chain_size , sizeof * matcher->chain_version );
+  {
+    const subst_list_type * list = subst_list;
+    int chain_index = matcher->chain_size - 1;
+    while (list != NULL) {
+      matcher->chain[chain_index] = list;
+      matcher->chain_version[chain_index] = list->version;
+      chain_index--;
+      list = list->parent;
+    }
+  }
+
+  /* All the substitutions in the order they are applied; the top most parent first. */
+  {
+    int chain_index;
+    for (chain_index = 0; chain_index < matcher->chain_size; chain_index++) {
+      const subst_list_type * list = matcher->chain[chain_index];
+      int index;
+      for (index = 0; index < vector_get_size( list->string_data ); index++) {
+        const subst_list_string_type * node = vector_iget_const( list->string_data , index );
+        if (node->value != NULL)
+          vector_append_ref( nodes , node );
+      }
+    }
+  }
+
+  matcher->num_nodes = 1;
+  matcher->alloc_size = 256;
+  matcher->nodes = util_calloc( matcher->alloc_size , sizeof * matcher->nodes );
+  matcher->nodes[SUBST_MATCHER_ROOT].first_child = -1;
+  matcher->nodes[SUBST_MATCHER_ROOT].next_sibling = -1;
+  matcher->nodes[SUBST_MATCHER_ROOT].fail = SUBST_MATCHER_ROOT;
+  matcher->nodes[SUBST_MATCHER_ROOT].key_index = -1;
+  matcher->nodes[SUBST_MATCHER_ROOT].c = 0;
+  for (c = 0; c < 256; c++)
+    matcher->root_child[c] = -1;
+
+  matcher->num_keys = 0;
+  matcher->max_key_length = 0;
+  matcher->key_length = util_calloc( vector_get_size( nodes ) , sizeof * matcher->key_length );
+  matcher->value_length = util_calloc( vector_get_size( nodes ) , sizeof * matcher->value_length );
+  matcher->values = util_calloc( vector_get_size( nodes ) , sizeof * matcher->values );
+  matcher->single_pass = true;
+  {
+    int index;
+    for (index = 0; index < vector_get_size( nodes ); index++)
+      matcher->values[index] = NULL;
+  }
+
+  /*
+    If the same key is present several times - typically both in the
+    parent and the child - only the first is matched in the input, the
+    later ones can only match text in the expanded values.
+  */
+  node_key_index = util_calloc( vector_get_size( nodes ) , sizeof * node_key_index );
+  {
+    int index;
+    for (index = 0; index < vector_get_size( nodes ); index++) {
+      const subst_list_string_type * node = vector_iget_const( nodes , index );
+      if (strlen( node->key ) == 0)
+        matcher->single_pass = false;
+      else
+        node_key_index[index] = subst_list_matcher_add_key( matcher , node->key );
+    }
+  }
+
+  if (matcher->single_pass)
+    matcher->single_pass = subst_list_matcher_init_fail( matcher );
+
+  if (matcher->single_pass) {
+    int index;
+    for (index = 0; index < vector_get_size( nodes ); index++) {
+      const subst_list_string_type * node = vector_iget_const( nodes , index );
+      int key_index = node_key_index[index];
+
+      if (key_index >= 0) {
+        if (subst_list_matcher_has_match( matcher , node->value )) {
+          buffer_type * buffer = buffer_alloc( strlen( node->value ) + 1 );
+          int next_index;
+
+          buffer_fwrite( buffer , node->value , 1 , strlen( node->value ) + 1 );
+          for (next_index = index + 1; next_index < vector_get_size( nodes ); next_index++) {
+            const subst_list_string_type * next_node = vector_iget_const( nodes , next_index );
+            if (strstr( buffer_get_data( buffer ) , next_node->key ) != NULL) {
+              if (!subst_list_matcher_value_is_closed( nodes , buffer_get_data( buffer )))
+                matcher->single_pass = false;
+              subst_list_replace_key__( buffer , next_node->key , next_node->value );
+            }
+          }
+          matcher->values[key_index] = util_alloc_string_copy( buffer_get_data( buffer ));
+          buffer_free( buffer );
+        } else
+          matcher->values[key_index] = util_alloc_string_copy( node->value );
+
+        matcher->value_length[key_index] = strlen( matcher->values[key_index] );
+      }
+    }
+  }
+
+  free( node_key_index );
+  vector_free( nodes );
+  return matcher;
+}
+
+
+static bool subst_list_matcher_is_valid( const subst_list_matcher_type * matcher , const subst_list_type * subst_list ) {
+  const subst_list_type * list = subst_list;
+  int chain_index = matcher->chain_size - 1;
+
+  while (list != NULL) {
+    if (chain_index < 0)
+      return false;
+
+    if ((matcher->chain[chain_index] != list) || (matcher->chain_version[chain_index] != list->version))
+      return false;
+
+    chain_index--;
+    list = list->parent;
+  }
+  return (chain_index < 0);
+}
+
+
+/*
+  Performs all the string substitutions in one pass. The return value
+  is false if the single pass could not be used, in that case the
+  buffer has not been modified and the sequential implementation must
+  be used instead.
+*/
+
+static bool subst_list_matcher_replace( const subst_list_matcher_type * matcher , buffer_type * buffer , bool * match) {
+  const char * data = buffer_get_data( buffer );
+  size_t data_size = buffer_get_size( buffer );
+  size_t string_length = strlen( data );
+  buffer_type * target = buffer_alloc( data_size + 1 );
+  bool single_pass = matcher->single_pass;
+  size_t copy_start = 0;
+  size_t pos = 0;
+  int node = SUBST_MATCHER_ROOT;
+
+  *match = false;
+  while (single_pass && (pos < string_length)) {
+    node = subst_list_matcher_next( matcher , node , data[pos] );
+    pos++;
+
+    if (matcher->nodes[node].key_index >= 0) {
+      int key_index = matcher->nodes[node].key_index;
+      size_t key_start = pos - matcher->key_length[key_index];
+      size_t left_length;
+      size_t right_length = util_size_t_min( matcher->max_key_length - 1 , string_length - pos );
+
+      buffer_fwrite( target , &data[copy_start] , 1 , key_start - copy_start );
+      left_length = util_size_t_min( matcher->max_key_length - 1 , buffer_get_size( target ));
+
+      if (subst_list_matcher_boundary_match( matcher ,
+                                             buffer_iget_data( target , buffer_get_size( target ) - left_length ) , left_length ,
+                                             matcher->values[key_index] , matcher->value_length[key_index] ,
+                                             &data[pos] , right_length))
+        single_pass = false;
+      else {
+        buffer_fwrite( target , matcher->values[key_index] , 1 , matcher->value_length[key_index] );
+        copy_start = pos;
+        node = SUBST_MATCHER_ROOT;
+        *match = true;
+      }
+    }
+  }
+
+  if (single_pass && *match) {
+    /* The remaining data - including the terminating \0 - is copied unchanged. */
+    buffer_fwrite( target , &data[copy_start] , 1 , data_size - copy_start );
+    buffer_clear( buffer );
+    buffer_fwrite( buffer , buffer_get_data( target ) , 1 , buffer_get_size( target ));
+  }
+  buffer_free( target );
+
+  if (!single_pass)
+    *match = false;
+  return single_pass;
+}
+
+
+/*
+  Will return the matcher of this instance, compiling a new matcher if
+  this instance or one of its parents has been modified.
+*/
+
+static const subst_list_matcher_type * subst_list_get_matcher( const subst_list_type * subst_list ) {
+  subst_list_type * mutable_list = (subst_list_type *) subst_list;
+  const subst_list_matcher_type * matcher;
+
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock( &mutable_list->matcher_lock );
+#endif
+
+  if (mutable_list->matcher != NULL && !subst_list_matcher_is_valid( mutable_list->matcher , subst_list )) {
+    subst_list_matcher_free( mutable_list->matcher );
+    mutable_list->matcher = NULL;
+  }
+
+  if (mutable_list->matcher == NULL)
+    mutable_list->matcher = subst_list_matcher_alloc( subst_list );
+  matcher = mutable_list->matcher;
+
+#ifdef HAVE_PTHREAD
+  pthread_mutex_unlock( &mutable_list->matcher_lock );
+#endif
+
+  return matcher;
+}
+
+
 /*****************************************************************/
 
 /**
@@ -251,6 +814,7 @@ UTIL_IS_INSTANCE_FUNCTION( subst_list , SUBST_LIST_TYPE_ID )
 
 void subst_list_set_parent( subst_list_type * subst_list , const subst_list_type * parent) {
   subst_list->parent = parent;
+  subst_list->version++;
   if (parent != NULL)
     subst_list->func_pool = subst_list->parent->func_pool;
 }
@@ -287,6 +851,11 @@ subst_list_type * subst_list_alloc(const void * input_arg) {
   subst_list->map              = hash_alloc();
   subst_list->string_data      = vector_alloc_new();
   subst_list->func_data        = vector_alloc_new();
+  subst_list->version          = 0;
+  subst_list->matcher          = NULL;
+#ifdef HAVE_PTHREAD
+  pthread_mutex_init( &subst_list->matcher_lock , NULL );
+#endif
 
   if (input_arg != NULL) {
     if (subst_list_is_instance( input_arg ))
@@ -322,6 +891,7 @@ static void subst_list_insert__(subst_list_type * subst_list , const char * key
   if (node == NULL) /* Did not have the node. */
     node = subst_list_insert_new_node(subst_list , key ,append);
   subst_list_string_set_value(node , value , doc_string , insert_mode);
+  subst_list->version++;
 }
 
 
@@ -392,10 +962,16 @@ void subst_list_insert_func(subst_list_type * subst_list , const char * func_nam
 
 void subst_list_clear( subst_list_type * subst_list ) {
   vector_clear( subst_list->string_data );
+  subst_list->version++;
 }
 
 
 void subst_list_free(subst_list_type * subst_list) {
+  if (subst_list->matcher != NULL)
+    subst_list_matcher_free( subst_list->matcher );
+#ifdef HAVE_PTHREAD
+  pthread_mutex_destroy( &subst_list->matcher_lock );
+#endif
   vector_free( subst_list->string_data );
   vector_free( subst_list->func_data );
   hash_free( subst_list->map );
@@ -429,19 +1005,27 @@ void subst_list_free(subst_list_type * subst_list) {
    subst_list. This is the lowest level function, which does *NOT*
    consider the parent pointer.
 */
+static bool subst_list_replace_key__( buffer_type * buffer , const char * key , const char * value) {
+  bool global_match = false;
+  bool match;
+  buffer_rewind( buffer );
+  do {
+    match = buffer_search_replace( buffer , key , value);
+    if (match)
+      global_match = true;
+  } while (match);
+  return global_match;
+}
+
+
 static bool subst_list_replace_strings__(const subst_list_type * subst_list , buffer_type * buffer) {
   int index;
   bool global_match = false;
   for (index = 0; index < vector_get_size( subst_list->string_data ); index++) {
     const subst_list_string_type * node = vector_iget_const( subst_list->string_data , index );
     if (node->value != NULL) {
-      bool match;
-      buffer_rewind( buffer );
-      do {
-        match = buffer_search_replace( buffer , node->key , node->value);
-        if (match)
-          global_match = true;
-      } while (match);
+      if (subst_list_replace_key__( buffer , node->key , node->value ))
+        global_match = true;
     }
   }
   return global_match;
@@ -589,15 +1173,16 @@ static bool subst_list_eval_funcs__(const subst_list_type * subst_list , buffer_
 
 
    Currently the implementation is purely top down, the latter case
-   above is not supported. The actual implementation here is in terms
-   of recursion, the low level function doing the stuff is
-   subst_list_replace_strings__() which is not recursive.
+   above is not supported. The sequential implementation here is in
+   terms of recursion, the low level function doing the stuff is
+   subst_list_replace_strings__() which is not recursive. The single
+   pass with the compiled matcher gives the same result.
 */
 
-static bool subst_list_replace_strings( const subst_list_type * subst_list , buffer_type * buffer ) {
+static bool subst_list_replace_strings_sequential( const subst_list_type * subst_list , buffer_type * buffer ) {
   bool match = false;
   if (subst_list->parent != NULL)
-    match = subst_list_replace_strings( subst_list->parent , buffer );
+    match = subst_list_replace_strings_sequential( subst_list->parent , buffer );
 
   /* The actual string replace */
   match = (subst_list_replace_strings__( subst_list , buffer ) || match);
@@ -605,6 +1190,17 @@ static bool subst_list_replace_strings( const subst_list_type * subst_list , buf
 }
 
 
+static bool subst_list_replace_strings( const subst_list_type * subst_list , buffer_type * buffer ) {
+  const subst_list_matcher_type * matcher = subst_list_get_matcher( subst_list );
+  bool match;
+
+  if (!subst_list_matcher_replace( matcher , buffer , &match ))
+    match = subst_list_replace_strings_sequential( subst_list , buffer );
+
+  return match;
+}
+
+
 /*
   This function updates a buffer instance inplace with all the
   substitutions in the subst_list.
@@ -848,6 +1444,101 @@ void subst_list_fprintf(const subst_list_type * subst_list , FILE * stream) {
 
 
 
+static bool subst_list_has_func_match( const subst_list_type * subst_list , const char * text ) {
+  const subst_list_type * list = subst_list;
+  while (list != NULL) {
+    int index;
+    for (index = 0; index < vector_get_size( list->func_data ); index++) {
+      const subst_list_func_type * subst_func = vector_iget_const( list->func_data , index );
+      if (strstr( text , subst_func->name ) != NULL)
+        return true;
+    }
+    list = list->parent;
+  }
+  return false;
+}
+
+
+static void subst_list_append_string_nodes( const subst_list_type * subst_list , vector_type * nodes ) {
+  int index;
+  if (subst_list->parent != NULL)
+    subst_list_append_string_nodes( subst_list->parent , nodes );
+
+  for (index = 0; index < vector_get_size( subst_list->string_data ); index++)
+    vector_append_ref( nodes , vector_iget_const( subst_list->string_data , index ));
+}
+
+
+/**
+   Will return the keys, from this subst_list and all its parents,
+   whose values can influence the result of filtering @text; i.e. the
+   keys which occur in @text and recursively the keys which occur in
+   the values of those keys. The keys are returned in the order they
+   are found in the list, starting with the parent.
+
+   If @text, or one of the values involved, contains the name of one
+   of the functions the result can not be determined from the values
+   alone and NULL is returned.
+*/
+
+stringlist_type * subst_list_alloc_used_keys( const subst_list_type * subst_list , const char * text ) {
+  vector_type * nodes = vector_alloc_new();
+  stringlist_type * used_keys = NULL;
+
+  subst_list_append_string_nodes( subst_list , nodes );
+  if (!subst_list_has_func_match( subst_list , text )) {
+    int num_nodes = vector_get_size( nodes );
+    bool * used = util_calloc( util_int_max( 1 , num_nodes ) , sizeof * used );
+    bool func_match = false;
+    bool complete = false;
+    int index;
+
+    for (index = 0; index < num_nodes; index++) {
+      const subst_list_string_type * node = vector_iget_const( nodes , index );
+      used[index] = (node->value != NULL) && (strstr( text , node->key ) != NULL);
+    }
+
+    while (!complete && !func_match) {
+      complete = true;
+      for (index = 0; index < num_nodes; index++) {
+        const subst_list_string_type * node = vector_iget_const( nodes , index );
+        if (!used[index] && node->value != NULL) {
+          int used_index;
+          for (used_index = 0; used_index < num_nodes; used_index++) {
+            const subst_list_string_type * used_node = vector_iget_const( nodes , used_index );
+            if (used[used_index] && strstr( used_node->value , node->key ) != NULL) {
+              used[index] = true;
+              complete = false;
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    for (index = 0; index < num_nodes; index++) {
+      const subst_list_string_type * node = vector_iget_const( nodes , index );
+      if (used[index] && subst_list_has_func_match( subst_list , node->value ))
+        func_match = true;
+    }
+
+    if (!func_match) {
+      used_keys = stringlist_alloc_new();
+      for (index = 0; index < num_nodes; index++) {
+        const subst_list_string_type * node = vector_iget_const( nodes , index );
+        if (used[index] && !stringlist_contains( used_keys , node->key ))
+          stringlist_append_copy( used_keys , node->key );
+      }
+    }
+    free( used );
+  }
+
+  vector_free( nodes );
+  return used_keys;
+}
+
+
+
 
 
 
@@ -181,13 +181,55 @@ void template_free( template_type * template ) {
    
 
 
-void template_instantiate( const template_type * template , const char * __target_file , const subst_list_type * arg_list , bool override_symlink) {
+/**
+   Will return the name of the file which is created when the template
+   is instantiated with target file @__target_file, i.e. with all the
+   substitutions performed.
+*/
+
+char * template_alloc_target_file( const template_type * template , const char * __target_file , const subst_list_type * arg_list) {
   char * target_file = util_alloc_string_copy( __target_file );
 
-  /* Finding the name of the target file. */
   subst_list_update_string( template->arg_list , &target_file);
   if (arg_list != NULL) subst_list_update_string( arg_list , &target_file );
 
+  return target_file;
+}
+
+
+/**
+   Will return the text which is filtered with @arg_list when the
+   template is instantiated, i.e. the name of the template file
+   followed by the content of the template, both with the internal
+   substitutions performed. The result of template_instantiate() is
+   determined by this text and the values in @arg_list.
+*/
+
+char * template_alloc_source_text( const template_type * template , const subst_list_type * arg_list) {
+  char * template_file = util_alloc_string_copy( template->template_file );
+  char * char_buffer;
+  char * source_text;
+
+  if (template->internalize_template)
+    char_buffer = util_alloc_string_copy( template->template_buffer);
+  else
+    char_buffer = template_load( template , arg_list );
+
+  subst_list_update_string( template->arg_list , &template_file);
+  subst_list_update_string( template->arg_list , &char_buffer );
+  source_text = util_alloc_sprintf( "%s\n%s" , template_file , char_buffer );
+
+  free( char_buffer );
+  free( template_file );
+  return source_text;
+}
+
+
+
+void template_instantiate( const template_type * template , const char * __target_file , const subst_list_type * arg_list , bool override_symlink) {
+  /* Finding the name of the target file. */
+  char * target_file = template_alloc_target_file( template , __target_file , arg_list );
+
   {
     char * char_buffer;
     /* Loading the template - possibly expanding keys in the filename */
@@ -23,6 +23,8 @@
 #include <signal.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <errno.h>
+#include <time.h>
 
 #include "ert/util/build_config.h"
 
@@ -32,15 +34,24 @@
 
 
 /**
-   This file implements a small thread_pool object based on
-   pthread_create() function calls. The characetristics of this
+   This file implements a small thread_pool object based on a fixed
+   set of long lived worker threads. The characetristics of this
    implementation is as follows:
 
-    1. The jobs are mangaged by a separate thread - dispatch_thread.
-    2. The new jobs are just appended to the queue, the
-       dispatch_thread sees them in the queue and dispatches them.
-    3. The dispatch thread manages a list of thread_pool_job_slot_type
-       instances - one slot for each actually running job.
+    1. The worker threads - max_running of them - are created when the
+       pool is allocated, and live until the pool is freed; i.e. there
+       is no pthread_create() call per job.
+
+    2. Each worker has a deque of jobs. Jobs added by the calling
+       scope are distributed round robin to the workers, jobs added
+       from a job running in the pool are added to the deque of the
+       current worker. A worker takes the oldest job from its own
+       deque, when that is empty it will steal the newest job from
+       the deque of another worker.
+
+    3. Workers with nothing to do wait on a condition variable, and
+       thread_pool_join() waits on a condition variable until all the
+       jobs have completed - there is no polling.
 
    Example
    -------
@@ -90,6 +101,10 @@
 
   6. When you are really finished: thread_pool_free( tp );
 
+
+   For loops there is the convenience function thread_pool_parallel_for()
+   which will split an index range in chunks, run the chunks in the
+   pool and wait for them to complete.
 */
 
 
@@ -100,9 +115,6 @@ typedef void * (start_func_ftype) (void *) ;
    Internal struct which is used as queue node.
 */
 typedef struct {
-  thread_pool_type * pool;                /* A back-reference to the thread_pool holding the queue. */
-  int                slot_index;          /* The index in the space [0,max_running) of the job slot where this job is running. */
-  int                queue_index;         /* The index of the current tp_arg in the queue. */
   void             * func_arg;            /* The arguments to this job - supplied by the calling scope. */
   start_func_ftype * func;                /* The function to call - supplied by the calling scope. */
   void             * return_value;
@@ -111,13 +123,25 @@ typedef struct {
 
 
 /**
-   Internal struct used to keep track of the job slots.
+   The deque of one worker; the elements are indices into the queue of
+   the pool. The owner takes jobs from the head, thieves from the
+   tail.
 */
 typedef struct {
-  pthread_t  thread;                /* The thread variable currently (or more correct:last) running. */
-  int        run_count;             /* The number of times this slot has been used - just to check whether the slot has been used AT ALL when/if joining. */
-  bool       running;               /* Is the job_slot running now?? */
-} thread_pool_job_slot_type;
+  pthread_mutex_t   lock;
+  int             * jobs;
+  int               alloc_size;
+  int               head;                 /* Position of the oldest job in the ring buffer. */
+  int               size;
+} thread_pool_deque_type;
+
+
+typedef struct {
+  thread_pool_type       * pool;
+  int                      worker_index;
+  pthread_t                thread;
+  thread_pool_deque_type   deque;
+} thread_pool_worker_type;
 
 
 
@@ -126,53 +150,107 @@ typedef struct {
 struct thread_pool_struct {
   UTIL_TYPE_ID_DECLARATION;
   thread_pool_arg_type      * queue;              /* The jobs to be executed are appended in this vector. */
-  int                         queue_index;        /* The index of the next job to run. */
-  int                         queue_size;         /* The number of jobs in the queue - including those which are complete. [Should be protected / atomic / ... ] */
+  int                         queue_size;         /* The number of jobs in the queue - including those which are complete. */
   int                         queue_alloc_size;   /* The allocated size of the queue. */
-
-  int                         max_running;        /* The max number of concurrently running jobs. */
-  bool                        join;               /* Flag set by the main thread to inform the dispatch thread that joining should start. */
-  bool                        accepting_jobs;     /* True|False whether the dispatch thread is running. */
-
-  thread_pool_job_slot_type * job_slots;          /* A vector to @max_running job slots, each slot can be reused several times.*/
-  pthread_t                   dispatch_thread;
+  int                         complete_count;     /* The number of jobs which have completed. */
+  int                         pending_count;      /* The number of jobs waiting in the deques. */
+  int                         next_worker;        /* The worker which will get the next job from the calling scope. */
+
+  int                         max_running;        /* The max number of concurrently running jobs - i.e. the number of workers. */
+  bool                        join;               /* Flag set by the main thread when joining has started. */
+  bool                        accepting_jobs;     /* True|False whether the pool has been (re)started and not yet joined. */
+  bool                        shutdown;           /* Set by thread_pool_free() to stop the workers. */
+
+  thread_pool_worker_type   * workers;
+  pthread_key_t               worker_key;         /* Thread specific pointer to the current worker - NULL in other threads. */
+  pthread_mutex_t             lock;               /* Protects the counters above. */
+  pthread_cond_t              work_cond;          /* Signaled when a job has been added. */
+  pthread_cond_t              complete_cond;      /* Signaled when all jobs have completed. */
   pthread_rwlock_t            queue_lock;
 };
 
 
-static UTIL_SAFE_CAST_FUNCTION( thread_pool , THREAD_POOL_TYPE_ID )
+/*****************************************************************/
+
+static void thread_pool_deque_init( thread_pool_deque_type * deque ) {
+  pthread_mutex_init( &deque->lock , NULL );
+  deque->alloc_size = 32;
+  deque->jobs = util_calloc( deque->alloc_size , sizeof * deque->jobs );
+  deque->head = 0;
+  deque->size = 0;
+}
 
 
-/**
-   This function will grow the queue. It is called by the main thread
-   (i.e. the context of the calling scope), and the queue is read by
-   the dispatch_thread - i.e. access to the queue must be protected by
-   rwlock.
-*/
+static void thread_pool_deque_free_content( thread_pool_deque_type * deque ) {
+  pthread_mutex_destroy( &deque->lock );
+  free( deque->jobs );
+}
 
-static void thread_pool_resize_queue( thread_pool_type * pool, int queue_length ) {
-  pthread_rwlock_wrlock( &pool->queue_lock );
+
+static void thread_pool_deque_push( thread_pool_deque_type * deque , int queue_index) {
+  pthread_mutex_lock( &deque->lock );
   {
-    pool->queue            = util_realloc( pool->queue , queue_length * sizeof * pool->queue );
-    pool->queue_alloc_size = queue_length;
+    if (deque->size == deque->alloc_size) {
+      int new_alloc_size = 2 * deque->alloc_size;
+      int * new_jobs = util_calloc( new_alloc_size , sizeof * new_jobs );
+      int i;
+
+      for (i = 0; i < deque->size; i++)
+        new_jobs[i] = deque->jobs[ (deque->head + i) % deque->alloc_size ];
+
+      free( deque->jobs );
+      deque->jobs = new_jobs;
+      deque->alloc_size = new_alloc_size;
+      deque->head = 0;
+    }
+
+    deque->jobs[ (deque->head + deque->size) % deque->alloc_size ] = queue_index;
+    deque->size++;
   }
-  pthread_rwlock_unlock( &pool->queue_lock );
+  pthread_mutex_unlock( &deque->lock );
 }
 
 
+/* Used by the owner of the deque: takes the oldest job. */
+static int thread_pool_deque_pop_head( thread_pool_deque_type * deque ) {
+  int queue_index = -1;
+  pthread_mutex_lock( &deque->lock );
+  if (deque->size > 0) {
+    queue_index = deque->jobs[ deque->head ];
+    deque->head = (deque->head + 1) % deque->alloc_size;
+    deque->size--;
+  }
+  pthread_mutex_unlock( &deque->lock );
+  return queue_index;
+}
+
+
+/* Used by the other workers: takes the newest job. */
+static int thread_pool_deque_pop_tail( thread_pool_deque_type * deque ) {
+  int queue_index = -1;
+  pthread_mutex_lock( &deque->lock );
+  if (deque->size > 0) {
+    deque->size--;
+    queue_index = deque->jobs[ (deque->head + deque->size) % deque->alloc_size ];
+  }
+  pthread_mutex_unlock( &deque->lock );
+  return queue_index;
+}
+
+/*****************************************************************/
+
+
 /**
-   This function updates an element in the queue, the function is
-   called by the executing threads, on the same time the main thread
-   might be resizing the thread, we therefor take a read lock during
-   execution of this function. (Write lock is not necessary because we
-   will not change the queue pointer itself, only something it points
-   to.)
+   This function will grow the queue. It is called with the pool lock
+   held, and the queue is read by the worker threads - i.e. access to
+   the queue must be protected by rwlock.
 */
 
-static void thread_pool_iset_return_value( thread_pool_type * pool , int index , void * return_value) {
-  pthread_rwlock_rdlock( &pool->queue_lock );
+static void thread_pool_resize_queue( thread_pool_type * pool, int queue_length ) {
+  pthread_rwlock_wrlock( &pool->queue_lock );
   {
-    pool->queue[ index ].return_value = return_value;
+    pool->queue            = util_realloc( pool->queue , queue_length * sizeof * pool->queue );
+    pool->queue_alloc_size = queue_length;
   }
   pthread_rwlock_unlock( &pool->queue_lock );
 }
@@ -184,121 +262,96 @@ void * thread_pool_iget_return_value( const thread_pool_type * pool , int queue_
 
 
 /**
-   The pthread_create() call which this is all about, does not start
-   the user supplied function. Instead it will start an instance of
-   this function, which will do some housekeeping before calling the
-   user supplied function.
+   Will find a job for the worker; first from the deque of the worker
+   itself and then by stealing from the others. Returns -1 if there
+   are no jobs in any of the deques.
 */
 
-static void * thread_pool_start_job( void * arg ) {
-  thread_pool_arg_type * tp_arg = (thread_pool_arg_type * ) arg;
-  thread_pool_type * tp         =  tp_arg->pool;
-  int slot_index                =  tp_arg->slot_index;
-  void * func_arg               =  tp_arg->func_arg;
-  start_func_ftype * func       =  tp_arg->func;
-  void * return_value;
+static int thread_pool_worker_get_job( thread_pool_worker_type * worker ) {
+  thread_pool_type * pool = worker->pool;
+  int queue_index = thread_pool_deque_pop_head( &worker->deque );
 
+  if (queue_index < 0) {
+    int offset;
+    for (offset = 1; offset < pool->max_running; offset++) {
+      thread_pool_worker_type * victim = &pool->workers[ (worker->worker_index + offset) % pool->max_running ];
+      queue_index = thread_pool_deque_pop_tail( &victim->deque );
+      if (queue_index >= 0)
+        break;
+    }
+  }
+
+  return queue_index;
+}
 
-  return_value = func( func_arg );                  /* Starting the real external function */
-  tp->job_slots[ slot_index ].running = false;      /* We mark the job as completed. */
-  free( arg );
 
-  if (return_value != NULL)
-    thread_pool_iset_return_value( tp , tp_arg->queue_index , return_value);
+static void thread_pool_run_job( thread_pool_type * pool , int queue_index ) {
+  thread_pool_arg_type job;
 
-  return NULL;
+  /*
+     The queue might be resized by the calling scope - we must take a
+     copy of the node we are interested in.
+  */
+  pthread_rwlock_rdlock( &pool->queue_lock );
+  job = pool->queue[ queue_index ];
+  pthread_rwlock_unlock( &pool->queue_lock );
+
+  job.return_value = job.func( job.func_arg );     /* Starting the real external function */
+
+  if (job.return_value != NULL) {
+    pthread_rwlock_rdlock( &pool->queue_lock );
+    pool->queue[ queue_index ].return_value = job.return_value;
+    pthread_rwlock_unlock( &pool->queue_lock );
+  }
+
+  pthread_mutex_lock( &pool->lock );
+  {
+    pool->complete_count++;
+    if (pool->complete_count == pool->queue_size)
+      pthread_cond_broadcast( &pool->complete_cond );
+  }
+  pthread_mutex_unlock( &pool->lock );
 }
 
 
 
 /**
-   This function is run by the dispatch_thread. The thread will keep
-   an eye on the queue, and dispatch new jobs when there are free
-   slots available.
+   This function is run by the worker threads. The worker will run
+   jobs as long as it can find them, and then wait until more jobs
+   are added - or the pool is freed.
 */
 
-static void * thread_pool_main_loop( void * arg ) {
-  thread_pool_type * tp = thread_pool_safe_cast( arg );
-  {
-    const int usleep_init = 1000;  /* The sleep time when there are free slots available - but no jobs wanting to run. */
-    int internal_offset   = 0;     /* Keep track of the (index of) the last job slot fired off - minor time saving. */
-    while (true) {
-      if (tp->queue_size > tp->queue_index) {
-        /*
-           There are jobs in the queue which would like to run -
-           let us see if we can find a slot for them.
-        */
-        int counter     = 0;
-        bool slot_found = false;
-        do {
-          int slot_index = (counter + internal_offset) % tp->max_running;
-          thread_pool_job_slot_type * job_slot = &tp->job_slots[ slot_index ];
-          if (!job_slot->running) {
-            /* OK thread[slot_index] is ready to take this job.*/
-            thread_pool_arg_type * tp_arg;
-
-            /*
-               The queue might be updated by the main thread - we must
-               take a copy of the node we are interested in.
-            */
-            pthread_rwlock_rdlock( &tp->queue_lock );
-            tp_arg = util_alloc_copy( &tp->queue[ tp->queue_index ] , sizeof * tp_arg );
-            pthread_rwlock_unlock( &tp->queue_lock );
-
-            tp_arg->slot_index = slot_index;
-            job_slot->running = true;
-            /*
-               Here is the actual pthread_create() call creating an
-               additional running thread.
-            */
-
-            /*Cleanup of previous run threads. Needed to avoid memory leak*/
-            if (job_slot->run_count > 0)
-              pthread_join(job_slot->thread, NULL);
-
-            pthread_create( &job_slot->thread , NULL , thread_pool_start_job , tp_arg );
-            job_slot->run_count += 1;
-            tp->queue_index++;
-            internal_offset += (counter + 1);
-            slot_found = true;
-          } else
-            counter++;
-        } while (!slot_found && (counter < tp->max_running));
-
-        if (!slot_found) {
-            util_yield();
-        }
-      } else
-        util_usleep(usleep_init);    /* There are no jobs wanting to run. */
-
-      /*****************************************************************/
-      /*
-        We exit explicitly from this loop when both conditions apply:
+static void * thread_pool_worker_main( void * arg ) {
+  thread_pool_worker_type * worker = (thread_pool_worker_type *) arg;
+  thread_pool_type * pool = worker->pool;
 
-         1. tp->join       == true              :  The calling scope has signaled that it will not submit more jobs.
-         2. tp->queue_size == tp->queue_index   :  This function has submitted all the jobs in the queue.
-      */
-      if ((tp->join) && (tp->queue_size == tp->queue_index))
-        break;
-    } /* End of while() loop */
-  }
+  pthread_setspecific( pool->worker_key , worker );
+  while (true) {
+    int queue_index = thread_pool_worker_get_job( worker );
 
-  /*
-     There are no more jobs in the queue, and the main scope has
-     signaled that join should start. Observe that we join only the
-     jobs corresponding to explicitly running job_slots; when a job
-     slot is used multiple times the first jobs run in the job_slot
-     will not be explicitly joined.
-  */
-  {
-    int i;
-    for (i=0; i < tp->max_running; i++) {
-      thread_pool_job_slot_type job_slot = tp->job_slots[i];
-      if (job_slot.run_count > 0)
-        pthread_join( job_slot.thread , NULL );
+    if (queue_index >= 0) {
+      pthread_mutex_lock( &pool->lock );
+      pool->pending_count--;
+      pthread_mutex_unlock( &pool->lock );
+
+      thread_pool_run_job( pool , queue_index );
+    } else {
+      bool exit_loop = false;
+
+      pthread_mutex_lock( &pool->lock );
+      {
+        while (!pool->shutdown && (pool->pending_count == 0))
+          pthread_cond_wait( &pool->work_cond , &pool->lock );
+
+        if (pool->shutdown && (pool->pending_count == 0))
+          exit_loop = true;
+      }
+      pthread_mutex_unlock( &pool->lock );
+
+      if (exit_loop)
+        break;
     }
   }
-  /* When we are here all the jobs have completed. */
   return NULL;
 }
 
@@ -306,9 +359,9 @@ static void * thread_pool_main_loop( void * arg ) {
 
 
 /**
-   This function initializes a couple of counters, and starts up the
-   dispatch thread. If the thread_pool should be reused after a join,
-   this function must be called before adding new jobs.
+   This function resets the counters of the pool. If the thread_pool
+   should be reused after a join, this function must be called before
+   adding new jobs.
 
    The functions thread_pool_restart() and thread_pool_join() should
    be joined up like open/close and malloc/free combinations.
@@ -317,22 +370,15 @@ static void * thread_pool_main_loop( void * arg ) {
 void thread_pool_restart( thread_pool_type * tp ) {
   if (tp->accepting_jobs)
     util_abort("%s: fatal error - tried restart already running thread pool\n",__func__);
+
+  pthread_mutex_lock( &tp->lock );
   {
     tp->join           = false;
-    tp->queue_index    = 0;
     tp->queue_size     = 0;
-    {
-      int i;
-      for (i=0; i < tp->max_running; i++) {
-        tp->job_slots[i].run_count = 0;
-        tp->job_slots[i].running   = false;
-      }
-    }
-
-    /* Starting the dispatch thread. */
-    pthread_create( &tp->dispatch_thread , NULL , thread_pool_main_loop , tp );
+    tp->complete_count = 0;
     tp->accepting_jobs = true;
   }
+  pthread_mutex_unlock( &tp->lock );
 }
 
 
@@ -340,75 +386,52 @@ void thread_pool_restart( thread_pool_type * tp ) {
 /**
    This function is called by the calling scope when all the jobs have
    been submitted, and we just wait for them to complete.
-
-   This function just sets the join switch to true - this again tells
-   the dispatch_thread to start the join process on the worker
-   threads.
 */
 
 void thread_pool_join(thread_pool_type * pool) {
-  pool->join = true;                               /* Signals to the main thread that joining can start. */
-  if (pool->max_running > 0) {
-    pthread_join( pool->dispatch_thread , NULL );  /* Wait for the main thread to complete. */
+  pthread_mutex_lock( &pool->lock );
+  {
+    pool->join = true;
+    while (pool->complete_count < pool->queue_size)
+      pthread_cond_wait( &pool->complete_cond , &pool->lock );
     pool->accepting_jobs = false;
   }
+  pthread_mutex_unlock( &pool->lock );
 }
 
 /*
-  This will try to join the thread; if the manager thread has not
-  completed within @timeout_seconds the function will return false. If
-  the join fails the queue will be reset in a non-joining state and it
-  will be open for more jobs. Probably not in a 100% sane state.
+  This will try to join the pool; if the jobs have not completed
+  within @timeout_seconds the function will return false. If the join
+  fails the pool will be reset in a non-joining state and it will be
+  open for more jobs.
 */
 
 bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
   bool join_ok = true;
+  struct timespec ts;
+  time_t timeout_time = time( NULL );
 
-  pool->join = true;                               /* Signals to the main thread that joining can start. */
-  if (pool->max_running > 0) {
-    struct timespec ts;
-    time_t timeout_time = time( NULL );
-
-    util_inplace_forward_seconds_utc(&timeout_time , timeout_seconds );
-    ts.tv_sec = timeout_time;
-    ts.tv_nsec = 0;
+  util_inplace_forward_seconds_utc(&timeout_time , timeout_seconds );
+  ts.tv_sec = timeout_time;
+  ts.tv_nsec = 0;
 
-#ifdef HAVE_TIMEDJOIN
-
-    {
-      int join_return = pthread_timedjoin_np( pool->dispatch_thread , NULL , &ts);  /* Wait for the main thread to complete. */
-      if (join_return == 0)
-        pool->accepting_jobs = false;
-      else {
-        pool->join = false;
-        join_ok = false;
-      }
+  pthread_mutex_lock( &pool->lock );
+  {
+    pool->join = true;
+    while (pool->complete_count < pool->queue_size) {
+      if (pthread_cond_timedwait( &pool->complete_cond , &pool->lock , &ts ) == ETIMEDOUT)
+        break;
     }
 
-#else
-
-    while(true) {
-        if (pthread_kill(pool->dispatch_thread, 0) == 0){
-            util_yield();
-        } else {
-            pthread_join(pool->dispatch_thread, NULL);
-            pool->accepting_jobs = false;
-            break;
-        }
-
-        time_t now = time(NULL);
-
-        if(util_difftime_seconds(now, timeout_time) <= 0) {
-            join_ok = false;
-            break;
-        }
+    if (pool->complete_count == pool->queue_size)
+      pool->accepting_jobs = false;
+    else {
+      pool->join = false;
+      join_ok = false;
     }
-
-#endif
-
-
-
   }
+  pthread_mutex_unlock( &pool->lock );
+
   return join_ok;
 }
 
@@ -417,20 +440,44 @@ bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
 
 /**
    max_running is the maximum number of concurrent threads. If
-   @start_queue is true the dispatch thread will start immediately. If
-   the function is called with @start_queue == false you must first
-   call thread_pool_restart() BEFORE you can start adding jobs.
+   @start_queue is true the pool will accept jobs immediately. If the
+   function is called with @start_queue == false you must first call
+   thread_pool_restart() BEFORE you can start adding jobs.
 */
 
 thread_pool_type * thread_pool_alloc(int max_running , bool start_queue) {
   thread_pool_type * pool = util_malloc( sizeof *pool );
   UTIL_TYPE_ID_INIT( pool , THREAD_POOL_TYPE_ID );
-  pool->job_slots         = util_calloc( max_running , sizeof * pool->job_slots );
   pool->max_running       = max_running;
   pool->queue             = NULL;
+  pool->queue_size        = 0;
+  pool->complete_count    = 0;
+  pool->pending_count     = 0;
+  pool->next_worker       = 0;
+  pool->join              = false;
   pool->accepting_jobs    = false;
+  pool->shutdown          = false;
   pthread_rwlock_init( &pool->queue_lock , NULL);
+  pthread_mutex_init( &pool->lock , NULL );
+  pthread_cond_init( &pool->work_cond , NULL );
+  pthread_cond_init( &pool->complete_cond , NULL );
+  pthread_key_create( &pool->worker_key , NULL );
   thread_pool_resize_queue( pool  , 32 );
+
+  pool->workers = util_calloc( max_running , sizeof * pool->workers );
+  {
+    int i;
+    for (i=0; i < max_running; i++) {
+      thread_pool_worker_type * worker = &pool->workers[i];
+      worker->pool = pool;
+      worker->worker_index = i;
+      thread_pool_deque_init( &worker->deque );
+    }
+
+    for (i=0; i < max_running; i++)
+      pthread_create( &pool->workers[i].thread , NULL , thread_pool_worker_main , &pool->workers[i] );
+  }
+
   if (start_queue)
     thread_pool_restart( pool );
   return pool;
@@ -442,40 +489,159 @@ void thread_pool_add_job(thread_pool_type * pool , start_func_ftype * start_func
   if (pool->max_running == 0) /* Blocking non-threaded mode: */
     start_func( func_arg );
   else {
+    thread_pool_worker_type * current_worker = pthread_getspecific( pool->worker_key );
+
+    pthread_mutex_lock( &pool->lock );
     if (pool->accepting_jobs) {
+      int queue_index = pool->queue_size;
+      thread_pool_worker_type * worker;
+
       if (pool->queue_size == pool->queue_alloc_size)
         thread_pool_resize_queue( pool , pool->queue_alloc_size * 2);
 
+      pool->queue[ queue_index ].func_arg     = func_arg;
+      pool->queue[ queue_index ].func         = start_func;
+      pool->queue[ queue_index ].return_value = NULL;
+      pool->queue_size++;
+
       /*
-         The new job is added to the queue - the main thread is watching
-         the queue and will pick up the new job.
+         A job added from one of the workers goes to the deque of
+         that worker, a job from the calling scope is distributed
+         round robin.
       */
-      {
-        int queue_index = pool->queue_size;
-
-        pool->queue[ queue_index ].pool         = pool;
-        pool->queue[ queue_index ].func_arg     = func_arg;
-        pool->queue[ queue_index ].func         = start_func;
-        pool->queue[ queue_index ].return_value = NULL;
-        pool->queue[ queue_index ].queue_index = queue_index;
+      if (current_worker != NULL)
+        worker = current_worker;
+      else {
+        worker = &pool->workers[ pool->next_worker ];
+        pool->next_worker = (pool->next_worker + 1) % pool->max_running;
       }
-      pool->queue_size++;  /* <- This is shared between this thread and the dispatch thread */
-    } else
+      thread_pool_deque_push( &worker->deque , queue_index );
+      pool->pending_count++;
+      pthread_cond_signal( &pool->work_cond );
+      pthread_mutex_unlock( &pool->lock );
+    } else {
+      pthread_mutex_unlock( &pool->lock );
       util_abort("%s: thread_pool is not running - restart with thread_pool_restart()?? \n",__func__);
+    }
+  }
+}
+
+
+/*****************************************************************/
+
+typedef struct {
+  thread_pool_loop_ftype * func;
+  void                   * arg;
+  int                      remaining;      /* The number of chunks which have not completed. */
+  pthread_mutex_t          lock;
+  pthread_cond_t           complete_cond;
+} thread_pool_loop_type;
+
+
+typedef struct {
+  thread_pool_loop_type  * loop;
+  int                      begin;
+  int                      end;
+} thread_pool_chunk_type;
+
+
+static void * thread_pool_run_chunk( void * arg ) {
+  thread_pool_chunk_type * chunk = (thread_pool_chunk_type *) arg;
+  thread_pool_loop_type * loop = chunk->loop;
+  int index;
+
+  for (index = chunk->begin; index < chunk->end; index++)
+    loop->func( index , loop->arg );
+
+  pthread_mutex_lock( &loop->lock );
+  loop->remaining--;
+  if (loop->remaining == 0)
+    pthread_cond_signal( &loop->complete_cond );
+  pthread_mutex_unlock( &loop->lock );
+
+  return NULL;
+}
+
+
+/**
+   Will call func( index , arg ) for all index in [begin,end) using the
+   worker threads of the pool, and return when all the calls have
+   completed. The pool must be running, i.e. accepting jobs; the pool
+   is not joined. If the function is called from a job running in the
+   same pool - or the pool has no worker threads - the loop is run
+   serially in the calling thread.
+*/
+
+void thread_pool_parallel_for( thread_pool_type * pool , int begin , int end , thread_pool_loop_ftype * func , void * arg) {
+  if (end <= begin)
+    return;
+
+  if ((pool->max_running == 0) || (pthread_getspecific( pool->worker_key ) != NULL)) {
+    int index;
+    for (index = begin; index < end; index++)
+      func( index , arg );
+  } else {
+    thread_pool_loop_type loop;
+    int size = end - begin;
+    int chunk_size = util_int_max( 1 , size / (4 * pool->max_running));
+    int num_chunks = (size + chunk_size - 1) / chunk_size;
+    thread_pool_chunk_type * chunks = util_calloc( num_chunks , sizeof * chunks );
+    int i;
+
+    loop.func = func;
+    loop.arg = arg;
+    loop.remaining = num_chunks;
+    pthread_mutex_init( &loop.lock , NULL );
+    pthread_cond_init( &loop.complete_cond , NULL );
+
+    for (i = 0; i < num_chunks; i++) {
+      chunks[i].loop  = &loop;
+      chunks[i].begin = begin + i * chunk_size;
+      chunks[i].end   = util_int_min( end , chunks[i].begin + chunk_size );
+      thread_pool_add_job( pool , thread_pool_run_chunk , &chunks[i] );
+    }
+
+    pthread_mutex_lock( &loop.lock );
+    while (loop.remaining > 0)
+      pthread_cond_wait( &loop.complete_cond , &loop.lock );
+    pthread_mutex_unlock( &loop.lock );
+
+    pthread_cond_destroy( &loop.complete_cond );
+    pthread_mutex_destroy( &loop.lock );
+    free( chunks );
   }
 }
 
 
 
 /*
-  Observe that this function does not join the worker threads,
-  i.e. you should call thread_pool_join() first (otherwise the thing
-  will go up in flames).
+  Observe that this function does not join the pool, i.e. you should
+  call thread_pool_join() first. The worker threads are stopped and
+  joined here.
 */
 
 
 void thread_pool_free(thread_pool_type * pool) {
-  util_safe_free( pool->job_slots );
+  pthread_mutex_lock( &pool->lock );
+  pool->shutdown = true;
+  pthread_cond_broadcast( &pool->work_cond );
+  pthread_mutex_unlock( &pool->lock );
+
+  {
+    int i;
+    for (i=0; i < pool->max_running; i++)
+      pthread_join( pool->workers[i].thread , NULL );
+
+    for (i=0; i < pool->max_running; i++)
+      thread_pool_deque_free_content( &pool->workers[i].deque );
+  }
+
+  pthread_key_delete( pool->worker_key );
+  pthread_cond_destroy( &pool->complete_cond );
+  pthread_cond_destroy( &pool->work_cond );
+  pthread_mutex_destroy( &pool->lock );
+  pthread_rwlock_destroy( &pool->queue_lock );
+  util_safe_free( pool->workers );
   util_safe_free( pool->queue );
   free(pool);
 }
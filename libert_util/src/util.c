@@ -762,6 +762,24 @@ void util_yield() {
 #endif
 }
 
+
+/**
+   Returns the number of processors currently online, or 1 if that can
+   not be determined. Used as the default size of thread pools.
+*/
+
+int util_get_num_cpu( void ) {
+  int num_cpu = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+  {
+    long online = sysconf( _SC_NPROCESSORS_ONLN );
+    if (online > 0)
+      num_cpu = online;
+  }
+#endif
+  return num_cpu;
+}
+
 /**
    This function will allocate and read a line from stdin. If there is
    no input waiting on stdin (this typically only applies if stdin is
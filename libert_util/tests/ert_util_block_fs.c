@@ -17,11 +17,14 @@
 */
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <pthread.h>
 
 
 #include <ert/util/block_fs.h>
+#include <ert/util/buffer.h>
 #include <ert/util/test_util.h>
 #include <ert/util/test_work_area.h>
 
@@ -102,8 +105,81 @@ void test_lock_conflict() {
 
 
 
+#define NUM_FILES   100
+#define NUM_THREADS 8
+
+static void fill_data( int * data , int file_nr ) {
+  int i;
+  for (i=0; i < file_nr + 1; i++)
+    data[i] = file_nr * 1000 + i;
+}
+
+
+void * read_files( void * arg ) {
+  block_fs_type * bfs = block_fs_safe_cast( arg );
+  buffer_type * buffer = buffer_alloc( 100 );
+  int expected[NUM_FILES];
+  int data[NUM_FILES];
+  int iter,file_nr;
+
+  for (iter = 0; iter < 10; iter++) {
+    for (file_nr = 0; file_nr < NUM_FILES; file_nr++) {
+      char * filename = util_alloc_sprintf("file_%d" , file_nr);
+      fill_data( expected , file_nr );
+
+      block_fs_fread_file( bfs , filename , data );
+      test_assert_int_equal( 0 , memcmp( expected , data , (file_nr + 1) * sizeof * data ));
+
+      block_fs_fread_realloc_buffer( bfs , filename , buffer );
+      test_assert_int_equal( (file_nr + 1) * sizeof * data , buffer_get_size( buffer ));
+      test_assert_int_equal( 0 , memcmp( expected , buffer_get_data( buffer ) , (file_nr + 1) * sizeof * data ));
+
+      free( filename );
+    }
+  }
+  buffer_free( buffer );
+  return NULL;
+}
+
+
+void test_concurrent_read() {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/concurrent_read");
+  block_fs_type * bfs = block_fs_mount( "test.mnt" , 1000 , 10000 , 0.67 , 10 , false , false , false );
+  int data[NUM_FILES];
+  int file_nr;
+
+  for (file_nr = 0; file_nr < NUM_FILES; file_nr++) {
+    char * filename = util_alloc_sprintf("file_%d" , file_nr);
+    fill_data( data , file_nr );
+    block_fs_fwrite_file( bfs , filename , data , (file_nr + 1) * sizeof * data );
+    free( filename );
+  }
+
+  {
+    pthread_t threads[NUM_THREADS];
+    int i;
+    for (i=0; i < NUM_THREADS; i++)
+      pthread_create( &threads[i] , NULL , read_files , bfs );
+
+    for (i=0; i < NUM_THREADS; i++)
+      pthread_join( threads[i] , NULL );
+  }
+
+  block_fs_close( bfs , false );
+
+  /* Remount and verify that the data has been correctly persisted. */
+  bfs = block_fs_mount( "test.mnt" , 1000 , 10000 , 0.67 , 10 , false , false , false );
+  read_files( bfs );
+  block_fs_close( bfs , false );
+
+  test_work_area_free( work_area );
+}
+
+
+
 int main(int argc , char ** argv) {
   test_readonly();
   test_lock_conflict();
+  test_concurrent_read();
   exit(0);
 }
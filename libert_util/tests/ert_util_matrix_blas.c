@@ -0,0 +1,141 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ert_util_matrix_blas.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/rng.h>
+#include <ert/util/matrix.h>
+#include <ert/util/matrix_blas.h>
+#include <ert/util/thread_pool.h>
+
+
+void assert_matrix_close( const matrix_type * A , const matrix_type * B ) {
+  test_assert_int_equal( matrix_get_rows( A ) , matrix_get_rows( B ));
+  test_assert_int_equal( matrix_get_columns( A ) , matrix_get_columns( B ));
+  for (int j=0; j < matrix_get_columns( A ); j++)
+    for (int i=0; i < matrix_get_rows( A ); i++) {
+      double b = matrix_iget( B , i , j );
+      test_assert_true( fabs( matrix_iget( A , i , j ) - b ) <= 1e-10 * (1 + fabs( b )));
+    }
+}
+
+
+void test_inplace_dgemm( rng_type * rng , int rows , int columns ) {
+  matrix_type * A0 = matrix_alloc( rows , columns );
+  matrix_type * X  = matrix_alloc( columns , columns );
+  matrix_type * A1 = matrix_alloc( rows , columns );
+  thread_pool_type * tp = thread_pool_alloc( 3 , false );
+
+  matrix_random_init( A0 , rng );
+  matrix_random_init( X , rng );
+  matrix_assign( A1 , A0 );
+  matrix_inplace_matmul( A1 , X );
+
+  {
+    matrix_type * A = matrix_alloc_copy( A0 );
+    matrix_inplace_dgemm( A , X );
+    assert_matrix_close( A , A1 );
+    matrix_free( A );
+  }
+
+  {
+    matrix_type * A = matrix_alloc_copy( A0 );
+    matrix_inplace_dgemm_mt( A , X , tp );
+    assert_matrix_close( A , A1 );
+    matrix_free( A );
+  }
+
+  {
+    matrix_type * A = matrix_alloc_copy( A0 );
+    matrix_inplace_dgemm_mt1( A , X , 7 );
+    assert_matrix_close( A , A1 );
+    matrix_free( A );
+  }
+
+  thread_pool_free( tp );
+  matrix_free( A1 );
+  matrix_free( X );
+  matrix_free( A0 );
+}
+
+
+/*
+  A shared view into a larger matrix; only the rows of the view should
+  be updated.
+*/
+
+void test_inplace_dgemm_shared( rng_type * rng ) {
+  const int rows = 1000;
+  const int columns = 25;
+  const int row_offset = 17;
+  const int view_rows = 711;
+  matrix_type * A0 = matrix_alloc( rows , columns );
+  matrix_type * A  = matrix_alloc( rows , columns );
+  matrix_type * X  = matrix_alloc( columns , columns );
+  matrix_type * A1;
+
+  matrix_random_init( A0 , rng );
+  matrix_random_init( X , rng );
+  matrix_assign( A , A0 );
+  {
+    matrix_type * view = matrix_alloc_shared( A0 , row_offset , 0 , view_rows , columns );
+    A1 = matrix_alloc_copy( view );
+    matrix_inplace_matmul( A1 , X );
+    matrix_free( view );
+  }
+
+  {
+    thread_pool_type * tp = thread_pool_alloc( 4 , false );
+    matrix_type * view = matrix_alloc_shared( A , row_offset , 0 , view_rows , columns );
+
+    matrix_inplace_dgemm_mt( view , X , tp );
+    assert_matrix_close( view , A1 );
+
+    for (int j=0; j < columns; j++) {
+      for (int i=0; i < row_offset; i++)
+        test_assert_double_equal( matrix_iget( A , i , j ) , matrix_iget( A0 , i , j ));
+      for (int i=row_offset + view_rows; i < rows; i++)
+        test_assert_double_equal( matrix_iget( A , i , j ) , matrix_iget( A0 , i , j ));
+    }
+
+    matrix_free( view );
+    thread_pool_free( tp );
+  }
+
+  matrix_free( A1 );
+  matrix_free( X );
+  matrix_free( A );
+  matrix_free( A0 );
+}
+
+
+int main( int argc , char ** argv) {
+  rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+
+  test_inplace_dgemm( rng , 1 , 10 );
+  test_inplace_dgemm( rng , 5 , 1 );
+  test_inplace_dgemm( rng , 100 , 10 );
+  test_inplace_dgemm( rng , 10007 , 13 );
+  test_inplace_dgemm( rng , 20001 , 100 );
+  test_inplace_dgemm_shared( rng );
+
+  rng_free( rng );
+  exit(0);
+}
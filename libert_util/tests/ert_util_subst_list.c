@@ -20,7 +20,10 @@
 #include <string.h>
 
 #include <ert/util/test_work_area.h>
+#include <ert/util/buffer.h>
 #include <ert/util/subst_list.h>
+#include <ert/util/subst_func.h>
+#include <ert/util/stringlist.h>
 #include <ert/util/test_util.h>
 
 
@@ -90,8 +93,167 @@ void test_filter_file2() {
 
 
 
+void test_filtered_string( const subst_list_type * subst_list , const char * input , const char * expected) {
+  char * filtered_string = subst_list_alloc_filtered_string( subst_list , input );
+  test_assert_string_equal( filtered_string , expected );
+  free( filtered_string );
+}
+
+
+void test_cascade() {
+  subst_list_type * subst_list = subst_list_alloc( NULL );
+  subst_list_append_copy( subst_list , "<PATH>" , "/tmp/run/<CASE>" , NULL);
+  subst_list_append_copy( subst_list , "<CASE>" , "Test4" , NULL);
+  test_filtered_string( subst_list , "<PATH>/x <CASE>" , "/tmp/run/Test4/x Test4");
+  subst_list_free( subst_list );
+
+  subst_list = subst_list_alloc( NULL );
+  subst_list_append_copy( subst_list , "<CASE>" , "Test4" , NULL);
+  subst_list_append_copy( subst_list , "<PATH>" , "/tmp/run/<CASE>" , NULL);
+  test_filtered_string( subst_list , "<PATH>/x <CASE>" , "/tmp/run/<CASE>/x Test4");
+  subst_list_free( subst_list );
+}
+
+
+void test_parent() {
+  subst_list_type * parent = subst_list_alloc( NULL );
+  subst_list_type * subst_list = subst_list_alloc( parent );
+
+  subst_list_append_copy( parent , "<A>" , "parent" , NULL);
+  subst_list_append_copy( subst_list , "<A>" , "child" , NULL);
+  subst_list_append_copy( subst_list , "<B>" , "<A>" , NULL);
+  test_filtered_string( subst_list , "<A> <B>" , "parent <A>");
+
+  /* The compiled matcher must be updated when the parent or the child is modified. */
+  subst_list_append_copy( parent , "<A>" , "PARENT" , NULL);
+  test_filtered_string( subst_list , "<A> <B>" , "PARENT <A>");
+
+  subst_list_append_copy( subst_list , "<C>" , "c" , NULL);
+  test_filtered_string( subst_list , "<A> <B> <C>" , "PARENT <A> c");
+
+  subst_list_clear( subst_list );
+  test_filtered_string( subst_list , "<A> <B> <C>" , "PARENT <B> <C>");
+
+  subst_list_free( subst_list );
+  subst_list_free( parent );
+}
+
+
+void test_overlap() {
+  subst_list_type * subst_list = subst_list_alloc( NULL );
+
+  /* Overlapping keys. */
+  subst_list_append_copy( subst_list , "AB" , "1" , NULL);
+  subst_list_append_copy( subst_list , "BC" , "2" , NULL);
+  test_filtered_string( subst_list , "ABC BC" , "1C 2");
+  subst_list_clear( subst_list );
+
+  /* One key is a substring of another key. */
+  subst_list_append_copy( subst_list , "<A>" , "1" , NULL);
+  subst_list_append_copy( subst_list , "A" , "2" , NULL);
+  test_filtered_string( subst_list , "<A> A" , "1 2");
+  subst_list_clear( subst_list );
+
+  /* Keys created by the substitution. */
+  subst_list_append_copy( subst_list , "<X>" , "<" , NULL);
+  subst_list_append_copy( subst_list , "<Y>" , "Z>" , NULL);
+  subst_list_append_copy( subst_list , "<Z>" , "zz" , NULL);
+  test_filtered_string( subst_list , "<X>Z> <X><Y>" , "zz zz");
+  subst_list_clear( subst_list );
+
+  subst_list_append_copy( subst_list , "<A>" , "" , NULL);
+  subst_list_append_copy( subst_list , "<<B>>" , "x" , NULL);
+  test_filtered_string( subst_list , "<<<A>B>> <A>" , "x ");
+
+  subst_list_free( subst_list );
+}
+
+
+void test_many_keys() {
+  subst_list_type * subst_list = subst_list_alloc( NULL );
+  buffer_type * input = buffer_alloc( 1024 );
+  buffer_type * expected = buffer_alloc( 1024 );
+  int i;
+
+  for (i = 0; i < 1000; i++) {
+    char * key = util_alloc_sprintf("<KEY%d>" , i);
+    char * value = util_alloc_sprintf("%d" , 2*i);
+    subst_list_append_owned_ref( subst_list , key , value , NULL);
+    free( key );
+  }
+
+  for (i = 0; i < 5000; i++) {
+    char * key = util_alloc_sprintf("<KEY%d>" , (i * 7) % 1000);
+    buffer_strcat( input , key );
+    buffer_strcat( input , " : ");
+    buffer_strcat( expected , subst_list_get_value( subst_list , key ));
+    buffer_strcat( expected , " : ");
+    free( key );
+  }
+
+  test_filtered_string( subst_list , buffer_get_data( input ) , buffer_get_data( expected ));
+
+  buffer_free( expected );
+  buffer_free( input );
+  subst_list_free( subst_list );
+}
+
+
+void test_used_keys() {
+  subst_func_pool_type * func_pool = subst_func_pool_alloc( );
+  subst_list_type * parent;
+  subst_list_type * subst_list;
+
+  subst_func_pool_add_func( func_pool , "ADD" , "Adds arguments" , subst_func_add , true , 1 , 0 , NULL);
+  parent = subst_list_alloc( func_pool );
+  subst_list_insert_func( parent , "ADD" , "__ADD__" );
+  subst_list_append_copy( parent , "<CASE>" , "Test<IENS>" , NULL);
+  subst_list_append_copy( parent , "<CWD>" , "/tmp" , NULL);
+
+  subst_list = subst_list_alloc( parent );
+  subst_list_append_copy( subst_list , "<IENS>" , "7" , NULL);
+  subst_list_append_copy( subst_list , "<RUNPATH>" , "/run/<CASE>" , NULL);
+  subst_list_append_copy( subst_list , "<ITER>" , "0" , NULL);
+
+  {
+    stringlist_type * used_keys = subst_list_alloc_used_keys( subst_list , "No keys here" );
+    test_assert_int_equal( 0 , stringlist_get_size( used_keys ));
+    stringlist_free( used_keys );
+  }
+
+  {
+    stringlist_type * used_keys = subst_list_alloc_used_keys( subst_list , "<CWD>/<ITER>" );
+    test_assert_int_equal( 2 , stringlist_get_size( used_keys ));
+    test_assert_string_equal( "<CWD>" , stringlist_iget( used_keys , 0 ));
+    test_assert_string_equal( "<ITER>" , stringlist_iget( used_keys , 1 ));
+    stringlist_free( used_keys );
+  }
+
+  {
+    stringlist_type * used_keys = subst_list_alloc_used_keys( subst_list , "cd <RUNPATH>" );
+    test_assert_int_equal( 3 , stringlist_get_size( used_keys ));
+    test_assert_true( stringlist_contains( used_keys , "<RUNPATH>" ));
+    test_assert_true( stringlist_contains( used_keys , "<CASE>" ));
+    test_assert_true( stringlist_contains( used_keys , "<IENS>" ));
+    stringlist_free( used_keys );
+  }
+
+  test_assert_NULL( subst_list_alloc_used_keys( subst_list , "X = __ADD__(1,2)" ));
+
+  subst_list_free( subst_list );
+  subst_list_free( parent );
+  subst_func_pool_free( func_pool );
+}
+
+
+
 int main(int argc , char ** argv) {
   test_create();
   test_filter_file1();
   test_filter_file2();
+  test_cascade();
+  test_parent();
+  test_overlap();
+  test_many_keys();
+  test_used_keys();
 }
@@ -18,6 +18,8 @@
 #include <stdlib.h>
 #include <pthread.h>
 
+#include <ert/util/util.h>
+
 #include <ert/util/test_util.h>
 #include <ert/util/thread_pool.h>
 
@@ -64,7 +66,112 @@ void run() {
 
 
 
+void * return_arg(void * arg) {
+  return arg;
+}
+
+
+void test_return_value_and_restart() {
+  int job_size = 100;
+  int * values = util_calloc( job_size , sizeof * values );
+  thread_pool_type * tp = thread_pool_alloc( 4 , false );
+  int iter, i;
+
+  for (iter = 0; iter < 3; iter++) {
+    thread_pool_restart( tp );
+    for (i=0; i < job_size; i++)
+      thread_pool_add_job( tp , return_arg , &values[i] );
+    thread_pool_join( tp );
+
+    for (i=0; i < job_size; i++)
+      test_assert_ptr_equal( &values[i] , thread_pool_iget_return_value( tp , i ));
+  }
+  thread_pool_free( tp );
+  free( values );
+}
+
+
+typedef struct {
+  thread_pool_type * tp;
+  int                value;
+} nested_arg_type;
+
+
+void * add_nested(void * arg) {
+  nested_arg_type * nested_arg = arg;
+  int i;
+  for (i=0; i < 10; i++)
+    thread_pool_add_job( nested_arg->tp , inc , &nested_arg->value );
+  return NULL;
+}
+
+
+void test_nested_jobs() {
+  nested_arg_type nested_arg;
+  int i;
+
+  nested_arg.tp = thread_pool_alloc( 4 , true );
+  nested_arg.value = 0;
+  pthread_mutex_init(&lock , NULL);
+  for (i=0; i < 100; i++)
+    thread_pool_add_job( nested_arg.tp , add_nested , &nested_arg );
+
+  thread_pool_join( nested_arg.tp );
+  thread_pool_free( nested_arg.tp );
+  test_assert_int_equal( 1000 , nested_arg.value );
+  pthread_mutex_destroy( &lock );
+}
+
+
+void * sleep_job(void * arg) {
+  util_usleep( 500000 );
+  return NULL;
+}
+
+
+void test_try_join() {
+  thread_pool_type * tp = thread_pool_alloc( 2 , true );
+  thread_pool_add_job( tp , sleep_job , NULL );
+  test_assert_false( thread_pool_try_join( tp , 0 ));
+  test_assert_true( thread_pool_try_join( tp , 10 ));
+  thread_pool_free( tp );
+}
+
+
+void square(int index , void * arg) {
+  int * values = arg;
+  values[index] = index * index;
+}
+
+
+void test_parallel_for() {
+  int size = 10000;
+  int * values = util_calloc( size , sizeof * values );
+  int max_running;
+
+  for (max_running = 0; max_running < 4; max_running++) {
+    thread_pool_type * tp = thread_pool_alloc( max_running , true );
+    int i;
+
+    for (i=0; i < size; i++)
+      values[i] = -1;
+
+    thread_pool_parallel_for( tp , 0 , size , square , values );
+    for (i=0; i < size; i++)
+      test_assert_int_equal( i*i , values[i] );
+
+    thread_pool_join( tp );
+    thread_pool_free( tp );
+  }
+  free( values );
+}
+
+
 int main( int argc , char ** argv) {
   create_and_destroy();
   run();
+  test_return_value_and_restart();
+  test_nested_jobs();
+  test_try_join();
+  test_parallel_for();
 }
@@ -39,6 +39,7 @@ typedef struct  forward_model_struct forward_model_type ;
   forward_model_type     * forward_model_alloc(const ext_joblist_type * ext_joblist);
   void                     forward_model_parse_init(forward_model_type * forward_model , const char * input_string );
   void                     forward_model_python_fprintf(const forward_model_type *  , const char * , const subst_list_type * , mode_t umask);
+  char                   * forward_model_alloc_python_filename( const char * path );
   void                     forward_model_free( forward_model_type * );
   forward_model_type *     forward_model_alloc_copy(const forward_model_type * forward_model);
   void                     forward_model_iset_job_arg( forward_model_type * forward_model , int job_index , const char * arg , const char * value);
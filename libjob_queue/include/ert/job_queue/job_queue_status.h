@@ -24,6 +24,7 @@ extern "C" {
 #endif
 
 #include <ert/util/type_macros.h>
+#include <ert/util/int_vector.h>
 #include <ert/job_queue/queue_driver.h>
 
   typedef struct job_queue_status_struct job_queue_status_type;
@@ -34,6 +35,12 @@ extern "C" {
   void job_queue_status_clear( job_queue_status_type * status );
   void job_queue_status_inc( job_queue_status_type * status_count , job_status_type status_type);
   bool job_queue_status_transition( job_queue_status_type * status_count , job_status_type src_status , job_status_type target_status);
+  bool job_queue_status_transition_index( job_queue_status_type * status_count , int queue_index , job_status_type src_status , job_status_type target_status);
+  void job_queue_status_get_indices( job_queue_status_type * status , int status_mask , int max_count , int_vector_type * indices);
+  void job_queue_status_notify( job_queue_status_type * status );
+  void job_queue_status_notify__( void * arg );
+  unsigned int job_queue_status_get_event_count( job_queue_status_type * status );
+  bool job_queue_status_wait( job_queue_status_type * status , unsigned int event_count , int timeout_usec);
   int job_queue_status_get_total_count( const job_queue_status_type * status );
 
   UTIL_IS_INSTANCE_HEADER( job_queue_status );
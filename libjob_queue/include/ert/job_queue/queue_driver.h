@@ -105,6 +105,8 @@ extern "C" {
   typedef const void * (get_option_ftype) (const void *, const char *);
   typedef bool (has_option_ftype) (const void *, const char *);
   typedef void (init_option_list_ftype) (stringlist_type *);
+  typedef void (queue_driver_notify_ftype) (void *);
+  typedef void (set_notify_ftype) (void *, queue_driver_notify_ftype *, void *);
 
 
   queue_driver_type * queue_driver_alloc_RSH(const char * rsh_cmd, const hash_type * rsh_hostlist);
@@ -118,6 +120,8 @@ extern "C" {
   void queue_driver_blacklist_node(queue_driver_type * driver, void * job_data);
   void queue_driver_kill_job(queue_driver_type * driver, void * job_data);
   job_status_type queue_driver_get_status(queue_driver_type * driver, void * job_data);
+  void queue_driver_set_notify(queue_driver_type * driver, queue_driver_notify_ftype * notify, void * notify_arg);
+  bool queue_driver_has_notify(const queue_driver_type * driver);
 
   const char * queue_driver_get_name(const queue_driver_type * driver);
 
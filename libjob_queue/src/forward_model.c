@@ -193,11 +193,16 @@ void forward_model_parse_init(forward_model_type * forward_model , const char *
   used when running the remote jobs.
 */
 
+char * forward_model_alloc_python_filename( const char * path ) {
+  return util_alloc_filename(path , DEFAULT_JOB_MODULE , NULL);
+}
+
+
 void forward_model_python_fprintf(const forward_model_type * forward_model ,
                                   const char * path,
                                   const subst_list_type * global_args,
                                   mode_t umask) {
-  char * module_file = util_alloc_filename(path , DEFAULT_JOB_MODULE , NULL);
+  char * module_file = forward_model_alloc_python_filename( path );
   FILE * stream      = util_fopen(module_file , "w");
   int i;
 
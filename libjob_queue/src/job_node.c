@@ -469,7 +469,7 @@ submit_status_type job_queue_node_submit( job_queue_node_type * node , job_queue
       */
       submit_status = SUBMIT_OK;
       job_queue_node_set_status( node , new_status);
-      job_queue_status_transition(status, old_status, new_status);
+      job_queue_status_transition_index(status, node->queue_index, old_status, new_status);
     } else
       /*
         In this case the status of the job itself will be
@@ -514,14 +514,14 @@ bool job_queue_node_update_status( job_queue_node_type * node , job_queue_status
         if (runtime >= node->max_confirm_wait) {
           // max_confirm_wait has passed since sim_start without success; the job is dead
           job_status_type new_status = JOB_QUEUE_DO_KILL_NODE_FAILURE;
-          status_change = job_queue_status_transition(status, current_status, new_status);
+          status_change = job_queue_status_transition_index(status, node->queue_index, current_status, new_status);
           job_queue_node_set_status(node, new_status);
         }
       }
       current_status = job_queue_node_get_status(node);
       if (current_status & JOB_QUEUE_CAN_UPDATE_STATUS) {
         job_status_type new_status = queue_driver_get_status( driver , node->job_data);
-        status_change = job_queue_status_transition(status , current_status , new_status);
+        status_change = job_queue_status_transition_index(status, node->queue_index, current_status , new_status);
         job_queue_node_set_status(node,new_status);
       }
     }
@@ -535,7 +535,7 @@ bool job_queue_node_status_transition( job_queue_node_type * node , job_queue_st
   pthread_mutex_lock( &node->data_mutex );
   {
     job_status_type old_status = job_queue_node_get_status( node );
-    status_change = job_queue_status_transition(status , old_status, new_status);
+    status_change = job_queue_status_transition_index(status, node->queue_index, old_status, new_status);
 
     if (status_change)
       job_queue_node_set_status( node , new_status );
@@ -570,7 +570,7 @@ bool job_queue_node_kill( job_queue_node_type * node , job_queue_status_type * s
         queue_driver_free_job( driver , node->job_data );
         node->job_data = NULL;
       }
-      job_queue_status_transition(status, current_status, JOB_QUEUE_IS_KILLED);
+      job_queue_status_transition_index(status, node->queue_index, current_status, JOB_QUEUE_IS_KILLED);
       job_queue_node_set_status( node , JOB_QUEUE_IS_KILLED);
       result = true;
     }
@@ -618,7 +618,7 @@ void job_queue_node_restart( job_queue_node_type * node , job_queue_status_type
   pthread_mutex_lock( &node->data_mutex );
   {
     job_status_type current_status = job_queue_node_get_status( node );
-    job_queue_status_transition(status, current_status, JOB_QUEUE_WAITING);
+    job_queue_status_transition_index(status, node->queue_index, current_status, JOB_QUEUE_WAITING);
     job_queue_node_set_status( node , JOB_QUEUE_WAITING);
     job_queue_node_reset_submit_attempt(node);
   }
@@ -28,6 +28,7 @@
 #include <ert/util/util.h>
 #include <ert/util/thread_pool.h>
 #include <ert/util/arg_pack.h>
+#include <ert/util/int_vector.h>
 
 #include <ert/job_queue/job_queue.h>
 #include <ert/job_queue/job_node.h>
@@ -136,6 +137,20 @@
 
        When the queue manager subsequently finds the job with status
        'JOB_QUEUE_WAITING' it will (re)submit this job.
+
+
+    5. The job_queue_status object keeps track of which jobs are in
+       which state, so the queue manager only visits the jobs which
+       need attention; e.g. the jobs to submit are taken directly
+       from the set of WAITING jobs.
+
+       Every status change wakes up the queue manager, which sleeps
+       in job_queue_status_wait() between the iterations. When
+       nothing happens the driver is polled for status updates with
+       intervals growing from JOB_QUEUE_MIN_POLL_USEC up to
+       queue->usleep_time; drivers which can post status changes
+       themselves (see queue_driver_set_notify()) are polled even
+       less frequently.
 */
 
 
@@ -207,7 +222,8 @@
 
 /*****************************************************************/
 
-#define JOB_QUEUE_TYPE_ID 665210
+#define JOB_QUEUE_TYPE_ID       665210
+#define JOB_QUEUE_MIN_POLL_USEC  10000
 
 struct job_queue_struct {
   UTIL_TYPE_ID_DECLARATION;
@@ -228,7 +244,7 @@ struct job_queue_struct {
   int                        max_ok_wait_time;                  /* Seconds to wait for an OK file - when the job itself has said all OK. */
   int                        max_duration;                      /* Maximum allowed time for a job to run, 0 = unlimited */
   time_t                     stop_time;                         /* A job is only allowed to run until this time. 0 = no time set, ignore stop_time */
-  unsigned long              usleep_time;                       /* The sleep time before checking for updates. */
+  unsigned long              usleep_time;                       /* The maximum time between polling the driver for status updates. */
   pthread_mutex_t            run_mutex;                         /* This mutex is used to ensure that ONLY one thread is executing the job_queue_run_jobs(). */
   thread_pool_type         * work_pool;
 };
@@ -277,14 +293,16 @@ static bool job_queue_change_node_status(job_queue_type * queue , job_queue_node
 
 static bool job_queue_update_status(job_queue_type * queue ) {
   bool update = false;
-  int ijob;
+  int_vector_type * indices = int_vector_alloc( 0 , 0 );
 
-  for (ijob = 0; ijob < job_list_get_size( queue->job_list ); ijob++) {
-    job_queue_node_type * node = job_list_iget_job( queue->job_list , ijob );
+  job_queue_status_get_indices( queue->status , JOB_QUEUE_CAN_UPDATE_STATUS , -1 , indices );
+  for (int i = 0; i < int_vector_size( indices ); i++) {
+    job_queue_node_type * node = job_list_iget_job( queue->job_list , int_vector_iget( indices , i ));
     bool node_update = job_queue_node_update_status( node , queue->status , queue->driver );
     if (node_update)
       update = true;
   }
+  int_vector_free( indices );
   return update;
 }
 
@@ -649,13 +667,16 @@ bool job_queue_is_running( const job_queue_type * queue ) {
 
 
 static void job_queue_user_exit__( job_queue_type * queue ) {
-  int queue_index;
-  for (queue_index = 0; queue_index < job_list_get_size( queue->job_list ); queue_index++) {
-    job_queue_node_type * node = job_list_iget_job( queue->job_list , queue_index );
+  int_vector_type * indices = int_vector_alloc( 0 , 0 );
+
+  job_queue_status_get_indices( queue->status , JOB_QUEUE_CAN_KILL , -1 , indices );
+  for (int i = 0; i < int_vector_size( indices ); i++) {
+    job_queue_node_type * node = job_list_iget_job( queue->job_list , int_vector_iget( indices , i ));
 
     if (JOB_QUEUE_CAN_KILL & job_queue_node_get_status(node))
       job_queue_node_status_transition(node,queue->status,JOB_QUEUE_DO_KILL);
   }
+  int_vector_free( indices );
 }
 
 
@@ -668,17 +689,25 @@ static bool job_queue_check_node_status_files( const job_queue_type * job_queue
     if (ok_file == NULL)
       return true;               /* If the ok-file has not been set we just return true immediately. */
     else {
-      int ok_sleep_time    =  1; /* Time to wait between checks for OK|EXIT file.                         */
-      int  total_wait_time =  0;
+      /*
+        The OK file is usually present when the job is DONE; if it is
+        not we check again with exponentially increasing intervals,
+        from JOB_QUEUE_MIN_POLL_USEC up to one second, to pick up a
+        file which is delayed by e.g. a network file system without
+        blocking the callback thread for a full second.
+      */
+      int ok_usleep_time   = JOB_QUEUE_MIN_POLL_USEC;
+      long total_wait_time = 0;
 
       while (true) {
         if (util_file_exists( ok_file )) {
           return true;
           break;
         } else {
-          if (total_wait_time <  job_queue->max_ok_wait_time) {
-            sleep( ok_sleep_time );
-            total_wait_time += ok_sleep_time;
+          if (total_wait_time <  1000000L * job_queue->max_ok_wait_time) {
+            usleep( ok_usleep_time );
+            total_wait_time += ok_usleep_time;
+            ok_usleep_time = util_int_min( 2 * ok_usleep_time , 1000000 );
           } else {
             /* We have waited long enough - this does not seem to give any OK file. */
             return false;
@@ -814,21 +843,27 @@ static void job_queue_check_expired(job_queue_type * queue) {
   if ((job_queue_get_max_job_duration(queue) <= 0) && (job_queue_get_job_stop_time(queue) <= 0))
     return;
 
-  for (int i = 0; i < job_list_get_size( queue->job_list ); i++) {
-    job_queue_node_type * node = job_list_iget_job( queue->job_list , i );
-
-    if (job_queue_node_get_status(node) == JOB_QUEUE_RUNNING) {
-      time_t now = time(NULL);
-      if ( job_queue_get_max_job_duration(queue) > 0) {
-        double elapsed = difftime(now, job_queue_node_get_sim_start( node ));
-        if (elapsed > job_queue_get_max_job_duration(queue))
-          job_queue_change_node_status(queue, node, JOB_QUEUE_DO_KILL);
-      }
-      if (job_queue_get_job_stop_time(queue) > 0) {
-        if (now >= job_queue_get_job_stop_time(queue))
-          job_queue_change_node_status(queue, node, JOB_QUEUE_DO_KILL);
+  {
+    int_vector_type * indices = int_vector_alloc( 0 , 0 );
+
+    job_queue_status_get_indices( queue->status , JOB_QUEUE_RUNNING , -1 , indices );
+    for (int i = 0; i < int_vector_size( indices ); i++) {
+      job_queue_node_type * node = job_list_iget_job( queue->job_list , int_vector_iget( indices , i ));
+
+      if (job_queue_node_get_status(node) == JOB_QUEUE_RUNNING) {
+        time_t now = time(NULL);
+        if ( job_queue_get_max_job_duration(queue) > 0) {
+          double elapsed = difftime(now, job_queue_node_get_sim_start( node ));
+          if (elapsed > job_queue_get_max_job_duration(queue))
+            job_queue_change_node_status(queue, node, JOB_QUEUE_DO_KILL);
+        }
+        if (job_queue_get_job_stop_time(queue) > 0) {
+          if (now >= job_queue_get_job_stop_time(queue))
+            job_queue_change_node_status(queue, node, JOB_QUEUE_DO_KILL);
+        }
       }
     }
+    int_vector_free( indices );
   }
 }
 
@@ -884,14 +919,28 @@ void job_queue_run_jobs(job_queue_type * queue , int num_total_run, bool verbose
     */
     const int NUM_WORKER_THREADS = 4;
     queue->work_pool = thread_pool_alloc( NUM_WORKER_THREADS , true );
+    if (job_queue_has_driver( queue ))
+      queue_driver_set_notify( queue->driver , job_queue_status_notify__ , queue->status );
     {
       bool new_jobs         = false;
       bool cont             = true;
       int  phase = 0;
+      int  max_poll_usec    = queue->usleep_time;
+      int  poll_usec        = JOB_QUEUE_MIN_POLL_USEC;
+      int_vector_type * indices = int_vector_alloc( 0 , 0 );
+
+      if (job_queue_has_driver( queue ) && queue_driver_has_notify( queue->driver ))
+        max_poll_usec = 8 * queue->usleep_time;
 
       queue->running = true;
       do {
         bool local_user_exit = false;
+        /*
+          The event count must be read before the status is inspected;
+          then any status change in the iteration below will make the
+          job_queue_status_wait() at the end return immediately.
+        */
+        unsigned int event_count = job_queue_status_get_event_count( queue->status );
         job_list_get_rdlock( queue->job_list );
         /*****************************************************************/
         if (queue->user_exit)  {/* An external thread has called the job_queue_user_exit() function, and we should kill
@@ -966,23 +1015,16 @@ void job_queue_run_jobs(job_queue_type * queue , int num_total_run, bool verbose
                 new_jobs = true;
 
             if (new_jobs) {
-              int submit_count = 0;
-              int queue_index  = 0;
-
-              while ((queue_index < job_list_get_size( queue->job_list )) && (num_submit_new > 0)) {
+              job_queue_status_get_indices( queue->status , JOB_QUEUE_WAITING , num_submit_new , indices );
+              for (int i = 0; i < int_vector_size( indices ); i++) {
+                int queue_index = int_vector_iget( indices , i );
                 job_queue_node_type * node = job_list_iget_job( queue->job_list , queue_index );
                 if (job_queue_node_get_status(node) == JOB_QUEUE_WAITING) {
-                  {
-                    submit_status_type submit_status = job_queue_submit_job(queue , queue_index);
-
-                    if (submit_status == SUBMIT_OK) {
-                      num_submit_new--;
-                      submit_count++;
-                    } else if ((submit_status == SUBMIT_DRIVER_FAIL) || (submit_status == SUBMIT_QUEUE_CLOSED))
-                      break;
-                  }
+                  submit_status_type submit_status = job_queue_submit_job(queue , queue_index);
+
+                  if ((submit_status == SUBMIT_DRIVER_FAIL) || (submit_status == SUBMIT_QUEUE_CLOSED))
+                    break;
                 }
-                queue_index++;
               }
             }
 
@@ -991,9 +1033,11 @@ void job_queue_run_jobs(job_queue_type * queue , int num_total_run, bool verbose
               /*
                 Checking for complete / exited / overtime jobs
                */
-              int queue_index;
-              for (queue_index = 0; queue_index < job_list_get_size( queue->job_list ); queue_index++) {
-                job_queue_node_type * node = job_list_iget_job( queue->job_list , queue_index );
+              job_queue_status_get_indices( queue->status ,
+                                            JOB_QUEUE_DONE + JOB_QUEUE_EXIT + JOB_QUEUE_DO_KILL_NODE_FAILURE + JOB_QUEUE_DO_KILL ,
+                                            -1 , indices );
+              for (int i = 0; i < int_vector_size( indices ); i++) {
+                job_queue_node_type * node = job_list_iget_job( queue->job_list , int_vector_iget( indices , i ));
 
                 switch (job_queue_node_get_status(node)) {
                   case(JOB_QUEUE_DONE):
@@ -1023,12 +1067,21 @@ void job_queue_run_jobs(job_queue_type * queue , int num_total_run, bool verbose
         job_list_unlock( queue->job_list );
         if (local_user_exit)
           cont = false;    /* This is how we signal that we want to get out . */
-        else {
-          util_yield();
-          job_list_reader_wait( queue->job_list , queue->usleep_time , 8 * queue->usleep_time);
+        else if (cont) {
+          /*
+            Sleep until something happens; when the wait times out
+            the driver is polled again, with increasing intervals.
+          */
+          if (job_queue_status_wait( queue->status , event_count , poll_usec ))
+            poll_usec = JOB_QUEUE_MIN_POLL_USEC;
+          else
+            poll_usec = util_int_min( 2 * poll_usec , max_poll_usec );
         }
       } while ( cont );
+      int_vector_free( indices );
     }
+    if (job_queue_has_driver( queue ))
+      queue_driver_set_notify( queue->driver , NULL , NULL );
     if (verbose)
       printf("\n");
     thread_pool_join( queue->work_pool );
@@ -1219,6 +1272,7 @@ job_queue_type * job_queue_alloc(int  max_submit               ,
 
 void job_queue_submit_complete( job_queue_type * queue ){
   queue->submit_complete = true;
+  job_queue_status_notify( queue->status );
 }
 
 
@@ -1270,6 +1324,7 @@ void job_queue_set_pause_on( job_queue_type * job_queue) {
 
 void job_queue_set_pause_off( job_queue_type * job_queue) {
   job_queue->pause_on = false;
+  job_queue_status_notify( job_queue->status );
 }
 
 /*
@@ -1290,6 +1345,7 @@ bool job_queue_start_user_exit( job_queue_type * queue) {
     while (true) {
       if (queue->running) {
         queue->user_exit = true;
+        job_queue_status_notify( queue->status );
         break;
     }
       usleep( usleep_time );
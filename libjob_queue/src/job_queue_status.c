@@ -16,19 +16,42 @@
    for more details.
 */
 #include <pthread.h>
+#include <stdint.h>
+#include <errno.h>
+#include <sys/time.h>
 
 #include <ert/util/type_macros.h>
 #include <ert/util/util.h>
+#include <ert/util/int_vector.h>
 
 #include <ert/job_queue/queue_driver.h>
 #include <ert/job_queue/job_queue_status.h>
 
 #define JOB_QUEUE_STATUS_TYPE_ID 777620306
+#define INDEX_SET_WORD_BITS      64
+
+/*
+  In addition to the number of jobs in each state the job_queue_status
+  keeps track of which jobs are in each state, with one bitset of
+  queue indices for each state. That way the job_queue can find
+  e.g. the waiting jobs without scanning the complete job list.
+
+  Every status transition increments the event_count and signals the
+  change_cond condition variable; the thread running the queue can
+  then sleep in job_queue_status_wait() until something has happened,
+  instead of polling at a fixed interval. Other threads, e.g. a queue
+  driver which has detected that a job has completed, can wake the
+  queue with job_queue_status_notify().
+*/
 
 struct job_queue_status_struct {
   UTIL_TYPE_ID_DECLARATION;
   int status_list[JOB_QUEUE_MAX_STATE];
+  uint64_t * index_set[JOB_QUEUE_MAX_STATE];
+  int index_set_words;
+  unsigned int event_count;
   pthread_mutex_t update_mutex;
+  pthread_cond_t change_cond;
 };
 
 static const int status_index[] = {  JOB_QUEUE_NOT_ACTIVE ,  // Initial, allocated job state, job not added                                - controlled by job_queue
@@ -68,20 +91,75 @@ job_queue_status_type * job_queue_status_alloc() {
   job_queue_status_type * status = util_malloc( sizeof * status );
   UTIL_TYPE_ID_INIT( status ,   JOB_QUEUE_STATUS_TYPE_ID );
   pthread_mutex_init( &status->update_mutex , NULL );
+  pthread_cond_init( &status->change_cond , NULL );
+  for (int index = 0; index < JOB_QUEUE_MAX_STATE; index++)
+    status->index_set[ index ] = NULL;
+  status->index_set_words = 0;
+  status->event_count = 0;
   job_queue_status_clear( status );
   return status;
 }
 
 
 void job_queue_status_free( job_queue_status_type * status ) {
+  for (int index = 0; index < JOB_QUEUE_MAX_STATE; index++)
+    util_safe_free( status->index_set[ index ] );
+  pthread_cond_destroy( &status->change_cond );
+  pthread_mutex_destroy( &status->update_mutex );
   free( status );
 }
 
 
 void job_queue_status_clear( job_queue_status_type * status ) {
   int index;
-  for (index = 0; index < JOB_QUEUE_MAX_STATE; index++)
+  pthread_mutex_lock( &status->update_mutex );
+  for (index = 0; index < JOB_QUEUE_MAX_STATE; index++) {
     status->status_list[ index ] = 0;
+    for (int word = 0; word < status->index_set_words; word++)
+      status->index_set[ index ][ word ] = 0;
+  }
+  pthread_mutex_unlock( &status->update_mutex );
+}
+
+
+/*
+  Must hold the update_mutex.
+*/
+
+static void job_queue_status_signal__( job_queue_status_type * status ) {
+  status->event_count++;
+  pthread_cond_broadcast( &status->change_cond );
+}
+
+
+/*
+  Must hold the update_mutex. Negative queue indices, i.e. nodes which
+  have not been added to a job_list, are only counted.
+*/
+
+static void job_queue_status_set_index__( job_queue_status_type * status , int state_index , int queue_index , bool value) {
+  if (queue_index < 0)
+    return;
+
+  {
+    int word = queue_index / INDEX_SET_WORD_BITS;
+    uint64_t mask = ((uint64_t) 1) << (queue_index % INDEX_SET_WORD_BITS);
+
+    if (word >= status->index_set_words) {
+      int new_words = util_int_max( word + 1 , 2 * status->index_set_words );
+      for (int index = 0; index < JOB_QUEUE_MAX_STATE; index++) {
+        status->index_set[ index ] = util_realloc( status->index_set[ index ] , new_words * sizeof * status->index_set[ index ] );
+        for (int w = status->index_set_words; w < new_words; w++)
+          status->index_set[ index ][ w ] = 0;
+      }
+      status->index_set_words = new_words;
+    }
+
+    if (value)
+      status->index_set[ state_index ][ word ] |= mask;
+    else
+      status->index_set[ state_index ][ word ] &= ~mask;
+  }
 }
 
 
@@ -102,35 +180,139 @@ void job_queue_status_inc( job_queue_status_type * status_count , job_status_typ
   {
     int count = status_count->status_list[index];
     status_count->status_list[index] = count + 1;
+    job_queue_status_signal__( status_count );
   }
   pthread_mutex_unlock( &status_count->update_mutex );
 }
 
 
-static void job_queue_status_dec( job_queue_status_type * status_count , job_status_type status_type) {
-  int index = STATUS_INDEX( status_type );
+/*
+  The decrement, the increment and the update of the index sets are
+  performed as one atomic operation; the counts of the other threads
+  might still be read while the transition is in progress, if the
+  different status counts do not add up perfectly at all times that is
+  ok.
+*/
 
-  pthread_mutex_lock( &status_count->update_mutex );
+bool job_queue_status_transition_index( job_queue_status_type * status_count , int queue_index , job_status_type src_status , job_status_type target_status) {
+  if (src_status == target_status)
+    return false;
   {
-    int count = status_count->status_list[index];
-    status_count->status_list[index] = count - 1;
+    int src_index = STATUS_INDEX( src_status );
+    int target_index = STATUS_INDEX( target_status );
+
+    pthread_mutex_lock( &status_count->update_mutex );
+    {
+      status_count->status_list[src_index] -= 1;
+      status_count->status_list[target_index] += 1;
+      job_queue_status_set_index__( status_count , src_index , queue_index , false );
+      job_queue_status_set_index__( status_count , target_index , queue_index , true );
+      job_queue_status_signal__( status_count );
+    }
+    pthread_mutex_unlock( &status_count->update_mutex );
   }
-  pthread_mutex_unlock( &status_count->update_mutex );
+  return true;
 }
 
 
-/*
-  The important point is that each individual ++ and -- operation is
-  atomic, if the different status counts do not add up perfectly at
-  all times that is ok.
-*/
 bool job_queue_status_transition(job_queue_status_type * status_count, job_status_type src_status,
         job_status_type target_status) {
-  if (src_status == target_status)
-    return false;
-  job_queue_status_dec( status_count, src_status );
-  job_queue_status_inc( status_count, target_status );
-  return true;
+  return job_queue_status_transition_index( status_count , -1 , src_status , target_status );
+}
+
+
+/*
+  Will fill @indices with the queue indices, in increasing order, of
+  the jobs which are in one of the states in @status_mask. If
+  @max_count >= 0 at most @max_count indices are returned. The result
+  is a snapshot; the calling scope must check the status of the
+  individual jobs before acting on them.
+*/
+
+void job_queue_status_get_indices( job_queue_status_type * status , int status_mask , int max_count , int_vector_type * indices) {
+  int_vector_reset( indices );
+  if (max_count == 0)
+    return;
+
+  pthread_mutex_lock( &status->update_mutex );
+  {
+    bool full = false;
+    for (int word = 0; (word < status->index_set_words) && !full; word++) {
+      uint64_t bits = 0;
+      for (int index = 0; index < JOB_QUEUE_MAX_STATE; index++)
+        if (status_index[index] & status_mask)
+          bits |= status->index_set[index][word];
+
+      for (int bit = 0; (bits != 0) && !full; bit++) {
+        uint64_t mask = ((uint64_t) 1) << bit;
+        if (bits & mask) {
+          int_vector_append( indices , word * INDEX_SET_WORD_BITS + bit );
+          full = (int_vector_size( indices ) == max_count);
+          bits &= ~mask;
+        }
+      }
+    }
+  }
+  pthread_mutex_unlock( &status->update_mutex );
+}
+
+
+/*
+  Wakes up the threads sleeping in job_queue_status_wait() without any
+  change in the status counts.
+*/
+
+void job_queue_status_notify( job_queue_status_type * status ) {
+  pthread_mutex_lock( &status->update_mutex );
+  job_queue_status_signal__( status );
+  pthread_mutex_unlock( &status->update_mutex );
+}
+
+
+void job_queue_status_notify__( void * arg ) {
+  job_queue_status_type * status = job_queue_status_safe_cast( arg );
+  job_queue_status_notify( status );
+}
+
+
+unsigned int job_queue_status_get_event_count( job_queue_status_type * status ) {
+  unsigned int event_count;
+  pthread_mutex_lock( &status->update_mutex );
+  event_count = status->event_count;
+  pthread_mutex_unlock( &status->update_mutex );
+  return event_count;
+}
+
+
+/*
+  Will block until the event count differs from @event_count, or at
+  most @timeout_usec microseconds. The return value is true if there
+  has been an event. The calling scope should get the event count
+  *before* it inspects the status, then events which happen while the
+  status is inspected are not lost.
+*/
+
+bool job_queue_status_wait( job_queue_status_type * status , unsigned int event_count , int timeout_usec) {
+  struct timespec deadline;
+  bool event;
+  {
+    struct timeval now;
+    long usec;
+
+    gettimeofday( &now , NULL );
+    usec = now.tv_usec + timeout_usec;
+    deadline.tv_sec = now.tv_sec + usec / 1000000;
+    deadline.tv_nsec = (usec % 1000000) * 1000;
+  }
+
+  pthread_mutex_lock( &status->update_mutex );
+  while (status->event_count == event_count) {
+    if (pthread_cond_timedwait( &status->change_cond , &status->update_mutex , &deadline ) == ETIMEDOUT)
+      break;
+  }
+  event = (status->event_count != event_count);
+  pthread_mutex_unlock( &status->update_mutex );
+  return event;
 }
 
 
@@ -33,10 +33,11 @@
 
 struct local_job_struct {
   UTIL_TYPE_ID_DECLARATION;
-  bool            active;
-  job_status_type status;
-  pthread_t       run_thread;
-  pid_t           child_process;
+  bool                active;
+  job_status_type     status;
+  pthread_t           run_thread;
+  pid_t               child_process;
+  local_driver_type * driver;
 };
 
 
@@ -45,8 +46,11 @@ struct local_job_struct {
 
 struct local_driver_struct {
   UTIL_TYPE_ID_DECLARATION;
-  pthread_attr_t     thread_attr;
-  pthread_mutex_t    submit_lock;
+  pthread_attr_t               thread_attr;
+  pthread_mutex_t              submit_lock;
+  pthread_mutex_t              notify_lock;
+  queue_driver_notify_ftype  * notify;
+  void                       * notify_arg;
 };
 
 /*****************************************************************/
@@ -62,6 +66,7 @@ local_job_type * local_job_alloc() {
   UTIL_TYPE_ID_INIT( job , LOCAL_JOB_TYPE_ID );
   job->active = false;
   job->status = JOB_QUEUE_WAITING;
+  job->driver = NULL;
   return job;
 }
 
@@ -103,6 +108,23 @@ void local_driver_kill_job( void * __driver , void * __job) {
 }
 
 
+static void local_driver_notify( local_driver_type * driver ) {
+  pthread_mutex_lock( &driver->notify_lock );
+  if (driver->notify != NULL)
+    driver->notify( driver->notify_arg );
+  pthread_mutex_unlock( &driver->notify_lock );
+}
+
+
+void local_driver_set_notify( void * __driver , queue_driver_notify_ftype * notify , void * notify_arg) {
+  local_driver_type * driver = local_driver_safe_cast( __driver );
+  pthread_mutex_lock( &driver->notify_lock );
+  driver->notify = notify;
+  driver->notify_arg = notify_arg;
+  pthread_mutex_unlock( &driver->notify_lock );
+}
+
+
 void * submit_job_thread__(void * __arg) {
   arg_pack_type *arg_pack = arg_pack_safe_cast(__arg);
   const char *executable = arg_pack_iget_const_ptr(arg_pack, 0);
@@ -124,8 +146,16 @@ void * submit_job_thread__(void * __arg) {
     waitpid(job->child_process, &wait_status, 0);
   }
 
-  job->status = JOB_QUEUE_DONE;
-  job->active = false;
+  /*
+    When the status has been set to DONE the job can be freed by the
+    queue at any time; it should not be touched after that.
+  */
+  {
+    local_driver_type * driver = job->driver;
+    job->active = false;
+    job->status = JOB_QUEUE_DONE;
+    local_driver_notify( driver );
+  }
   pthread_exit(NULL);
   return NULL;
 }
@@ -150,6 +180,7 @@ void * local_driver_submit_job(void * __driver           ,
     arg_pack_append_ptr( arg_pack , job );
     
     pthread_mutex_lock( &driver->submit_lock );
+    job->driver = driver;
     job->active = true;
     job->status = JOB_QUEUE_RUNNING;
     
@@ -180,6 +211,9 @@ void * local_driver_alloc() {
   local_driver_type * local_driver = util_malloc(sizeof * local_driver );
   UTIL_TYPE_ID_INIT( local_driver , LOCAL_DRIVER_TYPE_ID);
   pthread_mutex_init( &local_driver->submit_lock , NULL );
+  pthread_mutex_init( &local_driver->notify_lock , NULL );
+  local_driver->notify = NULL;
+  local_driver->notify_arg = NULL;
   pthread_attr_init( &local_driver->thread_attr );
   pthread_attr_setdetachstate( &local_driver->thread_attr , PTHREAD_CREATE_DETACHED );
   
@@ -71,6 +71,7 @@ struct queue_driver_struct {
   get_option_ftype * get_option;
   has_option_ftype * has_option;
   init_option_list_ftype * init_options;
+  set_notify_ftype * set_notify;
 
   void * data; /* Driver specific data - passed as first argument to the driver functions above. */
 
@@ -184,6 +185,7 @@ static queue_driver_type * queue_driver_alloc_empty() {
   driver->data = NULL;
   driver->max_running_string = NULL;
   driver->init_options = NULL;
+  driver->set_notify = NULL;
 
   queue_driver_set_generic_option__(driver, MAX_RUNNING, "0");
 
@@ -228,6 +230,7 @@ queue_driver_type * queue_driver_alloc(job_driver_type type) {
       driver->free_driver = local_driver_free__;
       driver->name = util_alloc_string_copy("local");
       driver->init_options = local_driver_init_option_list;
+      driver->set_notify = local_driver_set_notify;
       driver->data = local_driver_alloc();
       break;
     case RSH_DRIVER:
@@ -359,6 +362,24 @@ job_status_type queue_driver_get_status(queue_driver_type * driver, void * job_d
   return status;
 }
 
+/**
+   Drivers which detect status changes by themselves, e.g. the LOCAL
+   driver which waits for the child processes, can call the @notify
+   function when the status of a job has changed; that way the
+   job_queue does not have to poll the driver to discover that a job
+   has completed. Drivers which do not support this ignore the call,
+   and must be polled with queue_driver_get_status().
+*/
+
+void queue_driver_set_notify(queue_driver_type * driver, queue_driver_notify_ftype * notify, void * notify_arg) {
+  if (driver->set_notify != NULL)
+    driver->set_notify(driver->data, notify, notify_arg);
+}
+
+bool queue_driver_has_notify(const queue_driver_type * driver) {
+  return (driver->set_notify != NULL);
+}
+
 void queue_driver_free_driver(queue_driver_type * driver) {
   driver->free_driver(driver->data);
 }
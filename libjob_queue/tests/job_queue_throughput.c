@@ -0,0 +1,120 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'job_queue_throughput.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include <ert/util/util.h>
+#include <ert/util/test_util.h>
+#include <ert/util/test_work_area.h>
+#include <ert/util/timer.h>
+
+#include <ert/job_queue/job_queue.h>
+#include <ert/job_queue/queue_driver.h>
+
+/*
+  Runs a large number of trivial jobs with the local driver, and
+  prints the throughput of the queue and the cpu time used by the
+  thread running the queue manager:
+
+     job_queue_throughput  job_queue_stress_task  [num_jobs  [max_running]]
+
+  The job_queue_stress_task creates an OK file in the runpath and
+  exits immediately, so the time used is dominated by the queue
+  itself and by starting the processes.
+*/
+
+
+static double thread_cpu_time( void ) {
+  struct timespec ts;
+  clock_gettime( CLOCK_THREAD_CPUTIME_ID , &ts );
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+
+static double process_cpu_time( void ) {
+  struct rusage usage;
+  getrusage( RUSAGE_SELF , &usage );
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + 1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+
+int main(int argc , char ** argv) {
+  char * job = util_alloc_abs_path( argv[1] );
+  int num_jobs = 2000;
+  int max_running = 50;
+  test_work_area_type * work_area = test_work_area_alloc( "job_queue_throughput" );
+  job_queue_type * queue = job_queue_alloc( 1 , "OK" , NULL , "ERROR" );
+  queue_driver_type * driver = queue_driver_alloc_local( );
+
+  util_install_signals();
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &num_jobs );
+  if (argc > 3)
+    util_sscanf_int( argv[3] , &max_running );
+
+  {
+    char * max_running_string = util_alloc_sprintf( "%d" , max_running );
+    queue_driver_set_option( driver , MAX_RUNNING , max_running_string );
+    free( max_running_string );
+  }
+  job_queue_set_driver( queue , driver );
+
+  for (int i = 0; i < num_jobs; i++) {
+    char * run_path = util_alloc_sprintf( "job%05d" , i );
+    const char * job_argv[4] = { run_path , "RUNNING" , "OK" , "0" };
+
+    util_make_path( run_path );
+    test_assert_int_equal( i , job_queue_add_job( queue , job , NULL , NULL , NULL , NULL , 1 , run_path , run_path , 4 , job_argv ));
+    free( run_path );
+  }
+
+  {
+    timer_type * timer = timer_alloc( false );
+    double cpu0 = process_cpu_time( );
+    double loop_cpu0 = thread_cpu_time( );
+    double wall_time , loop_cpu , cpu;
+
+    timer_start( timer );
+    job_queue_run_jobs( queue , num_jobs , false );
+    timer_stop( timer );
+
+    loop_cpu = thread_cpu_time( ) - loop_cpu0;
+    cpu = process_cpu_time( ) - cpu0;
+    wall_time = timer_get_total_time( timer );
+
+    printf("jobs:%6d   max_running:%4d   time: %8.3f s   jobs/s: %8.1f   queue loop cpu: %8.3f s   process cpu: %8.3f s\n",
+           num_jobs , max_running , wall_time , num_jobs / wall_time , loop_cpu , cpu );
+    timer_free( timer );
+  }
+
+  test_assert_int_equal( num_jobs , job_queue_get_num_complete( queue ));
+  test_assert_int_equal( 0 , job_queue_get_num_failed( queue ));
+  for (int i = 0; i < num_jobs; i++)
+    test_assert_int_equal( JOB_QUEUE_SUCCESS , job_queue_iget_job_status( queue , i ));
+
+  job_queue_free( queue );
+  queue_driver_free( driver );
+  test_work_area_free( work_area );
+  free( job );
+  exit(0);
+}
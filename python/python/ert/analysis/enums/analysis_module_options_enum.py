@@ -23,6 +23,7 @@ class AnalysisModuleOptionsEnum(BaseCEnum):
     ANALYSIS_UPDATE_A = None
     ANALYSIS_SCALE_DATA = None
     ANALYSIS_ITERABLE = None
+    ANALYSIS_OBS_COVAR = None
  
 AnalysisModuleOptionsEnum.populateEnum(ANALYSIS_LIB , "analysis_module_flag_enum_iget")
 AnalysisModuleOptionsEnum.registerEnum(ANALYSIS_LIB , "analysis_module_options_enum")
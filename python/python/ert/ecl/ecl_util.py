@@ -109,9 +109,13 @@ EclUnitTypeEnum.registerEnum(ECL_LIB, "ecl_unit_enum")
 class EclFileFlagEnum(BaseCEnum):
     ECL_FILE_CLOSE_STREAM = None
     ECL_FILE_WRITABLE = None
+    ECL_FILE_MMAP = None
+    ECL_FILE_INDEX = None
 
 EclFileFlagEnum.addEnum("ECL_FILE_CLOSE_STREAM" , 1 )
 EclFileFlagEnum.addEnum("ECL_FILE_WRITABLE" , 2 )
+EclFileFlagEnum.addEnum("ECL_FILE_MMAP" , 4 )
+EclFileFlagEnum.addEnum("ECL_FILE_INDEX" , 8 )
 
 EclFileFlagEnum.registerEnum(ECL_LIB, "ecl_file_flag_enum")
 
@@ -37,6 +37,10 @@ class AnalysisConfig(BaseCClass):
     _have_enough_realisations = EnkfPrototype("bool analysis_config_have_enough_realisations(analysis_config, int, int)")
     _get_max_runtime = EnkfPrototype("int analysis_config_get_max_runtime(analysis_config)")
     _set_max_runtime = EnkfPrototype("void analysis_config_set_max_runtime(analysis_config, int)")
+    _get_num_threads = EnkfPrototype("int analysis_config_get_num_threads(analysis_config)")
+    _set_num_threads = EnkfPrototype("void analysis_config_set_num_threads(analysis_config, int)")
+    _get_memory_limit = EnkfPrototype("double analysis_config_get_memory_limit(analysis_config)")
+    _set_memory_limit = EnkfPrototype("void analysis_config_set_memory_limit(analysis_config, double)")
     _get_stop_long_running = EnkfPrototype("bool analysis_config_get_stop_long_running(analysis_config)")
     _set_stop_long_running = EnkfPrototype("void analysis_config_set_stop_long_running(analysis_config, bool)")
     _get_active_module_name = EnkfPrototype("char* analysis_config_get_active_module_name(analysis_config)")
@@ -112,6 +116,20 @@ class AnalysisConfig(BaseCClass):
     def set_max_runtime(self, max_runtime):
         self._set_max_runtime(max_runtime)
 
+    def get_num_threads(self):
+        """ @rtype: int """
+        return self._get_num_threads()
+
+    def set_num_threads(self, num_threads):
+        self._set_num_threads(num_threads)
+
+    def get_memory_limit(self):
+        """ @rtype: float """
+        return self._get_memory_limit()
+
+    def set_memory_limit(self, memory_limit):
+        self._set_memory_limit(memory_limit)
+
     def free(self):
         self._free()
         
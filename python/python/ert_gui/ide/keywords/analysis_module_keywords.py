@@ -16,6 +16,8 @@ class AnalysisModuleKeywords(object):
         ert_keywords.addKeyword(self.addStdCutoff())
         ert_keywords.addKeyword(self.addSingleNodeUpdate())
         ert_keywords.addKeyword(self.addIterRetryCount())
+        ert_keywords.addKeyword(self.addAnalysisThreads())
+        ert_keywords.addKeyword(self.addAnalysisMemoryLimit())
 
 
 
@@ -103,4 +105,22 @@ class AnalysisModuleKeywords(object):
                                                  documentation_link="keywords/single_node_update",
                                                  required=False,
                                                  group=self.group)
-        return single_node_update
\ No newline at end of file
+        return single_node_update
+
+
+    def addAnalysisThreads(self):
+        analysis_threads = ConfigurationLineDefinition(keyword=KeywordDefinition("ANALYSIS_THREADS"),
+                                                 arguments=[IntegerArgument()],
+                                                 documentation_link="keywords/analysis_threads",
+                                                 required=False,
+                                                 group=self.group)
+        return analysis_threads
+
+
+    def addAnalysisMemoryLimit(self):
+        analysis_memory_limit = ConfigurationLineDefinition(keyword=KeywordDefinition("ANALYSIS_MEMORY_LIMIT"),
+                                                 arguments=[FloatArgument()],
+                                                 documentation_link="keywords/analysis_memory_limit",
+                                                 required=False,
+                                                 group=self.group)
+        return analysis_memory_limit
@@ -36,6 +36,28 @@ class AnalysisConfigTest(ExtendedTestCase):
         self.assertTrue( ac.get_stop_long_running() )
 
 
+    def test_num_threads(self):
+        ac = AnalysisConfig()
+        self.assertTrue( ac.get_num_threads() >= 1 )
+
+        ac.set_num_threads( 3 )
+        self.assertEqual( 3 , ac.get_num_threads() )
+
+        ac.set_num_threads( 0 )
+        self.assertTrue( ac.get_num_threads() >= 1 )
+
+
+    def test_memory_limit(self):
+        ac = AnalysisConfig()
+        self.assertEqual( 0 , ac.get_memory_limit() )
+
+        ac.set_memory_limit( 512.5 )
+        self.assertEqual( 512.5 , ac.get_memory_limit() )
+
+        ac.set_memory_limit( -1 )
+        self.assertEqual( 0 , ac.get_memory_limit() )
+
+
     def test_analysis_modules(self):
         ac = AnalysisConfig()
         self.assertIsNone( ac.activeModuleName() )
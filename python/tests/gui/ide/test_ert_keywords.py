@@ -124,6 +124,8 @@ class ErtKeywordTest(ExtendedTestCase):
         self.keywordTest("ITER_COUNT", [IntegerArgument], "keywords/iter_count", "Analysis Module")
         self.keywordTest("STD_CUTOFF", [FloatArgument], "keywords/std_cutoff", "Analysis Module")
         self.keywordTest("SINGLE_NODE_UPDATE", [BoolArgument], "keywords/single_node_update", "Analysis Module")
+        self.keywordTest("ANALYSIS_THREADS", [IntegerArgument], "keywords/analysis_threads", "Analysis Module")
+        self.keywordTest("ANALYSIS_MEMORY_LIMIT", [FloatArgument], "keywords/analysis_memory_limit", "Analysis Module")
 
 
     def test_advanced_keywords(self):